@@ -0,0 +1,80 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SPSC_QUEUE_H
+#define SRSRAN_SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace srsran {
+
+/**
+ * Lock-free queue for exactly one producer thread and one consumer thread with the following features:
+ * - no allocations, no locks and no system calls while pushing/popping elements. Just an atomic index update
+ * - pushing into a full queue and popping from an empty one fail instead of blocking, the caller decides whether to
+ *   drop, retry or sleep
+ * - the read and write indexes live in separate cache lines, so the producer and consumer do not share a line that
+ *   both write
+ */
+template <typename T, size_t N>
+class static_spsc_queue
+{
+  static_assert(N > 0, "The queue capacity must be positive");
+
+public:
+  bool try_push(const T& t)
+  {
+    size_t w = wpos.load(std::memory_order_relaxed);
+    if (w - rpos.load(std::memory_order_acquire) >= N) {
+      return false;
+    }
+    buffer[w % N] = t;
+    wpos.store(w + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(T& t)
+  {
+    size_t r = rpos.load(std::memory_order_relaxed);
+    if (r == wpos.load(std::memory_order_acquire)) {
+      return false;
+    }
+    t = buffer[r % N];
+    rpos.store(r + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const { return wpos.load(std::memory_order_acquire) - rpos.load(std::memory_order_acquire); }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() >= N; }
+  size_t max_size() const { return N; }
+
+private:
+  std::array<T, N> buffer = {};
+  alignas(64) std::atomic<size_t> wpos{0};
+  alignas(64) std::atomic<size_t> rpos{0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_SPSC_QUEUE_H
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSRAN_CPU_TOPOLOGY_H
+#define SRSRAN_CPU_TOPOLOGY_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * CPU layout of the host as exported by Linux in sysfs: the online logical CPUs, the physical core and package each
+ * of them belongs to, their NUMA node and whether they have been isolated from the scheduler (isolcpus).
+ */
+class cpu_topology
+{
+public:
+  struct cpu_t {
+    uint32_t id         = 0;
+    uint32_t core_id    = 0;
+    uint32_t package_id = 0;
+    uint32_t numa_node  = 0;
+    bool     isolated   = false;
+  };
+
+  /// Reads the layout from the sysfs system directory. Returns false if the online CPUs cannot be read
+  bool read(const std::string& sysfs_system = "/sys/devices/system");
+
+  const std::vector<cpu_t>& get_cpus() const { return cpus; }
+
+  /**
+   * Selects one logical CPU per physical core, so SMT siblings do not share the work of two threads. Only isolated
+   * cores are considered if isolated_only is set. The cores are taken from the NUMA node with most candidate cores,
+   * ordered by CPU id.
+   */
+  std::vector<uint32_t> select_cores(bool isolated_only) const;
+
+  std::string to_string() const;
+
+  /// Parses a sysfs CPU list such as "0-3,8,10-11". An empty list is valid
+  static bool parse_cpu_list(const std::string& str, std::vector<uint32_t>& list);
+
+private:
+  std::vector<cpu_t> cpus;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_CPU_TOPOLOGY_H
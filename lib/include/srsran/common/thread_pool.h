@@ -85,6 +85,9 @@ public:
   uint32_t    get_nof_workers();
   std::string get_id();
 
+  /// Limits wait_worker() and wait_worker_nb() to the first nof_active workers, the others are only given by id
+  void set_nof_active_workers(uint32_t nof_active);
+
 private:
   bool find_finished_worker(uint32_t tti, uint32_t* id);
 
@@ -94,6 +97,7 @@ private:
   std::vector<worker*>                 workers     = {};
   uint32_t                             nof_workers = 0;
   uint32_t                             max_workers = 0;
+  uint32_t                             nof_active  = UINT32_MAX;
   bool                                 running     = false;
   std::condition_variable              cvar_queue  = {};
   std::mutex                           mutex_queue = {};
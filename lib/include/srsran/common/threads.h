@@ -39,6 +39,7 @@ bool threads_new_rt(pthread_t* thread, void* (*start_routine)(void*), void* arg)
 bool threads_new_rt_prio(pthread_t* thread, void* (*start_routine)(void*), void* arg, int prio_offset);
 bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void* arg, int cpu, int prio_offset);
 bool threads_new_rt_mask(pthread_t* thread, void* (*start_routine)(void*), void* arg, int mask, int prio_offset);
+bool threads_set_affinity(pthread_t thread, const uint32_t* cpus, uint32_t nof_cpus);
 void threads_print_self();
 
 #ifdef __cplusplus
@@ -46,6 +47,7 @@ void threads_print_self();
 
 #include <atomic>
 #include <string>
+#include <vector>
 
 namespace srsran {
 
@@ -79,6 +81,12 @@ public:
     return threads_new_rt_mask(&_thread, thread_function_entry, this, mask, prio);
   }
 
+  /// Pins the running thread to the given CPU ids, which are not limited to the first 8 CPUs like the start masks
+  bool set_affinity(const std::vector<uint32_t>& cpus)
+  {
+    return _thread != 0 and threads_set_affinity(_thread, cpus.data(), (uint32_t)cpus.size());
+  }
+
   void print_priority() { threads_print_self(); }
 
   void set_name(const std::string& name_)
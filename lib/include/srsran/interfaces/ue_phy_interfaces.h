@@ -95,15 +95,18 @@ struct phy_args_t {
   bool        estimator_fil_auto           = false;
   float       estimator_fil_stddev         = 1.0f;
   uint32_t    estimator_fil_order          = 4;
+  bool        estimator_precomputed        = true;
   float       snr_to_cqi_offset            = 0.0f;
   std::string sss_algorithm                = "full";
   float       rx_gain_offset               = 62;
   bool        pdsch_csi_enabled            = true;
+  bool        pdsch_fused_demod            = true;
   bool        pdsch_8bit_decoder           = false;
   uint32_t    intra_freq_meas_len_ms       = 20;
   uint32_t    intra_freq_meas_period_ms    = 200;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
+  bool        fast_cell_search             = true;
 
   bool nr_store_pdsch_ko = false;
 
@@ -60,6 +60,18 @@ typedef struct SRSRAN_API {
   float ema_alpha;        ///< EMA alpha parameter for avg power calculation, used in SRSRAN_CFR_THR_AUTO_EMA mode
 } srsran_cfr_cfg_t;
 
+/**
+ * @brief Number of samples of the blocks the peak search is split in. Only the blocks whose peak power exceeds the
+ * threshold are searched sample by sample
+ */
+#define SRSRAN_CFR_BLOCK_LEN 64
+
+/**
+ * @brief Maximum number of clipped samples per symbol that are filtered by adding the filter impulse response, instead
+ * of filtering the whole symbol in the frequency domain
+ */
+#define SRSRAN_CFR_MAX_LOOKUP_PEAKS 16
+
 typedef struct SRSRAN_API {
   srsran_cfr_cfg_t cfg;
   float            max_papr_lin;
@@ -69,9 +81,12 @@ typedef struct SRSRAN_API {
   float*            lpf_spectrum; ///< FFT filter spectrum
   uint32_t          lpf_bw;       ///< Bandwidth of the LPF
 
-  float* abs_buffer_in;  ///< Store the input absolute value
-  float* abs_buffer_out; ///< Store the output absolute value
-  cf_t*  peak_buffer;
+  cf_t*    pulse;            ///< Filter impulse response, repeated twice for circular indexing
+  uint32_t max_lookup_peaks; ///< Clipped samples filtered with the impulse response, the FFT is used above it
+
+  float*    block_max;   ///< Peak power of every block of SRSRAN_CFR_BLOCK_LEN samples
+  cf_t*     peak_buffer; ///< Clipping noise of every clipped sample, scaled by alpha
+  uint32_t* peak_idx;    ///< Index of every clipped sample
 
   float pwr_avg_in;  ///< store the avg. input power with MA or EMA averaging
   float pwr_avg_out; ///< store the avg. output power with MA or EMA averaging
@@ -81,6 +81,30 @@ typedef enum SRSRAN_API {
   SRSRAN_ESTIMATOR_ALG_WIENER,
 } srsran_chest_dl_estimator_alg_t;
 
+// Maximum number of taps of a precomputed frequency interpolation table
+#define SRSRAN_CHEST_DL_INTERP_MAX_TAPS 16
+
+// Number of precomputed frequency interpolation tables kept by the estimator
+#define SRSRAN_CHEST_DL_INTERP_NOF_TABLES 4
+
+// Maximum number of OFDM symbols carrying cell-specific reference signals for one port
+#define SRSRAN_CHEST_DL_MAX_PILOT_SYMB 4
+
+/* Frequency smoothing and interpolation weights for one pilot pattern and filter. Every estimate is a weighted sum of
+ * nof_taps consecutive pilots, so the table holds nof_taps rows of 2 x nof_re weights (real and imaginary parts) */
+typedef struct SRSRAN_API {
+  uint32_t nof_pilots;
+  uint32_t spacing;
+  uint32_t offset;
+  uint32_t filter_len;
+  float    filter[SRSRAN_CHEST_DL_INTERP_MAX_TAPS];
+  uint32_t nof_re;
+  uint32_t nof_taps;
+  uint32_t stride;
+  float*   weights;
+  uint64_t last_use;
+} srsran_chest_dl_interp_table_t;
+
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
   uint32_t      nof_rx_antennas;
@@ -106,6 +130,11 @@ typedef struct SRSRAN_API {
   srsran_interp_lin_t           srsran_interp_lin_3;
   srsran_interp_lin_t           srsran_interp_lin_mbsfn;
 
+  srsran_chest_dl_interp_table_t interp_table[SRSRAN_CHEST_DL_INTERP_NOF_TABLES];
+  uint64_t                       interp_table_count;
+  cf_t*                          interp_hold[SRSRAN_MAX_PORTS][SRSRAN_CHEST_DL_MAX_PILOT_SYMB];
+  uint32_t                       interp_hold_len;
+
   float rssi[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
   float rsrp[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
   float rsrp_corr[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
@@ -133,6 +162,10 @@ typedef struct SRSRAN_API {
   uint32_t cfo_estimate_sf_mask;
   bool     sync_error_enable;
 
+  /* Smooths and interpolates the pilots in frequency with precomputed weights for all ports at once. It applies to
+   * normal subframes with a fixed filter and the average or interpolate estimators, otherwise it is ignored */
+  bool precomputed_interp;
+
 } srsran_chest_dl_cfg_t;
 
 SRSRAN_API int srsran_chest_dl_init(srsran_chest_dl_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
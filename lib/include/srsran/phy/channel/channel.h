@@ -29,8 +29,14 @@
 #include "rlf.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -67,6 +73,9 @@ public:
     bool     rlf_enable   = false;
     uint32_t rlf_t_on_ms  = 10000;
     uint32_t rlf_t_off_ms = 2000;
+
+    // Parallel processing options, 0 threads runs every stage in the calling thread
+    uint32_t nof_threads = 0;
   };
 
   channel(const args_t& channel_args, uint32_t _nof_channels, srslog::basic_logger& logger);
@@ -76,18 +85,68 @@ public:
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
+  enum stage_t { STAGE_HST = 0, STAGE_AWGN, STAGE_FADING, STAGE_DELAY, STAGE_RLF, NOF_STAGES };
+
+  /// A pipeline task runs one stage of one channel over all the segments of a block
+  struct task_t {
+    uint32_t channel;
+    uint32_t stage_idx;
+  };
+
+  void run_stage(stage_t                   stage,
+                 uint32_t                  ch,
+                 const cf_t*               in,
+                 cf_t*                     out,
+                 uint32_t                  offset,
+                 uint32_t                  len,
+                 const srsran_timestamp_t& t);
+  void run_serial(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                  uint32_t                  len,
+                  const srsran_timestamp_t& t);
+  void run_parallel(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                    cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                    uint32_t                  len,
+                    const srsran_timestamp_t& t);
+  void run_task(const task_t& task);
+  void run_tasks(uint32_t nof_tasks);
+  void worker_loop();
+
   srslog::basic_logger&    logger;
   float                    hst_init_phase              = 0.0f;
   srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
   srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
+  srsran_channel_awgn_t*   awgn[SRSRAN_MAX_CHANNELS]   = {};
+  srsran_channel_hst_t*    hst[SRSRAN_MAX_CHANNELS]    = {};
   srsran_channel_rlf_t*    rlf                         = nullptr;
   cf_t*                    buffer_in                   = nullptr;
   cf_t*                    buffer_out                  = nullptr;
   uint32_t                 nof_channels                = 0;
   uint32_t                 current_srate               = 0;
   args_t                   args                        = {};
+  std::vector<stage_t>     stages                      = {};
+
+  // Pipelined processing. Every stage of every channel is a task, the block is split in segments and each task waits for
+  // the previous stage of its channel to hand over a segment before processing it
+  std::vector<std::thread> workers;
+  std::mutex               mutex;
+  std::condition_variable  cvar_start;
+  std::condition_variable  cvar_done;
+  uint64_t                 generation                                    = 0;
+  bool                     running                                       = true;
+  uint32_t                 nof_busy                                      = 0;
+  std::vector<task_t>      tasks                                         = {};
+  std::atomic<uint32_t>    next_task                                     = {0};
+  std::atomic<uint32_t>    nof_done                                      = {0};
+  cf_t*                    stage_buffer[SRSRAN_MAX_CHANNELS][NOF_STAGES] = {};
+  cf_t*                    task_in[SRSRAN_MAX_CHANNELS]                  = {};
+  cf_t*                    task_out[SRSRAN_MAX_CHANNELS]                 = {};
+  uint32_t                 task_len                                      = 0;
+  uint32_t                 segment_len                                   = 0;
+  uint32_t                 nof_segments                                  = 0;
+  srsran_timestamp_t       task_time                                     = {};
+
+  std::array<std::array<std::atomic<uint32_t>, NOF_STAGES>, SRSRAN_MAX_CHANNELS> progress = {};
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
@@ -50,17 +50,17 @@ typedef struct {
   uint32_t state_len;  // Length of the impulse response saved in the state
 
   float coeff_alpha[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS]; // Angle of arrival
-  float coeff_a[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
-  float coeff_b[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
+  float coeff_w[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Doppler shift in turns per second
+  float coeff_a[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase in turns
+  float coeff_b[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase in turns
   cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain
 
   // Utils
-  srsran_dft_plan_t fft;             // DFT to frequency domain
-  srsran_dft_plan_t ifft;            // DFT to time domain
-  cf_t*             temp;            // Temporal buffer, length fft_size
-  cf_t*             h_freq;          // Channel frequency response, length fft_size
-  cf_t*             y_freq;          // Intermediate frequency domain buffer
-  float             sin_table[1024]; // Table of sinus values
+  srsran_dft_plan_t fft;    // DFT to frequency domain
+  srsran_dft_plan_t ifft;   // DFT to time domain
+  cf_t*             temp;   // Temporal buffer, length fft_size
+  cf_t*             h_freq; // Channel frequency response, length fft_size
+  cf_t*             y_freq; // Intermediate frequency domain buffer
 
   // State variables
   cf_t* state; // To save impulse response of the filter
@@ -80,6 +80,21 @@ SRSRAN_API double srsran_channel_fading_execute(srsran_channel_fading_t* q,
                                                 uint32_t                 nof_samples,
                                                 double                   init_time);
 
+/**
+ * @brief Generates the complex gain of every path of several fading channels at the same time instant, for instance
+ * one channel for each emulated UE. The gains are sum-of-sinusoids processes, all the sinusoids of a channel are
+ * evaluated together with SIMD.
+ *
+ * @param q Array of nof_channels fading channel objects
+ * @param nof_channels Number of fading channels
+ * @param time Time instant in seconds
+ * @param gains Output gains, SRSRAN_CHANNEL_FADING_MAXTAPS for each channel, the unused paths are set to zero
+ */
+SRSRAN_API void srsran_channel_fading_gen_gains(srsran_channel_fading_t* const* q,
+                                                uint32_t                        nof_channels,
+                                                double                          time,
+                                                cf_t*                           gains);
+
 #ifdef __cplusplus
 }
 #endif
@@ -102,6 +102,11 @@ SRSRAN_API int srsran_dft_replan_r(srsran_dft_plan_t* plan, int new_dft_points);
 
 SRSRAN_API void srsran_dft_plan_free(srsran_dft_plan_t* plan);
 
+/* Writes the FFTW wisdom gathered so far to the wisdom file if it has changed. The wisdom is otherwise only saved at
+ * exit, call this once the initial plans are created so a restart after an abnormal termination does not plan again.
+ */
+SRSRAN_API int srsran_dft_wisdom_save(void);
+
 /* Set options */
 
 SRSRAN_API void srsran_dft_plan_set_mirror(srsran_dft_plan_t* plan, bool val);
@@ -34,6 +34,9 @@
 #include "srsran/config.h"
 #include <stdbool.h>
 
+/* Number of codewords decoded at once by srsran_viterbi_decode_batch() when a lane-parallel decoder is available */
+#define SRSRAN_VITERBI_BATCH_LANES 16
+
 typedef enum { SRSRAN_VITERBI_27 = 0, SRSRAN_VITERBI_29, SRSRAN_VITERBI_37, SRSRAN_VITERBI_39 } srsran_viterbi_type_t;
 
 typedef struct SRSRAN_API {
@@ -47,11 +50,13 @@ typedef struct SRSRAN_API {
   int (*decode)(void*, uint8_t*, uint8_t*, uint32_t);
   int (*decode_s)(void*, uint16_t*, uint8_t*, uint32_t);
   int (*decode_f)(void*, float*, uint8_t*, uint32_t);
+  int (*decode_batch)(void*, float**, uint8_t**, uint32_t, uint32_t);
   void (*free)(void*);
   uint8_t*  tmp;
   uint16_t* tmp_s;
   uint8_t*  symbols_uc;
   uint16_t* symbols_us;
+  void*     ptr_batch;
 } srsran_viterbi_t;
 
 SRSRAN_API int srsran_viterbi_init(srsran_viterbi_t*     q,
@@ -68,6 +73,14 @@ SRSRAN_API void srsran_viterbi_free(srsran_viterbi_t* q);
 
 SRSRAN_API int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data, uint32_t frame_length);
 
+/* Decodes nof_cw codewords of the same length. The result is the same as calling srsran_viterbi_decode_f() on each
+ * of them, but up to SRSRAN_VITERBI_BATCH_LANES codewords are decoded in parallel when the decoder supports it. */
+SRSRAN_API int srsran_viterbi_decode_batch(srsran_viterbi_t* q,
+                                           float*            symbols[],
+                                           uint8_t*          data[],
+                                           uint32_t          nof_cw,
+                                           uint32_t          frame_length);
+
 SRSRAN_API int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data, uint32_t frame_length);
 
 SRSRAN_API int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* data, uint32_t frame_length);
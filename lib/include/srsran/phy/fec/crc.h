@@ -44,6 +44,12 @@ typedef struct SRSRAN_API {
   uint64_t crcmask;
   uint64_t crchighbit;
   uint32_t srsran_crc_out;
+
+  // Slice-by-8 tables shared by all the CRCs with the same generator, the CRC register is kept left-aligned in 32 bits
+  const uint32_t (*table8)[256];
+
+  // Carry-less folding constants x^128, x^192, x^512 and x^576 modulo the generator polynomial
+  uint64_t fold_k[4];
 } srsran_crc_t;
 
 SRSRAN_API int srsran_crc_init(srsran_crc_t* h, uint32_t srsran_crc_poly, int srsran_crc_order);
@@ -60,6 +60,8 @@ typedef struct {
   uint16_t                   ls;           /*!< \brief The desired lifting size. */
   float                      scaling_fctr; /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
   uint32_t                   max_nof_iter; /*!< \brief Maximum number of iterations, set to 0 for default value. */
+
+  bool syndrome_early_stop; /*!< \brief Stop iterating as soon as the hard decisions satisfy all parity checks. */
 } srsran_ldpc_decoder_args_t;
 
 /*!
@@ -67,6 +69,8 @@ typedef struct {
  */
 typedef struct SRSRAN_API {
   void*              ptr;          /*!< \brief Registers used by the decoder. */
+  void*              ptr_batch;    /*!< \brief Registers used by the batched decoder (NULL if not available). */
+  uint32_t           batch_size;   /*!< \brief Number of codewords decoded at once by the batched decoder. */
   srsran_basegraph_t bg;           /*!< \brief Current base graph. */
   uint16_t           ls;           /*!< \brief Current lifting size. */
   uint32_t           max_nof_iter; /*!< \brief Maximum number of iterations. */
@@ -82,6 +86,11 @@ typedef struct SRSRAN_API {
 
   float scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum algorithm. */
 
+  bool     syndrome_early_stop; /*!< \brief Enables the early stop based on the syndrome of the hard decisions. */
+  uint8_t* hard_bits;           /*!< \brief Hard decisions of the (transmitted part of the) codeword. */
+  uint8_t* syndrome;            /*!< \brief Syndrome of a single layer of the lifted graph. */
+  uint32_t last_nof_iter;       /*!< \brief Number of iterations carried out by the last decoding. */
+
   void (*free)(void*); /*!< \brief Pointer to a "destructor". */
 
   int (*decode_f)(void*,
@@ -99,6 +108,13 @@ typedef struct SRSRAN_API {
                   uint8_t*,
                   uint32_t,
                   srsran_crc_t*); /*!< \brief Pointer to the decoding function (16-bit version). */
+  int (*decode_batch_c)(void*,
+                        const int8_t* const*,
+                        uint8_t* const*,
+                        uint32_t,
+                        srsran_crc_t*,
+                        int*,
+                        uint32_t); /*!< \brief Pointer to the batched decoding function (8-bit version). */
 } srsran_ldpc_decoder_t;
 
 /*!
@@ -172,6 +188,10 @@ srsran_ldpc_decoder_decode_c(srsran_ldpc_decoder_t* q, const int8_t* llrs, uint8
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
  * \param[in,out] crc Code-block CRC object for early stop. Set for NULL to disable check
  * \return -1 if an error occurred, the number of used iterations, and 0 if CRC is provided and did not match
+ * \remark If the decoder was initialized with \ref srsran_ldpc_decoder_args_t::syndrome_early_stop, the decoding
+ *    also stops as soon as all the parity checks are satisfied, in which case the CRC (if provided) is evaluated
+ *    only once. The number of carried out iterations is always available in
+ *    \ref srsran_ldpc_decoder_t::last_nof_iter.
  */
 SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 const int8_t*          llrs,
@@ -179,4 +199,31 @@ SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 uint32_t               cdwd_rm_length,
                                                 srsran_crc_t*          crc);
 
+/*!
+ * Decodes several codewords sharing base graph and lifting size with 8-bit integer-valued LLRs. When the
+ * decoder supports it (small lifting sizes), the codewords are processed together in the same registers;
+ * otherwise, they are decoded one after the other. In both cases, the result is the same as calling
+ * srsran_ldpc_decoder_decode_crc_c() for each codeword.
+ * \param[in] q A pointer to the LDPC decoder (a srsran_ldpc_decoder_t structure
+ *    instance) that carries out the decoding.
+ * \param[in] llrs An array of \p nof_cb pointers to the LLRs of each codeword.
+ * \param[out] messages An array of \p nof_cb pointers to the decoded messages.
+ * \param[in] cdwd_rm_length The number of bits forming the longest codeword (after rate matching).
+ * \param[in,out] crc Code-block CRC object for early stop. Set for NULL to disable check
+ * \param[out] nof_iterations Array of \p nof_cb elements with, for each codeword, the number of used
+ *    iterations, and 0 if CRC is provided and did not match. It can be NULL.
+ * \param[in] nof_cb The number of codewords.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ * \remark As with srsran_ldpc_decoder_decode_crc_c(), each codeword stops as soon as all its parity checks are
+ *    satisfied if the decoder was initialized with \ref srsran_ldpc_decoder_args_t::syndrome_early_stop. Afterwards,
+ *    \ref srsran_ldpc_decoder_t::last_nof_iter holds the number of iterations carried out for the last codeword.
+ */
+SRSRAN_API int srsran_ldpc_decoder_decode_batch(srsran_ldpc_decoder_t* q,
+                                                const int8_t* const*   llrs,
+                                                uint8_t* const*        messages,
+                                                uint32_t               cdwd_rm_length,
+                                                srsran_crc_t*          crc,
+                                                int*                   nof_iterations,
+                                                uint32_t               nof_cb);
+
 #endif // SRSRAN_LDPCDECODER_H
@@ -37,6 +37,11 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+/*!
+ * Maximum number of decoding paths of the list decoder.
+ */
+#define SRSRAN_POLAR_DECODER_MAX_LIST_SIZE 8
+
 /*!
  * Lists the different types of polar decoder.
  */
@@ -45,15 +50,17 @@ typedef enum SRSRAN_API {
   SRSRAN_POLAR_DECODER_SSC_S = 1, /*!< \brief Fixed-point (16 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C = 2, /*!< \brief Fixed-point (8 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C_AVX2 =
-      3 /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+      3, /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+  SRSRAN_POLAR_DECODER_SCL_F = 4 /*!< \brief Floating-point Fast-SSC List (Fast-SSCL) decoder. */
 } srsran_polar_decoder_type_t;
 
 /*!
  * \brief Describes a polar decoder.
  */
 typedef struct SRSRAN_API {
-  void*   ptr;  /*!< \brief Pointer to the actual polar decoder structure. */
-  uint8_t nMax; /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  void*   ptr;       /*!< \brief Pointer to the actual polar decoder structure. */
+  uint8_t nMax;      /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  uint8_t list_size; /*!< \brief Maximum number of candidates returned by the decoder. */
   int (*decode_f)(void*           ptr,
                   const float*    symbols,
                   uint8_t*        data_decoded,
@@ -72,6 +79,18 @@ typedef struct SRSRAN_API {
                   const uint8_t   n,
                   const uint16_t* frozen_set,
                   const uint16_t  frozen_set_size); /*!< \brief Pointer to the decoder function (8-bit version). */
+  int (*decode_list_f)(void*           ptr,
+                       const float*    symbols,
+                       uint8_t**       data_decoded,
+                       const uint8_t   n,
+                       const uint16_t* frozen_set,
+                       const uint16_t  frozen_set_size); /*!< \brief Pointer to the list decoder function (float). */
+  int (*decode_list_c)(void*           ptr,
+                       const int8_t*   symbols,
+                       uint8_t**       data_decoded,
+                       const uint8_t   n,
+                       const uint16_t* frozen_set,
+                       const uint16_t  frozen_set_size); /*!< \brief Pointer to the list decoder function (8-bit). */
   void (*free)(void*);                             /*!< \brief Pointer to a "destructor". */
 } srsran_polar_decoder_t;
 
@@ -87,6 +106,18 @@ SRSRAN_API int srsran_polar_decoder_init(srsran_polar_decoder_t*     q,
                                          srsran_polar_decoder_type_t polar_decoder_type,
                                          const uint8_t               code_size_log);
 
+/*!
+ * Initializes a Fast-SSC list polar decoder (::SRSRAN_POLAR_DECODER_SCL_F) that keeps up to \a list_size decoding
+ * paths. srsran_polar_decoder_init() with ::SRSRAN_POLAR_DECODER_SCL_F uses ::SRSRAN_POLAR_DECODER_MAX_LIST_SIZE
+ * paths.
+ * \param[out] q A pointer to the initialized polar decoder.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] list_size Number of decoding paths, from 1 (SC decoding) to ::SRSRAN_POLAR_DECODER_MAX_LIST_SIZE.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int
+srsran_polar_decoder_init_list(srsran_polar_decoder_t* q, const uint8_t code_size_log, const uint8_t list_size);
+
 /*!
  * The polar decoder "destructor": it frees all the resources.
  * \param[in, out] q A pointer to the dismantled decoder.
@@ -145,4 +176,42 @@ SRSRAN_API int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
                                              const uint16_t*         frozen_set,
                                              const uint16_t          frozen_set_size);
 
+/*!
+ * Decodes the input (float) codeword and returns the candidate messages in decreasing order of likelihood, so
+ * that the caller can select the first one that passes its CRC. Decoders that are not list decoders return
+ * a single candidate.
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector.
+ * \param[out] data_decoded Array of q->list_size pointers to the candidate decoder output vectors.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of candidates if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_list_f(srsran_polar_decoder_t* q,
+                                                  const float*            input_llr,
+                                                  uint8_t**               data_decoded,
+                                                  const uint8_t           code_size_log,
+                                                  const uint16_t*         frozen_set,
+                                                  const uint16_t          frozen_set_size);
+
+/*!
+ * Decodes the input (int8_t) codeword and returns the candidate messages in decreasing order of likelihood, so
+ * that the caller can select the first one that passes its CRC. Decoders that are not list decoders return
+ * a single candidate.
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector.
+ * \param[out] data_decoded Array of q->list_size pointers to the candidate decoder output vectors.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of candidates if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                                  const int8_t*           input_llr,
+                                                  uint8_t**               data_decoded,
+                                                  const uint8_t           code_size_log,
+                                                  const uint16_t*         frozen_set,
+                                                  const uint16_t          frozen_set_size);
+
 #endif // SRSRAN_POLARDECODER_H
@@ -399,14 +399,94 @@ inline static uint8x16_t v_load_s8(int i15,
 
 #define INF 10000
 
+#else
+#ifdef WINIMP_IS_AVX512_16
+
+#ifndef LV_HAVE_AVX512
+#error "Selected AVX512 window decoder but instruction set not supported"
+#endif
+
+#include <immintrin.h>
+
+#define WINIMP avx512_16
+#define nof_blocks 32
+
+#define llr_t int16_t
+
+// Sub-block input buffers are only guaranteed 32-byte alignment, use unaligned access
+#define simd_type_t __m512i
+#define simd_load(x) _mm512_loadu_si512((void*)(x))
+#define simd_store(x, y) _mm512_storeu_si512((void*)(x), y)
+#define simd_add _mm512_adds_epi16
+#define simd_sub _mm512_subs_epi16
+#define simd_max _mm512_max_epi16
+#define simd_set1 _mm512_set1_epi16
+#define simd_insert(v, x, pos) _mm512_mask_set1_epi16(v, (__mmask32)1U << (pos), x)
+#define simd_shuffle(v, move) move(v, 2)
+// Shift by one element across the 128-bit lanes, the element shifted in is overwritten by the caller
+#define move_right(v, s) _mm512_alignr_epi8(_mm512_alignr_epi32(v, v, 4), v, s)
+#define move_left(v, s) _mm512_alignr_epi8(v, _mm512_alignr_epi32(v, v, 12), 16 - (s))
+#define simd_rb_shift _mm512_srai_epi16
+
+#define normalize_period 2
+#define win_overlap_len 40
+
+#define INF 10000
+
+#else
+#ifdef WINIMP_IS_AVX512_8
+
+#ifndef LV_HAVE_AVX512
+#error "Selected AVX512 window decoder but instruction set not supported"
+#endif
+
+#include <immintrin.h>
+
+#define WINIMP avx512_8
+#define nof_blocks 64
+
+#define llr_t int8_t
+
+// Sub-block input buffers are only guaranteed 32-byte alignment, use unaligned access
+#define simd_type_t __m512i
+#define simd_load(x) _mm512_loadu_si512((void*)(x))
+#define simd_store(x, y) _mm512_storeu_si512((void*)(x), y)
+#define simd_add _mm512_adds_epi8
+#define simd_sub _mm512_subs_epi8
+#define simd_max _mm512_max_epi8
+#define simd_set1 _mm512_set1_epi8
+#define simd_insert(v, x, pos) _mm512_mask_set1_epi8(v, (__mmask64)1ULL << (pos), x)
+#define simd_shuffle(v, move) move(v, 1)
+// Shift by one element across the 128-bit lanes, the element shifted in is overwritten by the caller
+#define move_right(v, s) _mm512_alignr_epi8(_mm512_alignr_epi32(v, v, 4), v, s)
+#define move_left(v, s) _mm512_alignr_epi8(v, _mm512_alignr_epi32(v, v, 12), 16 - (s))
+#define simd_rb_shift simd_rb_shift_512
+
+#define INF 0
+
+#define normalize_max
+#define normalize_period 1
+#define win_overlap_len 40
+#define use_saturated_add
+#define divide_output 1
+
+inline static __m512i simd_rb_shift_512(__m512i v, const int l)
+{
+  __m512i low = _mm512_srai_epi16(_mm512_slli_epi16(v, 8), l + 8);
+  __m512i hi  = _mm512_srai_epi16(v, l);
+  return _mm512_mask_blend_epi8((__mmask64)0x5555555555555555ULL, hi, low);
+}
+
 #else
 #error "Unknown WINIMP value"
 #endif
+#endif
 
 #endif
 #endif
 #endif
 #endif
+#endif
 
 typedef struct SRSRAN_API {
   uint32_t max_long_cb;
@@ -908,6 +988,21 @@ void MAKE_FUNC(
     INSERT8_INPUT(parity1, 24, 2);
 #endif
 
+#if nof_blocks >= 64
+    INSERT8_INPUT(syst, 32, 0);
+    INSERT8_INPUT(parity0, 32, 1);
+    INSERT8_INPUT(parity1, 32, 2);
+    INSERT8_INPUT(syst, 40, 0);
+    INSERT8_INPUT(parity0, 40, 1);
+    INSERT8_INPUT(parity1, 40, 2);
+    INSERT8_INPUT(syst, 48, 0);
+    INSERT8_INPUT(parity0, 48, 1);
+    INSERT8_INPUT(parity1, 48, 2);
+    INSERT8_INPUT(syst, 56, 0);
+    INSERT8_INPUT(parity0, 56, 1);
+    INSERT8_INPUT(parity1, 56, 2);
+#endif
+
     simd_store(systPtr++, syst);
     simd_store(parity0Ptr++, parity0);
     simd_store(parity1Ptr++, parity1);
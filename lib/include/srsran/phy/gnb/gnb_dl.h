@@ -56,10 +56,24 @@ typedef struct SRSRAN_API {
   srsran_dci_nr_t   dci; ///< Stores DCI configuration
   srsran_pdcch_nr_t pdcch;
   srsran_ssb_t      ssb;
+
+  bool shared_grid; ///< The resource grid belongs to another object, see srsran_gnb_dl_set_grid()
 } srsran_gnb_dl_t;
 
 SRSRAN_API int srsran_gnb_dl_init(srsran_gnb_dl_t* q, cf_t* output[SRSRAN_MAX_PORTS], const srsran_gnb_dl_args_t* args);
 
+/**
+ * @brief Initialises a gNb DL object that only encodes PDSCH, without resource grid, modulator, PDCCH nor SSB. It
+ * writes into the grid of the object given in srsran_gnb_dl_set_grid(), so the PDSCH of a slot can be encoded by
+ * several threads in parallel
+ */
+SRSRAN_API int srsran_gnb_dl_init_shared(srsran_gnb_dl_t* q, const srsran_gnb_dl_args_t* args);
+
+/**
+ * @brief Makes an object initialised with srsran_gnb_dl_init_shared() write into the resource grid of another one
+ */
+SRSRAN_API void srsran_gnb_dl_set_grid(srsran_gnb_dl_t* q, const srsran_gnb_dl_t* owner);
+
 SRSRAN_API int srsran_gnb_dl_set_carrier(srsran_gnb_dl_t* q, const srsran_carrier_nr_t* carrier);
 
 SRSRAN_API int srsran_gnb_dl_set_ssb_config(srsran_gnb_dl_t* q, const srsran_ssb_cfg_t* ssb);
@@ -47,10 +47,22 @@ typedef struct SRSRAN_API {
   srsran_chest_dl_res_t chest_pusch;
   srsran_chest_ul_res_t chest_pucch;
   float                 pusch_min_snr_dB; ///< Minimum measured DMRS SNR, below this threshold PUSCH is not decoded
+  bool                  shared_grid;      ///< The resource grid belongs to another object, see srsran_gnb_ul_set_grid()
 } srsran_gnb_ul_t;
 
 SRSRAN_API int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args_t* args);
 
+/**
+ * @brief Initialises a gNb UL object without resource grid nor FFT. It decodes PUSCH and PUCCH from the grid of the
+ * object given in srsran_gnb_ul_set_grid(), so the channels of a slot can be decoded by several threads in parallel
+ */
+SRSRAN_API int srsran_gnb_ul_init_shared(srsran_gnb_ul_t* q, const srsran_gnb_ul_args_t* args);
+
+/**
+ * @brief Makes an object initialised with srsran_gnb_ul_init_shared() decode from the resource grid of another one
+ */
+SRSRAN_API void srsran_gnb_ul_set_grid(srsran_gnb_ul_t* q, const srsran_gnb_ul_t* owner);
+
 SRSRAN_API void srsran_gnb_ul_free(srsran_gnb_ul_t* q);
 
 SRSRAN_API int srsran_gnb_ul_set_carrier(srsran_gnb_ul_t* q, const srsran_carrier_nr_t* carrier);
@@ -110,6 +110,31 @@ SRSRAN_API int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
                                        float              scaling,
                                        float              noise_estimate);
 
+/* Returns true if srsran_predecoding_demod_type() can handle the given layer to codeword mapping: either one codeword
+ * per layer or a single codeword spread over all the layers in transmit diversity.
+ */
+SRSRAN_API bool srsran_predecoding_demod_supported(srsran_tx_scheme_t type, int nof_ports, int nof_layers, int nof_cw);
+
+/* Estimates the vector "x" like srsran_predecoding_type() and soft-demodulates it straight into "llr" (int8_t if
+ * llr_is_8bit, int16_t otherwise), block by block, so the equalized symbols never leave the cache. The CSI, if
+ * provided, is filled exactly as in srsran_predecoding_type().
+ */
+SRSRAN_API int srsran_predecoding_demod_type(cf_t*              y[SRSRAN_MAX_PORTS],
+                                             cf_t*              h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                             float*             csi[SRSRAN_MAX_CODEWORDS],
+                                             void*              llr[SRSRAN_MAX_CODEWORDS],
+                                             srsran_mod_t       mod[SRSRAN_MAX_CODEWORDS],
+                                             bool               llr_is_8bit,
+                                             int                nof_rxant,
+                                             int                nof_ports,
+                                             int                nof_layers,
+                                             int                nof_cw,
+                                             int                codebook_idx,
+                                             int                nof_symbols,
+                                             srsran_tx_scheme_t type,
+                                             float              scaling,
+                                             float              noise_estimate);
+
 SRSRAN_API int srsran_precoding_pmi_select(cf_t*     h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
                                            uint32_t  nof_symbols,
                                            float     noise_estimate,
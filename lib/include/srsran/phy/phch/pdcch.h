@@ -47,6 +47,18 @@
 
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
+#define SRSRAN_PDCCH_MAX_DECODED 64
+
+/* Result of decoding one PDCCH candidate. It only depends on the location and the payload size, so it is shared by all
+ * the formats, search spaces and RNTIs looked for in the same subframe. */
+typedef struct SRSRAN_API {
+  uint32_t ncce;
+  uint32_t L;
+  uint32_t nof_bits;
+  uint16_t crc_rem;
+  uint8_t  payload[SRSRAN_DCI_MAX_BITS];
+} srsran_pdcch_decoded_t;
+
 /* PDCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -65,8 +77,14 @@ typedef struct SRSRAN_API {
   cf_t*    d;
   uint8_t* e;
   float    rm_f[3 * (SRSRAN_DCI_MAX_BITS + 16)];
+  float*   rm_batch; // SRSRAN_VITERBI_BATCH_LANES rate-recovered candidates, UE only
   float*   llr;
 
+  /* blind search state, reset every time the LLRs are extracted */
+  float                  cce_llr_abs[SRSRAN_MAX_PRB]; // Sum of the LLR magnitudes of each CCE
+  srsran_pdcch_decoded_t decoded[SRSRAN_PDCCH_MAX_DECODED];
+  uint32_t               nof_decoded;
+
   /* tx & rx objects */
   srsran_modem_table_t mod;
   srsran_sequence_t    seq[SRSRAN_NOF_SF_X_FRAME];
@@ -104,6 +122,17 @@ SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
 SRSRAN_API int
 srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg);
 
+/* Decodes at once, with srsran_viterbi_decode_batch(), all the candidates given by the locations and the payload sizes
+ * of the formats. Their results are kept so that the following calls to srsran_pdcch_decode_msg() for any of them do
+ * not decode them again. Candidates failing the energy check of srsran_pdcch_decode_msg() are skipped. */
+SRSRAN_API int srsran_pdcch_decode_candidates(srsran_pdcch_t*              q,
+                                              srsran_dl_sf_cfg_t*          sf,
+                                              srsran_dci_cfg_t*            dci_cfg,
+                                              const srsran_dci_location_t* locations,
+                                              uint32_t                     nof_locations,
+                                              const srsran_dci_format_t*   formats,
+                                              uint32_t                     nof_formats);
+
 /**
  * @brief Computes decoded DCI correlation. It encodes the given DCI message and compares it with the received LLRs
  * @param q PDCCH object
@@ -59,6 +59,7 @@ typedef struct SRSRAN_API {
   bool                  power_scale;
   bool                  csi_enable;
   bool                  use_tbs_index_alt;
+  bool                  fused_demod;
 
   union {
     srsran_softbuffer_tx_t* tx[SRSRAN_MAX_CODEWORDS];
@@ -46,6 +46,7 @@ typedef struct SRSRAN_API {
   srsran_sch_nr_args_t sch;
   bool                 measure_evm;
   bool                 measure_time;
+  bool                 fused_demod; ///< Demodulate while equalizing, d is not filled (ignored if measure_evm is set)
   uint32_t             max_prb;
   uint32_t             max_layers;
 } srsran_pdsch_nr_args_t;
@@ -65,6 +66,7 @@ typedef struct SRSRAN_API {
   srsran_modem_table_t modem_tables[SRSRAN_MOD_NITEMS]; ///< Modulator tables
   srsran_evm_buffer_t* evm_buffer;
   bool                 meas_time_en;
+  bool                 fused_demod;
   uint32_t             meas_time_us;
   srsran_re_pattern_t  dmrs_re_pattern;
   uint32_t             nof_rvd_re;
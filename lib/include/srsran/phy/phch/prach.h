@@ -47,6 +47,9 @@
 // Short PRACH ZC sequence sequence length
 #define SRSRAN_PRACH_N_ZC_SHORT 139
 
+// Number of PRACH preamble sequences available in a cell
+#define SRSRAN_PRACH_NOF_PREAMBLES 64
+
 /** Generation and detection of RACH signals for uplink.
  *  Currently only supports preamble formats 0-3.
  *  Does not currently support high speed flag.
@@ -59,6 +62,15 @@ typedef struct {
   cf_t  phase_array[2 * SRSRAN_PRACH_N_ZC_LONG];
 } srsran_prach_cancellation_t;
 
+/**
+ * Measurements of a single preamble, updated by every detection for all the searched preambles, detected or not.
+ */
+typedef struct SRSRAN_API {
+  float energy;      // Correlation peak power, normalised to the received power of the preamble
+  float peak_to_avg; // Correlation peak to average ratio
+  float t_offset;    // Time offset of the correlation peak in seconds
+} srsran_prach_meas_t;
+
 typedef struct SRSRAN_API {
   // Parameters from higher layers (extracted from SIB2)
   bool     is_nr;
@@ -119,6 +131,14 @@ typedef struct SRSRAN_API {
   cf_t                        sub[839 * 2];
   float                       phase[839];
 
+  // Correlation with all the root sequences, computed in a single pass with a batched IFFT
+  srsran_dft_plan_t   roots_ifft;
+  uint32_t            nof_roots_ifft;
+  cf_t*               roots_corr_spec;
+  float*              roots_corr;
+  srsran_prach_meas_t meas[SRSRAN_PRACH_NOF_PREAMBLES]; // Measurements of the last detection, indexed by preamble
+  uint32_t            nof_meas;
+
 } srsran_prach_t;
 
 typedef struct SRSRAN_API {
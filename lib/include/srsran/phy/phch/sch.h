@@ -48,6 +48,32 @@
 #define SRSRAN_TX_NULL 100
 #endif
 
+/**
+ * @brief Code block decoding job. It holds everything needed for rate dematching and turbo decoding one code block of
+ * a transport block. Its content is private to the SCH implementation.
+ */
+typedef struct srsran_sch_cb_job_s srsran_sch_cb_job_t;
+
+/**
+ * @brief Code block decoding resources owned by an executor thread. Each thread running jobs must use its own instance.
+ */
+typedef struct SRSRAN_API {
+  srsran_tdec_t decoder;
+  srsran_crc_t  crc_tb;
+  srsran_crc_t  crc_cb;
+  uint8_t*      data; ///< Temporary decoded code block, including its CRC
+} srsran_sch_cb_decoder_t;
+
+/**
+ * @brief External code block decoding executor. When it is set, the code blocks of a transport block are dispatched as
+ * independent jobs through push() and the decoder waits for all of them to complete. The executor is in charge of
+ * calling srsran_sch_cb_job_run() for every pushed job from any thread, providing a decoder owned by that thread.
+ */
+typedef struct SRSRAN_API {
+  void* arg;
+  void (*push)(void* arg, srsran_sch_cb_job_t* job);
+} srsran_sch_cb_executor_t;
+
 /* DL-SCH AND UL-SCH common functions */
 typedef struct SRSRAN_API {
 
@@ -61,7 +87,7 @@ typedef struct SRSRAN_API {
   uint8_t*         parity_bits;
   void*            e;
   uint8_t*         temp_g_bits;
-  uint32_t*        ul_interleaver;
+  void*            ul_deinterleaver; ///< Cache of UL-SCH deinterleaver tables
   srsran_uci_bit_t ack_ri_bits[57600]; // 4*M_sc*Qm_max for RI and ACK
 
   srsran_tcod_t encoder;
@@ -71,6 +97,10 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  /* Optional parallel code block decoding */
+  srsran_sch_cb_executor_t cb_executor;
+  void*                    cb_batch;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
@@ -81,6 +111,27 @@ SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
 
+/**
+ * @brief Sets an executor for decoding the code blocks of a transport block in parallel. Passing NULL, or an executor
+ * without push function, restores the serial decoding.
+ * @param q SCH object
+ * @param executor Code block executor, its content is copied
+ * @return SRSRAN_SUCCESS if the executor is set, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sch_set_cb_executor(srsran_sch_t* q, const srsran_sch_cb_executor_t* executor);
+
+SRSRAN_API int srsran_sch_cb_decoder_init(srsran_sch_cb_decoder_t* q);
+
+SRSRAN_API void srsran_sch_cb_decoder_free(srsran_sch_cb_decoder_t* q);
+
+/**
+ * @brief Runs a code block decoding job previously pushed to an executor. It is thread-safe provided that every
+ * concurrent call uses a different decoder.
+ * @param job Job provided by the executor push function
+ * @param decoder Decoding resources of the calling thread
+ */
+SRSRAN_API void srsran_sch_cb_job_run(srsran_sch_cb_job_t* job, srsran_sch_cb_decoder_t* decoder);
+
 SRSRAN_API int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data, uint8_t* e_bits);
 
 SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
@@ -52,6 +52,8 @@ typedef struct {
   uint8_t* payload;  ///< SCH payload
   bool     crc;      ///< CRC match
   float    avg_iter; ///< Average iterations
+  uint32_t nof_iter; ///< Total number of LDPC iterations carried out for the transport block
+  uint32_t max_iter; ///< Maximum number of LDPC iterations carried out for a single code block
 } srsran_sch_tb_res_nr_t;
 
 typedef struct SRSRAN_API {
@@ -85,7 +87,8 @@ typedef struct SRSRAN_API {
   bool     disable_simd;
   bool     decoder_use_flooded;
   float    decoder_scaling_factor;
-  uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  uint32_t max_nof_iter;                ///< Maximum number of LDPC iterations
+  bool     decoder_syndrome_early_stop; ///< Stop LDPC iterations as soon as all parity checks are satisfied
 } srsran_sch_nr_args_t;
 
 /**
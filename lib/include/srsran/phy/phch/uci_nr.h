@@ -38,9 +38,10 @@
  * @brief NR-UCI Encoder/decoder initialization arguments
  */
 typedef struct {
-  bool  disable_simd;         ///< Disable Polar code SIMD
-  float block_code_threshold; ///< Set normalised block code threshold (receiver only)
-  float one_bit_threshold;    ///< Decode threshold for 1 bit (receiver only)
+  bool     disable_simd;         ///< Disable Polar code SIMD
+  float    block_code_threshold; ///< Set normalised block code threshold (receiver only)
+  float    one_bit_threshold;    ///< Decode threshold for 1 bit (receiver only)
+  uint32_t polar_list_size;      ///< Polar list size, CRC11-aided list decoding if greater than 1 (receiver only)
 } srsran_uci_nr_args_t;
 
 typedef struct {
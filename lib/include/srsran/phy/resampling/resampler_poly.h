@@ -0,0 +1,150 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         resampler_poly.h
+ *
+ *  Description:  Streaming rational rate resampler using a polyphase filter
+ *                bank. The output rate is the input rate multiplied by L/M.
+ *
+ *  Reference:    Multirate Signal Processing for Communication Systems
+ *                fredric j. harris
+ *****************************************************************************/
+
+#ifndef SRSRAN_RESAMPLER_POLY_H
+#define SRSRAN_RESAMPLER_POLY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "srsran/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum number of polyphase branches, it limits the interpolation factor L
+ */
+#define SRSRAN_RESAMPLER_POLY_MAX_PHASES 1024
+
+/**
+ * Polyphase resampler quality, it determines the number of taps of each branch
+ */
+typedef enum {
+  SRSRAN_RESAMPLER_POLY_QUALITY_LOW = 0, ///< 16 taps per branch
+  SRSRAN_RESAMPLER_POLY_QUALITY_MEDIUM,  ///< 32 taps per branch
+  SRSRAN_RESAMPLER_POLY_QUALITY_HIGH,    ///< 64 taps per branch
+} srsran_resampler_poly_quality_t;
+
+/**
+ * @brief Polyphase resampler internal buffers and state
+ */
+typedef struct {
+  srsran_resampler_poly_quality_t quality;    ///< Selected quality
+  uint32_t                        interp;     ///< Interpolation factor L
+  uint32_t                        decim;      ///< Decimation factor M
+  uint32_t                        nof_taps;   ///< Number of taps of each polyphase branch
+  uint32_t                        delay;      ///< Filter delay in output samples
+  uint32_t                        next_idx;   ///< Window start of the next output sample, in the state and input
+  uint32_t                        next_phase; ///< Polyphase branch of the next output sample
+  float*                          filter;     ///< Polyphase branches, nof_taps time reversed coefficients each
+  cf_t*                           state;      ///< Last nof_taps input samples followed by the first new ones
+} srsran_resampler_poly_t;
+
+/**
+ * @brief Initialises a polyphase resampler converting between two sampling rates.
+ *
+ * The rate ratio is reduced to the smallest L/M fraction, both rates are rounded to 1 Hz.
+ *
+ * @param q Object pointer
+ * @param srate_in_hz Input sampling rate in Hz
+ * @param srate_out_hz Output sampling rate in Hz
+ * @param quality Filter quality
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_poly_init(srsran_resampler_poly_t*        q,
+                                          double                          srate_in_hz,
+                                          double                          srate_out_hz,
+                                          srsran_resampler_poly_quality_t quality);
+
+/**
+ * @brief Resets the internal resampler state, the samples in the filter are set to zero
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q);
+
+/**
+ * @brief Gets the resampler delay. The output sample n corresponds to the input at the time of the output sample
+ * n - delay.
+ * @param q Object pointer
+ * @return the delay in number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q);
+
+/**
+ * @brief Gets the number of input samples that produce exactly the given number of output samples from the current
+ * state
+ * @param q Object pointer
+ * @param nof_output Number of output samples
+ * @return the number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output);
+
+/**
+ * @brief Gets the number of output samples produced by the given number of input samples from the current state
+ * @param q Object pointer
+ * @param nof_input Number of input samples
+ * @return the number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_nof_output(const srsran_resampler_poly_t* q, uint32_t nof_input);
+
+/**
+ * @brief Resamples a block of a continuous stream.
+ *
+ * The input and output lengths must be consistent with the state. That is the case if nof_input is given by
+ * srsran_resampler_poly_nof_input() for nof_output, or nof_output is given by srsran_resampler_poly_nof_output()
+ * for nof_input.
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param output Points at the output complex buffer
+ * @param nof_input Number of input samples
+ * @param nof_output Number of output samples
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                         const cf_t*              input,
+                                         cf_t*                    output,
+                                         uint32_t                 nof_input,
+                                         uint32_t                 nof_output);
+
+/**
+ * @brief Frees the polyphase resampler buffers
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_free(srsran_resampler_poly_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_RESAMPLER_POLY_H
@@ -103,6 +103,36 @@ typedef struct SRSRAN_API {
 
 typedef enum { PSS_TX, PSS_RX } pss_direction_t;
 
+/* Coarse search of the three PSS sequences at once.
+ *
+ * The input is transformed once at the full rate and only the band around DC that holds the PSS is kept, which
+ * decimates the signal in the frequency domain. The decimated spectrum is correlated with all the N_id_2 sequences,
+ * so the cost of each correlation is a small inverse DFT. The peak positions are rounded to the decimation factor and
+ * must be refined at the full rate (e.g. srsran_sync_find() over a small window around them).
+ */
+typedef struct SRSRAN_API {
+  uint32_t          frame_size;
+  uint32_t          fft_size;
+  uint32_t          decimate;
+  uint32_t          dft_size;     // Full rate DFT size, holds the linear correlation of the whole frame
+  uint32_t          dft_size_dec; // dft_size / decimate
+  srsran_dft_plan_t dftp_input;
+  srsran_dft_plan_t idftp_corr;
+  cf_t*             input_pad;
+  cf_t*             input_fft;
+  cf_t*             input_fft_dec;
+  cf_t*             pss_fft_dec[SRSRAN_NOF_NID_2]; // Decimated band of each PSS matched filter
+  cf_t*             corr_fft;
+  cf_t*             corr;
+  float*            corr_abs;
+} srsran_pss_search_t;
+
+typedef struct SRSRAN_API {
+  uint32_t peak_pos;   // Full rate correlation peak, same reference as srsran_pss_find_pss()
+  float    peak_value; // Squared correlation peak
+  float    psr;        // Peak to side-lobe ratio
+} srsran_pss_search_res_t;
+
 /* Basic functionality */
 SRSRAN_API int srsran_pss_init_fft(srsran_pss_t* q, uint32_t frame_size, uint32_t fft_size);
 
@@ -141,4 +171,11 @@ SRSRAN_API int srsran_pss_chest(srsran_pss_t* q, const cf_t* input, cf_t ce[SRSR
 
 SRSRAN_API float srsran_pss_cfo_compute(srsran_pss_t* q, const cf_t* pss_recv);
 
+SRSRAN_API int srsran_pss_search_init(srsran_pss_search_t* q, uint32_t frame_size, uint32_t fft_size, uint32_t decimate);
+
+SRSRAN_API void srsran_pss_search_free(srsran_pss_search_t* q);
+
+SRSRAN_API int
+srsran_pss_search_run(srsran_pss_search_t* q, const cf_t* input, srsran_pss_search_res_t res[SRSRAN_NOF_NID_2]);
+
 #endif // SRSRAN_PSS_H
@@ -74,6 +74,11 @@ typedef struct SRSRAN_API {
   uint8_t*  mode_counted;
 
   srsran_ue_cellsearch_result_t* candidates;
+
+  // srsran_ue_cellsearch_scan_fast() objects
+  srsran_pss_search_t pss_search;                    // Decimated search of the three N_id_2
+  srsran_sync_t       sync_refine[SRSRAN_NOF_NID_2]; // Full rate refinement around each coarse peak
+  uint32_t            search_overlap;                // Samples kept from the previous frame
 } srsran_ue_cellsearch_t;
 
 SRSRAN_API int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
@@ -97,6 +102,10 @@ SRSRAN_API int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
                                          srsran_ue_cellsearch_result_t found_cells[3],
                                          uint32_t*                     max_N_id_2);
 
+SRSRAN_API int srsran_ue_cellsearch_scan_fast(srsran_ue_cellsearch_t*       q,
+                                              srsran_ue_cellsearch_result_t found_cells[3],
+                                              uint32_t*                     max_N_id_2);
+
 SRSRAN_API int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_t nof_frames);
 
 SRSRAN_API void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable);
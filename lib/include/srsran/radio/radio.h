@@ -26,6 +26,7 @@
 #include "srsran/common/interfaces_common.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/resampling/resampler_poly.h"
 #include "srsran/phy/rf/rf.h"
 #include "srsran/radio/radio_base.h"
 #include "srsran/srslog/srslog.h"
@@ -110,6 +111,8 @@ private:
   std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_buffer;
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> tx_resamplers = {}; ///< Used for non-integer rate ratios
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> rx_resamplers = {}; ///< Used for non-integer rate ratios
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
 
   rf_timestamp_t    end_of_burst_time = {};
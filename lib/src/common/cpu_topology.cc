@@ -0,0 +1,186 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/cpu_topology.h"
+#include "srsran/srslog/bundled/fmt/format.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdlib.h>
+
+namespace srsran {
+
+/// Reads the first line of a sysfs file, returns false if it cannot be opened
+static bool read_line(const std::string& path, std::string& line)
+{
+  std::ifstream file(path);
+  if (not file.is_open()) {
+    return false;
+  }
+  line.clear();
+  std::getline(file, line);
+  return true;
+}
+
+static bool read_uint(const std::string& path, uint32_t& value)
+{
+  std::string line;
+  if (not read_line(path, line) or line.empty()) {
+    return false;
+  }
+  char*         end = nullptr;
+  unsigned long v   = strtoul(line.c_str(), &end, 10);
+  if (end == line.c_str()) {
+    return false;
+  }
+  value = (uint32_t)v;
+  return true;
+}
+
+bool cpu_topology::parse_cpu_list(const std::string& str, std::vector<uint32_t>& list)
+{
+  list.clear();
+  size_t pos = 0;
+  while (pos < str.size()) {
+    size_t end = str.find(',', pos);
+    if (end == std::string::npos) {
+      end = str.size();
+    }
+    std::string range = str.substr(pos, end - pos);
+    pos               = end + 1;
+
+    // Trailing new lines and spaces are not part of the list
+    range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+    if (range.empty()) {
+      continue;
+    }
+
+    char*         first_end = nullptr;
+    unsigned long first     = strtoul(range.c_str(), &first_end, 10);
+    if (first_end == range.c_str()) {
+      return false;
+    }
+    unsigned long last = first;
+    if (*first_end == '-') {
+      char* last_end = nullptr;
+      last           = strtoul(first_end + 1, &last_end, 10);
+      if (last_end == first_end + 1 or *last_end != '\0' or last < first) {
+        return false;
+      }
+    } else if (*first_end != '\0') {
+      return false;
+    }
+    for (unsigned long i = first; i <= last; i++) {
+      list.push_back((uint32_t)i);
+    }
+  }
+  return true;
+}
+
+bool cpu_topology::read(const std::string& sysfs_system)
+{
+  cpus.clear();
+
+  std::string           line;
+  std::vector<uint32_t> online;
+  if (not read_line(sysfs_system + "/cpu/online", line) or not parse_cpu_list(line, online) or online.empty()) {
+    return false;
+  }
+
+  // The isolated list is absent in old kernels, no CPU is isolated then
+  std::vector<uint32_t> isolated;
+  if (read_line(sysfs_system + "/cpu/isolated", line)) {
+    parse_cpu_list(line, isolated);
+  }
+
+  // Map every CPU to its NUMA node, machines without NUMA support have a single node
+  std::map<uint32_t, uint32_t> cpu_node;
+  std::vector<uint32_t>        nodes;
+  if (read_line(sysfs_system + "/node/online", line) and parse_cpu_list(line, nodes)) {
+    for (uint32_t node : nodes) {
+      std::vector<uint32_t> node_cpus;
+      if (read_line(fmt::format("{}/node/node{}/cpulist", sysfs_system, node), line) and
+          parse_cpu_list(line, node_cpus)) {
+        for (uint32_t cpu : node_cpus) {
+          cpu_node[cpu] = node;
+        }
+      }
+    }
+  }
+
+  for (uint32_t id : online) {
+    cpu_t       cpu = {};
+    std::string dir = fmt::format("{}/cpu/cpu{}/topology/", sysfs_system, id);
+    cpu.id          = id;
+    if (not read_uint(dir + "core_id", cpu.core_id)) {
+      cpu.core_id = id;
+    }
+    read_uint(dir + "physical_package_id", cpu.package_id);
+    cpu.numa_node = cpu_node.count(id) ? cpu_node[id] : 0;
+    cpu.isolated  = std::find(isolated.begin(), isolated.end(), id) != isolated.end();
+    cpus.push_back(cpu);
+  }
+
+  return true;
+}
+
+std::vector<uint32_t> cpu_topology::select_cores(bool isolated_only) const
+{
+  // Keep the first logical CPU of every physical core in each node
+  std::map<uint32_t, std::vector<uint32_t> > node_cores;
+  std::set<std::pair<uint32_t, uint32_t> >   seen_cores;
+  for (const cpu_t& cpu : cpus) {
+    if (isolated_only and not cpu.isolated) {
+      continue;
+    }
+    if (seen_cores.insert(std::make_pair(cpu.package_id, cpu.core_id)).second) {
+      node_cores[cpu.numa_node].push_back(cpu.id);
+    }
+  }
+
+  std::vector<uint32_t> selected;
+  for (const auto& node : node_cores) {
+    if (node.second.size() > selected.size()) {
+      selected = node.second;
+    }
+  }
+  std::sort(selected.begin(), selected.end());
+  return selected;
+}
+
+std::string cpu_topology::to_string() const
+{
+  std::set<uint32_t>                       nodes;
+  std::set<std::pair<uint32_t, uint32_t> > cores;
+  uint32_t                                 nof_isolated = 0;
+  for (const cpu_t& cpu : cpus) {
+    nodes.insert(cpu.numa_node);
+    cores.insert(std::make_pair(cpu.package_id, cpu.core_id));
+    nof_isolated += cpu.isolated ? 1 : 0;
+  }
+  return fmt::format(
+      "cpus={} cores={} numa_nodes={} isolated_cpus={}", cpus.size(), cores.size(), nodes.size(), nof_isolated);
+}
+
+} // namespace srsran
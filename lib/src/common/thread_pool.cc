@@ -21,6 +21,7 @@
 
 #include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <algorithm>
 #include <assert.h>
 #include <chrono>
 #include <stdio.h>
@@ -160,7 +161,7 @@ bool thread_pool::worker::is_stopped() const
 
 bool thread_pool::find_finished_worker(uint32_t tti, uint32_t* id)
 {
-  for (uint32_t i = 0; i < nof_workers; i++) {
+  for (uint32_t i = 0; i < std::min(nof_workers, nof_active); i++) {
     if (status[i] == IDLE) {
       *id = i;
       return true;
@@ -267,6 +268,13 @@ std::string thread_pool::get_id()
   return id;
 }
 
+void thread_pool::set_nof_active_workers(uint32_t nof_active_)
+{
+  std::lock_guard<std::mutex> lock(mutex_queue);
+  nof_active = std::max(nof_active_, 1U);
+  cvar_queue.notify_all();
+}
+
 /**************************************************************************
  *  task_thread_pool - uses a queue to enqueue callables, that start
  *  once a worker is available
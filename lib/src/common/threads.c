@@ -176,6 +176,27 @@ bool threads_new_rt_cpu(pthread_t* thread, void* (*start_routine)(void*), void*
   return ret;
 }
 
+bool threads_set_affinity(pthread_t thread, const uint32_t* cpus, uint32_t nof_cpus)
+{
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (uint32_t i = 0; i < nof_cpus; i++) {
+    if (cpus[i] < CPU_SETSIZE) {
+      CPU_SET(cpus[i], &cpuset);
+    }
+  }
+  if (CPU_COUNT(&cpuset) == 0) {
+    return false;
+  }
+
+  int err = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset);
+  if (err) {
+    fprintf(stderr, "Error: Failed to set thread affinity: %s\n", strerror(err));
+    return false;
+  }
+  return true;
+}
+
 void threads_print_self()
 {
   pthread_t          thread;
@@ -21,6 +21,7 @@
 
 #include "srsran/phy/cfr/cfr.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 // Uncomment this to use a literal implementation of the CFR algorithm
@@ -29,7 +30,159 @@
 // Uncomment this to filter by zeroing the FFT bins instead of applying a frequency window
 #define CFR_LPF_WITH_ZEROS
 
-static inline float cfr_symb_peak(float* in_abs, int len);
+/**
+ * Computes the peak power of every block of SRSRAN_CFR_BLOCK_LEN samples in a single pass. Returns the peak power of
+ * the symbol and writes its average power in pwr_avg.
+ */
+static float cfr_power_stats(const cf_t* in, float* block_max, uint32_t len, float* pwr_avg)
+{
+  float    peak = 0.0f;
+  float    sum  = 0.0f;
+  uint32_t i    = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  srsran_simd_aligned float tmp[SRSRAN_SIMD_F_SIZE];
+  simd_f_t                  _sum = srsran_simd_f_zero();
+  for (; i + SRSRAN_CFR_BLOCK_LEN <= len; i += SRSRAN_CFR_BLOCK_LEN) {
+    simd_f_t _max = srsran_simd_f_zero();
+    for (uint32_t j = i; j < i + SRSRAN_CFR_BLOCK_LEN; j += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t _x  = srsran_simd_cfi_loadu(&in[j]);
+      simd_f_t  _re = srsran_simd_cf_re(_x);
+      simd_f_t  _im = srsran_simd_cf_im(_x);
+      simd_f_t  _p  = srsran_simd_f_add(srsran_simd_f_mul(_re, _re), srsran_simd_f_mul(_im, _im));
+      _max = srsran_simd_f_select(_max, _p, srsran_simd_f_max(_p, _max));
+      _sum = srsran_simd_f_add(_sum, _p);
+    }
+
+    srsran_simd_f_store(tmp, _max);
+    float m = tmp[0];
+    for (uint32_t k = 1; k < SRSRAN_SIMD_F_SIZE; k++) {
+      m = SRSRAN_MAX(m, tmp[k]);
+    }
+    block_max[i / SRSRAN_CFR_BLOCK_LEN] = m;
+    peak                                = SRSRAN_MAX(peak, m);
+  }
+
+  srsran_simd_f_store(tmp, _sum);
+  for (uint32_t k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+    sum += tmp[k];
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  // Remaining blocks, the last one can be shorter
+  for (; i < len; i += SRSRAN_CFR_BLOCK_LEN) {
+    float m = 0.0f;
+    for (uint32_t j = i; j < SRSRAN_MIN(i + SRSRAN_CFR_BLOCK_LEN, len); j++) {
+      float p = __real__ in[j] * __real__ in[j] + __imag__ in[j] * __imag__ in[j];
+      m       = SRSRAN_MAX(m, p);
+      sum += p;
+    }
+    block_max[i / SRSRAN_CFR_BLOCK_LEN] = m;
+    peak                                = SRSRAN_MAX(peak, m);
+  }
+
+  *pwr_avg = sum / (float)len;
+  return peak;
+}
+
+/**
+ * Finds the samples above the threshold, only in the blocks whose peak exceeds it, and stores their clipping noise
+ * scaled by alpha. Returns the number of clipped samples.
+ */
+static uint32_t cfr_find_peaks(srsran_cfr_t* q, const cf_t* in, float beta)
+{
+  const float    alpha     = q->cfg.alpha;
+  const float    thr_pwr   = beta * beta;
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t       nof_peaks = 0;
+
+  for (uint32_t b = 0; b < SRSRAN_CEIL(symbol_sz, SRSRAN_CFR_BLOCK_LEN); b++) {
+    if (q->block_max[b] <= thr_pwr) {
+      continue;
+    }
+    for (uint32_t i = b * SRSRAN_CFR_BLOCK_LEN; i < SRSRAN_MIN((b + 1) * SRSRAN_CFR_BLOCK_LEN, symbol_sz); i++) {
+      float p = __real__ in[i] * __real__ in[i] + __imag__ in[i] * __imag__ in[i];
+      if (p > thr_pwr) {
+        q->peak_idx[nof_peaks]    = i;
+        q->peak_buffer[nof_peaks] = in[i] * (alpha * (1.0f - beta / sqrtf(p)));
+        nof_peaks++;
+      }
+    }
+  }
+
+  return nof_peaks;
+}
+
+/**
+ * Subtracts the filtered clipping noise of each peak from the symbol, adding the filter impulse response circularly
+ * shifted to the peak position
+ */
+static void cfr_cancel_peaks_lookup(srsran_cfr_t* q, cf_t* out, uint32_t nof_peaks)
+{
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t       i         = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t _peak[SRSRAN_CFR_MAX_LOOKUP_PEAKS];
+  for (uint32_t k = 0; k < nof_peaks; k++) {
+    _peak[k] = srsran_simd_cf_set1(q->peak_buffer[k]);
+  }
+
+  for (; i + SRSRAN_SIMD_CF_SIZE <= symbol_sz; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _y = srsran_simd_cfi_loadu(&out[i]);
+    for (uint32_t k = 0; k < nof_peaks; k++) {
+      uint32_t  offset = symbol_sz - q->peak_idx[k] + i;
+      simd_cf_t _h     = srsran_simd_cfi_loadu(&q->pulse[offset]);
+      _y               = srsran_simd_cf_sub(_y, srsran_simd_cf_prod(_peak[k], _h));
+    }
+    srsran_simd_cfi_storeu(&out[i], _y);
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < symbol_sz; i++) {
+    for (uint32_t k = 0; k < nof_peaks; k++) {
+      out[i] -= q->peak_buffer[k] * q->pulse[symbol_sz - q->peak_idx[k] + i];
+    }
+  }
+}
+
+/**
+ * Filters the clipped symbol in the frequency domain, used when there are too many peaks for the lookup
+ */
+static void cfr_cancel_peaks_fft(srsran_cfr_t* q, cf_t* out, uint32_t nof_peaks)
+{
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+
+#ifdef CFR_PEAK_EXTRACTION
+  // Filter the clipping noise alone and subtract it
+  cf_t* peaks = q->peak_buffer + symbol_sz;
+  srsran_vec_cf_zero(peaks, symbol_sz);
+  for (uint32_t k = 0; k < nof_peaks; k++) {
+    peaks[q->peak_idx[k]] = q->peak_buffer[k];
+  }
+  srsran_dft_run_c(&q->fft_plan, peaks, peaks);
+#ifdef CFR_LPF_WITH_ZEROS
+  srsran_vec_cf_zero(peaks + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
+#else  /* CFR_LPF_WITH_ZEROS */
+  srsran_vec_prod_cfc(peaks, q->lpf_spectrum, peaks, symbol_sz);
+#endif /* CFR_LPF_WITH_ZEROS */
+  srsran_dft_run_c(&q->ifft_plan, peaks, peaks);
+  srsran_vec_sub_ccc(out, peaks, out, symbol_sz);
+#else  /* CFR_PEAK_EXTRACTION */
+
+  // Clip the signal, then filter it
+  for (uint32_t k = 0; k < nof_peaks; k++) {
+    out[q->peak_idx[k]] -= q->peak_buffer[k];
+  }
+  srsran_dft_run_c(&q->fft_plan, out, out);
+#ifdef CFR_LPF_WITH_ZEROS
+  srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
+#else  /* CFR_LPF_WITH_ZEROS */
+  srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
+#endif /* CFR_LPF_WITH_ZEROS */
+  srsran_dft_run_c(&q->ifft_plan, out, out);
+#endif /* CFR_PEAK_EXTRACTION */
+}
 
 void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
 {
@@ -44,21 +197,19 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
     return;
   }
 
-  const float    alpha     = q->cfg.alpha;
   const uint32_t symbol_sz = q->cfg.symbol_sz;
   float          beta      = 0.0f;
 
-  // Calculate absolute input values
-  srsran_vec_abs_cf(in, q->abs_buffer_in, symbol_sz);
+  // Power of every sample, peak and average power of the symbol
+  float       pwr_symb_avg  = 0.0f;
+  const float pwr_symb_peak = cfr_power_stats(in, q->block_max, symbol_sz, &pwr_symb_avg);
 
   // In auto modes, the beta threshold is calculated based on the measured PAPR
   if (q->cfg.cfr_mode == SRSRAN_CFR_THR_MANUAL) {
     beta = q->cfg.manual_thr;
   } else {
-    const float symb_peak     = cfr_symb_peak(q->abs_buffer_in, q->cfg.symbol_sz);
-    const float pwr_symb_peak = symb_peak * symb_peak;
-    const float pwr_symb_avg  = srsran_vec_avg_power_ff(q->abs_buffer_in, q->cfg.symbol_sz);
-    float       symb_papr     = 0.0f;
+    const float symb_peak = sqrtf(pwr_symb_peak);
+    float       symb_papr = 0.0f;
 
     if (isnormal(pwr_symb_avg) && isnormal(pwr_symb_peak)) {
       if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_CMA) {
@@ -77,72 +228,39 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
   }
 
   // Clipping algorithm
-  if (isnormal(beta)) {
-#ifdef CFR_PEAK_EXTRACTION
-    srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
-    cf_t clip_thr = 0;
-    for (int i = 0; i < symbol_sz; i++) {
-      if (q->abs_buffer_in[i] > beta) {
-        clip_thr          = beta * (in[i] / q->abs_buffer_in[i]);
-        q->peak_buffer[i] = in[i] - clip_thr;
-      }
-    }
-
-    // Apply FFT filter to the peak signal
-    srsran_dft_run_c(&q->fft_plan, q->peak_buffer, q->peak_buffer);
-#ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(q->peak_buffer + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
-#else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(q->peak_buffer, q->lpf_spectrum, q->peak_buffer, symbol_sz);
-#endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, q->peak_buffer, q->peak_buffer);
-
-    // Scale the peak signal according to alpha
-    srsran_vec_sc_prod_cfc(q->peak_buffer, alpha, q->peak_buffer, symbol_sz);
-
-    // Apply the filtered clipping
-    srsran_vec_sub_ccc(in, q->peak_buffer, out, symbol_sz);
-#else /* CFR_PEAK_EXTRACTION */
-
-    // Generate a clipping envelope and clip the signal
-    srsran_vec_gen_clip_env(q->abs_buffer_in, beta, alpha, q->abs_buffer_in, symbol_sz);
-    srsran_vec_prod_cfc(in, q->abs_buffer_in, out, symbol_sz);
+  uint32_t nof_peaks = 0;
+  if (isnormal(beta) && pwr_symb_peak > beta * beta) {
+    nof_peaks = cfr_find_peaks(q, in, beta);
+  }
 
-    // FFT filter
-    srsran_dft_run_c(&q->fft_plan, out, out);
-#ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
-#else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
-#endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, out, out);
-#endif /* CFR_PEAK_EXTRACTION */
+  if (in != out) {
+    srsran_vec_cf_copy(out, in, symbol_sz);
+  }
 
-  } else {
-    // If no processing, copy the input samples into the output buffer
-    if (in != out) {
-      srsran_vec_cf_copy(out, in, symbol_sz);
-    }
+  // A few peaks are cancelled with the filter impulse response, otherwise the symbol is filtered with the FFT. The
+  // results are the same as long as the input symbol is within the filter bandwidth
+  if (nof_peaks > q->max_lookup_peaks) {
+    cfr_cancel_peaks_fft(q, out, nof_peaks);
+  } else if (nof_peaks > 0) {
+    cfr_cancel_peaks_lookup(q, out, nof_peaks);
   }
-  if (q->cfg.cfr_mode != SRSRAN_CFR_THR_MANUAL && q->cfg.measure_out_papr) {
-    srsran_vec_abs_cf(in, q->abs_buffer_out, symbol_sz);
 
-    const float symb_peak     = cfr_symb_peak(q->abs_buffer_out, q->cfg.symbol_sz);
-    const float pwr_symb_peak = symb_peak * symb_peak;
-    const float pwr_symb_avg  = srsran_vec_avg_power_ff(q->abs_buffer_out, q->cfg.symbol_sz);
-    float       symb_papr     = 0.0f;
+  if (q->cfg.cfr_mode != SRSRAN_CFR_THR_MANUAL && q->cfg.measure_out_papr) {
+    float       pwr_symb_avg_out  = 0.0f;
+    const float pwr_symb_peak_out = cfr_power_stats(out, q->block_max, symbol_sz, &pwr_symb_avg_out);
+    float       symb_papr         = 0.0f;
 
-    if (isnormal(pwr_symb_avg) && isnormal(pwr_symb_peak)) {
+    if (isnormal(pwr_symb_avg_out) && isnormal(pwr_symb_peak_out)) {
       if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_CMA) {
         // Do not increment cma_n here, as it is being done when calculating input PAPR
-        q->pwr_avg_out = SRSRAN_VEC_CMA(pwr_symb_avg, q->pwr_avg_out, q->cma_n);
+        q->pwr_avg_out = SRSRAN_VEC_CMA(pwr_symb_avg_out, q->pwr_avg_out, q->cma_n);
       }
 
       else if (q->cfg.cfr_mode == SRSRAN_CFR_THR_AUTO_EMA) {
-        q->pwr_avg_out = SRSRAN_VEC_EMA(pwr_symb_avg, q->pwr_avg_out, q->cfg.ema_alpha);
+        q->pwr_avg_out = SRSRAN_VEC_EMA(pwr_symb_avg_out, q->pwr_avg_out, q->cfg.ema_alpha);
       }
 
-      symb_papr = pwr_symb_peak / q->pwr_avg_out;
+      symb_papr = pwr_symb_peak_out / q->pwr_avg_out;
     }
 
     const float papr_out_db = srsran_convert_power_to_dB(symb_papr);
@@ -190,33 +308,34 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     q->pwr_avg_out = CFR_EMA_INIT_AVG_PWR;
   }
 
-  if (q->abs_buffer_in) {
-    free(q->abs_buffer_in);
+  if (q->block_max) {
+    free(q->block_max);
   }
-  q->abs_buffer_in = srsran_vec_f_malloc(q->cfg.symbol_sz);
-  if (!q->abs_buffer_in) {
-    ERROR("Error allocating abs_buffer_in");
-    goto clean_exit;
-  }
-
-  if (q->abs_buffer_out) {
-    free(q->abs_buffer_out);
-  }
-  q->abs_buffer_out = srsran_vec_f_malloc(q->cfg.symbol_sz);
-  if (!q->abs_buffer_out) {
-    ERROR("Error allocating abs_buffer_out");
+  q->block_max = srsran_vec_f_malloc(SRSRAN_CEIL(q->cfg.symbol_sz, SRSRAN_CFR_BLOCK_LEN));
+  if (!q->block_max) {
+    ERROR("Error allocating block_max");
     goto clean_exit;
   }
 
+  // The second half holds the whole clipping noise symbol when filtering it with the FFT
   if (q->peak_buffer) {
     free(q->peak_buffer);
   }
-  q->peak_buffer = srsran_vec_cf_malloc(q->cfg.symbol_sz);
+  q->peak_buffer = srsran_vec_cf_malloc(2 * q->cfg.symbol_sz);
   if (!q->peak_buffer) {
     ERROR("Error allocating peak_buffer");
     goto clean_exit;
   }
 
+  if (q->peak_idx) {
+    free(q->peak_idx);
+  }
+  q->peak_idx = srsran_vec_u32_malloc(q->cfg.symbol_sz);
+  if (!q->peak_idx) {
+    ERROR("Error allocating peak_idx");
+    goto clean_exit;
+  }
+
   // Allocate the filter
   if (q->lpf_spectrum) {
     free(q->lpf_spectrum);
@@ -289,9 +408,26 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
   srsran_dft_plan_set_norm(&q->fft_plan, true);
   srsran_dft_plan_set_norm(&q->ifft_plan, true);
 
-  srsran_vec_cf_zero(q->peak_buffer, q->cfg.symbol_sz);
-  srsran_vec_f_zero(q->abs_buffer_in, q->cfg.symbol_sz);
-  srsran_vec_f_zero(q->abs_buffer_out, q->cfg.symbol_sz);
+  // Filter impulse response, the FFT and iFFT are normalised so it is scaled once more
+  if (q->pulse) {
+    free(q->pulse);
+  }
+  q->pulse = srsran_vec_cf_malloc(2 * q->cfg.symbol_sz);
+  if (!q->pulse) {
+    ERROR("Error allocating pulse");
+    goto clean_exit;
+  }
+  for (uint32_t i = 0; i < q->cfg.symbol_sz; i++) {
+    q->pulse[i] = q->lpf_spectrum[i];
+  }
+  srsran_dft_run_c(&q->ifft_plan, q->pulse, q->pulse);
+  srsran_vec_sc_prod_cfc(q->pulse, 1.0f / sqrtf((float)q->cfg.symbol_sz), q->pulse, q->cfg.symbol_sz);
+  srsran_vec_cf_copy(q->pulse + q->cfg.symbol_sz, q->pulse, q->cfg.symbol_sz);
+
+  // Adding the impulse response of each peak costs about as much as the FFT and iFFT with log2(symbol_sz) peaks
+  q->max_lookup_peaks = SRSRAN_MIN(SRSRAN_CFR_MAX_LOOKUP_PEAKS, (uint32_t)log2(q->cfg.symbol_sz));
+
+  srsran_vec_cf_zero(q->peak_buffer, 2 * q->cfg.symbol_sz);
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
@@ -306,15 +442,18 @@ void srsran_cfr_free(srsran_cfr_t* q)
   if (q) {
     srsran_dft_plan_free(&q->fft_plan);
     srsran_dft_plan_free(&q->ifft_plan);
-    if (q->abs_buffer_in) {
-      free(q->abs_buffer_in);
-    }
-    if (q->abs_buffer_out) {
-      free(q->abs_buffer_out);
+    if (q->block_max) {
+      free(q->block_max);
     }
     if (q->peak_buffer) {
       free(q->peak_buffer);
     }
+    if (q->peak_idx) {
+      free(q->peak_idx);
+    }
+    if (q->pulse) {
+      free(q->pulse);
+    }
     if (q->lpf_spectrum) {
       free(q->lpf_spectrum);
     }
@@ -322,13 +461,6 @@ void srsran_cfr_free(srsran_cfr_t* q)
   }
 }
 
-// Find the peak absolute value of an OFDM symbol
-static inline float cfr_symb_peak(float* in_abs, int len)
-{
-  const uint32_t max_index = srsran_vec_max_fi(in_abs, len);
-  return in_abs[max_index];
-}
-
 bool srsran_cfr_params_valid(srsran_cfr_cfg_t* cfr_conf)
 {
   if (cfr_conf == NULL) {
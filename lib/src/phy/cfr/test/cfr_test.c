@@ -28,8 +28,22 @@
 #include "srsran/phy/utils/random.h"
 #include "srsran/srsran.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CFR_TEST_CYCLES() __rdtsc()
+#endif /* defined(__x86_64__) || defined(__i386__) */
+
 #define MAX_ACPR_DB -100
 
+// Largest error of the CFR output relative to clipping and filtering the symbol with the FFT, manual mode only
+#define MAX_REF_NMSE_DB -60
+
+// Smallest PAPR reduction of the CFR output
+#define MIN_PAPR_REDUCTION_DB 0.5f
+
+// Default manual threshold relative to the RMS of the generated signal
+#define THR_MANUAL_RMS_FACTOR 1.8f
+
 
 // Default CFR type
 static char* cfr_mode_str = "manual";
@@ -41,7 +55,7 @@ static int               nof_frames      = 10;
 static srsran_cfr_mode_t cfr_mode        = SRSRAN_CFR_THR_MANUAL;
 static float             alpha           = 1.0f;
 static bool              dc_empty        = true;
-static float             thr_manual      = 1.5f;
+static float             thr_manual      = 0.0f;
 static float             max_papr_db     = 8.0f;
 static float             ema_alpha       = (float)1 / (float)SRSRAN_CP_NORM_NSYMB;
 
@@ -68,11 +82,43 @@ static void usage(char* prog)
   printf("\t-m CFR mode: manual, auto_cma, auto_ema [Default %s]\n", cfr_mode_str);
   printf("\t-d Use DC subcarrier: [Default DC empty]\n");
   printf("\t-a CFR alpha: [Default %.2f]\n", alpha);
-  printf("\t-t CFR manual threshold: [Default %.2f]\n", thr_manual);
+  printf("\t-t CFR manual threshold, 0 for %.1f times the signal RMS: [Default %.2f]\n",
+         THR_MANUAL_RMS_FACTOR,
+         thr_manual);
   printf("\t-p CFR Max PAPR in dB (auto modes): [Default %.2f]\n", max_papr_db);
   printf("\t-E Power avg EMA alpha (EMA mode): [Default %.2f]\n", ema_alpha);
 }
 
+/**
+ * Reference CFR of one symbol in manual mode: clips the samples above the threshold and filters the whole symbol in
+ * the frequency domain. The peak cancellation with the filter impulse response shall give the same result. Returns the
+ * number of clipped samples.
+ */
+static uint32_t cfr_reference(srsran_dft_plan_t* fft,
+                              srsran_dft_plan_t* ifft,
+                              const cf_t*        in,
+                              cf_t*              out,
+                              uint32_t           symbol_sz,
+                              uint32_t           symbol_bw,
+                              float              threshold)
+{
+  uint32_t nof_peaks = 0;
+  for (uint32_t i = 0; i < symbol_sz; i++) {
+    float amplitude = cabsf(in[i]);
+    out[i]          = in[i];
+    if (amplitude > threshold) {
+      out[i] -= in[i] * (alpha * (1.0f - threshold / amplitude));
+      nof_peaks++;
+    }
+  }
+
+  srsran_dft_run_c(fft, out, out);
+  srsran_vec_cf_zero(out + symbol_bw / 2 + dc_empty, symbol_sz - symbol_bw - dc_empty);
+  srsran_dft_run_c(ifft, out, out);
+
+  return nof_peaks;
+}
+
 static int parse_args(int argc, char** argv)
 {
   int opt;
@@ -129,6 +175,7 @@ int main(int argc, char** argv)
   cf_t*           input       = NULL;
   cf_t*           output      = NULL;
   cf_t*           error       = NULL;
+  cf_t*           reference   = NULL;
   float*          acpr_buff   = NULL;
   float           mse_dB      = 0.0f;
   float           nmse_dB     = 0.0f;
@@ -165,14 +212,22 @@ int main(int argc, char** argv)
     const uint32_t frame_sz       = symbol_sz * nof_symb_frame;
     const uint32_t total_nof_re   = frame_sz * nof_frames;
     const uint32_t total_nof_symb = nof_symb_frame * nof_frames;
+
+    // The generated subcarriers have a power of 2/3, so the symbols have an RMS of sqrt(2/3 * symbol_bw / symbol_sz)
+    float threshold = thr_manual;
+    if (threshold <= 0) {
+      threshold = THR_MANUAL_RMS_FACTOR * sqrtf(2.0f / 3.0f * (float)symbol_bw / (float)symbol_sz);
+    }
+
     printf("Running test for %d PRB, %d Frames: \t", nof_prb, nof_frames);
     fflush(stdout);
 
     input     = srsran_vec_cf_malloc(total_nof_re);
     output    = srsran_vec_cf_malloc(total_nof_re);
     error     = srsran_vec_cf_malloc(total_nof_re);
+    reference = srsran_vec_cf_malloc(symbol_sz);
     acpr_buff = srsran_vec_f_malloc(total_nof_symb);
-    if (!input || !output || !error || !acpr_buff) {
+    if (!input || !output || !error || !reference || !acpr_buff) {
       perror("malloc");
       goto clean_exit;
     }
@@ -189,7 +244,7 @@ int main(int argc, char** argv)
     cfr_tx_cfg.cfr_mode         = cfr_mode;
     cfr_tx_cfg.max_papr_db      = max_papr_db;
     cfr_tx_cfg.alpha            = alpha;
-    cfr_tx_cfg.manual_thr       = thr_manual;
+    cfr_tx_cfg.manual_thr       = threshold;
     cfr_tx_cfg.ema_alpha        = ema_alpha;
     cfr_tx_cfg.dc_sc            = dc_empty;
 
@@ -229,6 +284,9 @@ int main(int argc, char** argv)
     acpr_in_dB = srsran_convert_power_to_dB(acpr_in_dB);
 
     // Execute CFR
+#ifdef CFR_TEST_CYCLES
+    uint64_t cycles_start = CFR_TEST_CYCLES();
+#endif /* CFR_TEST_CYCLES */
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
       for (uint32_t j = 0; j < nof_frames; j++) {
@@ -240,7 +298,12 @@ int main(int argc, char** argv)
       }
     }
     gettimeofday(&end, NULL);
-    printf("%.1fMsps \t", (float)(total_nof_re * nof_repetitions) / elapsed_us(&start, &end));
+    printf("%.1fMsps ", (float)(total_nof_re * nof_repetitions) / elapsed_us(&start, &end));
+#ifdef CFR_TEST_CYCLES
+    uint64_t cycles = CFR_TEST_CYCLES() - cycles_start;
+    printf("%.2f cycles/sample ", (double)cycles / ((double)total_nof_re * nof_repetitions));
+#endif /* CFR_TEST_CYCLES */
+    printf("\t");
 
     // Compute metrics
     srsran_vec_sub_ccc(input, output, error, total_nof_re);
@@ -257,6 +320,27 @@ int main(int argc, char** argv)
     float papr_in  = srsran_convert_power_to_dB(srsran_vec_papr_c(input, total_nof_re));
     float papr_out = srsran_convert_power_to_dB(srsran_vec_papr_c(output, total_nof_re));
 
+    // In manual mode, compare every symbol with the reference, whichever method the CFR used to cancel the peaks
+    float    ref_nmse_dB      = -INFINITY;
+    uint32_t nof_lookup_symb  = 0;
+    uint32_t nof_clipped_symb = 0;
+    if (cfr_mode == SRSRAN_CFR_THR_MANUAL) {
+      for (uint32_t i = 0; i < total_nof_symb; i++) {
+        uint32_t nof_peaks =
+            cfr_reference(&ofdm_fft, &ofdm_ifft, input + i * symbol_sz, reference, symbol_sz, symbol_bw, threshold);
+        if (nof_peaks == 0) {
+          continue;
+        }
+        nof_clipped_symb++;
+        nof_lookup_symb += (nof_peaks <= cfr.max_lookup_peaks) ? 1 : 0;
+
+        srsran_vec_sub_ccc(reference, output + i * symbol_sz, reference, symbol_sz);
+        float nmse = srsran_vec_avg_power_cf(reference, symbol_sz) /
+                     srsran_vec_avg_power_cf(input + i * symbol_sz, symbol_sz);
+        ref_nmse_dB = SRSRAN_MAX(ref_nmse_dB, srsran_convert_power_to_dB(nmse));
+      }
+    }
+
     ofdm_symb = NULL;
     for (int i = 0; i < total_nof_symb; i++) {
       ofdm_symb = output + i * symbol_sz;
@@ -270,17 +354,23 @@ int main(int argc, char** argv)
 
     printf("MSE=%.3fdB  NMSE=%.3fdB  EVM=%.3f%%  SNR=%.3fdB", mse_dB, nmse_dB, evm, snr_dB);
     printf("  In-PAPR=%.3fdB  Out-PAPR=%.3fdB", papr_in, papr_out);
-    printf("  In-ACPR=%.3fdB  Out-ACPR=%.3fdB\n", acpr_in_dB, acpr_out_dB);
+    printf("  In-ACPR=%.3fdB  Out-ACPR=%.3fdB", acpr_in_dB, acpr_out_dB);
+    if (cfr_mode == SRSRAN_CFR_THR_MANUAL) {
+      printf("  Ref-NMSE=%.1fdB (%d/%d lookup)", ref_nmse_dB, nof_lookup_symb, nof_clipped_symb);
+    }
+    printf("\n");
 
     srsran_dft_plan_free(&ofdm_ifft);
     srsran_dft_plan_free(&ofdm_fft);
     free(input);
     free(output);
     free(error);
+    free(reference);
     free(acpr_buff);
     input     = NULL;
     output    = NULL;
     error     = NULL;
+    reference = NULL;
     acpr_buff = NULL;
 
     ++nof_prb;
@@ -288,6 +378,14 @@ int main(int argc, char** argv)
       printf("ACPR too large \n");
       goto clean_exit;
     }
+    if (papr_in - papr_out < MIN_PAPR_REDUCTION_DB) {
+      printf("PAPR not reduced \n");
+      goto clean_exit;
+    }
+    if (ref_nmse_dB > MAX_REF_NMSE_DB) {
+      printf("Output differs from the FFT reference \n");
+      goto clean_exit;
+    }
   }
   ret = SRSRAN_SUCCESS;
 
@@ -306,6 +404,9 @@ clean_exit:
   if (error) {
     free(error);
   }
+  if (reference) {
+    free(reference);
+  }
   if (acpr_buff) {
     free(acpr_buff);
   }
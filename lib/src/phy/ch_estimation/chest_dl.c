@@ -31,6 +31,7 @@
 
 #include "srsran/phy/ch_estimation/chest_dl.h"
 #include "srsran/phy/utils/convolution.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 //#define DEFAULT_FILTER_LEN 3
@@ -141,6 +142,17 @@ int srsran_chest_dl_init(srsran_chest_dl_t* q, uint32_t max_prb, uint32_t nof_rx
       goto clean_exit;
     }
 
+    q->interp_hold_len = SRSRAN_NRE * max_prb + (SRSRAN_NRE / 2) * (SRSRAN_CHEST_DL_INTERP_MAX_TAPS - 1);
+    for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+      for (uint32_t j = 0; j < SRSRAN_CHEST_DL_MAX_PILOT_SYMB; j++) {
+        q->interp_hold[i][j] = srsran_vec_cf_malloc(q->interp_hold_len);
+        if (!q->interp_hold[i][j]) {
+          perror("malloc");
+          goto clean_exit;
+        }
+      }
+    }
+
     q->wiener_dl = calloc(sizeof(srsran_wiener_dl_t), 1);
     if (q->wiener_dl) {
       srsran_wiener_dl_init(q->wiener_dl, max_prb, 2, nof_rx_antennas);
@@ -202,6 +214,18 @@ void srsran_chest_dl_free(srsran_chest_dl_t* q)
     srsran_wiener_dl_free(q->wiener_dl);
     free(q->wiener_dl);
   }
+  for (uint32_t i = 0; i < SRSRAN_CHEST_DL_INTERP_NOF_TABLES; i++) {
+    if (q->interp_table[i].weights) {
+      free(q->interp_table[i].weights);
+    }
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    for (uint32_t j = 0; j < SRSRAN_CHEST_DL_MAX_PILOT_SYMB; j++) {
+      if (q->interp_hold[i][j]) {
+        free(q->interp_hold[i][j]);
+      }
+    }
+  }
   bzero(q, sizeof(srsran_chest_dl_t));
 }
 
@@ -315,6 +339,12 @@ int srsran_chest_dl_set_cell(srsran_chest_dl_t* q, srsran_cell_t cell)
         fprintf(stderr, "Error initializing interpolator\n");
         return SRSRAN_ERROR;
       }
+
+      // Precomputed interpolation tables are rebuilt for the new cell on demand
+      for (uint32_t i = 0; i < SRSRAN_CHEST_DL_INTERP_NOF_TABLES; i++) {
+        q->interp_table[i].nof_pilots = 0;
+        q->interp_table[i].last_use   = 0;
+      }
     }
     ret = SRSRAN_SUCCESS;
   }
@@ -434,6 +464,60 @@ static float estimate_noise_empty_sc(srsran_chest_dl_t* q, cf_t* input)
 
 #define cesymb(i) ce[SRSRAN_RE_IDX(q->cell.nof_prb, i, 0)]
 
+/* Interpolates in the time domain the symbols estimated by the frequency interpolation */
+static void interpolate_pilots_time(srsran_chest_dl_t*     q,
+                                    srsran_dl_sf_cfg_t*    sf,
+                                    srsran_chest_dl_cfg_t* cfg,
+                                    cf_t*                  ce,
+                                    uint32_t               port_id,
+                                    uint32_t               nsymbols)
+{
+  if (sf->sf_type == SRSRAN_SF_NORM && (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2)) {
+    // If we average per subframe, just copy the estimates in the time domain
+    for (uint32_t l = 1; l < 2 * SRSRAN_CP_NSYMB(q->cell.cp); l++) {
+      memcpy(&ce[l * SRSRAN_NRE * q->cell.nof_prb], ce, sizeof(cf_t) * SRSRAN_NRE * q->cell.nof_prb);
+    }
+  } else {
+    if (sf->sf_type == SRSRAN_SF_MBSFN) {
+      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(2), &cesymb(1), 2, 1);
+      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(2), &cesymb(6), &cesymb(3), 4, 3);
+      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(6), &cesymb(10), &cesymb(7), 4, 3);
+      srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(6), &cesymb(10), &cesymb(10), &cesymb(11), 4, 1);
+    } else {
+      if (SRSRAN_CP_ISNORM(q->cell.cp)) {
+        if (port_id < 2) {
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(4), &cesymb(1), 4, 3);
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(4), &cesymb(7), &cesymb(5), 3, 2);
+          if (nsymbols == 4) {
+            srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(7), &cesymb(11), &cesymb(8), 4, 3);
+            srsran_interp_linear_vector2(
+                &q->srsran_interp_linvec, &cesymb(7), &cesymb(11), &cesymb(11), &cesymb(12), 4, 2);
+          } else {
+            srsran_interp_linear_vector2(
+                &q->srsran_interp_linvec, &cesymb(4), &cesymb(7), &cesymb(7), &cesymb(8), 3, 6);
+          }
+        } else {
+          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(8), &cesymb(1), &cesymb(1), &cesymb(0), 7, 1);
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(8), &cesymb(2), 7, 6);
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(8), &cesymb(9), 7, 5);
+        }
+      } else {
+        if (port_id < 2) {
+          // TODO: TDD and extended cyclic prefix
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(3), &cesymb(1), 3, 2);
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(3), &cesymb(6), &cesymb(4), 3, 2);
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(6), &cesymb(9), &cesymb(7), 3, 2);
+          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(6), &cesymb(9), &cesymb(9), &cesymb(10), 3, 2);
+        } else {
+          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(7), &cesymb(1), &cesymb(1), &cesymb(0), 6, 1);
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(7), &cesymb(2), 6, 5);
+          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(7), &cesymb(8), 6, 4);
+        }
+      }
+    }
+  }
+}
+
 static void interpolate_pilots(srsran_chest_dl_t*     q,
                                srsran_dl_sf_cfg_t*    sf,
                                srsran_chest_dl_cfg_t* cfg,
@@ -508,50 +592,40 @@ static void interpolate_pilots(srsran_chest_dl_t*     q,
   }
 
   /* Now interpolate in the time domain between symbols */
-  if (sf->sf_type == SRSRAN_SF_NORM && (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2)) {
-    // If we average per subframe, just copy the estimates in the time domain
-    for (uint32_t l = 1; l < 2 * SRSRAN_CP_NSYMB(q->cell.cp); l++) {
-      memcpy(&ce[l * SRSRAN_NRE * q->cell.nof_prb], ce, sizeof(cf_t) * SRSRAN_NRE * q->cell.nof_prb);
+  interpolate_pilots_time(q, sf, cfg, ce, port_id, nsymbols);
+}
+
+/* Averages the pilots of all the symbols in the time domain if the estimator is set to average. The pilots of every
+ * pair of symbols are interleaved into a single symbol, which is written in input. Returns true if averaged. */
+static bool average_pilots_time(srsran_chest_dl_t*     q,
+                                srsran_dl_sf_cfg_t*    sf,
+                                srsran_chest_dl_cfg_t* cfg,
+                                cf_t*                  input,
+                                cf_t*                  temp,
+                                uint32_t               port_id)
+{
+  uint32_t nsymbols = (sf->sf_type == SRSRAN_SF_MBSFN) ? srsran_refsignal_mbsfn_nof_symbols()
+                                                       : srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+  uint32_t nref     = (sf->sf_type == SRSRAN_SF_MBSFN) ? 6 * q->cell.nof_prb : 2 * q->cell.nof_prb;
+
+  if (cfg->estimator_alg != SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2) {
+    return false;
+  }
+
+  if (srsran_refsignal_cs_fidx(q->cell, 0, port_id, 0) < 3) {
+    srsran_vec_interleave(input, &input[nref], temp, nref);
+    for (int l = 2; l < nsymbols - 1; l += 2) {
+      srsran_vec_interleave_add(&input[l * nref], &input[(l + 1) * nref], temp, nref);
     }
   } else {
-    if (sf->sf_type == SRSRAN_SF_MBSFN) {
-      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(2), &cesymb(1), 2, 1);
-      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(2), &cesymb(6), &cesymb(3), 4, 3);
-      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(6), &cesymb(10), &cesymb(7), 4, 3);
-      srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(6), &cesymb(10), &cesymb(10), &cesymb(11), 4, 1);
-    } else {
-      if (SRSRAN_CP_ISNORM(q->cell.cp)) {
-        if (port_id < 2) {
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(4), &cesymb(1), 4, 3);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(4), &cesymb(7), &cesymb(5), 3, 2);
-          if (nsymbols == 4) {
-            srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(7), &cesymb(11), &cesymb(8), 4, 3);
-            srsran_interp_linear_vector2(
-                &q->srsran_interp_linvec, &cesymb(7), &cesymb(11), &cesymb(11), &cesymb(12), 4, 2);
-          } else {
-            srsran_interp_linear_vector2(
-                &q->srsran_interp_linvec, &cesymb(4), &cesymb(7), &cesymb(7), &cesymb(8), 3, 6);
-          }
-        } else {
-          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(8), &cesymb(1), &cesymb(1), &cesymb(0), 7, 1);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(8), &cesymb(2), 7, 6);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(8), &cesymb(9), 7, 5);
-        }
-      } else {
-        if (port_id < 2) {
-          // TODO: TDD and extended cyclic prefix
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(3), &cesymb(1), 3, 2);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(3), &cesymb(6), &cesymb(4), 3, 2);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(6), &cesymb(9), &cesymb(7), 3, 2);
-          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(6), &cesymb(9), &cesymb(9), &cesymb(10), 3, 2);
-        } else {
-          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(7), &cesymb(1), &cesymb(1), &cesymb(0), 6, 1);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(7), &cesymb(2), 6, 5);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(7), &cesymb(8), 6, 4);
-        }
-      }
+    srsran_vec_interleave(&input[nref], input, temp, nref);
+    for (int l = 2; l < nsymbols - 1; l += 2) {
+      srsran_vec_interleave_add(&input[(l + 1) * nref], &input[l * nref], temp, nref);
     }
   }
+  srsran_vec_sc_prod_cfc(temp, 2.0f / (float)nsymbols, input, 2 * nref);
+
+  return true;
 }
 
 static void average_pilots(srsran_chest_dl_t*     q,
@@ -568,23 +642,8 @@ static void average_pilots(srsran_chest_dl_t*     q,
   uint32_t nref     = (sf->sf_type == SRSRAN_SF_MBSFN) ? 6 * q->cell.nof_prb : 2 * q->cell.nof_prb;
 
   // Average in the time domain if enabled
-  if (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE && nsymbols > 1) {
-    cf_t* temp = output; // Use output as temporal buffer
-
-    if (srsran_refsignal_cs_fidx(q->cell, 0, port_id, 0) < 3) {
-      srsran_vec_interleave(input, &input[nref], temp, nref);
-      for (int l = 2; l < nsymbols - 1; l += 2) {
-        srsran_vec_interleave_add(&input[l * nref], &input[(l + 1) * nref], temp, nref);
-      }
-    } else {
-      srsran_vec_interleave(&input[nref], input, temp, nref);
-      for (int l = 2; l < nsymbols - 1; l += 2) {
-        srsran_vec_interleave_add(&input[(l + 1) * nref], &input[l * nref], temp, nref);
-      }
-    }
+  if (average_pilots_time(q, sf, cfg, input, output, port_id)) {
     nref *= 2;
-    srsran_vec_sc_prod_cfc(temp, 2.0f / (float)nsymbols, input, nref);
-
     nsymbols = 1;
   }
 
@@ -639,18 +698,15 @@ static float chest_estimate_cfo(srsran_chest_dl_t* q)
   return -cargf(sum) * n / (ns * (n + ng)) / 2 / M_PI;
 }
 
-static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
+/* Estimates the CFO and, for the REFS algorithm, the noise from the least-squares pilot estimates */
+static void chest_estimate_noise_pilots(srsran_chest_dl_t*     q,
                                         srsran_dl_sf_cfg_t*    sf,
                                         srsran_chest_dl_cfg_t* cfg,
-                                        cf_t*                  input,
-                                        cf_t*                  ce,
                                         uint32_t               port_id,
                                         uint32_t               rxant_id)
 {
-  float       filter[SRSRAN_CHEST_MAX_SMOOTH_FIL_LEN];
-  uint32_t    filter_len = 0;
-  uint32_t    sf_idx     = sf->tti % 10;
-  srsran_sf_t ch_mode    = sf->sf_type;
+  uint32_t    sf_idx  = sf->tti % 10;
+  srsran_sf_t ch_mode = sf->sf_type;
 
   if (cfg->cfo_estimate_enable && ((1 << sf_idx) & cfg->cfo_estimate_sf_mask) && ch_mode != SRSRAN_SF_MBSFN) {
     q->cfo = chest_estimate_cfo(q);
@@ -664,6 +720,79 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
 
     q->noise_estimate[rxant_id][port_id] = estimate_noise_pilots(q, sf, port_id);
   }
+}
+
+/* Computes the frequency smoothing filter of the configured type and returns its length */
+static uint32_t chest_smooth_filter(srsran_chest_dl_t*     q,
+                                    srsran_dl_sf_cfg_t*    sf,
+                                    srsran_chest_dl_cfg_t* cfg,
+                                    uint32_t               port_id,
+                                    uint32_t               rxant_id,
+                                    float*                 filter)
+{
+  uint32_t filter_len = 0;
+
+  switch (cfg->filter_type) {
+    case SRSRAN_CHEST_FILTER_GAUSS:
+      if (sf->sf_type == SRSRAN_SF_MBSFN) {
+        ERROR("Warning: Gauss filter not supported in MBSFN subframes");
+      }
+      if (cfg->filter_coef[0] <= 0) {
+        filter_len = srsran_chest_set_smooth_filter_gauss(filter, 4, q->noise_estimate[rxant_id][port_id] * 200.0f);
+      } else {
+        filter_len = srsran_chest_set_smooth_filter_gauss(filter, (uint32_t)cfg->filter_coef[0], cfg->filter_coef[1]);
+      }
+      break;
+    case SRSRAN_CHEST_FILTER_TRIANGLE:
+      filter_len = srsran_chest_set_smooth_filter3_coeff(filter, cfg->filter_coef[0]);
+      break;
+    default:
+      break;
+  }
+
+  return filter_len;
+}
+
+/* Estimates the noise from the channel estimates for the PSS and EMPTY algorithms */
+static void chest_estimate_noise_ce(srsran_chest_dl_t*     q,
+                                    srsran_dl_sf_cfg_t*    sf,
+                                    srsran_chest_dl_cfg_t* cfg,
+                                    cf_t*                  input,
+                                    cf_t*                  ce,
+                                    uint32_t               port_id,
+                                    uint32_t               rxant_id)
+{
+  uint32_t sf_idx = sf->tti % 10;
+
+  switch (cfg->noise_alg) {
+    case SRSRAN_NOISE_ALG_PSS:
+      if (sf_idx == 0 || sf_idx == 5) {
+        q->noise_estimate[rxant_id][port_id] = estimate_noise_pss(q, input, ce);
+      }
+      break;
+    case SRSRAN_NOISE_ALG_EMPTY:
+      if (sf_idx == 0 || sf_idx == 5) {
+        q->noise_estimate[rxant_id][port_id] = estimate_noise_empty_sc(q, input);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
+                                        srsran_dl_sf_cfg_t*    sf,
+                                        srsran_chest_dl_cfg_t* cfg,
+                                        cf_t*                  input,
+                                        cf_t*                  ce,
+                                        uint32_t               port_id,
+                                        uint32_t               rxant_id)
+{
+  float       filter[SRSRAN_CHEST_MAX_SMOOTH_FIL_LEN];
+  uint32_t    filter_len = 0;
+  srsran_sf_t ch_mode    = sf->sf_type;
+
+  chest_estimate_noise_pilots(q, sf, cfg, port_id, rxant_id);
 
   if (q->wiener_dl && ch_mode == SRSRAN_SF_NORM && cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_WIENER) {
     bool     ready   = q->wiener_dl->ready;
@@ -698,23 +827,7 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
   }
 
   if (ce != NULL) {
-    switch (cfg->filter_type) {
-      case SRSRAN_CHEST_FILTER_GAUSS:
-        if (ch_mode == SRSRAN_SF_MBSFN) {
-          ERROR("Warning: Gauss filter not supported in MBSFN subframes");
-        }
-        if (cfg->filter_coef[0] <= 0) {
-          filter_len = srsran_chest_set_smooth_filter_gauss(filter, 4, q->noise_estimate[rxant_id][port_id] * 200.0f);
-        } else {
-          filter_len = srsran_chest_set_smooth_filter_gauss(filter, (uint32_t)cfg->filter_coef[0], cfg->filter_coef[1]);
-        }
-        break;
-      case SRSRAN_CHEST_FILTER_TRIANGLE:
-        filter_len = srsran_chest_set_smooth_filter3_coeff(filter, cfg->filter_coef[0]);
-        break;
-      default:
-        break;
-    }
+    filter_len = chest_smooth_filter(q, sf, cfg, port_id, rxant_id, filter);
 
     if (cfg->estimator_alg != SRSRAN_ESTIMATOR_ALG_INTERPOLATE && ch_mode == SRSRAN_SF_MBSFN) {
       ERROR("Warning: Subframe interpolation must be enabled in MBSFN subframes");
@@ -729,20 +842,7 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
     }
 
     /* Estimate noise for PSS and EMPTY algorithms */
-    switch (cfg->noise_alg) {
-      case SRSRAN_NOISE_ALG_PSS:
-        if (sf_idx == 0 || sf_idx == 5) {
-          q->noise_estimate[rxant_id][port_id] = estimate_noise_pss(q, input, ce);
-        }
-        break;
-      case SRSRAN_NOISE_ALG_EMPTY:
-        if (sf_idx == 0 || sf_idx == 5) {
-          q->noise_estimate[rxant_id][port_id] = estimate_noise_empty_sc(q, input);
-        }
-        break;
-      default:
-        break;
-    }
+    chest_estimate_noise_ce(q, sf, cfg, input, ce, port_id, rxant_id);
   }
 }
 
@@ -803,13 +903,13 @@ chest_dl_estimate_correct_sync_error(srsran_chest_dl_t* q, srsran_dl_sf_cfg_t* s
   }
 }
 
-static int estimate_port(srsran_chest_dl_t*     q,
-                         srsran_dl_sf_cfg_t*    sf,
-                         srsran_chest_dl_cfg_t* cfg,
-                         cf_t*                  input,
-                         cf_t*                  ce,
-                         uint32_t               port_id,
-                         uint32_t               rxant_id)
+/* Computes the least-squares estimates of the port pilots and the power measurements */
+static void estimate_port_pilots(srsran_chest_dl_t*     q,
+                                 srsran_dl_sf_cfg_t*    sf,
+                                 srsran_chest_dl_cfg_t* cfg,
+                                 cf_t*                  input,
+                                 uint32_t               port_id,
+                                 uint32_t               rxant_id)
 {
   uint32_t npilots = srsran_refsignal_cs_nof_re(&q->csr_refs, sf, port_id);
 
@@ -826,13 +926,350 @@ static int estimate_port(srsran_chest_dl_t*     q,
     q->rsrp_corr[rxant_id][port_id] = energy * energy;
   }
   q->rsrp[rxant_id][port_id] = srsran_vec_avg_power_cf(q->pilot_recv_signal, npilots);
-  q->rssi[rxant_id][port_id] = chest_dl_rssi(q, sf, input, port_id);
+
+  /* Ports 0 and 1, as well as ports 2 and 3, carry references in the same symbols */
+  if (port_id % 2) {
+    q->rssi[rxant_id][port_id] = q->rssi[rxant_id][port_id - 1];
+  } else {
+    q->rssi[rxant_id][port_id] = chest_dl_rssi(q, sf, input, port_id);
+  }
+}
+
+static int estimate_port(srsran_chest_dl_t*     q,
+                         srsran_dl_sf_cfg_t*    sf,
+                         srsran_chest_dl_cfg_t* cfg,
+                         cf_t*                  input,
+                         cf_t*                  ce,
+                         uint32_t               port_id,
+                         uint32_t               rxant_id)
+{
+  estimate_port_pilots(q, sf, cfg, input, port_id, rxant_id);
 
   chest_interpolate_noise_est(q, sf, cfg, input, ce, port_id, rxant_id);
 
   return 0;
 }
 
+static bool interp_table_match(const srsran_chest_dl_interp_table_t* t,
+                               uint32_t                              nof_pilots,
+                               uint32_t                              spacing,
+                               uint32_t                              offset,
+                               const float*                          filter,
+                               uint32_t                              filter_len)
+{
+  return t->nof_pilots == nof_pilots && t->spacing == spacing && t->offset == offset &&
+         t->filter_len == filter_len && memcmp(t->filter, filter, sizeof(float) * filter_len) == 0;
+}
+
+/* Computes the weights of the pilots smoothed with srsran_conv_same_cf() and then interpolated with
+ * srsran_interp_linear_offset(). The estimate of subcarrier k depends on the nof_taps pilots starting at
+ * floor((k - offset) / spacing) - filter_len / 2 - 1, the ones out of range have zero weight */
+static int interp_table_build(srsran_chest_dl_t*              q,
+                              srsran_chest_dl_interp_table_t* t,
+                              uint32_t                        nof_pilots,
+                              uint32_t                        spacing,
+                              uint32_t                        offset,
+                              const float*                    filter,
+                              uint32_t                        filter_len)
+{
+  uint32_t nof_re   = nof_pilots * spacing;
+  uint32_t nof_taps = filter_len + 3;
+  uint32_t stride   = 2 * nof_re;
+#if SRSRAN_SIMD_F_SIZE
+  stride = SRSRAN_CEIL(stride, SRSRAN_SIMD_F_SIZE) * SRSRAN_SIMD_F_SIZE;
+#endif
+
+  if (nof_pilots < 2 * filter_len || nof_taps > SRSRAN_CHEST_DL_INTERP_MAX_TAPS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (t->weights) {
+    free(t->weights);
+  }
+  t->nof_pilots = 0;
+  t->weights    = srsran_vec_f_malloc(nof_taps * stride);
+  if (!t->weights) {
+    return SRSRAN_ERROR;
+  }
+  srsran_vec_f_zero(t->weights, nof_taps * stride);
+
+  // Pilot i is smoothed with pilots i - half to i - half + filter_len - 1. The filter applies as is far from the
+  // edges, the rows of the smoothing at the edges are found by smoothing impulses
+  int32_t half = (int32_t)filter_len / 2;
+  float   edge[SRSRAN_CHEST_DL_INTERP_MAX_TAPS][SRSRAN_CHEST_DL_INTERP_MAX_TAPS] = {};
+  for (int32_t j = 0; j < (int32_t)nof_pilots; j++) {
+    if (j >= (int32_t)filter_len && j < (int32_t)(nof_pilots - filter_len)) {
+      continue;
+    }
+    srsran_vec_cf_zero(q->tmp_noise, nof_pilots);
+    q->tmp_noise[j] = 1.0f;
+    srsran_conv_same_cf(q->tmp_noise, (float*)filter, q->pilot_estimates_average, nof_pilots, filter_len);
+    for (int32_t e = 0; e < 2 * half; e++) {
+      int32_t i = (e < half) ? e : (int32_t)nof_pilots - 2 * half + e;
+      int32_t f = j - i + half;
+      if (f >= 0 && f < (int32_t)filter_len) {
+        edge[e][f] = crealf(q->pilot_estimates_average[i]);
+      }
+    }
+  }
+
+  for (uint32_t k = 0; k < nof_re; k++) {
+    int32_t b     = (k < offset) ? -1 : (int32_t)((k - offset) / spacing);
+    int32_t i     = SRSRAN_MIN(SRSRAN_MAX(b, 0), (int32_t)nof_pilots - 2);
+    float   frac  = ((float)k - (float)offset - (float)(i * spacing)) / (float)spacing;
+    int32_t first = b - half - 1;
+
+    // Linear interpolation (or extrapolation at the edges) between the smoothed pilots i and i + 1
+    for (int32_t r = i; r < i + 2; r++) {
+      float        a    = (r == i) ? 1.0f - frac : frac;
+      const float* coef = filter;
+      if (r < half) {
+        coef = edge[r];
+      } else if (r >= (int32_t)nof_pilots - half) {
+        coef = edge[r - (int32_t)nof_pilots + 2 * half];
+      }
+      for (int32_t f = 0; f < (int32_t)filter_len; f++) {
+        int32_t j = r + f - half;
+        if (j >= 0 && j < (int32_t)nof_pilots) {
+          float* w = &t->weights[(j - first) * stride + 2 * k];
+          w[0] += a * coef[f];
+          w[1] += a * coef[f];
+        }
+      }
+    }
+  }
+
+  t->nof_pilots = nof_pilots;
+  t->spacing    = spacing;
+  t->offset     = offset;
+  t->filter_len = filter_len;
+  memcpy(t->filter, filter, sizeof(float) * filter_len);
+  t->nof_re   = nof_re;
+  t->nof_taps = nof_taps;
+  t->stride   = stride;
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Returns the table for the given pilot pattern and filter, computing it if it is not cached. The least recently used
+ * table is replaced, so the tables used by the subframe being estimated are kept */
+static srsran_chest_dl_interp_table_t* interp_table_get(srsran_chest_dl_t* q,
+                                                        uint32_t           nof_pilots,
+                                                        uint32_t           spacing,
+                                                        uint32_t           offset,
+                                                        const float*       filter,
+                                                        uint32_t           filter_len)
+{
+  srsran_chest_dl_interp_table_t* t = &q->interp_table[0];
+  for (uint32_t i = 0; i < SRSRAN_CHEST_DL_INTERP_NOF_TABLES; i++) {
+    if (interp_table_match(&q->interp_table[i], nof_pilots, spacing, offset, filter, filter_len)) {
+      q->interp_table[i].last_use = ++q->interp_table_count;
+      return &q->interp_table[i];
+    }
+    if (q->interp_table[i].last_use < t->last_use) {
+      t = &q->interp_table[i];
+    }
+  }
+
+  if (interp_table_build(q, t, nof_pilots, spacing, offset, filter, filter_len)) {
+    ERROR("Error computing channel estimator interpolation table");
+    return NULL;
+  }
+  t->last_use = ++q->interp_table_count;
+  return t;
+}
+
+/* Repeats every pilot along the subcarriers it weights, so that tap t of subcarrier k is at hold[k + t * spacing] */
+static void interp_table_hold(const srsran_chest_dl_interp_table_t* t, const cf_t* pilots, cf_t* hold)
+{
+  uint32_t len  = t->nof_re + t->spacing * (t->nof_taps - 1);
+  uint32_t next = t->offset;
+  int32_t  j    = -(int32_t)(t->filter_len / 2) - 2;
+
+  for (uint32_t k = 0; k < len; j++, next += t->spacing) {
+    cf_t v = (j >= 0 && j < (int32_t)t->nof_pilots) ? pilots[j] : 0.0f;
+    for (; k < next && k < len; k++) {
+      hold[k] = v;
+    }
+  }
+}
+
+/* Applies the table weights to a batch of pilot symbols, each weight is loaded once for all of them. Every estimated
+ * symbol is written nof_copies times, nof_re subcarriers apart, which fills the subframe when averaging in time */
+static void interp_table_apply(const srsran_chest_dl_interp_table_t* t,
+                               cf_t* const*                          hold,
+                               cf_t* const*                          ce,
+                               uint32_t                              nof_symbols,
+                               uint32_t                              nof_copies)
+{
+  const uint32_t len   = 2 * t->nof_re;
+  const uint32_t shift = 2 * t->spacing;
+  uint32_t       x     = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  for (; x + SRSRAN_SIMD_F_SIZE <= len; x += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t w[SRSRAN_CHEST_DL_INTERP_MAX_TAPS];
+    for (uint32_t tap = 0; tap < t->nof_taps; tap++) {
+      w[tap] = srsran_simd_f_load(&t->weights[tap * t->stride + x]);
+    }
+
+    for (uint32_t n = 0; n < nof_symbols; n++) {
+      const float* h   = (const float*)hold[n] + x;
+      simd_f_t     acc = srsran_simd_f_mul(w[0], srsran_simd_f_loadu(h));
+      for (uint32_t tap = 1; tap < t->nof_taps; tap++) {
+        acc = srsran_simd_f_add(acc, srsran_simd_f_mul(w[tap], srsran_simd_f_loadu(&h[tap * shift])));
+      }
+      for (uint32_t c = 0; c < nof_copies; c++) {
+        srsran_simd_f_storeu((float*)ce[n] + c * len + x, acc);
+      }
+    }
+  }
+#endif
+
+  for (; x < len; x++) {
+    for (uint32_t n = 0; n < nof_symbols; n++) {
+      const float* h   = (const float*)hold[n] + x;
+      float        acc = 0.0f;
+      for (uint32_t tap = 0; tap < t->nof_taps; tap++) {
+        acc += t->weights[tap * t->stride + x] * h[tap * shift];
+      }
+      for (uint32_t c = 0; c < nof_copies; c++) {
+        ((float*)ce[n])[c * len + x] = acc;
+      }
+    }
+  }
+}
+
+/* Returns true if the ports can be interpolated with precomputed tables and writes the smoothing filter */
+static bool chest_dl_interp_tables_enabled(srsran_chest_dl_t*     q,
+                                           srsran_dl_sf_cfg_t*    sf,
+                                           srsran_chest_dl_cfg_t* cfg,
+                                           float*                 filter,
+                                           uint32_t*              filter_len)
+{
+  if (!cfg->precomputed_interp || sf->sf_type != SRSRAN_SF_NORM ||
+      (cfg->estimator_alg != SRSRAN_ESTIMATOR_ALG_AVERAGE && cfg->estimator_alg != SRSRAN_ESTIMATOR_ALG_INTERPOLATE)) {
+    return false;
+  }
+
+  // The automatic Gauss filter depends on the noise estimate of every port
+  if (cfg->filter_type == SRSRAN_CHEST_FILTER_GAUSS && cfg->filter_coef[0] <= 0) {
+    return false;
+  }
+
+  if (cfg->filter_type == SRSRAN_CHEST_FILTER_NONE) {
+    filter[0]   = 1.0f;
+    *filter_len = 1;
+  } else {
+    *filter_len = chest_smooth_filter(q, sf, cfg, 0, 0, filter);
+  }
+
+  return *filter_len > 0 && *filter_len + 3 <= SRSRAN_CHEST_DL_INTERP_MAX_TAPS && *filter_len <= q->cell.nof_prb;
+}
+
+/* Estimates all the ports of one receive antenna. The pilot symbols of all ports are smoothed and interpolated in
+ * frequency together with the precomputed tables, then every port is interpolated in time */
+static int estimate_ports_interp_tables(srsran_chest_dl_t*     q,
+                                        srsran_dl_sf_cfg_t*    sf,
+                                        srsran_chest_dl_cfg_t* cfg,
+                                        cf_t*                  input,
+                                        srsran_chest_dl_res_t* res,
+                                        uint32_t               rxant_id,
+                                        const float*           filter,
+                                        uint32_t               filter_len)
+{
+  srsran_chest_dl_interp_table_t* table[SRSRAN_MAX_PORTS * SRSRAN_CHEST_DL_MAX_PILOT_SYMB];
+  cf_t*                           hold[SRSRAN_MAX_PORTS * SRSRAN_CHEST_DL_MAX_PILOT_SYMB];
+  cf_t*                           out[SRSRAN_MAX_PORTS * SRSRAN_CHEST_DL_MAX_PILOT_SYMB];
+  uint32_t                        item_copies[SRSRAN_MAX_PORTS * SRSRAN_CHEST_DL_MAX_PILOT_SYMB];
+  uint32_t                        copies[SRSRAN_MAX_PORTS];
+  uint32_t                        nof_items = 0;
+  uint32_t                        nof_prb   = q->cell.nof_prb;
+  uint32_t                        nof_symb  = 2 * SRSRAN_CP_NSYMB(q->cell.cp);
+
+  for (uint32_t port_id = 0; port_id < q->cell.nof_ports; port_id++) {
+    cf_t*    ce       = res->ce[port_id][rxant_id];
+    uint32_t nsymbols = srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+
+    // Without time interpolation the estimates are copied to all the symbols of the subframe
+    copies[port_id] = (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2) ? nof_symb : 1;
+
+    estimate_port_pilots(q, sf, cfg, input, port_id, rxant_id);
+    chest_estimate_noise_pilots(q, sf, cfg, port_id, rxant_id);
+
+    if (ce == NULL) {
+      continue;
+    }
+
+    if (cfg->filter_type != SRSRAN_CHEST_FILTER_NONE) {
+      average_pilots_time(q, sf, cfg, q->pilot_estimates, q->pilot_estimates_average, port_id);
+    }
+
+    if (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE && nsymbols > 1) {
+      // The pilots of every pair of symbols are interleaved every 3 subcarriers
+      table[nof_items] = interp_table_get(q, 4 * nof_prb, SRSRAN_NRE / 4, q->cell.id % 3, filter, filter_len);
+      if (table[nof_items] == NULL) {
+        return SRSRAN_ERROR;
+      }
+      hold[nof_items]        = q->interp_hold[port_id][0];
+      out[nof_items]         = ce;
+      item_copies[nof_items] = copies[port_id];
+      interp_table_hold(table[nof_items], q->pilot_estimates, hold[nof_items]);
+      nof_items++;
+    } else {
+      uint32_t freq_nsymbols = (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE) ? 1 : nsymbols;
+      for (uint32_t l = 0; l < freq_nsymbols; l++) {
+        uint32_t fidx_offset = srsran_refsignal_cs_fidx(q->cell, l, port_id, 0);
+        table[nof_items]     = interp_table_get(q, 2 * nof_prb, SRSRAN_NRE / 2, fidx_offset, filter, filter_len);
+        if (table[nof_items] == NULL) {
+          return SRSRAN_ERROR;
+        }
+        hold[nof_items]        = q->interp_hold[port_id][l];
+        out[nof_items]         = ce;
+        item_copies[nof_items] = copies[port_id];
+        if (nsymbols > 1) {
+          out[nof_items] += srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id) * nof_prb * SRSRAN_NRE;
+        }
+        interp_table_hold(table[nof_items], &q->pilot_estimates[2 * nof_prb * l], hold[nof_items]);
+        nof_items++;
+      }
+    }
+  }
+
+  // Interpolate together the symbols of all ports that share a table, a subframe uses at most two of them
+  for (uint32_t i = 0; i < nof_items; i++) {
+    srsran_chest_dl_interp_table_t* t = table[i];
+    if (t == NULL) {
+      continue;
+    }
+
+    cf_t*    batch_hold[SRSRAN_MAX_PORTS * SRSRAN_CHEST_DL_MAX_PILOT_SYMB];
+    cf_t*    batch_out[SRSRAN_MAX_PORTS * SRSRAN_CHEST_DL_MAX_PILOT_SYMB];
+    uint32_t n = 0;
+    for (uint32_t j = i; j < nof_items; j++) {
+      if (table[j] == t && item_copies[j] == item_copies[i]) {
+        batch_hold[n] = hold[j];
+        batch_out[n]  = out[j];
+        table[j]      = NULL;
+        n++;
+      }
+    }
+    interp_table_apply(t, batch_hold, batch_out, n, item_copies[i]);
+  }
+
+  for (uint32_t port_id = 0; port_id < q->cell.nof_ports; port_id++) {
+    cf_t* ce = res->ce[port_id][rxant_id];
+    if (ce != NULL) {
+      if (copies[port_id] == 1) {
+        interpolate_pilots_time(q, sf, cfg, ce, port_id, srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id));
+      }
+      chest_estimate_noise_ce(q, sf, cfg, input, ce, port_id, rxant_id);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 static int estimate_port_mbsfn(srsran_chest_dl_t*     q,
                                srsran_dl_sf_cfg_t*    sf,
                                srsran_chest_dl_cfg_t* cfg,
@@ -1002,12 +1439,23 @@ int srsran_chest_dl_estimate_cfg(srsran_chest_dl_t*     q,
                                  cf_t*                  input[SRSRAN_MAX_PORTS],
                                  srsran_chest_dl_res_t* res)
 {
+  float    filter[SRSRAN_CHEST_MAX_SMOOTH_FIL_LEN];
+  uint32_t filter_len = 0;
+  bool     use_tables = chest_dl_interp_tables_enabled(q, sf, cfg, filter, &filter_len);
+
   for (uint32_t rxant_id = 0; rxant_id < q->nof_rx_antennas; rxant_id++) {
     // Estimate and correct synchronization error if enabled
     if (cfg->sync_error_enable) {
       chest_dl_estimate_correct_sync_error(q, sf, input[rxant_id], rxant_id);
     }
 
+    if (use_tables) {
+      if (estimate_ports_interp_tables(q, sf, cfg, input[rxant_id], res, rxant_id, filter, filter_len)) {
+        return SRSRAN_ERROR;
+      }
+      continue;
+    }
+
     for (uint32_t port_id = 0; port_id < q->cell.nof_ports; port_id++) {
       if (sf->sf_type == SRSRAN_SF_MBSFN) {
         if (estimate_port_mbsfn(q, sf, cfg, input[rxant_id], res->ce[port_id][rxant_id], port_id, rxant_id)) {
@@ -35,7 +35,10 @@ srsran_cell_t cell = {6,              // nof_prb
                       SRSRAN_PHICH_R_1_6,
                       SRSRAN_FDD};
 
-char* output_matlab = NULL;
+char*    output_matlab       = NULL;
+uint32_t test_nof_ports      = 0;
+uint32_t test_nof_rx_ant     = 1;
+uint32_t bench_nof_subframes = 0;
 
 void usage(char* prog)
 {
@@ -47,13 +50,17 @@ void usage(char* prog)
   printf("\t-c cell_id (1000 tests all). [Default %d]\n", cell.id);
 
   printf("\t-o output matlab file [Default %s]\n", output_matlab ? output_matlab : "None");
+  printf("\t-b benchmark throughput over this many subframes [Default %d]\n", bench_nof_subframes);
+  printf("\t-p number of ports in the precomputed interpolation test and benchmark [Default cell ports]\n");
+  printf("\t-a number of receive antennas in the precomputed interpolation test and benchmark [Default %d]\n",
+         test_nof_rx_ant);
   printf("\t-v increase verbosity\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "recov")) != -1) {
+  while ((opt = getopt(argc, argv, "recovbpa")) != -1) {
     switch (opt) {
       case 'r':
         cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +77,15 @@ void parse_args(int argc, char** argv)
       case 'v':
         increase_srsran_verbose_level();
         break;
+      case 'b':
+        bench_nof_subframes = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        test_nof_ports = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'a':
+        test_nof_rx_ant = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -77,6 +93,178 @@ void parse_args(int argc, char** argv)
   }
 }
 
+/* Estimates every subframe of a frame with and without the precomputed interpolation for all the fixed smoothing
+ * filters, with the average and interpolate estimators, and checks that both give the same estimates */
+static int test_precomputed_interp(srsran_cell_t test_cell)
+{
+  srsran_chest_dl_t     est;
+  srsran_chest_dl_res_t res[2];
+  cf_t*                 input[SRSRAN_MAX_PORTS] = {};
+  int                   ret                     = SRSRAN_ERROR;
+
+  const srsran_chest_filter_t filter_types[3] = {
+      SRSRAN_CHEST_FILTER_NONE, SRSRAN_CHEST_FILTER_TRIANGLE, SRSRAN_CHEST_FILTER_GAUSS};
+
+  if (test_nof_ports) {
+    test_cell.nof_ports = test_nof_ports;
+  }
+
+  uint32_t num_re = SRSRAN_SF_LEN_RE(test_cell.nof_prb, test_cell.cp);
+
+  if (srsran_chest_dl_init(&est, test_cell.nof_prb, test_nof_rx_ant) || srsran_chest_dl_set_cell(&est, test_cell) ||
+      srsran_chest_dl_res_init(&res[0], test_cell.nof_prb) || srsran_chest_dl_res_init(&res[1], test_cell.nof_prb)) {
+    ERROR("Error initializing estimator");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t a = 0; a < test_nof_rx_ant; a++) {
+    input[a] = srsran_vec_cf_malloc(num_re);
+    if (!input[a]) {
+      perror("srsran_vec_malloc");
+      goto clean_exit;
+    }
+    for (uint32_t i = 0; i < num_re; i++) {
+      input[a][i] = 0.5 - rand() / (float)RAND_MAX + I * (0.5 - rand() / (float)RAND_MAX);
+    }
+  }
+
+  for (uint32_t f = 0; f < 3; f++) {
+    for (uint32_t alg = 0; alg < 2; alg++) {
+      srsran_chest_dl_cfg_t cfg;
+      ZERO_OBJECT(cfg);
+      cfg.filter_type    = filter_types[f];
+      cfg.filter_coef[0] = 4;
+      cfg.filter_coef[1] = 1.0f;
+      cfg.noise_alg      = SRSRAN_NOISE_ALG_REFS;
+      cfg.estimator_alg  = (alg == 0) ? SRSRAN_ESTIMATOR_ALG_AVERAGE : SRSRAN_ESTIMATOR_ALG_INTERPOLATE;
+
+      float max_err = 0.0f;
+      float power   = 0.0f;
+      for (uint32_t tti = 0; tti < SRSRAN_NOF_SF_X_FRAME; tti++) {
+        srsran_dl_sf_cfg_t sf_cfg;
+        ZERO_OBJECT(sf_cfg);
+        sf_cfg.tti = tti;
+
+        for (uint32_t precomputed = 0; precomputed < 2; precomputed++) {
+          cfg.precomputed_interp = precomputed;
+          if (srsran_chest_dl_estimate_cfg(&est, &sf_cfg, &cfg, input, &res[precomputed])) {
+            ERROR("Error estimating channel");
+            goto clean_exit;
+          }
+        }
+
+        for (uint32_t p = 0; p < test_cell.nof_ports; p++) {
+          for (uint32_t a = 0; a < test_nof_rx_ant; a++) {
+            for (uint32_t i = 0; i < num_re; i++) {
+              max_err = SRSRAN_MAX(max_err, cabsf(res[0].ce[p][a][i] - res[1].ce[p][a][i]));
+              power += cabsf(res[0].ce[p][a][i]);
+            }
+          }
+        }
+      }
+      power /= SRSRAN_NOF_SF_X_FRAME * test_cell.nof_ports * test_nof_rx_ant * num_re;
+
+      INFO("Precomputed filter=%d alg=%d: max. error %f (average magnitude %f)", f, alg, max_err, power);
+      if (!(max_err <= 1e-3f * power)) {
+        ERROR("Precomputed interpolation does not match for filter=%d alg=%d: max. error %f (average magnitude %f)",
+              f,
+              alg,
+              max_err,
+              power);
+        goto clean_exit;
+      }
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t a = 0; a < SRSRAN_MAX_PORTS; a++) {
+    if (input[a]) {
+      free(input[a]);
+    }
+  }
+  srsran_chest_dl_res_free(&res[0]);
+  srsran_chest_dl_res_free(&res[1]);
+  srsran_chest_dl_free(&est);
+  return ret;
+}
+
+/* Measures the estimation time per subframe of all ports and receive antennas with the UE default configuration, with
+ * and without the precomputed interpolation */
+static int benchmark(void)
+{
+  srsran_chest_dl_t     est;
+  srsran_chest_dl_res_t res;
+  cf_t*                 input[SRSRAN_MAX_PORTS] = {};
+  srsran_cell_t         bench_cell              = cell;
+  int                   ret                     = SRSRAN_ERROR;
+
+  if (test_nof_ports) {
+    bench_cell.nof_ports = test_nof_ports;
+  }
+
+  uint32_t num_re = SRSRAN_SF_LEN_RE(bench_cell.nof_prb, bench_cell.cp);
+
+  if (srsran_chest_dl_init(&est, bench_cell.nof_prb, test_nof_rx_ant) ||
+      srsran_chest_dl_set_cell(&est, bench_cell) || srsran_chest_dl_res_init(&res, bench_cell.nof_prb)) {
+    ERROR("Error initializing estimator");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t a = 0; a < test_nof_rx_ant; a++) {
+    input[a] = srsran_vec_cf_malloc(num_re);
+    if (!input[a]) {
+      perror("srsran_vec_malloc");
+      goto clean_exit;
+    }
+    for (uint32_t i = 0; i < num_re; i++) {
+      input[a][i] = 0.5 - rand() / (float)RAND_MAX + I * (0.5 - rand() / (float)RAND_MAX);
+    }
+  }
+
+  for (uint32_t alg = 0; alg < 2; alg++) {
+    srsran_chest_dl_cfg_t cfg;
+    ZERO_OBJECT(cfg);
+    cfg.filter_type    = SRSRAN_CHEST_FILTER_GAUSS;
+    cfg.filter_coef[0] = 4;
+    cfg.filter_coef[1] = 1.0f;
+    cfg.noise_alg      = SRSRAN_NOISE_ALG_REFS;
+    cfg.estimator_alg  = (alg == 0) ? SRSRAN_ESTIMATOR_ALG_AVERAGE : SRSRAN_ESTIMATOR_ALG_INTERPOLATE;
+
+    for (uint32_t precomputed = 0; precomputed < 2; precomputed++) {
+      cfg.precomputed_interp = precomputed;
+
+      struct timeval t[3];
+      gettimeofday(&t[1], NULL);
+      for (uint32_t k = 0; k < bench_nof_subframes; k++) {
+        srsran_dl_sf_cfg_t sf_cfg;
+        ZERO_OBJECT(sf_cfg);
+        sf_cfg.tti = k % 10;
+        srsran_chest_dl_estimate_cfg(&est, &sf_cfg, &cfg, input, &res);
+      }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      printf("CHEST %s %s %dx%d: %.1f us per subframe\n",
+             (alg == 0) ? "average" : "interpolate",
+             precomputed ? "precomputed" : "generic",
+             bench_cell.nof_ports,
+             test_nof_rx_ant,
+             (float)(t[0].tv_sec * 1e6 + t[0].tv_usec) / bench_nof_subframes);
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t a = 0; a < SRSRAN_MAX_PORTS; a++) {
+    if (input[a]) {
+      free(input[a]);
+    }
+  }
+  srsran_chest_dl_res_free(&res);
+  srsran_chest_dl_free(&est);
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   srsran_chest_dl_t est;
@@ -89,6 +277,11 @@ int main(int argc, char** argv)
 
   parse_args(argc, argv);
 
+  if (test_nof_rx_ant == 0 || test_nof_rx_ant > SRSRAN_MAX_PORTS) {
+    ERROR("Invalid number of receive antennas");
+    goto do_exit;
+  }
+
   if (output_matlab) {
     fmatlab = fopen(output_matlab, "w");
     if (!fmatlab) {
@@ -225,10 +418,19 @@ int main(int argc, char** argv)
         fprintf(fmatlab, ";\n");
       }
     }
+
+    if (test_precomputed_interp(cell)) {
+      goto do_exit;
+    }
+
     cid += 10;
     INFO("cid=%d", cid);
   }
   srsran_chest_dl_free(&est);
+
+  if (bench_nof_subframes && benchmark()) {
+    goto do_exit;
+  }
   ret = 0;
 
 do_exit:
@@ -25,6 +25,22 @@
 
 using namespace srsran;
 
+// Maximum number of segments a block is split in for pipelining the stages
+#define CHANNEL_MAX_SEGMENTS 8
+
+// Segment length granularity in samples when the fading stage does not impose its own
+#define CHANNEL_SEGMENT_ALIGN 64
+
+extern "C" {
+static inline cf_t local_cexpf(float phase)
+{
+  cf_t ret;
+  __real__ ret = cosf(phase);
+  __imag__ ret = sinf(phase);
+  return ret;
+}
+}
+
 channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, srslog::basic_logger& logger) :
   logger(logger)
 {
@@ -73,19 +89,19 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     } else {
       delay[i] = nullptr;
     }
-  }
 
-  // Create AWGN channnel
-  if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
-    awgn = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
-    ret  = srsran_channel_awgn_init(awgn, 1234);
-    srsran_channel_awgn_set_n0(awgn, args.awgn_signal_power_dBfs - args.awgn_snr_dB);
-  }
+    // Create AWGN channnel, each channel has its own random generator so they can run in parallel
+    if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
+      awgn[i] = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
+      ret     = srsran_channel_awgn_init(awgn[i], 1234 + i);
+      srsran_channel_awgn_set_n0(awgn[i], args.awgn_signal_power_dBfs - args.awgn_snr_dB);
+    }
 
-  // Create high speed train
-  if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
-    hst = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
-    srsran_channel_hst_init(hst, channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    // Create high speed train
+    if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
+      hst[i] = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
+      srsran_channel_hst_init(hst[i], channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    }
   }
 
   // Create Radio Link Failure simulator
@@ -96,11 +112,56 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
 
   if (ret != SRSRAN_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
+    return;
+  }
+
+  // Enabled stages in processing order
+  if (hst[0]) {
+    stages.push_back(STAGE_HST);
+  }
+  if (awgn[0]) {
+    stages.push_back(STAGE_AWGN);
+  }
+  if (fading[0]) {
+    stages.push_back(STAGE_FADING);
+  }
+  if (delay[0]) {
+    stages.push_back(STAGE_DELAY);
+  }
+  if (rlf) {
+    stages.push_back(STAGE_RLF);
+  }
+
+  // Create the pipeline stage buffers and workers
+  if (args.nof_threads > 0 && !stages.empty()) {
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      for (uint32_t s = 0; s < stages.size(); s++) {
+        stage_buffer[i][s] = srsran_vec_cf_malloc(buffer_size);
+        if (stage_buffer[i][s] == nullptr) {
+          fprintf(stderr, "Error: allocating channel pipeline buffers, running serially\n");
+          return;
+        }
+      }
+    }
+
+    for (uint32_t i = 0; i < args.nof_threads; i++) {
+      workers.emplace_back(&channel::worker_loop, this);
+    }
   }
 }
 
 channel::~channel()
 {
+  // Stop workers
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+  }
+  cvar_start.notify_all();
+  for (std::thread& w : workers) {
+    w.join();
+  }
+
   if (buffer_in) {
     free(buffer_in);
   }
@@ -109,16 +170,6 @@ channel::~channel()
     free(buffer_out);
   }
 
-  if (awgn) {
-    srsran_channel_awgn_free(awgn);
-    free(awgn);
-  }
-
-  if (hst) {
-    srsran_channel_hst_free(hst);
-    free(hst);
-  }
-
   if (rlf) {
     srsran_channel_rlf_free(rlf);
     free(rlf);
@@ -134,29 +185,64 @@ channel::~channel()
       srsran_channel_delay_free(delay[i]);
       free(delay[i]);
     }
+
+    if (awgn[i]) {
+      srsran_channel_awgn_free(awgn[i]);
+      free(awgn[i]);
+    }
+
+    if (hst[i]) {
+      srsran_channel_hst_free(hst[i]);
+      free(hst[i]);
+    }
+
+    for (uint32_t s = 0; s < NOF_STAGES; s++) {
+      if (stage_buffer[i][s]) {
+        free(stage_buffer[i][s]);
+      }
+    }
   }
 }
 
-extern "C" {
-static inline cf_t local_cexpf(float phase)
+void channel::run_stage(stage_t                   stage,
+                        uint32_t                  ch,
+                        const cf_t*               in,
+                        cf_t*                     out,
+                        uint32_t                  offset,
+                        uint32_t                  len,
+                        const srsran_timestamp_t& t)
 {
-  cf_t ret;
-  __real__ ret = cosf(phase);
-  __imag__ ret = sinf(phase);
-  return ret;
-}
+  switch (stage) {
+    case STAGE_HST:
+      // The doppler is given by the time of the block, its phase continues from the beginning of the block
+      srsran_channel_hst_execute(hst[ch], const_cast<cf_t*>(in), out, len, &t);
+      srsran_vec_sc_prod_ccc(
+          out, local_cexpf(hst_init_phase - 2.0f * (float)M_PI * offset * hst[ch]->fs_hz / hst[ch]->srate_hz), out, len);
+      break;
+    case STAGE_AWGN:
+      srsran_channel_awgn_run_c(awgn[ch], in, out, len);
+      break;
+    case STAGE_FADING:
+      srsran_channel_fading_execute(
+          fading[ch], in, out, len, t.full_secs + t.frac_secs + (double)offset / (double)current_srate);
+      break;
+    case STAGE_DELAY:
+      // The delay is given by the time of the block
+      srsran_channel_delay_execute(delay[ch], in, out, len, &t);
+      break;
+    case STAGE_RLF:
+      srsran_channel_rlf_execute(rlf, in, out, len, &t);
+      break;
+    default:
+      break;
+  }
 }
 
-void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
-                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
-                  uint32_t                  len,
-                  const srsran_timestamp_t& t)
+void channel::run_serial(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                         cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                         uint32_t                  len,
+                         const srsran_timestamp_t& t)
 {
-  // Early return if pointers are not enabled
-  if (in == nullptr || out == nullptr) {
-    return;
-  }
-
   // For each channel
   for (uint32_t i = 0; i < nof_channels; i++) {
     // Skip iteration if any buffer is null
@@ -175,38 +261,154 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
     // Copy input buffer
     srsran_vec_cf_copy(buffer_in, in[i], len);
 
-    if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
+    // Run every stage, swapping the internal buffers
+    cf_t* x = buffer_in;
+    cf_t* y = buffer_out;
+    for (stage_t stage : stages) {
+      run_stage(stage, i, x, y, 0, len, t);
+      std::swap(x, y);
     }
 
-    if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    // Copy output buffer
+    srsran_vec_cf_copy(out[i], x, len);
+  }
+}
+
+void channel::run_task(const task_t& task)
+{
+  uint32_t    ch   = task.channel;
+  uint32_t    s    = task.stage_idx;
+  bool        last = (s + 1 == stages.size());
+  const cf_t* in   = (s == 0) ? task_in[ch] : stage_buffer[ch][s - 1];
+  cf_t*       out  = last ? task_out[ch] : stage_buffer[ch][s];
+
+  // The stages can not run in place, a single stage working on the user buffer writes in its own buffer first
+  cf_t* dst = (in == out) ? stage_buffer[ch][s] : out;
+
+  for (uint32_t k = 0; k < nof_segments; k++) {
+    // Wait for the previous stage to hand over the segment
+    if (s > 0) {
+      while (progress[ch][s - 1].load(std::memory_order_acquire) <= k) {
+        std::this_thread::yield();
+      }
     }
 
-    if (fading[i]) {
-      srsran_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    uint32_t offset = k * segment_len;
+    uint32_t n      = SRSRAN_MIN(segment_len, task_len - offset);
+    run_stage(stages[s], ch, &in[offset], &dst[offset], offset, n, task_time);
+    if (dst != out) {
+      srsran_vec_cf_copy(&out[offset], &dst[offset], n);
     }
 
-    if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    progress[ch][s].store(k + 1, std::memory_order_release);
+  }
+}
+
+void channel::run_tasks(uint32_t nof_tasks)
+{
+  // Tasks are claimed in order, so the previous stage of a claimed task has always been claimed before
+  for (uint32_t idx = next_task.fetch_add(1); idx < nof_tasks; idx = next_task.fetch_add(1)) {
+    run_task(tasks[idx]);
+
+    if (nof_done.fetch_add(1) + 1 == nof_tasks) {
+      std::lock_guard<std::mutex> lock(mutex);
+      cvar_done.notify_all();
+    }
+  }
+}
+
+void channel::worker_loop()
+{
+  uint64_t seen = 0;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    cvar_start.wait(lock, [this, &seen]() { return !running || generation != seen; });
+    if (!running) {
+      return;
     }
+    seen = generation;
+
+    // Tasks are read without the lock, the block parameters do not change while a worker is busy
+    uint32_t nof_tasks = (uint32_t)tasks.size();
+    nof_busy++;
+    lock.unlock();
+    run_tasks(nof_tasks);
+    lock.lock();
+    nof_busy--;
+    cvar_done.notify_all();
+  }
+}
 
-    if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+void channel::run_parallel(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                           cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                           uint32_t                  len,
+                           const srsran_timestamp_t& t)
+{
+  uint32_t nof_tasks = 0;
+  {
+    // Wait for the workers to leave the previous block
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar_done.wait(lock, [this]() { return nof_busy == 0; });
+
+    // Segments are a multiple of the fading processing length, so the output does not depend on the split
+    uint32_t align = (fading[0] != nullptr) ? fading[0]->N / 2 : CHANNEL_SEGMENT_ALIGN;
+    segment_len    = SRSRAN_CEIL(SRSRAN_CEIL(len, CHANNEL_MAX_SEGMENTS), align) * align;
+    nof_segments   = SRSRAN_CEIL(len, segment_len);
+    task_len       = len;
+    task_time      = t;
+
+    // Tasks sorted by stage, every channel with buffers takes part
+    tasks.clear();
+    for (uint32_t s = 0; s < stages.size(); s++) {
+      for (uint32_t i = 0; i < nof_channels; i++) {
+        if (in[i] != nullptr && out[i] != nullptr) {
+          task_in[i]  = in[i];
+          task_out[i] = out[i];
+          progress[i][s].store(0, std::memory_order_relaxed);
+          tasks.push_back({i, s});
+        }
+      }
     }
+    nof_tasks = (uint32_t)tasks.size();
+    next_task.store(0);
+    nof_done.store(0);
+    generation++;
+  }
+  cvar_start.notify_all();
 
-    // Copy output buffer
-    srsran_vec_cf_copy(out[i], buffer_in, len);
+  // The calling thread processes tasks too
+  run_tasks(nof_tasks);
+
+  // Wait for the last stages to finish
+  std::unique_lock<std::mutex> lock(mutex);
+  cvar_done.wait(lock, [this, nof_tasks]() { return nof_done.load() == nof_tasks; });
+}
+
+void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                  uint32_t                  len,
+                  const srsran_timestamp_t& t)
+{
+  // Early return if pointers are not enabled
+  if (in == nullptr || out == nullptr) {
+    return;
+  }
+
+  // Nothing to process, the parallel segment length would be zero
+  if (len == 0) {
+    return;
   }
 
-  if (hst) {
+  if (workers.empty() || current_srate == 0) {
+    run_serial(in, out, len, t);
+  } else {
+    run_parallel(in, out, len, t);
+  }
+
+  if (hst[0]) {
     // Increment phase to keep it coherent between frames
-    hst_init_phase += (2 * M_PI * len * hst->fs_hz / hst->srate_hz);
+    hst_init_phase += (2 * M_PI * len * hst[0]->fs_hz / hst[0]->srate_hz);
 
     // Positive Remainder
     while (hst_init_phase > 2 * M_PI) {
@@ -225,8 +427,8 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
   if (delay[0]) {
     str << "delay=" << delay[0]->delay_us << "us; ";
   }
-  if (hst) {
-    str << "hst=" << hst->fs_hz << "Hz; ";
+  if (hst[0]) {
+    str << "hst=" << hst[0]->fs_hz << "Hz; ";
   }
   logger.debug("%s", str.str().c_str());
 }
@@ -244,10 +446,10 @@ void channel::set_srate(uint32_t srate)
       if (delay[i]) {
         srsran_channel_delay_update_srate(delay[i], srate);
       }
-    }
 
-    if (hst) {
-      srsran_channel_hst_update_srate(hst, srate);
+      if (hst[i]) {
+        srsran_channel_hst_update_srate(hst[i], srate);
+      }
     }
 
     // Update sampling rate
@@ -257,7 +459,9 @@ void channel::set_srate(uint32_t srate)
 
 void channel::set_signal_power_dBfs(float power_dBfs)
 {
-  if (awgn != nullptr) {
-    srsran_channel_awgn_set_n0(awgn, power_dBfs - args.awgn_snr_dB);
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (awgn[i] != nullptr) {
+      srsran_channel_awgn_set_n0(awgn[i], power_dBfs - args.awgn_snr_dB);
+    }
   }
 }
@@ -21,6 +21,7 @@
 
 #include "srsran/phy/channel/fading.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <math.h>
 #include <stdio.h>
@@ -77,80 +78,82 @@ static inline int parse_model(srsran_channel_fading_t* q, const char* str)
   return ret;
 }
 
-#ifdef LV_HAVE_SSE
-#include <immintrin.h>
-static inline __m128 _sine(const float* table, __m128 arg)
+/*
+ * Coefficients of the Taylor series of sin(2 * pi * y), accurate to 1e-7 for |y| <= 1/4
+ */
+#define FADING_SIN_C1 6.283185307f
+#define FADING_SIN_C3 -41.34170224f
+#define FADING_SIN_C5 81.60524928f
+#define FADING_SIN_C7 -76.70585975f
+#define FADING_SIN_C9 42.05869394f
+#define FADING_SIN_C11 -15.09464258f
+
+// Adding and subtracting 1.5 * 2^23 rounds a float to the nearest integer
+#define FADING_ROUND_MAGIC 12582912.0f
+
+#if SRSRAN_SIMD_F_SIZE
+static inline simd_f_t fading_cos_turns_simd(simd_f_t x)
 {
-  __m128 ret;
-  int    idx[4];
-  float  sine[4];
-
-  __m128 turns =
-      _mm_round_ps(_mm_mul_ps(arg, _mm_set1_ps(1.0f / (2.0f * (float)M_PI))), (_MM_FROUND_TO_ZERO + _MM_FROUND_NO_EXC));
-  __m128  argmod   = _mm_sub_ps(arg, _mm_mul_ps(turns, _mm_set1_ps(2.0f * (float)M_PI)));
-  __m128  indexps  = _mm_mul_ps(argmod, _mm_set1_ps(1024.0f / (2.0f * (float)M_PI)));
-  __m128i indexi32 = _mm_abs_epi32(_mm_cvtps_epi32(indexps));
-  _mm_store_si128((__m128i*)idx, indexi32);
-
-  for (int i = 0; i < 4; i++) {
-    sine[i] = table[idx[i]];
-  }
-
-  ret = _mm_load_ps(sine);
-  return ret;
+  // Reduce the phase to [-1/2, 1/2] turns
+  simd_f_t _magic = srsran_simd_f_set1(FADING_ROUND_MAGIC);
+  simd_f_t _r     = srsran_simd_f_sub(x, srsran_simd_f_sub(srsran_simd_f_add(x, _magic), _magic));
+
+  // cos(2 * pi * r) = sin(2 * pi * (1/4 - |r|))
+  simd_f_t _y  = srsran_simd_f_sub(srsran_simd_f_set1(0.25f), srsran_simd_f_abs(_r));
+  simd_f_t _y2 = srsran_simd_f_mul(_y, _y);
+  simd_f_t _p  = srsran_simd_f_set1(FADING_SIN_C11);
+  _p           = srsran_simd_f_add(srsran_simd_f_mul(_p, _y2), srsran_simd_f_set1(FADING_SIN_C9));
+  _p           = srsran_simd_f_add(srsran_simd_f_mul(_p, _y2), srsran_simd_f_set1(FADING_SIN_C7));
+  _p           = srsran_simd_f_add(srsran_simd_f_mul(_p, _y2), srsran_simd_f_set1(FADING_SIN_C5));
+  _p           = srsran_simd_f_add(srsran_simd_f_mul(_p, _y2), srsran_simd_f_set1(FADING_SIN_C3));
+  _p           = srsran_simd_f_add(srsran_simd_f_mul(_p, _y2), srsran_simd_f_set1(FADING_SIN_C1));
+  return srsran_simd_f_mul(_p, _y);
 }
+#endif /* SRSRAN_SIMD_F_SIZE */
 
-static inline __m128 _cosine(float* table, __m128 arg)
+static inline float fading_cos_turns(float x)
 {
-  arg = _mm_add_ps(arg, _mm_set1_ps((float)M_PI_2));
-  return _sine(table, arg);
+  return cosf(2.0f * (float)M_PI * x);
 }
-#endif /*LV_HAVE_SSE*/
 
-static inline cf_t
-get_doppler_dispersion(srsran_channel_fading_t* q, float t, float F_d, float* alpha, float* a, float* b)
+/*
+ * Evaluates the Doppler dispersion of every tap at time t. Each tap is the sum of SRSRAN_CHANNEL_FADING_NTERMS
+ * sinusoids, the phases are in turns and the imaginary parts are cosines delayed by a quarter turn.
+ */
+static void get_doppler_dispersion(const srsran_channel_fading_t* q, float t, cf_t* gains)
 {
-#ifdef LV_HAVE_SSE
-  const float recN   = 1.0f / sqrtf(SRSRAN_CHANNEL_FADING_NTERMS);
-  cf_t        ret    = 0;
-  __m128      _reacc = _mm_setzero_ps();
-  __m128      _imacc = _mm_setzero_ps();
-  __m128      _arg   = _mm_set1_ps((float)M_PI * F_d);
-  __m128      _t     = _mm_set1_ps(t);
-  __m128      _arg_  = (_mm_mul_ps(_arg, _t));
-
-  for (int i = 0; i < SRSRAN_CHANNEL_FADING_NTERMS; i += 4) {
-    __m128 _alpha = _mm_loadu_ps(&alpha[i]);
-    __m128 _a     = _mm_loadu_ps(&a[i]);
-    __m128 _b     = _mm_loadu_ps(&b[i]);
-    __m128 _arg1  = _mm_mul_ps(_arg_, _cosine(q->sin_table, _alpha));
-    __m128 _re    = _cosine(q->sin_table, _mm_add_ps(_arg1, _a));
-    __m128 _im    = _sine(q->sin_table, _mm_add_ps(_arg1, _b));
-    _reacc        = _mm_add_ps(_reacc, _re);
-    _imacc        = _mm_add_ps(_imacc, _im);
+  const float    recN  = 1.0f / sqrtf(SRSRAN_CHANNEL_FADING_NTERMS);
+  const uint32_t nterm = nof_taps[q->model] * SRSRAN_CHANNEL_FADING_NTERMS;
+  const float*   w     = &q->coeff_w[0][0];
+  const float*   a     = &q->coeff_a[0][0];
+  const float*   b     = &q->coeff_b[0][0];
+  uint32_t       i     = 0;
+
+  srsran_simd_aligned float re[SRSRAN_CHANNEL_FADING_MAXTAPS * SRSRAN_CHANNEL_FADING_NTERMS];
+  srsran_simd_aligned float im[SRSRAN_CHANNEL_FADING_MAXTAPS * SRSRAN_CHANNEL_FADING_NTERMS];
+
+#if SRSRAN_SIMD_F_SIZE
+  simd_f_t _t = srsran_simd_f_set1(t);
+  for (; i + SRSRAN_SIMD_F_SIZE <= nterm; i += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t _arg = srsran_simd_f_mul(srsran_simd_f_loadu(&w[i]), _t);
+    srsran_simd_f_store(&re[i], fading_cos_turns_simd(srsran_simd_f_add(_arg, srsran_simd_f_loadu(&a[i]))));
+    srsran_simd_f_store(&im[i], fading_cos_turns_simd(srsran_simd_f_add(_arg, srsran_simd_f_loadu(&b[i]))));
   }
+#endif /* SRSRAN_SIMD_F_SIZE */
 
-  __m128 _tmp = _mm_hadd_ps(_reacc, _imacc);
-  _tmp        = _mm_hadd_ps(_tmp, _tmp);
-  float r[4];
-  _mm_store_ps(r, _tmp);
-  __real__ ret = r[0];
-  __imag__ ret = r[1];
-
-  return ret * recN;
-
-#else
-  const float recN = 1.0f / sqrtf(SRSRAN_CHANNEL_FADING_NTERMS);
-  cf_t        r    = 0;
-
-  for (uint32_t i = 0; i < SRSRAN_CHANNEL_FADING_NTERMS; i++) {
-    float arg = (float)M_PI * F_d * cosf(alpha[i]) * t;
-    __real__ r += cosf(arg + a[i]);
-    __imag__ r += sinf(arg + b[i]);
+  for (; i < nterm; i++) {
+    re[i] = fading_cos_turns(w[i] * t + a[i]);
+    im[i] = fading_cos_turns(w[i] * t + b[i]);
   }
 
-  return recN * r;
-#endif /*LV_HAVE_SSE*/
+  for (uint32_t tap = 0; tap < nof_taps[q->model]; tap++) {
+    cf_t r = 0;
+    for (uint32_t j = 0; j < SRSRAN_CHANNEL_FADING_NTERMS; j++) {
+      __real__ r += re[tap * SRSRAN_CHANNEL_FADING_NTERMS + j];
+      __imag__ r += im[tap * SRSRAN_CHANNEL_FADING_NTERMS + j];
+    }
+    gains[tap] = recN * r;
+  }
 }
 
 static inline void generate_tap(float delay_ns, float power_db, float srate, cf_t* buf, uint32_t N, uint32_t path_delay)
@@ -164,10 +167,13 @@ static inline void generate_tap(float delay_ns, float power_db, float srate, cf_
 
 static inline void generate_taps(srsran_channel_fading_t* q, float time)
 {
+  // Compute the doppler dispersion of all taps
+  cf_t gains[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  get_doppler_dispersion(q, time, gains);
+
   // Generate taps
   for (int i = 0; i < nof_taps[q->model]; i++) {
-    // Compute phase for the doppler dispersion
-    cf_t a = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
+    cf_t a = gains[i];
 
     if (i) {
       // Copy tap frequency response
@@ -237,11 +243,12 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
 
     // Initialise values for each tap
     for (uint32_t i = 0; i < nof_taps[q->model]; i++) {
-      // Random Jakes model Coeffients
+      // Random Jakes model Coeffients, the phases are in turns and the imaginary part is evaluated as a cosine
       for (uint32_t j = 0; (float)j < SRSRAN_CHANNEL_FADING_NTERMS; j++) {
-        q->coeff_a[i][j]     = srsran_random_uniform_real_dist(random, 0, 2.0f * (float)M_PI);
-        q->coeff_b[i][j]     = srsran_random_uniform_real_dist(random, 0, 2.0f * (float)M_PI);
+        q->coeff_a[i][j]     = srsran_random_uniform_real_dist(random, 0.0f, 1.0f);
+        q->coeff_b[i][j]     = srsran_random_uniform_real_dist(random, -0.25f, 0.75f);
         q->coeff_alpha[i][j] = ((float)M_PI * ((float)i - (float)0.5f)) / (2.0f * nof_taps[q->model]);
+        q->coeff_w[i][j]     = q->doppler * cosf(q->coeff_alpha[i][j]) / 2.0f;
       }
 
       // Allocate tap frequency response
@@ -252,11 +259,6 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
           excess_tap_delay_ns[q->model][i], relative_power_db[q->model][i], q->srate, q->h_tap[i], q->N, q->path_delay);
     }
 
-    // Generate sine Table
-    for (uint32_t i = 0; i < 1024; i++) {
-      q->sin_table[i] = sinf((float)i * 2.0f * (float)M_PI / 1024);
-    }
-
     // Free random
     srsran_random_free(random);
 
@@ -365,3 +367,21 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
   // Return time
   return init_time;
 }
+
+void srsran_channel_fading_gen_gains(srsran_channel_fading_t* const* q,
+                                     uint32_t                        nof_channels,
+                                     double                          time,
+                                     cf_t*                           gains)
+{
+  if (q == NULL || gains == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    cf_t* g = &gains[i * SRSRAN_CHANNEL_FADING_MAXTAPS];
+    srsran_vec_cf_zero(g, SRSRAN_CHANNEL_FADING_MAXTAPS);
+    if (q[i] != NULL) {
+      get_doppler_dispersion(q[i], (float)time, g);
+    }
+  }
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/phy/channel/channel.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <sys/time.h>
+
+static uint32_t    nof_channels = 2;
+static uint32_t    nof_threads  = 4;
+static uint32_t    duration_ms  = 100;
+static uint32_t    srate_hz     = (uint32_t)23.04e6;
+static std::string model        = "etu70";
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ctdsm]\n", prog);
+  printf("\t-c Number of channels: [Default %d]\n", nof_channels);
+  printf("\t-t Number of worker threads: [Default %d]\n", nof_threads);
+  printf("\t-d Simulation time in ms: [Default %d]\n", duration_ms);
+  printf("\t-s Sampling rate in Hz: [Default %d]\n", srate_hz);
+  printf("\t-m Fading model: [Default %s]\n", model.c_str());
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ctdsm")) != -1) {
+    switch (opt) {
+      case 'c':
+        nof_channels = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        duration_ms = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        srate_hz = (uint32_t)strtof(argv[optind], NULL);
+        break;
+      case 'm':
+        model = argv[optind];
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t run_channel(srsran::channel& ch, cf_t** in, cf_t** out, uint32_t sf_len, uint32_t sf_idx)
+{
+  struct timeval     t[3] = {};
+  srsran_timestamp_t ts   = {};
+  srsran_timestamp_init(&ts, 0, (double)sf_idx / 1000.0);
+
+  gettimeofday(&t[1], NULL);
+  ch.run(in, out, sf_len, ts);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  return (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  if (nof_channels == 0 || nof_channels > SRSRAN_MAX_CHANNELS) {
+    ERROR("Invalid number of channels %d", nof_channels);
+    return SRSRAN_ERROR;
+  }
+
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("CHAN", false);
+
+  // Every stage enabled
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.awgn_enable             = true;
+  args.awgn_snr_dB             = 20.0f;
+  args.fading_enable           = true;
+  args.fading_model            = model;
+  args.hst_enable              = true;
+  args.delay_enable            = true;
+  args.delay_period_s          = 0.1f;
+
+  srsran::channel serial(args, nof_channels, logger);
+  args.nof_threads = nof_threads;
+  srsran::channel parallel(args, nof_channels, logger);
+  serial.set_srate(srate_hz);
+  parallel.set_srate(srate_hz);
+
+  uint32_t        sf_len                             = srate_hz / 1000;
+  cf_t*           input[SRSRAN_MAX_CHANNELS]         = {};
+  cf_t*           output_serial[SRSRAN_MAX_CHANNELS] = {};
+  cf_t*           output[SRSRAN_MAX_CHANNELS]        = {};
+  srsran_random_t random                             = srsran_random_init(0x1234);
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    input[i]         = srsran_vec_cf_malloc(sf_len);
+    output_serial[i] = srsran_vec_cf_malloc(sf_len);
+    output[i]        = srsran_vec_cf_malloc(sf_len);
+    if (input[i] == nullptr || output_serial[i] == nullptr || output[i] == nullptr) {
+      goto clean_exit;
+    }
+  }
+
+  {
+    uint64_t serial_usec   = 0;
+    uint64_t parallel_usec = 0;
+    double   error_pwr     = 0.0;
+    double   signal_pwr    = 0.0;
+
+    // An empty block has nothing to process and leaves the channel state as it is
+    run_channel(serial, input, output_serial, 0, 0);
+    run_channel(parallel, input, output, 0, 0);
+
+    for (uint32_t sf_idx = 0; sf_idx < duration_ms; sf_idx++) {
+      for (uint32_t i = 0; i < nof_channels; i++) {
+        srsran_random_uniform_complex_dist_vector(random, input[i], sf_len, -1.0f, 1.0f);
+      }
+
+      serial_usec += run_channel(serial, input, output_serial, sf_len, sf_idx);
+      parallel_usec += run_channel(parallel, input, output, sf_len, sf_idx);
+
+      // Both modes must produce the same signal
+      for (uint32_t i = 0; i < nof_channels; i++) {
+        signal_pwr += srsran_vec_avg_power_cf(output_serial[i], sf_len);
+        srsran_vec_sub_ccc(output_serial[i], output[i], output[i], sf_len);
+        error_pwr += srsran_vec_avg_power_cf(output[i], sf_len);
+      }
+    }
+
+    float error_db = srsran_convert_power_to_dB((float)(error_pwr / signal_pwr));
+    printf("%d channels, %.2f MHz: serial %.1f Msps, %d threads %.1f Msps; error %+.1f dB\n",
+           nof_channels,
+           srate_hz / 1e6,
+           (double)nof_channels * sf_len * duration_ms / (double)SRSRAN_MAX(serial_usec, 1),
+           nof_threads,
+           (double)nof_channels * sf_len * duration_ms / (double)SRSRAN_MAX(parallel_usec, 1),
+           error_db);
+
+    if (error_db < -60.0f) {
+      ret = SRSRAN_SUCCESS;
+    }
+  }
+
+clean_exit:
+  srsran_random_free(random);
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (input[i]) {
+      free(input[i]);
+    }
+    if (output_serial[i]) {
+      free(output_serial[i]);
+    }
+    if (output[i]) {
+      free(output[i]);
+    }
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
@@ -164,6 +164,35 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  // Check the path gains against the sum-of-sinusoids model evaluated in double precision
+  for (uint32_t i = 0; i < duration_ms; i++) {
+    srsran_channel_fading_t* q = &channel_fading;
+    cf_t                     gains[SRSRAN_CHANNEL_FADING_MAXTAPS];
+    float                    time_s = (float)i / 1000.0f;
+    srsran_channel_fading_gen_gains(&q, 1, time_s, gains);
+    for (uint32_t tap = 0; tap < SRSRAN_CHANNEL_FADING_MAXTAPS; tap++) {
+      double complex expected = 0;
+      if (q->h_tap[tap] != NULL) {
+        for (uint32_t j = 0; j < SRSRAN_CHANNEL_FADING_NTERMS; j++) {
+          double x = (double)q->coeff_w[tap][j] * time_s;
+          expected += cos(2.0 * M_PI * (x + q->coeff_a[tap][j]));
+          expected += _Complex_I * cos(2.0 * M_PI * (x + q->coeff_b[tap][j]));
+        }
+        expected /= sqrt(SRSRAN_CHANNEL_FADING_NTERMS);
+      }
+      if (cabs(expected - gains[tap]) > 1e-4) {
+        fprintf(stderr,
+                "Error: tap %d gain %+.6f%+.6fi, expected %+.6f%+.6fi\n",
+                tap,
+                __real__ gains[tap],
+                __imag__ gains[tap],
+                creal(expected),
+                cimag(expected));
+        goto clean_exit;
+      }
+    }
+  }
+
   // Allocate buffers
   input_buffer = srsran_vec_cf_malloc(srate / 1000);
   if (!input_buffer) {
@@ -24,6 +24,8 @@
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
+#include <pthread.h>
+
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
 #endif /* LV_HAVE_SSE */
@@ -214,6 +216,41 @@ static void sequence_gen_LTE_pr(uint8_t* pr, uint32_t len, uint32_t seed)
   }
 }
 
+/**
+ * Bit reversal of every byte, converts LSB first sequence bits into the MSB first packed format
+ */
+static const uint8_t sequence_reverse_lut[256] = {
+    0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
+    0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
+    0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
+    0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
+    0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
+    0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
+    0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
+    0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
+    0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
+    0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
+    0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
+    0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
+    0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
+    0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
+    0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
+    0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
+    0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
+    0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
+    0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
+    0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
+    0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
+    0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
+    0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
+    0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
+    0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
+    0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
+    0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
+    0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
+    0b00111111, 0b10111111, 0b01111111, 0b11111111,
+};
+
 void srsran_sequence_state_init(srsran_sequence_state_t* s, uint32_t seed)
 {
   s->x1 = sequence_x1_init;
@@ -496,6 +533,266 @@ void srsran_sequence_free(srsran_sequence_t* q)
   bzero(q, sizeof(srsran_sequence_t));
 }
 
+#ifdef LV_HAVE_AVX2
+/*
+ * Packed sequence cache
+ * ---------------------
+ *
+ * The data channels scramble every transmission with a sequence that only depends on the RNTI, codeword, slot and
+ * cell, so the same seeds come back every frame. Long sequences are kept in a process-wide cache shared by all the
+ * workers, packed MSB first as srsran_bit_pack_vector() does, and applied from there with AVX2. A sequence is a prefix
+ * of any longer sequence with the same seed, so an entry serves any length up to the one it holds.
+ *
+ * The cache is SEQUENCE_CACHE_NOF_WAYS-way set associative, the set is selected by a hash of the seed and its least
+ * recently used entry is replaced. Entries are pinned while they are read and are filled outside the mutex while they
+ * are pinned but not ready. Callers finding the entry busy, or every entry of their set pinned, generate the sequence
+ * as if there was no cache.
+ */
+#define SEQUENCE_CACHE_NOF_SETS_LOG2 (8U)
+#define SEQUENCE_CACHE_NOF_SETS (1U << SEQUENCE_CACHE_NOF_SETS_LOG2)
+#define SEQUENCE_CACHE_NOF_WAYS (4U)
+
+/**
+ * Shorter sequences are generated faster than they are looked up
+ */
+#define SEQUENCE_CACHE_MIN_LEN (1024U)
+
+typedef struct {
+  uint32_t seed;
+  uint32_t len;      ///< Number of valid bits, 0 while the entry is empty or being filled
+  uint32_t max_len;  ///< Number of allocated bits
+  uint32_t refcount; ///< Number of readers, plus the writer while it is filled
+  uint64_t last_use;
+  uint8_t* c_bytes;
+} sequence_cache_entry_t;
+
+static sequence_cache_entry_t sequence_cache[SEQUENCE_CACHE_NOF_SETS][SEQUENCE_CACHE_NOF_WAYS] = {};
+static uint64_t               sequence_cache_clock                                             = 0;
+static pthread_mutex_t        sequence_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+__attribute__((destructor)) __attribute__((unused)) static void sequence_cache_free()
+{
+  for (uint32_t i = 0; i < SEQUENCE_CACHE_NOF_SETS; i++) {
+    for (uint32_t j = 0; j < SEQUENCE_CACHE_NOF_WAYS; j++) {
+      if (sequence_cache[i][j].c_bytes) {
+        free(sequence_cache[i][j].c_bytes);
+      }
+    }
+  }
+  bzero(sequence_cache, sizeof(sequence_cache));
+}
+
+static void sequence_gen_packed(uint8_t* c_bytes, uint32_t len, uint32_t seed)
+{
+  uint32_t x1     = sequence_x1_init;           // X1 initial state is fix
+  uint32_t x2     = sequence_get_x2_init(seed); // loads x2 initial state
+  uint64_t buffer = 0;
+  uint32_t count  = 0;
+
+  for (uint32_t i = 0; i < (len + 7) / 8; i++) {
+    // Generate sequence bits
+    while (count < 8) {
+      buffer = buffer | ((uint64_t)(SEQUENCE_MASK & (x1 ^ x2)) << count);
+
+      // Step sequences
+      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
+      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+
+      count += SEQUENCE_PAR_BITS;
+    }
+
+    c_bytes[i] = sequence_reverse_lut[buffer & 255UL];
+    buffer     = buffer >> 8UL;
+    count -= 8;
+  }
+}
+
+/**
+ * Looks up the packed sequence of a seed, generating it if it is not cached. The returned entry is pinned until it is
+ * released with sequence_cache_put().
+ * @return The pinned entry, NULL if the sequence is not worth caching or the cache is busy
+ */
+static sequence_cache_entry_t* sequence_cache_get(uint32_t seed, uint32_t len)
+{
+  if (len < SEQUENCE_CACHE_MIN_LEN) {
+    return NULL;
+  }
+
+  sequence_cache_entry_t* set = sequence_cache[(seed * 0x9E3779B1U) >> (32U - SEQUENCE_CACHE_NOF_SETS_LOG2)];
+  sequence_cache_entry_t* e   = NULL;
+
+  pthread_mutex_lock(&sequence_cache_mutex);
+
+  for (uint32_t i = 0; i < SEQUENCE_CACHE_NOF_WAYS && e == NULL; i++) {
+    if ((set[i].len > 0 || set[i].refcount > 0) && set[i].seed == seed) {
+      // Hit
+      if (set[i].len >= len) {
+        set[i].refcount++;
+        set[i].last_use = ++sequence_cache_clock;
+        pthread_mutex_unlock(&sequence_cache_mutex);
+        return &set[i];
+      }
+
+      // Too short, it can be regenerated only if nobody else uses it
+      if (set[i].refcount > 0) {
+        pthread_mutex_unlock(&sequence_cache_mutex);
+        return NULL;
+      }
+      e = &set[i];
+    }
+  }
+
+  // Miss, replace the least recently used entry. Empty entries are never used, so they go first
+  if (e == NULL) {
+    for (uint32_t i = 0; i < SEQUENCE_CACHE_NOF_WAYS; i++) {
+      if (set[i].refcount == 0 && (e == NULL || set[i].last_use < e->last_use)) {
+        e = &set[i];
+      }
+    }
+  }
+  if (e == NULL) {
+    pthread_mutex_unlock(&sequence_cache_mutex);
+    return NULL;
+  }
+
+  e->seed     = seed;
+  e->len      = 0;
+  e->refcount = 1;
+  e->last_use = ++sequence_cache_clock;
+
+  pthread_mutex_unlock(&sequence_cache_mutex);
+
+  // Fill the entry, nobody else touches it while its length is 0
+  if (e->max_len < len) {
+    if (e->c_bytes) {
+      free(e->c_bytes);
+    }
+    e->c_bytes = srsran_vec_u8_malloc((len + 7) / 8);
+    e->max_len = (e->c_bytes) ? len : 0;
+  }
+
+  if (e->c_bytes) {
+    sequence_gen_packed(e->c_bytes, len, seed);
+  }
+
+  pthread_mutex_lock(&sequence_cache_mutex);
+  if (e->c_bytes) {
+    e->len = len;
+  } else {
+    e->refcount = 0;
+    e           = NULL;
+  }
+  pthread_mutex_unlock(&sequence_cache_mutex);
+
+  return e;
+}
+
+static void sequence_cache_put(sequence_cache_entry_t* e)
+{
+  pthread_mutex_lock(&sequence_cache_mutex);
+  e->refcount--;
+  pthread_mutex_unlock(&sequence_cache_mutex);
+}
+
+/**
+ * Expands 32 packed sequence bits into 32 byte masks, 0xff for the bits set to 1
+ */
+static inline __m256i sequence_packed_mask_32(const uint8_t* c_bytes)
+{
+  uint32_t w;
+  memcpy(&w, c_bytes, sizeof(uint32_t));
+
+  // Broadcast each byte 8 times
+  __m256i mask = _mm256_shuffle_epi8(_mm256_set1_epi32((int)w),
+                                     _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                                      2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3));
+
+  // Select one bit of each byte, MSB first
+  const __m256i bit = _mm256_set1_epi64x(0x0102040810204080);
+  return _mm256_cmpeq_epi8(_mm256_and_si256(mask, bit), bit);
+}
+
+static inline uint32_t sequence_packed_bit(const uint8_t* c_bytes, uint32_t i)
+{
+  return (c_bytes[i / 8] >> (7U - i % 8U)) & 1U;
+}
+
+static void sequence_packed_apply_s(const uint8_t* c_bytes, const int16_t* in, int16_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+
+  for (; i + 32 <= length; i += 32) {
+    __m256i mask    = sequence_packed_mask_32(&c_bytes[i / 8]);
+    __m256i mask_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(mask));
+    __m256i mask_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(mask, 1));
+
+    // Negate where the mask is set, (x ^ -1) - (-1) = -x
+    __m256i v_lo = _mm256_loadu_si256((__m256i*)(in + i));
+    __m256i v_hi = _mm256_loadu_si256((__m256i*)(in + i + 16));
+    _mm256_storeu_si256((__m256i*)(out + i), _mm256_sub_epi16(_mm256_xor_si256(v_lo, mask_lo), mask_lo));
+    _mm256_storeu_si256((__m256i*)(out + i + 16), _mm256_sub_epi16(_mm256_xor_si256(v_hi, mask_hi), mask_hi));
+  }
+
+  for (; i < length; i++) {
+    out[i] = sequence_packed_bit(c_bytes, i) ? -in[i] : in[i];
+  }
+}
+
+static void sequence_packed_apply_c(const uint8_t* c_bytes, const int8_t* in, int8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+
+  for (; i + 32 <= length; i += 32) {
+    __m256i mask = sequence_packed_mask_32(&c_bytes[i / 8]);
+
+    // Negate where the mask is set, (x ^ -1) - (-1) = -x
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    _mm256_storeu_si256((__m256i*)(out + i), _mm256_sub_epi8(_mm256_xor_si256(v, mask), mask));
+  }
+
+  for (; i < length; i++) {
+    out[i] = sequence_packed_bit(c_bytes, i) ? -in[i] : in[i];
+  }
+}
+
+static void sequence_packed_apply_bit(const uint8_t* c_bytes, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+
+  for (; i + 32 <= length; i += 32) {
+    __m256i mask = _mm256_and_si256(sequence_packed_mask_32(&c_bytes[i / 8]), _mm256_set1_epi8(1));
+
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    _mm256_storeu_si256((__m256i*)(out + i), _mm256_xor_si256(v, mask));
+  }
+
+  for (; i < length; i++) {
+    out[i] = in[i] ^ sequence_packed_bit(c_bytes, i);
+  }
+}
+
+static void sequence_packed_apply_packed(const uint8_t* c_bytes, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+
+  for (; i + 32 <= length / 8; i += 32) {
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    __m256i c = _mm256_loadu_si256((__m256i*)(c_bytes + i));
+    _mm256_storeu_si256((__m256i*)(out + i), _mm256_xor_si256(v, c));
+  }
+
+  for (; i < length / 8; i++) {
+    out[i] = in[i] ^ c_bytes[i];
+  }
+
+  // Process spare bits, the cached sequence may be longer
+  uint32_t rem8 = length % 8;
+  if (rem8 != 0) {
+    out[i] = in[i] ^ (c_bytes[i] & (uint8_t)(0xffU << (8U - rem8)));
+  }
+}
+#endif // LV_HAVE_AVX2
+
 void srsran_sequence_apply_f(const float* in, float* out, uint32_t length, uint32_t seed)
 {
   srsran_sequence_state_t seq = {};
@@ -506,6 +803,15 @@ void srsran_sequence_apply_f(const float* in, float* out, uint32_t length, uint3
 
 void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, uint32_t seed)
 {
+#ifdef LV_HAVE_AVX2
+  sequence_cache_entry_t* e = sequence_cache_get(seed, length);
+  if (e != NULL) {
+    sequence_packed_apply_s(e->c_bytes, in, out, length);
+    sequence_cache_put(e);
+    return;
+  }
+#endif // LV_HAVE_AVX2
+
   const int16_t s[2] = {+1, -1};
   uint32_t      x1   = sequence_x1_init;           // X1 initial state is fix
   uint32_t      x2   = sequence_get_x2_init(seed); // loads x2 initial state
@@ -619,6 +925,15 @@ void srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in,
 
 void srsran_sequence_apply_c(const int8_t* in, int8_t* out, uint32_t length, uint32_t seed)
 {
+#ifdef LV_HAVE_AVX2
+  sequence_cache_entry_t* e = sequence_cache_get(seed, length);
+  if (e != NULL) {
+    sequence_packed_apply_c(e->c_bytes, in, out, length);
+    sequence_cache_put(e);
+    return;
+  }
+#endif // LV_HAVE_AVX2
+
   srsran_sequence_state_t sequence_state;
   srsran_sequence_state_init(&sequence_state, seed);
   srsran_sequence_state_apply_c(&sequence_state, in, out, length);
@@ -682,6 +997,15 @@ void srsran_sequence_state_apply_bit(srsran_sequence_state_t* s, const uint8_t*
 
 void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
 {
+#ifdef LV_HAVE_AVX2
+  sequence_cache_entry_t* e = sequence_cache_get(seed, length);
+  if (e != NULL) {
+    sequence_packed_apply_bit(e->c_bytes, in, out, length);
+    sequence_cache_put(e);
+    return;
+  }
+#endif // LV_HAVE_AVX2
+
   srsran_sequence_state_t sequence_state = {};
   srsran_sequence_state_init(&sequence_state, seed);
   srsran_sequence_state_apply_bit(&sequence_state, in, out, length);
@@ -689,41 +1013,18 @@ void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length,
 
 void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
 {
+#ifdef LV_HAVE_AVX2
+  sequence_cache_entry_t* e = sequence_cache_get(seed, length);
+  if (e != NULL) {
+    sequence_packed_apply_packed(e->c_bytes, in, out, length);
+    sequence_cache_put(e);
+    return;
+  }
+#endif // LV_HAVE_AVX2
+
   uint32_t x1 = sequence_x1_init;           // X1 initial state is fix
   uint32_t x2 = sequence_get_x2_init(seed); // loads x2 initial state
 
-  const uint8_t reverse_lut[256] = {
-      0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
-      0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
-      0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
-      0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
-      0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
-      0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
-      0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
-      0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
-      0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
-      0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
-      0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
-      0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
-      0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
-      0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
-      0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
-      0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
-      0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
-      0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
-      0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
-      0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
-      0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
-      0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
-      0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
-      0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
-      0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
-      0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
-      0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
-      0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
-      0b00111111, 0b10111111, 0b01111111, 0b11111111,
-  };
-
   uint32_t i = 0;
 #if SEQUENCE_PAR_BITS % 8 != 0
   uint64_t buffer = 0;
@@ -744,7 +1045,7 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
     }
 
     // Apply XOR
-    out[i] = in[i] ^ reverse_lut[buffer & 255UL];
+    out[i] = in[i] ^ sequence_reverse_lut[buffer & 255UL];
     buffer = buffer >> 8UL;
     count -= 8;
   }
@@ -765,14 +1066,14 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
       count += SEQUENCE_PAR_BITS;
     }
 
-    out[i] = in[i] ^ reverse_lut[buffer & ((1U << rem8) - 1U) & 255U];
+    out[i] = in[i] ^ sequence_reverse_lut[buffer & ((1U << rem8) - 1U) & 255U];
   }
 #else  // SEQUENCE_PAR_BITS % 8 == 0
   while (i < (length / 8 - (SEQUENCE_PAR_BITS - 1) / 8)) {
     uint32_t c = (uint32_t)(x1 ^ x2);
 
     for (uint32_t j = 0; j < SEQUENCE_PAR_BITS / 8; j++) {
-      out[i] = in[i] ^ reverse_lut[c & 255U];
+      out[i] = in[i] ^ sequence_reverse_lut[c & 255U];
       c      = c >> 8U;
       i++;
     }
@@ -785,7 +1086,7 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
   // Process spare bytes
   uint32_t c = (uint32_t)(x1 ^ x2);
   while (i < length / 8) {
-    out[i] = in[i] ^ reverse_lut[c & 255U];
+    out[i] = in[i] ^ sequence_reverse_lut[c & 255U];
     c      = c >> 8U;
     i++;
   }
@@ -793,7 +1094,7 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
   // Process spare bits
   uint32_t rem8 = length % 8;
   if (rem8 != 0) {
-    out[i] = in[i] ^ reverse_lut[c & ((1U << rem8) - 1U) & 255U];
+    out[i] = in[i] ^ sequence_reverse_lut[c & ((1U << rem8) - 1U) & 255U];
   }
 #endif // SEQUENCE_PAR_BITS % 8 == 0
 }
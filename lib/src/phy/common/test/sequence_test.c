@@ -192,6 +192,60 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * Applies sequences of growing and shrinking lengths with the same seeds, so they are served by the cache from prefixes
+ * of longer sequences and regenerated when they are too short, and compares them with the sequence state generator.
+ */
+static int test_sequence_cache(uint32_t seed, uint32_t length)
+{
+  const uint32_t lengths[] = {length, length / 2 + 1, length, 2 * length + 5, length + 3};
+
+  for (uint32_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+    uint32_t len = lengths[l];
+
+    srsran_sequence_state_t state = {};
+    srsran_sequence_state_init(&state, seed);
+    srsran_sequence_state_apply_bit(&state, ones_unpacked, c, len);
+    srsran_bit_pack_vector(c, c_packed_gold, len);
+
+    // 8 bit, twice to hit the cache
+    for (uint32_t r = 0; r < 2; r++) {
+      srsran_sequence_apply_c(ones_char, c_char, len, seed);
+      for (uint32_t i = 0; i < len; i++) {
+        if (c_char[i] != (c[i] ? -1 : +1)) {
+          ERROR("Unmatched cached c_char seed=%08x; len=%d; i=%d", seed, len, i);
+          return SRSRAN_ERROR;
+        }
+      }
+    }
+
+    // 16 bit
+    srsran_sequence_apply_s(ones_short, c_short, len, seed);
+    for (uint32_t i = 0; i < len; i++) {
+      if (c_short[i] != (c[i] ? -1 : +1)) {
+        ERROR("Unmatched cached c_short seed=%08x; len=%d; i=%d", seed, len, i);
+        return SRSRAN_ERROR;
+      }
+    }
+
+    // Unpacked bits
+    srsran_sequence_apply_bit(ones_unpacked, c_unpacked, len, seed);
+    if (memcmp(c, c_unpacked, len) != 0) {
+      ERROR("Unmatched cached c_unpacked seed=%08x; len=%d", seed, len);
+      return SRSRAN_ERROR;
+    }
+
+    // Packed bits, the bits past the end must be left untouched
+    srsran_sequence_apply_packed(ones_packed, c_packed, len, seed);
+    if (memcmp(c_packed_gold, c_packed, (len + 7) / 8) != 0) {
+      ERROR("Unmatched cached c_packed seed=%08x; len=%d", seed, len);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   uint32_t repetitions = 1;
@@ -233,6 +287,16 @@ int main(int argc, char** argv)
     test_sequence(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions);
   }
 
+  // Test the sequence cache with lengths around the caching threshold and the largest ones
+  for (uint32_t length = 700; length <= max_length / 4; length = (length * 3) / 2) {
+    uint32_t seed = (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX);
+    if (test_sequence_cache(seed, length) < SRSRAN_SUCCESS) {
+      srsran_sequence_free(&sequence);
+      srsran_random_free(random_gen);
+      return SRSRAN_ERROR;
+    }
+  }
+
   // Free sequence object
   srsran_sequence_free(&sequence);
   srsran_random_free(random_gen);
@@ -21,6 +21,7 @@
 
 #include "srsran/srsran.h"
 #include <complex.h>
+#include <fcntl.h>
 #include <fftw3.h>
 #include <math.h>
 #include <pwd.h>
@@ -53,56 +54,247 @@ static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 
 static pthread_mutex_t fft_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-// This function is called in the beggining of any executable where it is linked
-__attribute__((constructor)) static void srsran_dft_load()
+/* Process-wide plan cache. Every carrier and worker asks for the same few transforms (the symbol size in each
+ * direction plus the per-slot guru plans of the OFDM modulators), so identical requests share one FFTW plan which is
+ * then executed on each caller's own buffers through the new-array execute functions. FFTW only allows this when the
+ * buffers have the same alignment and in-place/out-of-place layout as the ones used for planning, so both are part of
+ * the key. The cache is protected by fft_mutex.
+ */
+typedef struct {
+  bool real;     // r2r plan?
+  int  sign;     // FFTW_FORWARD/FFTW_BACKWARD or r2r kind
+  int  size;     // DFT length
+  int  how_many; // Number of transforms, 0 for plain 1D plans
+  int  istride;
+  int  ostride;
+  int  idist;
+  int  odist;
+  int  in_align;
+  int  out_align;
+  bool in_place;
+} dft_plan_key_t;
+
+typedef struct dft_plan_cache_s {
+  dft_plan_key_t           key;
+  fftwf_plan               p;
+  uint32_t                 refcount;
+  struct dft_plan_cache_s* next;
+} dft_plan_cache_t;
+
+static dft_plan_cache_t* plan_cache = NULL;
+
+static void dft_plan_key_set(dft_plan_key_t* key, bool real, int sign, int size, void* in, void* out)
+{
+  bzero(key, sizeof(dft_plan_key_t));
+  key->real      = real;
+  key->sign      = sign;
+  key->size      = size;
+  key->in_align  = fftwf_alignment_of((float*)in);
+  key->out_align = fftwf_alignment_of((float*)out);
+  key->in_place  = (in == out);
+}
+
+// Must be called with fft_mutex locked
+static fftwf_plan dft_plan_cache_get(const dft_plan_key_t* key, void* in, void* out)
+{
+  for (dft_plan_cache_t* e = plan_cache; e != NULL; e = e->next) {
+    if (memcmp(&e->key, key, sizeof(dft_plan_key_t)) == 0) {
+      e->refcount++;
+      return e->p;
+    }
+  }
+
+  fftwf_plan p = NULL;
+  if (key->real) {
+    p = fftwf_plan_r2r_1d(key->size, in, out, key->sign, FFTW_TYPE);
+  } else if (key->how_many == 0) {
+    p = fftwf_plan_dft_1d(key->size, in, out, key->sign, FFTW_TYPE);
+  } else {
+    const fftwf_iodim iodim        = {key->size, key->istride, key->ostride};
+    const fftwf_iodim howmany_dims = {key->how_many, key->idist, key->odist};
+    p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in, out, key->sign, FFTW_TYPE);
+  }
+  if (!p) {
+    return NULL;
+  }
+
+  dft_plan_cache_t* e = calloc(1, sizeof(dft_plan_cache_t));
+  if (!e) {
+    fftwf_destroy_plan(p);
+    return NULL;
+  }
+  e->key      = *key;
+  e->p        = p;
+  e->refcount = 1;
+  e->next     = plan_cache;
+  plan_cache  = e;
+
+  return p;
+}
+
+// Must be called with fft_mutex locked
+static void dft_plan_cache_put(fftwf_plan p)
 {
+  if (!p) {
+    return;
+  }
+  for (dft_plan_cache_t** e = &plan_cache; *e != NULL; e = &(*e)->next) {
+    if ((*e)->p == p) {
+      if (--(*e)->refcount == 0) {
+        dft_plan_cache_t* tmp = *e;
+        *e                    = tmp->next;
+        fftwf_destroy_plan(tmp->p);
+        free(tmp);
+      }
+      return;
+    }
+  }
+  fftwf_destroy_plan(p);
+}
+
 #ifdef FFTW_WISDOM_FILE
+// Wisdom as last read from or written to the wisdom file, used for skipping exports that would not change it
+static char* wisdom_saved = NULL;
+
+/* Opens and locks the wisdom lock file, which serialises the wisdom file accesses of every process. The wisdom file
+ * itself is replaced on every export, so a lock taken on it would not be seen by a process opening the new one.
+ * Returns the locked file descriptor, or -1 on error.
+ */
+static int dft_wisdom_lock(void)
+{
+  char lock_path[280];
   char full_path[256];
   get_fftw_wisdom_file(full_path, sizeof(full_path));
-  // lockf needs a file descriptor open for writing, so this must be r+
-  FILE* fd = fopen(full_path, "r+");
-  if (fd == NULL) {
-    return;
+  snprintf(lock_path, sizeof(lock_path), "%s.lock", full_path);
+
+  // lockf needs a file descriptor open for writing
+  int fd = open(lock_path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    return -1;
   }
-  if (lockf(fileno(fd), F_LOCK, 0) == -1) {
+  if (lockf(fd, F_LOCK, 0) == -1) {
     perror("lockf()");
-    fclose(fd);
-    return;
+    close(fd);
+    return -1;
   }
-  fftwf_import_wisdom_from_file(fd);
-  if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
+  return fd;
+}
+
+static void dft_wisdom_unlock(int fd)
+{
+  if (lockf(fd, F_ULOCK, 0) == -1) {
     perror("u-lockf()");
-    fclose(fd);
+  }
+  close(fd);
+}
+#endif
+
+// This function is called in the beggining of any executable where it is linked
+__attribute__((constructor)) static void srsran_dft_load()
+{
+#ifdef FFTW_WISDOM_FILE
+  char full_path[256];
+  get_fftw_wisdom_file(full_path, sizeof(full_path));
+  int lock = dft_wisdom_lock();
+  if (lock < 0) {
     return;
   }
-  fclose(fd);
+  if (fftwf_import_wisdom_from_filename(full_path)) {
+    wisdom_saved = fftwf_export_wisdom_to_string();
+  }
+  dft_wisdom_unlock(lock);
 #else
   printf("Warning: FFTW Wisdom file not defined\n");
 #endif
 }
 
-// This function is called in the ending of any executable where it is linked
-__attribute__((destructor)) void srsran_dft_exit()
-{
 #ifdef FFTW_WISDOM_FILE
+/* Merges the wisdom file into the planner and writes the result back if it contains anything new. The wisdom is
+ * written to a temporary file which is then renamed over the wisdom file, so readers never see a partial file and a
+ * crash in the middle of the export does not lose the previous wisdom. The whole merge is done with the wisdom lock
+ * held, so concurrent processes do not drop each other's wisdom. Must be called with fft_mutex locked.
+ */
+static int dft_wisdom_export(void)
+{
   char full_path[256];
+  char tmp_path[280];
   get_fftw_wisdom_file(full_path, sizeof(full_path));
-  FILE* fd = fopen(full_path, "w");
+  snprintf(tmp_path, sizeof(tmp_path), "%s.%d", full_path, getpid());
+
+  int lock = dft_wisdom_lock();
+  if (lock < 0) {
+    return SRSRAN_ERROR;
+  }
+
+  // Keep what other processes may have learned since this one started
+  fftwf_import_wisdom_from_filename(full_path);
+
+  int   ret    = SRSRAN_ERROR;
+  FILE* fd     = NULL;
+  char* wisdom = fftwf_export_wisdom_to_string();
+  if (wisdom == NULL) {
+    goto clean_exit;
+  }
+  if (wisdom_saved != NULL && strcmp(wisdom, wisdom_saved) == 0) {
+    ret = SRSRAN_SUCCESS;
+    goto clean_exit;
+  }
+
+  fd = fopen(tmp_path, "w");
   if (fd == NULL) {
-    return;
+    goto clean_exit;
   }
-  if (lockf(fileno(fd), F_LOCK, 0) == -1) {
-    perror("lockf()");
-    fclose(fd);
-    return;
+  bool write_ok = fputs(wisdom, fd) >= 0;
+  write_ok      = (fclose(fd) == 0) && write_ok;
+  if (!write_ok || rename(tmp_path, full_path) != 0) {
+    perror("fftw wisdom export");
+    unlink(tmp_path);
+    goto clean_exit;
   }
-  fftwf_export_wisdom_to_file(fd);
-  if (lockf(fileno(fd), F_ULOCK, 0) == -1) {
-    perror("u-lockf()");
-    fclose(fd);
-    return;
+
+  // The saved wisdom takes ownership of the string
+  if (wisdom_saved != NULL) {
+    free(wisdom_saved);
+  }
+  wisdom_saved = wisdom;
+  wisdom       = NULL;
+  ret          = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (wisdom != NULL) {
+    free(wisdom);
+  }
+  dft_wisdom_unlock(lock);
+  return ret;
+}
+#endif
+
+int srsran_dft_wisdom_save(void)
+{
+  int ret = SRSRAN_SUCCESS;
+#ifdef FFTW_WISDOM_FILE
+  pthread_mutex_lock(&fft_mutex);
+  ret = dft_wisdom_export();
+  pthread_mutex_unlock(&fft_mutex);
+#endif
+  return ret;
+}
+
+// This function is called in the ending of any executable where it is linked
+__attribute__((destructor)) void srsran_dft_exit()
+{
+#ifdef FFTW_WISDOM_FILE
+  // This is also called from the emergency handlers, do not wait for a planner that might never release the lock
+  if (pthread_mutex_trylock(&fft_mutex) == 0) {
+    dft_wisdom_export();
+
+    // The planner wisdom is forgotten below, a later export compares against nothing and merges the file again
+    if (wisdom_saved != NULL) {
+      free(wisdom_saved);
+      wisdom_saved = NULL;
+    }
+    pthread_mutex_unlock(&fft_mutex);
   }
-  fclose(fd);
 #endif
   fftwf_cleanup();
 }
@@ -153,21 +345,28 @@ int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
 {
   int sign = (plan->forward) ? FFTW_FORWARD : FFTW_BACKWARD;
 
-  const fftwf_iodim iodim        = {new_dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
+  dft_plan_key_t key;
+  dft_plan_key_set(&key, false, sign, new_dft_points, in_buffer, out_buffer);
+  key.how_many = how_many;
+  key.istride  = istride;
+  key.ostride  = ostride;
+  key.idist    = idist;
+  key.odist    = odist;
 
   pthread_mutex_lock(&fft_mutex);
 
-  /* Destroy current plan */
-  fftwf_destroy_plan(plan->p);
+  /* Release current plan */
+  dft_plan_cache_put(plan->p);
 
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  plan->p = dft_plan_cache_get(&key, in_buffer, out_buffer);
 
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
     return -1;
   }
+  plan->in        = in_buffer;
+  plan->out       = out_buffer;
   plan->size      = new_dft_points;
   plan->init_size = plan->size;
 
@@ -183,12 +382,12 @@ int srsran_dft_replan_c(srsran_dft_plan_t* plan, const int new_dft_points)
     return 0;
   }
 
+  dft_plan_key_t key;
+  dft_plan_key_set(&key, false, sign, new_dft_points, plan->in, plan->out);
+
   pthread_mutex_lock(&fft_mutex);
-  if (plan->p) {
-    fftwf_destroy_plan(plan->p);
-    plan->p = NULL;
-  }
-  plan->p = fftwf_plan_dft_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  dft_plan_cache_put(plan->p);
+  plan->p = dft_plan_cache_get(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -211,18 +410,25 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
 {
   int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
 
-  const fftwf_iodim iodim        = {dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
+  dft_plan_key_t key;
+  dft_plan_key_set(&key, false, sign, dft_points, in_buffer, out_buffer);
+  key.how_many = how_many;
+  key.istride  = istride;
+  key.ostride  = ostride;
+  key.idist    = idist;
+  key.odist    = odist;
 
   pthread_mutex_lock(&fft_mutex);
-
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  plan->p = dft_plan_cache_get(&key, in_buffer, out_buffer);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
     return -1;
   }
 
+  plan->in        = in_buffer;
+  plan->out       = out_buffer;
+
   plan->size      = dft_points;
   plan->init_size = plan->size;
   plan->mode      = SRSRAN_DFT_COMPLEX;
@@ -241,11 +447,12 @@ int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
 {
   allocate(plan, sizeof(fftwf_complex), sizeof(fftwf_complex), dft_points);
 
-  pthread_mutex_lock(&fft_mutex);
-
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-  plan->p  = fftwf_plan_dft_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  int            sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+  dft_plan_key_t key;
+  dft_plan_key_set(&key, false, sign, dft_points, plan->in, plan->out);
 
+  pthread_mutex_lock(&fft_mutex);
+  plan->p = dft_plan_cache_get(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -269,12 +476,12 @@ int srsran_dft_replan_r(srsran_dft_plan_t* plan, const int new_dft_points)
 {
   int sign = (plan->dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
+  dft_plan_key_t key;
+  dft_plan_key_set(&key, true, sign, new_dft_points, plan->in, plan->out);
+
   pthread_mutex_lock(&fft_mutex);
-  if (plan->p) {
-    fftwf_destroy_plan(plan->p);
-    plan->p = NULL;
-  }
-  plan->p = fftwf_plan_r2r_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  dft_plan_cache_put(plan->p);
+  plan->p = dft_plan_cache_get(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -289,8 +496,11 @@ int srsran_dft_plan_r(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
   allocate(plan, sizeof(float), sizeof(float), dft_points);
   int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
 
+  dft_plan_key_t key;
+  dft_plan_key_set(&key, true, sign, dft_points, plan->in, plan->out);
+
   pthread_mutex_lock(&fft_mutex);
-  plan->p = fftwf_plan_r2r_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
+  plan->p = dft_plan_cache_get(&key, plan->in, plan->out);
   pthread_mutex_unlock(&fft_mutex);
 
   if (!plan->p) {
@@ -372,7 +582,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
   fftwf_complex* f_out = plan->out;
 
   copy_pre((uint8_t*)plan->in, (uint8_t*)in, sizeof(cf_t), plan->size, plan->forward, plan->mirror, plan->dc);
-  fftwf_execute(plan->p);
+  fftwf_execute_dft(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / sqrtf(plan->size);
     srsran_vec_sc_prod_cfc(f_out, norm, f_out, plan->size);
@@ -388,7 +598,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
 void srsran_dft_run_guru_c(srsran_dft_plan_t* plan)
 {
   if (plan->is_guru == true) {
-    fftwf_execute(plan->p);
+    fftwf_execute_dft(plan->p, plan->in, plan->out);
   } else {
     ERROR("srsran_dft_run_guru_c: the selected plan is not guru!");
   }
@@ -402,7 +612,7 @@ void srsran_dft_run_r(srsran_dft_plan_t* plan, const float* in, float* out)
   float* f_out = plan->out;
 
   memcpy(plan->in, in, sizeof(float) * plan->size);
-  fftwf_execute(plan->p);
+  fftwf_execute_r2r(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / plan->size;
     srsran_vec_sc_prod_fff(f_out, norm, f_out, plan->size);
@@ -429,8 +639,7 @@ void srsran_dft_plan_free(srsran_dft_plan_t* plan)
     if (plan->out)
       fftwf_free(plan->out);
   }
-  if (plan->p)
-    fftwf_destroy_plan(plan->p);
+  dft_plan_cache_put(plan->p);
   pthread_mutex_unlock(&fft_mutex);
   bzero(plan, sizeof(srsran_dft_plan_t));
 }
@@ -36,6 +36,7 @@ static float       rx_window_offset      = 0.5f;
 static float       freq_shift_f          = 0.0f;
 static double      phase_compensation_hz = 0.0;
 static uint32_t    force_symbol_sz       = 0;
+static uint32_t    nof_rx                = 1;
 static double      elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
   if (ts_end->tv_usec > ts_start->tv_usec) {
@@ -57,12 +58,13 @@ static void usage(char* prog)
   printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
   printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
   printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-m Number of receivers sharing the same DFT plans [Default %d]\n", nof_rx);
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "Nnerosp")) != -1) {
+  while ((opt = getopt(argc, argv, "Nnerospm")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -85,6 +87,9 @@ static void parse_args(int argc, char** argv)
       case 'p':
         phase_compensation_hz = strtod(argv[optind], NULL);
         break;
+      case 'm':
+        nof_rx = SRSRAN_MIN(SRSRAN_MAX_PORTS, SRSRAN_MAX(1, (uint32_t)strtol(argv[optind], NULL, 10)));
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -96,8 +101,8 @@ int main(int argc, char** argv)
 {
   srsran_random_t random_gen = srsran_random_init(0);
   struct timeval  start, end;
-  srsran_ofdm_t   fft = {}, ifft = {};
-  cf_t *          input, *outfft, *outifft;
+  srsran_ofdm_t   fft[SRSRAN_MAX_PORTS] = {}, ifft = {};
+  cf_t *          input, *outfft[SRSRAN_MAX_PORTS] = {}, *outifft;
   float           mse;
   uint32_t        n_prb, max_prb;
 
@@ -119,12 +124,18 @@ int main(int argc, char** argv)
     fflush(stdout);
 
     input   = srsran_vec_cf_malloc(n_re);
-    outfft  = srsran_vec_cf_malloc(n_re);
     outifft = srsran_vec_cf_malloc(sf_len);
-    if (!input || !outfft || !outifft) {
+    if (!input || !outifft) {
       perror("malloc");
       exit(-1);
     }
+    for (uint32_t j = 0; j < nof_rx; j++) {
+      outfft[j] = srsran_vec_cf_malloc(n_re);
+      if (!outfft[j]) {
+        perror("malloc");
+        exit(-1);
+      }
+    }
     srsran_vec_cf_zero(outifft, sf_len);
 
     srsran_ofdm_cfg_t ofdm_cfg     = {};
@@ -142,12 +153,14 @@ int main(int argc, char** argv)
     }
 
     ofdm_cfg.in_buffer        = outifft;
-    ofdm_cfg.out_buffer       = outfft;
     ofdm_cfg.rx_window_offset = rx_window_offset;
     ofdm_cfg.freq_shift_f     = -freq_shift_f;
-    if (srsran_ofdm_rx_init_cfg(&fft, &ofdm_cfg)) {
-      ERROR("Error initializing FFT");
-      exit(-1);
+    for (uint32_t j = 0; j < nof_rx; j++) {
+      ofdm_cfg.out_buffer = outfft[j];
+      if (srsran_ofdm_rx_init_cfg(&fft[j], &ofdm_cfg)) {
+        ERROR("Error initializing FFT");
+        exit(-1);
+      }
     }
 
     if (isnormal(freq_shift_f)) {
@@ -168,27 +181,34 @@ int main(int argc, char** argv)
     // Execute Rx
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
-      srsran_ofdm_rx_sf(&fft);
+      for (uint32_t j = 0; j < nof_rx; j++) {
+        srsran_ofdm_rx_sf(&fft[j]);
+      }
     }
     gettimeofday(&end, NULL);
-    printf(" Rx@%.1fMsps", (double)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
+    printf(" Rx@%.1fMsps", (double)(sf_len * nof_repetitions * nof_rx) / elapsed_us(&start, &end));
 
-    // compute Mean Square Error
-    srsran_vec_sub_ccc(input, outfft, outfft, n_re);
-    mse = sqrtf(srsran_vec_avg_power_cf(outfft, n_re));
+    // compute Mean Square Error, every receiver must recover the input
+    for (uint32_t j = 0; j < nof_rx; j++) {
+      srsran_vec_sub_ccc(input, outfft[j], outfft[j], n_re);
+      mse = sqrtf(srsran_vec_avg_power_cf(outfft[j], n_re));
 
-    printf(" MSE=%.6f\n", mse);
+      printf(" MSE=%.6f", mse);
 
-    if (mse >= 0.0001) {
-      printf("MSE too large\n");
-      exit(-1);
+      if (mse >= 0.0001) {
+        printf("\nMSE too large\n");
+        exit(-1);
+      }
     }
+    printf("\n");
 
-    srsran_ofdm_rx_free(&fft);
+    for (uint32_t j = 0; j < nof_rx; j++) {
+      srsran_ofdm_rx_free(&fft[j]);
+      free(outfft[j]);
+    }
     srsran_ofdm_tx_free(&ifft);
 
     free(input);
-    free(outfft);
     free(outifft);
 
     n_prb++;
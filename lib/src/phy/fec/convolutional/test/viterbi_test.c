@@ -109,11 +109,16 @@ int main(int argc, char** argv)
   uint8_t * data_tx, *data_rx, *symbols;
   float     var[SNR_POINTS], varunc[SNR_POINTS];
   int       snr_points;
-  int       errors_s   = 0;
-  int       errors_us  = 0;
-  int       errors_c   = 0;
-  int       errors_f   = 0;
-  int       errors_sse = 0;
+  int       errors_s         = 0;
+  int       errors_us        = 0;
+  int       errors_c         = 0;
+  int       errors_f         = 0;
+  int       errors_sse       = 0;
+  int       mismatches_batch = 0;
+  uint32_t  nof_batch        = 0;
+  float*    llr_batch[SRSRAN_VITERBI_BATCH_LANES];
+  uint8_t*  data_f_batch[SRSRAN_VITERBI_BATCH_LANES];
+  uint8_t*  data_rx_batch[SRSRAN_VITERBI_BATCH_LANES];
 #ifdef TEST_SSE
   srsran_viterbi_t dec_sse;
 #endif
@@ -186,6 +191,16 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  for (uint32_t i = 0; i < SRSRAN_VITERBI_BATCH_LANES; i++) {
+    llr_batch[i]     = srsran_vec_f_malloc(coded_length);
+    data_f_batch[i]  = srsran_vec_u8_malloc(frame_length);
+    data_rx_batch[i] = srsran_vec_u8_malloc(frame_length);
+    if (!llr_batch[i] || !data_f_batch[i] || !data_rx_batch[i]) {
+      perror("malloc");
+      exit(-1);
+    }
+  }
+
   float ebno_inc, esno_db;
   ebno_inc = (SNR_MAX - SNR_MIN) / SNR_POINTS;
   if (ebno_db == 100.0) {
@@ -241,6 +256,20 @@ int main(int argc, char** argv)
       VITERBI_TEST(srsran_viterbi_decode_us, dec, llr_us, errors_us);
       VITERBI_TEST(srsran_viterbi_decode_uc, dec, llr_c, errors_c);
       VITERBI_TEST(srsran_viterbi_decode_f, dec, llr, errors_f);
+
+      /* The batch decoder must give exactly the same bits as the float decoder */
+      memcpy(llr_batch[nof_batch], llr, sizeof(float) * coded_length);
+      memcpy(data_f_batch[nof_batch], data_rx, sizeof(uint8_t) * frame_length);
+      nof_batch++;
+      if (nof_batch == SRSRAN_VITERBI_BATCH_LANES || frame_cnt + 1 == nof_frames) {
+        if (srsran_viterbi_decode_batch(&dec, llr_batch, data_rx_batch, nof_batch, frame_length) < SRSRAN_SUCCESS) {
+          mismatches_batch = -1;
+        }
+        for (uint32_t j = 0; j < nof_batch && mismatches_batch >= 0; j++) {
+          mismatches_batch += srsran_bit_diff(data_f_batch[j], data_rx_batch[j], frame_length);
+        }
+        nof_batch = 0;
+      }
 #ifdef TEST_SSE
       VITERBI_TEST(srsran_viterbi_decode_uc, dec_sse, llr_c, errors_sse);
 #endif
@@ -287,6 +316,16 @@ int main(int argc, char** argv)
   free(llr_s);
   free(llr_us);
   free(data_rx);
+  for (uint32_t i = 0; i < SRSRAN_VITERBI_BATCH_LANES; i++) {
+    free(llr_batch[i]);
+    free(data_f_batch[i]);
+    free(data_rx_batch[i]);
+  }
+
+  if (mismatches_batch != 0) {
+    ERROR("Batch decoder differs from the float decoder in %d bits", mismatches_batch);
+    exit(-1);
+  }
 
   if (snr_points == 1) {
     int expected_e = get_expected_errors(nof_frames, seed, frame_length, tail_biting, ebno_db);
@@ -47,6 +47,17 @@
 
 //#undef LV_HAVE_SSE
 
+/* Maximum absolute value of the symbols, used for scaling them before quantization */
+static float viterbi_max_abs(float* symbols, uint32_t len)
+{
+  float    max   = 1e-9;
+  uint32_t max_i = srsran_vec_max_abs_fi(symbols, len);
+  if (max_i < len && isnormal(symbols[max_i])) {
+    max = fabsf(symbols[max_i]);
+  }
+  return max;
+}
+
 int decode37(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
 {
   srsran_viterbi_t* q = o;
@@ -173,6 +184,47 @@ void free37_avx2_16bit(void* o)
     free(q->tmp_s);
   }
   delete_viterbi37_avx2_16bit(q->ptr);
+  delete_viterbi37_avx2_batch(q->ptr_batch);
+}
+
+int decode37_avx2_16bit_batch(void* o, float** symbols, uint8_t** data, uint32_t nof_cw, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  uint32_t best_state[SRSRAN_VITERBI_BATCH_LANES] = {};
+
+  uint32_t len = q->tail_biting ? 3 * frame_length : 3 * (frame_length + q->K - 1);
+
+  for (uint32_t i = 0; i < nof_cw; i += SRSRAN_VITERBI_BATCH_LANES) {
+    uint32_t nof_lanes = SRSRAN_MIN(nof_cw - i, SRSRAN_VITERBI_BATCH_LANES);
+
+    /* Quantize every codeword as srsran_viterbi_decode_f() does and load it in its lane */
+    for (uint32_t l = 0; l < nof_lanes; l++) {
+      float max = viterbi_max_abs(symbols[i + l], len);
+      srsran_vec_quant_fus(symbols[i + l], q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
+      load_viterbi37_avx2_batch(q->ptr_batch, l, q->symbols_us, len);
+    }
+
+    /* Initialize Viterbi decoder */
+    init_viterbi37_avx2_batch(q->ptr_batch, q->tail_biting ? -1 : 0);
+
+    /* Decode block */
+    if (q->tail_biting) {
+      update_viterbi37_blk_avx2_batch(q->ptr_batch, frame_length, TB_ITER * frame_length, best_state);
+      chainback_viterbi37_avx2_batch(q->ptr_batch,
+                                     &data[i],
+                                     nof_lanes,
+                                     TB_ITER * frame_length,
+                                     ((int)(TB_ITER / 2)) * frame_length,
+                                     frame_length,
+                                     best_state);
+    } else {
+      update_viterbi37_blk_avx2_batch(q->ptr_batch, frame_length + q->K - 1, frame_length + q->K - 1, NULL);
+      chainback_viterbi37_avx2_batch(q->ptr_batch, &data[i], nof_lanes, frame_length, 0, frame_length, best_state);
+    }
+  }
+
+  return q->framebits;
 }
 
 int decode37_avx2(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
@@ -464,9 +516,14 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
     ERROR("create_viterbi37 failed");
     free37(q);
     return -1;
-  } else {
-    return 0;
   }
+  if ((q->ptr_batch = create_viterbi37_avx2_batch(poly, TB_ITER * framebits, 3 * (q->framebits + q->K - 1))) == NULL) {
+    ERROR("create_viterbi37_avx2_batch failed");
+    free37_avx2_16bit(q);
+    return -1;
+  }
+  q->decode_batch = decode37_avx2_16bit_batch;
+  return 0;
 }
 
 #endif
@@ -558,11 +615,7 @@ int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data,
     len = 3 * (frame_length + q->K - 1);
   }
   if (!q->decode_f) {
-    float    max   = 1e-9;
-    uint32_t max_i = srsran_vec_max_abs_fi(symbols, len);
-    if (max_i < len && isnormal(symbols[max_i])) {
-      max = fabsf(symbols[max_i]);
-    }
+    float max = viterbi_max_abs(symbols, len);
 #ifdef VITERBI_16
     srsran_vec_quant_fus(symbols, q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
     return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
@@ -575,6 +628,31 @@ int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data,
   }
 }
 
+int srsran_viterbi_decode_batch(srsran_viterbi_t* q,
+                                float*            symbols[],
+                                uint8_t*          data[],
+                                uint32_t          nof_cw,
+                                uint32_t          frame_length)
+{
+  if (q == NULL || symbols == NULL || data == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return -1;
+  }
+  if (q->decode_batch) {
+    return q->decode_batch(q, symbols, data, nof_cw, frame_length);
+  }
+
+  /* No lane-parallel decoder, decode one codeword at a time */
+  int ret = q->framebits;
+  for (uint32_t i = 0; i < nof_cw && ret >= 0; i++) {
+    ret = srsran_viterbi_decode_f(q, symbols[i], data[i], frame_length);
+  }
+  return ret;
+}
+
 /* symbols are int16 */
 int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -82,4 +82,22 @@ void delete_viterbi37_avx2_16bit(void* p);
 
 int update_viterbi37_blk_avx2_16bit(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state);
 
+void* create_viterbi37_avx2_batch(int polys[3], uint32_t len, uint32_t syms_len);
+
+void delete_viterbi37_avx2_batch(void* p);
+
+int load_viterbi37_avx2_batch(void* p, uint32_t lane, const uint16_t* syms, uint32_t nof_syms);
+
+int init_viterbi37_avx2_batch(void* p, int starting_state);
+
+int update_viterbi37_blk_avx2_batch(void* p, uint32_t period, uint32_t nbits, uint32_t* best_state);
+
+int chainback_viterbi37_avx2_batch(void*           p,
+                                   uint8_t*        data[],
+                                   uint32_t        nof_lanes,
+                                   uint32_t        nbits,
+                                   uint32_t        offset,
+                                   uint32_t        nof_bits,
+                                   const uint32_t* endstate);
+
 #endif /* SRSRAN_VITERBI37_H_ */
@@ -0,0 +1,266 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Lane-parallel r=1/3 k=7 Viterbi decoder for AVX2.
+ *
+ * Instead of spreading the 64 trellis states of one codeword across the vector, as viterbi37_avx2_16bit.c does, every
+ * 16-bit lane runs its own decoder over a different codeword of the same length. All the codewords share the same
+ * trellis, so the butterflies need no shuffling, and the branch metrics of each step take only 8 vector operations.
+ * The metric arithmetic is the same as in viterbi37_avx2_16bit.c, so each lane decodes exactly the same bits as the
+ * single codeword decoder.
+ */
+
+#include "parity.h"
+#include "srsran/phy/fec/convolutional/viterbi.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#ifdef LV_HAVE_AVX2
+
+#include <immintrin.h>
+
+#define NOF_LANES SRSRAN_VITERBI_BATCH_LANES
+
+/* Words of decisions per step: one bit for each state and lane, two states per butterfly and word */
+#define DECISION_WORDS 32
+
+/* State info for instance of lane-parallel Viterbi decoder */
+struct v37_batch {
+  __m256i   metrics1[64]; /* path metric buffer 1, one vector per state */
+  __m256i   metrics2[64]; /* path metric buffer 2 */
+  uint8_t   branch[32];   /* encoder output bits of every butterfly */
+  uint16_t* syms;         /* received symbols, interleaved by lane */
+  uint32_t  syms_len;     /* maximum number of symbols per lane */
+  uint32_t* decisions;    /* DECISION_WORDS words per step */
+  uint32_t  len;          /* maximum number of steps */
+};
+
+/* Create a new instance of a lane-parallel Viterbi decoder */
+void* create_viterbi37_avx2_batch(int polys[3], uint32_t len, uint32_t syms_len)
+{
+  struct v37_batch* vp = NULL;
+
+  if (posix_memalign((void**)&vp, sizeof(__m256i), sizeof(struct v37_batch))) {
+    return NULL;
+  }
+  bzero(vp, sizeof(struct v37_batch));
+
+  for (uint32_t state = 0; state < 32; state++) {
+    for (uint32_t j = 0; j < 3; j++) {
+      uint32_t bit = (polys[j] < 0) ^ parity((2 * state) & polys[j]);
+      vp->branch[state] |= bit << j;
+    }
+  }
+
+  /* 6 extra steps are read by the chainback past the last decoded bit */
+  vp->len = len + 6;
+  if (posix_memalign((void**)&vp->decisions, sizeof(__m256i), vp->len * DECISION_WORDS * sizeof(uint32_t))) {
+    free(vp);
+    return NULL;
+  }
+  bzero(vp->decisions, vp->len * DECISION_WORDS * sizeof(uint32_t));
+
+  vp->syms_len = syms_len;
+  if (posix_memalign((void**)&vp->syms, sizeof(__m256i), syms_len * NOF_LANES * sizeof(uint16_t))) {
+    free(vp->decisions);
+    free(vp);
+    return NULL;
+  }
+  bzero(vp->syms, syms_len * NOF_LANES * sizeof(uint16_t));
+
+  return vp;
+}
+
+/* Delete instance of a lane-parallel Viterbi decoder */
+void delete_viterbi37_avx2_batch(void* p)
+{
+  struct v37_batch* vp = p;
+
+  if (vp != NULL) {
+    free(vp->syms);
+    free(vp->decisions);
+    free(vp);
+  }
+}
+
+/* Loads the symbols of one codeword into a lane */
+int load_viterbi37_avx2_batch(void* p, uint32_t lane, const uint16_t* syms, uint32_t nof_syms)
+{
+  struct v37_batch* vp = p;
+
+  if (vp == NULL || lane >= NOF_LANES || nof_syms > vp->syms_len) {
+    return -1;
+  }
+
+  for (uint32_t i = 0; i < nof_syms; i++) {
+    vp->syms[i * NOF_LANES + lane] = syms[i];
+  }
+
+  return 0;
+}
+
+/* Initialize all the lanes for start of new frames */
+int init_viterbi37_avx2_batch(void* p, int starting_state)
+{
+  struct v37_batch* vp = p;
+
+  if (vp == NULL) {
+    return -1;
+  }
+
+  /* init_viterbi37_avx2_16bit() clears the metrics after setting them, so all the states start from 0 and the start
+   * state is not biased. Do the same, otherwise the lanes would not match the single codeword decoder. */
+  (void)starting_state;
+  for (uint32_t i = 0; i < 64; i++) {
+    vp->metrics1[i] = _mm256_setzero_si256();
+  }
+
+  return 0;
+}
+
+/* Runs nbits trellis steps on all the lanes. The symbols are read cyclically every period steps, which decodes
+ * tail-biting codewords without replicating their symbols. */
+int update_viterbi37_blk_avx2_batch(void* p, uint32_t period, uint32_t nbits, uint32_t best_state[NOF_LANES])
+{
+  struct v37_batch* vp = p;
+
+  if (vp == NULL || nbits + 6 > vp->len || 3 * period > vp->syms_len) {
+    return -1;
+  }
+
+  __m256i*  old_metrics = vp->metrics1;
+  __m256i*  new_metrics = vp->metrics2;
+  uint32_t* d           = vp->decisions;
+
+  const __m256i ones  = _mm256_set1_epi16(-1);
+  const __m256i zeros = _mm256_setzero_si256();
+  const __m256i max   = _mm256_set1_epi16(8191);
+
+  for (uint32_t s = 0, t = 0; s < nbits; s++) {
+    const uint16_t* syms  = &vp->syms[3 * t * NOF_LANES];
+    __m256i         sym0v = _mm256_load_si256((__m256i*)&syms[0]);
+    __m256i         sym1v = _mm256_load_si256((__m256i*)&syms[NOF_LANES]);
+    __m256i         sym2v = _mm256_load_si256((__m256i*)&syms[2 * NOF_LANES]);
+    if (++t == period) {
+      t = 0;
+    }
+
+    /* Form the branch metrics of the 8 possible encoder outputs */
+    __m256i metric[8], m_metric[8];
+    for (uint32_t c = 0; c < 8; c++) {
+      __m256i m0 = _mm256_avg_epu16(_mm256_xor_si256((c & 1) ? ones : zeros, sym0v),
+                                    _mm256_xor_si256((c & 2) ? ones : zeros, sym1v));
+      metric[c]   = _mm256_avg_epu16(_mm256_xor_si256((c & 4) ? ones : zeros, sym2v), m0);
+      metric[c]   = _mm256_srli_epi16(metric[c], 3);
+      m_metric[c] = _mm256_sub_epi16(max, metric[c]);
+    }
+
+    for (uint32_t i = 0; i < 32; i++) {
+      uint32_t c = vp->branch[i];
+
+      /* Add branch metrics to path metrics */
+      __m256i m0 = _mm256_add_epi16(old_metrics[i], metric[c]);
+      __m256i m3 = _mm256_add_epi16(old_metrics[32 + i], metric[c]);
+      __m256i m1 = _mm256_add_epi16(old_metrics[32 + i], m_metric[c]);
+      __m256i m2 = _mm256_add_epi16(old_metrics[i], m_metric[c]);
+
+      /* Compare and select, using modulo arithmetic */
+      __m256i decision0 = _mm256_cmpgt_epi16(_mm256_sub_epi16(m0, m1), zeros);
+      __m256i decision1 = _mm256_cmpgt_epi16(_mm256_sub_epi16(m2, m3), zeros);
+
+      new_metrics[2 * i]     = _mm256_blendv_epi8(m0, m1, decision0);
+      new_metrics[2 * i + 1] = _mm256_blendv_epi8(m2, m3, decision1);
+
+      /* Bits 0-7: state 2i lanes 0-7, 8-15: state 2i+1 lanes 0-7, 16-23: state 2i lanes 8-15, 24-31: state 2i+1
+       * lanes 8-15 */
+      d[i] = (uint32_t)_mm256_movemask_epi8(_mm256_packs_epi16(decision0, decision1));
+    }
+
+    /* Metrics are compared with modulo arithmetic and are left to wrap around, as the single codeword decoder does */
+    d += DECISION_WORDS;
+
+    __m256i* tmp = old_metrics;
+    old_metrics  = new_metrics;
+    new_metrics  = tmp;
+  }
+
+  /* The chainback looks 6 steps past the last one */
+  bzero(d, 6 * DECISION_WORDS * sizeof(uint32_t));
+
+  if (best_state) {
+    /* Last state with the minimum metric, in every lane */
+    __m256i minv  = _mm256_set1_epi16(-1);
+    __m256i bestv = zeros;
+    for (uint32_t i = 0; i < 64; i++) {
+      __m256i le = _mm256_cmpeq_epi16(_mm256_min_epu16(old_metrics[i], minv), old_metrics[i]);
+      minv       = _mm256_min_epu16(old_metrics[i], minv);
+      bestv      = _mm256_blendv_epi8(bestv, _mm256_set1_epi16(i), le);
+    }
+
+    uint16_t best[NOF_LANES];
+    _mm256_storeu_si256((__m256i*)best, bestv);
+    for (uint32_t l = 0; l < NOF_LANES; l++) {
+      best_state[l] = best[l];
+    }
+  }
+
+  return 0;
+}
+
+/* Viterbi chainback of the first nof_lanes lanes over nbits steps. Only the bits from offset to offset + nof_bits are
+ * stored in data. */
+int chainback_viterbi37_avx2_batch(void*          p,
+                                   uint8_t*       data[],
+                                   uint32_t       nof_lanes,
+                                   uint32_t       nbits,
+                                   uint32_t       offset,
+                                   uint32_t       nof_bits,
+                                   const uint32_t endstate[NOF_LANES])
+{
+  struct v37_batch* vp = p;
+
+  if (vp == NULL || nof_lanes > NOF_LANES || nbits + 6 > vp->len) {
+    return -1;
+  }
+
+  const uint32_t* d = &vp->decisions[6 * DECISION_WORDS]; /* Look past tail */
+
+  for (uint32_t l = 0; l < nof_lanes; l++) {
+    uint32_t lane_shift = (l % 8) + 16 * (l / 8);
+    uint32_t state      = (endstate[l] % 64) << 2;
+
+    for (uint32_t n = nbits; n-- > offset;) {
+      uint32_t s = state >> 2;
+      uint32_t k = (d[n * DECISION_WORDS + s / 2] >> (lane_shift + 8 * (s % 2))) & 1;
+      state      = (state >> 1) | (k << 7);
+      if (n < offset + nof_bits) {
+        data[l][n - offset] = k;
+      }
+    }
+  }
+
+  return 0;
+}
+
+#endif
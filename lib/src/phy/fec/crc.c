@@ -22,6 +22,8 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include <pthread.h>
+#include <stdlib.h>
 
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
@@ -47,19 +49,233 @@ static void gen_crc_table(srsran_crc_t* h)
   }
 }
 
-uint64_t reversecrcbit(uint32_t crc, int nbits, srsran_crc_t* h)
+// Maximum number of different generator polynomials with slice-by-8 tables
+#define CRC_TABLE8_MAX_POLY 16
+
+typedef struct {
+  uint32_t polynom;
+  uint32_t order;
+  uint32_t table8[8][256];
+} crc_table8_t;
+
+// The tables only depend on the generator, they are computed once and kept for the lifetime of the process
+static crc_table8_t*   crc_table8_cache[CRC_TABLE8_MAX_POLY];
+static uint32_t        crc_table8_count = 0;
+static pthread_mutex_t crc_table8_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void gen_crc_table8(crc_table8_t* t)
+{
+  uint32_t shift   = 32U - t->order;
+  uint32_t polynom = t->polynom << shift;
+
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t crc = i << 24U;
+    for (uint32_t j = 0; j < 8; j++) {
+      crc = (crc & 0x80000000U) ? ((crc << 1U) ^ polynom) : (crc << 1U);
+    }
+    t->table8[0][i] = crc;
+  }
+
+  for (uint32_t k = 1; k < 8; k++) {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t prev   = t->table8[k - 1][i];
+      t->table8[k][i] = (prev << 8U) ^ t->table8[0][prev >> 24U];
+    }
+  }
+}
+
+// Returns the slice-by-8 tables for the generator of h, computing them the first time it is seen
+static const uint32_t (*get_crc_table8(const srsran_crc_t* h))[256]
+{
+  uint32_t            polynom = (uint32_t)(h->polynom & h->crcmask);
+  uint32_t            order   = (uint32_t)h->order;
+  const crc_table8_t* ret     = NULL;
+
+  pthread_mutex_lock(&crc_table8_mutex);
+  for (uint32_t i = 0; i < crc_table8_count && ret == NULL; i++) {
+    if (crc_table8_cache[i]->polynom == polynom && crc_table8_cache[i]->order == order) {
+      ret = crc_table8_cache[i];
+    }
+  }
+
+  if (ret == NULL && crc_table8_count < CRC_TABLE8_MAX_POLY) {
+    crc_table8_t* t = malloc(sizeof(crc_table8_t));
+    if (t != NULL) {
+      t->polynom = polynom;
+      t->order   = order;
+      gen_crc_table8(t);
+      crc_table8_cache[crc_table8_count++] = t;
+      ret                                  = t;
+    }
+  }
+  pthread_mutex_unlock(&crc_table8_mutex);
+
+  return (ret == NULL) ? NULL : ret->table8;
+}
+
+// Computes x^n modulo the generator polynomial
+static uint64_t crc_xpow_mod(const srsran_crc_t* h, uint32_t n)
+{
+  uint64_t top     = h->crchighbit << 1U;
+  uint64_t polynom = (uint64_t)h->polynom | top;
+  uint64_t r       = 1;
+
+  for (uint32_t i = 0; i < n; i++) {
+    r <<= 1U;
+    if (r & top) {
+      r ^= polynom;
+    }
+  }
+  return r;
+}
+
+static void gen_crc_fold(srsran_crc_t* h)
+{
+  h->fold_k[0] = crc_xpow_mod(h, 128);
+  h->fold_k[1] = crc_xpow_mod(h, 192);
+  h->fold_k[2] = crc_xpow_mod(h, 512);
+  h->fold_k[3] = crc_xpow_mod(h, 576);
+}
+
+static inline uint32_t crc_load_be32(const uint8_t* data)
 {
-  uint64_t m, rmask = 0x1;
+  return ((uint32_t)data[0] << 24U) | ((uint32_t)data[1] << 16U) | ((uint32_t)data[2] << 8U) | (uint32_t)data[3];
+}
+
+static inline uint32_t crc_update_byte(const srsran_crc_t* h, uint32_t crc, uint8_t byte)
+{
+  return (crc << 8U) ^ h->table8[0][(crc >> 24U) ^ byte];
+}
 
-  for (m = 0; m < nbits; m++) {
-    if ((rmask & crc) == 0x01)
-      crc = (crc ^ h->polynom) >> 1;
-    else
-      crc = crc >> 1;
+// Slice-by-8 update, one and two are the next 8 message bytes as big-endian words
+static inline uint32_t crc_update_64(const srsran_crc_t* h, uint32_t crc, uint32_t one, uint32_t two)
+{
+  one ^= crc;
+  return h->table8[7][one >> 24U] ^ h->table8[6][(one >> 16U) & 0xffU] ^ h->table8[5][(one >> 8U) & 0xffU] ^
+         h->table8[4][one & 0xffU] ^ h->table8[3][two >> 24U] ^ h->table8[2][(two >> 16U) & 0xffU] ^
+         h->table8[1][(two >> 8U) & 0xffU] ^ h->table8[0][two & 0xffU];
+}
+
+// Bit by bit update, used when the CRC has no slice-by-8 tables (e.g. it was never initialised)
+static uint32_t crc_checksum_bits(srsran_crc_t* h, const uint8_t* bits, uint32_t nof_bits, bool packed)
+{
+  uint64_t polynom = (uint64_t)h->polynom & h->crcmask;
+  uint64_t crc     = 0;
+
+  for (uint32_t i = 0; i < nof_bits; i++) {
+    uint8_t bit = packed ? ((bits[i / 8] >> (7U - i % 8U)) & 1U) : (bits[i] & 1U);
+    bool    msb = ((crc & h->crchighbit) != 0) ^ (bit != 0);
+    crc         = (crc << 1U) & h->crcmask;
+    if (msb) {
+      crc ^= polynom;
+    }
   }
-  return (crc & h->crcmask);
+
+  h->crcinit = crc;
+  return (uint32_t)crc;
 }
 
+static uint32_t crc_update_bytes(const srsran_crc_t* h, uint32_t crc, const uint8_t* data, uint32_t nof_bytes)
+{
+  uint32_t i = 0;
+  for (; i + 8 <= nof_bytes; i += 8) {
+    crc = crc_update_64(h, crc, crc_load_be32(&data[i]), crc_load_be32(&data[i + 4]));
+  }
+  for (; i < nof_bytes; i++) {
+    crc = crc_update_byte(h, crc, data[i]);
+  }
+  return crc;
+}
+
+// Packs 32 unpacked bits into a word, the first bit goes into the MSB
+static inline uint32_t crc_pack_32(uint8_t* bits)
+{
+#ifdef LV_HAVE_AVX2
+  // Reverses the bit order within each byte of the mask
+  const __m256i reverse = _mm256_set_epi8(
+      8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+
+  __m256i  v    = _mm256_loadu_si256((__m256i*)bits);
+  __m256i  mask = _mm256_shuffle_epi8(_mm256_cmpgt_epi8(v, _mm256_setzero_si256()), reverse);
+  uint32_t m    = (uint32_t)_mm256_movemask_epi8(mask);
+  return (m << 24U) | ((m << 8U) & 0xff0000U) | ((m >> 8U) & 0xff00U) | (m >> 24U);
+#else /* LV_HAVE_AVX2 */
+  return srsran_bit_pack(&bits, 32);
+#endif /* LV_HAVE_AVX2 */
+}
+
+#if defined(LV_HAVE_SSE) && defined(__PCLMUL__)
+#define CRC_HAVE_PCLMUL
+
+// Byte-reverses a 128-bit register so the first message byte becomes the most significant
+#define CRC_BSWAP128(X) _mm_shuffle_epi8(X, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15))
+
+// Multiplies the high half by k[1] and the low half by k[0], the product is congruent to x * x^128 (or x^512)
+static inline __m128i crc_fold_128(__m128i x, __m128i k)
+{
+  return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+// Folds all the whole 16 byte blocks of data into a 128-bit remainder congruent with them
+static __m128i crc_fold_bytes(const srsran_crc_t* h, const uint8_t* data, uint32_t nof_blocks)
+{
+  const __m128i* ptr = (const __m128i*)data;
+  __m128i        k1  = _mm_set_epi64x((int64_t)h->fold_k[1], (int64_t)h->fold_k[0]);
+  __m128i        x;
+  uint32_t       b;
+
+  if (nof_blocks >= 8) {
+    // Fold four independent streams 512 bits apart to hide the multiplier latency
+    __m128i k4 = _mm_set_epi64x((int64_t)h->fold_k[3], (int64_t)h->fold_k[2]);
+    __m128i x0 = CRC_BSWAP128(_mm_loadu_si128(&ptr[0]));
+    __m128i x1 = CRC_BSWAP128(_mm_loadu_si128(&ptr[1]));
+    __m128i x2 = CRC_BSWAP128(_mm_loadu_si128(&ptr[2]));
+    __m128i x3 = CRC_BSWAP128(_mm_loadu_si128(&ptr[3]));
+    for (b = 4; b + 4 <= nof_blocks; b += 4) {
+      x0 = _mm_xor_si128(crc_fold_128(x0, k4), CRC_BSWAP128(_mm_loadu_si128(&ptr[b])));
+      x1 = _mm_xor_si128(crc_fold_128(x1, k4), CRC_BSWAP128(_mm_loadu_si128(&ptr[b + 1])));
+      x2 = _mm_xor_si128(crc_fold_128(x2, k4), CRC_BSWAP128(_mm_loadu_si128(&ptr[b + 2])));
+      x3 = _mm_xor_si128(crc_fold_128(x3, k4), CRC_BSWAP128(_mm_loadu_si128(&ptr[b + 3])));
+    }
+    x = _mm_xor_si128(crc_fold_128(x0, k1), x1);
+    x = _mm_xor_si128(crc_fold_128(x, k1), x2);
+    x = _mm_xor_si128(crc_fold_128(x, k1), x3);
+  } else {
+    x = CRC_BSWAP128(_mm_loadu_si128(&ptr[0]));
+    b = 1;
+  }
+
+  for (; b < nof_blocks; b++) {
+    x = _mm_xor_si128(crc_fold_128(x, k1), CRC_BSWAP128(_mm_loadu_si128(&ptr[b])));
+  }
+
+  return x;
+}
+
+// Folds all the whole 128 bit blocks of unpacked bits into a 128-bit remainder congruent with them
+static __m128i crc_fold_bits(const srsran_crc_t* h, uint8_t* bits, uint32_t nof_blocks)
+{
+  __m128i k1 = _mm_set_epi64x((int64_t)h->fold_k[1], (int64_t)h->fold_k[0]);
+  __m128i x  = _mm_setzero_si128();
+
+  for (uint32_t b = 0; b < nof_blocks; b++, bits += 128) {
+    __m128i block = _mm_set_epi32(
+        (int)crc_pack_32(bits), (int)crc_pack_32(bits + 32), (int)crc_pack_32(bits + 64), (int)crc_pack_32(bits + 96));
+    x = _mm_xor_si128(crc_fold_128(x, k1), block);
+  }
+
+  return x;
+}
+
+// Reduces a folded remainder through the tables, starting from a zero register
+static uint32_t crc_fold_reduce(const srsran_crc_t* h, __m128i x)
+{
+  uint8_t tmp[16];
+  _mm_storeu_si128((__m128i*)tmp, CRC_BSWAP128(x));
+  return crc_update_bytes(h, 0, tmp, 16);
+}
+#endif /* defined(LV_HAVE_SSE) && defined(__PCLMUL__) */
+
 int srsran_crc_set_init(srsran_crc_t* crc_par, uint64_t crc_init_value)
 {
   crc_par->crcinit = crc_init_value;
@@ -86,76 +302,82 @@ int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
     return -1;
   }
 
-  // generate lookup table
+  // generate lookup tables
   gen_crc_table(h);
+  gen_crc_fold(h);
+  // Without tables the checksum falls back to the bit by bit computation
+  h->table8 = get_crc_table8(h);
 
   return 0;
 }
 
 uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
 {
-  int      i, k, len8, res8, a = 0;
-  uint32_t crc = 0;
-  uint8_t* pter;
+  if (h->table8 == NULL) {
+    return crc_checksum_bits(h, data, (uint32_t)len, false);
+  }
 
-  srsran_crc_set_init(h, 0);
+  uint32_t shift   = 32U - (uint32_t)h->order;
+  uint32_t polynom = (uint32_t)(h->polynom & h->crcmask) << shift;
+  uint32_t crc     = 0;
+  int      i       = 0;
 
-  // Pack bits into bytes
-  len8 = (len >> 3);
-  res8 = (len - (len8 << 3));
-  if (res8 > 0) {
-    a = 1;
+#ifdef CRC_HAVE_PCLMUL
+  // Long inputs are folded with carry-less multiplications, 128 bits at a time
+  if (len >= 256) {
+    uint32_t nof_blocks = (uint32_t)len / 128;
+    crc                 = crc_fold_reduce(h, crc_fold_bits(h, data, nof_blocks));
+    i                   = (int)nof_blocks * 128;
   }
+#endif /* CRC_HAVE_PCLMUL */
 
-  // Calculate CRC
-  for (i = 0; i < len8 + a; i++) {
-    pter = (uint8_t*)(data + 8 * i);
-    uint8_t byte;
-    if (i == len8) {
-      byte = 0x00;
-      for (k = 0; k < res8; k++) {
-        byte |= ((uint8_t) * (pter + k)) << (7 - k);
-      }
-    } else {
-#ifdef LV_HAVE_SSE
-      // Get 8 Bit
-      __m64 mask = _mm_cmpgt_pi8(*((__m64*)pter), _mm_set1_pi8(0));
-
-      // Reverse
-      mask = _mm_shuffle_pi8(mask, _mm_set_pi8(0, 1, 2, 3, 4, 5, 6, 7));
+  // Slice-by-8 over whole 64 bit chunks
+  for (; i + 64 <= len; i += 64) {
+    crc = crc_update_64(h, crc, crc_pack_32(&data[i]), crc_pack_32(&data[i + 32]));
+  }
 
-      // Get mask and write
-      byte = (uint8_t)_mm_movemask_pi8(mask);
-#else  /* LV_HAVE_SSE */
-      byte = (uint8_t)(srsran_bit_pack(&pter, 8) & 0xFF);
-#endif /* LV_HAVE_SSE */
-    }
-    srsran_crc_checksum_put_byte(h, byte);
+  // Remaining bytes
+  for (; i + 8 <= len; i += 8) {
+    uint8_t* pter = &data[i];
+    crc           = crc_update_byte(h, crc, (uint8_t)srsran_bit_pack(&pter, 8));
   }
-  crc = (uint32_t)srsran_crc_checksum_get(h);
 
-  // Reverse CRC res8 positions
-  if (a == 1) {
-    crc = reversecrcbit(crc, 8 - res8, h);
+  // Remaining bits
+  for (; i < len; i++) {
+    crc ^= (uint32_t)(data[i] & 1U) << 31U;
+    crc = (crc & 0x80000000U) ? ((crc << 1U) ^ polynom) : (crc << 1U);
   }
 
-  // Return CRC value
+  crc        = crc >> shift;
+  h->crcinit = crc;
+
   return crc;
 }
 
 // len is multiple of 8
 uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len)
 {
-  int      i;
-  uint32_t crc = 0;
+  uint32_t nof_bytes = (uint32_t)len / 8;
+  uint32_t crc       = 0;
+  uint32_t i         = 0;
 
-  srsran_crc_set_init(h, 0);
+  if (h->table8 == NULL) {
+    return crc_checksum_bits(h, data, nof_bytes * 8, true);
+  }
 
-  // Calculate CRC
-  for (i = 0; i < len / 8; i++) {
-    srsran_crc_checksum_put_byte(h, data[i]);
+#ifdef CRC_HAVE_PCLMUL
+  // Long inputs are folded with carry-less multiplications, 16 bytes at a time
+  if (nof_bytes >= 32) {
+    uint32_t nof_blocks = nof_bytes / 16;
+    crc                 = crc_fold_reduce(h, crc_fold_bytes(h, data, nof_blocks));
+    i                   = nof_blocks * 16;
   }
-  crc = (uint32_t)srsran_crc_checksum_get(h);
+#endif /* CRC_HAVE_PCLMUL */
+
+  crc = crc_update_bytes(h, crc, &data[i], nof_bytes - i);
+
+  crc        = crc >> (32U - (uint32_t)h->order);
+  h->crcinit = crc;
 
   return crc;
 }
@@ -0,0 +1,498 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_dec_c_avx2_batch.c
+ * \brief Definition LDPC decoder inner functions working
+ *    with 8-bit integer-valued LLRs (AVX2 version, several codewords at once).
+ *
+ * Lifted nodes of small lifting sizes only use a fraction of an AVX2 register. This
+ * version splits every register into segments of 8 or 16 chars and stores the same
+ * base node of a different codeword in each segment, so that up to 4 codewords sharing
+ * base graph and lifting size are decoded with the instructions needed for one.
+ * Segments never cross a 128-bit lane, which allows rotating all of them at once with
+ * an in-lane shuffle.
+ *
+ * Even if the inner representation is based on 8 bits, check-to-variable and
+ * variable-to-check messages are actually represented with 7 bits, the
+ * remaining bit is used to represent infinity.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include "../utils_avx2.h"
+#include "ldpc_dec_all.h"
+#include "srsran/phy/fec/ldpc/base_graph.h"
+#include "srsran/phy/utils/vector.h"
+
+#ifdef LV_HAVE_AVX2
+
+#include <immintrin.h>
+
+#include "ldpc_avx2_consts.h"
+
+#define F2I 65535 /*!< \brief Used for float to int conversion---float f is stored as (int)(f*F2I). */
+
+#define SEGMENT_SIZE_SHORT 8 /*!< \brief Segment size (in chars) for lifting sizes up to 8. */
+#define SEGMENT_SIZE_LONG 16 /*!< \brief Segment size (in chars) for lifting sizes up to 16. */
+
+/*!
+ * \brief Represents a node of the base factor graph.
+ */
+typedef union bg_node_t {
+  int8_t*  c; /*!< Each base node contains one segment of lifted nodes per codeword. */
+  __m256i* v; /*!< All the lifted nodes of the current base node as a 256-bit line. */
+} bg_node_t;
+
+/*!
+ * \brief Maximum message magnitude.
+ * Messages use a 7-bit quantization. Soft bits use the remaining bit to denote infinity.
+ */
+static const int8_t infinity7 = (1U << 6U) - 1;
+
+/*!
+ * \brief Inner registers for the LDPC decoder that works with 8-bit integer-valued LLRs.
+ */
+struct ldpc_regs_c_avx2_batch {
+  __m256i scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+
+  bg_node_t soft_bits;    /*!< \brief A-posteriori log-likelihood ratios. */
+  __m256i*  check_to_var; /*!< \brief Check-to-variable messages. */
+  __m256i*  var_to_check; /*!< \brief Variable-to-check messages. */
+  __m256i*  rotated_v2c;  /*!< \brief To store a rotated version of the variable-to-check messages. */
+
+  __m256i* rotate_right; /*!< \brief Shuffle masks rotating every segment to the right, one per shift. */
+  __m256i* rotate_left;  /*!< \brief Shuffle masks rotating every segment to the left, one per shift. */
+
+  uint16_t ls;       /*!< \brief Lifting size. */
+  uint16_t seg_size; /*!< \brief Number of chars allocated to each codeword in a register. */
+  uint8_t  hrr;      /*!< \brief Number of variable nodes in the high-rate region (before lifting). */
+  uint8_t  bgM;      /*!< \brief Number of check nodes (before lifting). */
+  uint8_t  bgN;      /*!< \brief Number of variable nodes (before lifting). */
+};
+
+/*!
+ * Carries out the actual update of the variable-to-check messages. It basically
+ * consists in \f$ z = x - y \f$ (as vectors). However, first it checks whether
+ * \f$\lvert x[i] \rvert = 2^{7}-1 \f$ (our representation of infinity) to
+ * ensure it is properly propagated. Also, the subtraction is saturated between
+ * \f$- clip\f$ and \f$+ clip\f$.
+ * \param[in] x     Minuend: array we subtract from (in practice, the soft bits).
+ * \param[in] y     Subtrahend: array to be subtracted (in practice, the
+ *                  check-to-variable messages).
+ * \param[out] z    Resulting difference array(in practice, the updated
+ *                  variable-to-check messages).
+ * \param[in]  clip The saturation value.
+ * \param[in]  len  The length of the vectors.
+ */
+static void
+inner_var_to_check_c_avx2_batch(const __m256i* x, const __m256i* y, __m256i* z, uint8_t clip, uint32_t len);
+
+/*!
+ * Scale packed 8-bit integers in \b a by the scaling factor \b sf / #F2I.
+ * \param[in] a   Vector of packed 8-bit integers.
+ * \param[in] sf  Scaling factor.
+ * \return    Vector of packed 8-bit integers with the scaling result.
+ */
+static __m256i _mm256_scalei_epi8(__m256i a, __m256i sf);
+
+/*!
+ * Fills the shuffle masks that rotate each segment of \b ls chars by \b shift positions.
+ * Chars beyond the lifting size in each segment are set to zero.
+ * \param[out] right    Mask for the rotation towards the right (char \f$ j \f$ takes char \f$ j + shift \f$).
+ * \param[out] left     Mask for the rotation towards the left (char \f$ j \f$ takes char \f$ j - shift \f$).
+ * \param[in]  shift    The rotation order in chars.
+ * \param[in]  ls       The lifting size.
+ * \param[in]  seg_size The segment size in chars.
+ */
+static void gen_rotation_masks(__m256i* right, __m256i* left, uint16_t shift, uint16_t ls, uint16_t seg_size);
+
+uint32_t get_ldpc_dec_c_avx2_batch_size(uint16_t ls)
+{
+  if (ls <= SEGMENT_SIZE_SHORT) {
+    return SRSRAN_AVX2_B_SIZE / SEGMENT_SIZE_SHORT;
+  }
+  if (ls <= SEGMENT_SIZE_LONG) {
+    return SRSRAN_AVX2_B_SIZE / SEGMENT_SIZE_LONG;
+  }
+  return 0;
+}
+
+void* create_ldpc_dec_c_avx2_batch(uint8_t bgN, uint8_t bgM, uint16_t ls, float scaling_fctr)
+{
+  struct ldpc_regs_c_avx2_batch* vp = NULL;
+
+  uint8_t  bgK = bgN - bgM;
+  uint16_t hrr = bgK + 4;
+
+  if (get_ldpc_dec_c_avx2_batch_size(ls) == 0) {
+    return NULL;
+  }
+
+  if ((vp = SRSRAN_MEM_ALLOC(struct ldpc_regs_c_avx2_batch, 1)) == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(vp, struct ldpc_regs_c_avx2_batch, 1);
+
+  if ((vp->soft_bits.v = SRSRAN_MEM_ALLOC(__m256i, bgN)) == NULL) {
+    delete_ldpc_dec_c_avx2_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->check_to_var = SRSRAN_MEM_ALLOC(__m256i, (hrr + 1) * (uint32_t)bgM)) == NULL) {
+    delete_ldpc_dec_c_avx2_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->var_to_check = SRSRAN_MEM_ALLOC(__m256i, hrr + 1)) == NULL) {
+    delete_ldpc_dec_c_avx2_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->rotated_v2c = SRSRAN_MEM_ALLOC(__m256i, hrr + 1)) == NULL) {
+    delete_ldpc_dec_c_avx2_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->rotate_right = SRSRAN_MEM_ALLOC(__m256i, ls)) == NULL) {
+    delete_ldpc_dec_c_avx2_batch(vp);
+    return NULL;
+  }
+
+  if ((vp->rotate_left = SRSRAN_MEM_ALLOC(__m256i, ls)) == NULL) {
+    delete_ldpc_dec_c_avx2_batch(vp);
+    return NULL;
+  }
+
+  vp->bgM      = bgM;
+  vp->bgN      = bgN;
+  vp->hrr      = hrr;
+  vp->ls       = ls;
+  vp->seg_size = SRSRAN_AVX2_B_SIZE / get_ldpc_dec_c_avx2_batch_size(ls);
+
+  for (uint16_t shift = 0; shift < ls; shift++) {
+    gen_rotation_masks(&vp->rotate_right[shift], &vp->rotate_left[shift], shift, ls, vp->seg_size);
+  }
+
+  // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm256_scalei_epi8
+  vp->scaling_fctr = _mm256_set1_epi16((uint16_t)((scaling_fctr + 0.00001525879) * F2I));
+
+  return vp;
+}
+
+void delete_ldpc_dec_c_avx2_batch(void* p)
+{
+  struct ldpc_regs_c_avx2_batch* vp = p;
+
+  if (vp == NULL) {
+    return;
+  }
+  if (vp->rotate_left) {
+    free(vp->rotate_left);
+  }
+  if (vp->rotate_right) {
+    free(vp->rotate_right);
+  }
+  if (vp->rotated_v2c) {
+    free(vp->rotated_v2c);
+  }
+  if (vp->var_to_check) {
+    free(vp->var_to_check);
+  }
+  if (vp->check_to_var) {
+    free(vp->check_to_var);
+  }
+  if (vp->soft_bits.v) {
+    free(vp->soft_bits.v);
+  }
+  free(vp);
+}
+
+int init_ldpc_dec_c_avx2_batch(void* p, const int8_t* const* llrs, uint16_t ls, uint32_t nof_cb)
+{
+  struct ldpc_regs_c_avx2_batch* vp = p;
+  int                            i  = 0;
+  int                            j  = 0;
+
+  if (p == NULL || nof_cb > SRSRAN_AVX2_B_SIZE / vp->seg_size) {
+    return -1;
+  }
+
+  // the first 2 x LS bits of the codeword are not sent, unused segments stay at zero
+  SRSRAN_MEM_ZERO(vp->soft_bits.v, __m256i, vp->bgN);
+  for (uint32_t k = 0; k < nof_cb; k++) {
+    for (i = 2; i < vp->bgN; i++) {
+      for (j = 0; j < ls; j++) {
+        vp->soft_bits.c[i * SRSRAN_AVX2_B_SIZE + k * vp->seg_size + j] = llrs[k][(i - 2) * ls + j];
+      }
+    }
+  }
+
+  SRSRAN_MEM_ZERO(vp->check_to_var, __m256i, (vp->hrr + 1) * (uint32_t)vp->bgM);
+  SRSRAN_MEM_ZERO(vp->var_to_check, __m256i, vp->hrr + 1);
+  return 0;
+}
+
+int update_ldpc_var_to_check_c_avx2_batch(void* p, int i_layer)
+{
+  struct ldpc_regs_c_avx2_batch* vp = p;
+
+  if (p == NULL) {
+    return -1;
+  }
+
+  __m256i* this_check_to_var = vp->check_to_var + i_layer * (vp->hrr + 1);
+
+  // Update the high-rate region.
+  inner_var_to_check_c_avx2_batch(vp->soft_bits.v, this_check_to_var, vp->var_to_check, infinity7, vp->hrr);
+
+  if (i_layer >= 4) {
+    // Update the extension region.
+    inner_var_to_check_c_avx2_batch(
+        vp->soft_bits.v + vp->hrr + i_layer - 4, this_check_to_var + vp->hrr, vp->var_to_check + vp->hrr, infinity7, 1);
+  }
+
+  return 0;
+}
+
+int update_ldpc_check_to_var_c_avx2_batch(void*           p,
+                                          int             i_layer,
+                                          const uint16_t* this_pcm,
+                                          const int8_t (*these_var_indices)[MAX_CNCT])
+{
+  struct ldpc_regs_c_avx2_batch* vp = p;
+
+  if (p == NULL) {
+    return -1;
+  }
+
+  int i = 0;
+
+  uint16_t shift      = 0;
+  int      i_v2c_base = 0;
+
+  __m256i* this_rotated_v2c = NULL;
+
+  __m256i this_abs_v2c_epi8;
+
+  __m256i mask_sign_epi8;
+  __m256i mask_min_epi8;
+  __m256i help_min_epi8;
+  __m256i min_ix_epi8 = _mm256_setzero_si256();
+  __m256i current_ix_epi8;
+
+  __m256i minp_v2c_epi8 = _mm256_set1_epi8(INT8_MAX);
+  __m256i mins_v2c_epi8 = _mm256_set1_epi8(INT8_MAX);
+  __m256i prod_v2c_epi8 = _mm256_setzero_si256();
+
+  int8_t current_var_index = (*these_var_indices)[0];
+
+  for (i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
+    shift      = this_pcm[current_var_index];
+    i_v2c_base = (current_var_index <= vp->hrr) ? current_var_index : vp->hrr;
+
+    current_ix_epi8 = _mm256_set1_epi8((int8_t)i);
+
+    this_rotated_v2c  = vp->rotated_v2c + i;
+    *this_rotated_v2c = _mm256_shuffle_epi8(vp->var_to_check[i_v2c_base], vp->rotate_right[shift]);
+    // mask_sign is 1 if this_rotated_v2c is strictly negative
+    mask_sign_epi8 = _mm256_cmpgt_epi8(zero_epi8, *this_rotated_v2c);
+    prod_v2c_epi8  = _mm256_xor_si256(prod_v2c_epi8, mask_sign_epi8);
+
+    this_abs_v2c_epi8 = _mm256_abs_epi8(*this_rotated_v2c);
+    // mask_min is 1 if this_abs_v2c is strictly smaller tha minp_v2c
+    mask_min_epi8 = _mm256_cmpgt_epi8(minp_v2c_epi8, this_abs_v2c_epi8);
+    help_min_epi8 = _mm256_blendv_epi8(this_abs_v2c_epi8, minp_v2c_epi8, mask_min_epi8);
+    minp_v2c_epi8 = _mm256_blendv_epi8(minp_v2c_epi8, this_abs_v2c_epi8, mask_min_epi8);
+    min_ix_epi8   = _mm256_blendv_epi8(min_ix_epi8, current_ix_epi8, mask_min_epi8);
+
+    // mask_min is 1 if this_abs_v2c is strictly smaller tha mins_v2c
+    mask_min_epi8 = _mm256_cmpgt_epi8(mins_v2c_epi8, this_abs_v2c_epi8);
+    mins_v2c_epi8 = _mm256_blendv_epi8(mins_v2c_epi8, help_min_epi8, mask_min_epi8);
+
+    current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
+  }
+
+  __m256i* this_check_to_var = vp->check_to_var + i_layer * (vp->hrr + 1);
+  current_var_index          = (*these_var_indices)[0];
+
+  __m256i mask_is_min_epi8;
+  __m256i this_c2v_epi8;
+  __m256i help_c2v_epi8;
+  __m256i final_sign_epi8;
+
+  for (i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
+    shift      = this_pcm[current_var_index];
+    i_v2c_base = (current_var_index <= vp->hrr) ? current_var_index : vp->hrr;
+
+    this_rotated_v2c = vp->rotated_v2c + i;
+    // mask_sign is 1 if this_rotated_v2c is strictly negative
+    final_sign_epi8 = _mm256_cmpgt_epi8(zero_epi8, *this_rotated_v2c);
+    final_sign_epi8 = _mm256_xor_si256(final_sign_epi8, prod_v2c_epi8);
+
+    current_ix_epi8  = _mm256_set1_epi8((int8_t)i);
+    mask_is_min_epi8 = _mm256_cmpeq_epi8(current_ix_epi8, min_ix_epi8);
+    this_c2v_epi8    = _mm256_blendv_epi8(minp_v2c_epi8, mins_v2c_epi8, mask_is_min_epi8);
+    this_c2v_epi8    = _mm256_scalei_epi8(this_c2v_epi8, vp->scaling_fctr);
+    help_c2v_epi8    = _mm256_sign_epi8(this_c2v_epi8, final_sign_epi8);
+    this_c2v_epi8    = _mm256_blendv_epi8(this_c2v_epi8, help_c2v_epi8, final_sign_epi8);
+
+    this_check_to_var[i_v2c_base] = _mm256_shuffle_epi8(this_c2v_epi8, vp->rotate_left[shift]);
+
+    current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
+  }
+
+  return 0;
+}
+
+int update_ldpc_soft_bits_c_avx2_batch(void* p, int i_layer, const int8_t (*these_var_indices)[MAX_CNCT])
+{
+  struct ldpc_regs_c_avx2_batch* vp = p;
+  if (p == NULL) {
+    return -1;
+  }
+
+  __m256i* this_check_to_var = vp->check_to_var + i_layer * (vp->hrr + 1);
+
+  int i_bit_tmp_base = 0;
+
+  __m256i tmp_epi8;
+  __m256i mask_epi8;
+
+  int8_t current_var_index = (*these_var_indices)[0];
+
+  for (int i = 0; (current_var_index != -1) && (i < MAX_CNCT); i++) {
+    i_bit_tmp_base = (current_var_index <= vp->hrr) ? current_var_index : vp->hrr;
+
+    tmp_epi8 = _mm256_adds_epi8(this_check_to_var[i_bit_tmp_base], vp->var_to_check[i_bit_tmp_base]);
+
+    // tmp = (tmp > infty7) : infty8 ? tmp
+    mask_epi8 = _mm256_cmpgt_epi8(tmp_epi8, infty7_epi8);
+    tmp_epi8  = _mm256_blendv_epi8(tmp_epi8, infty8_epi8, mask_epi8);
+
+    // tmp = (tmp < -infty7) : -infty8 ? tmp
+    mask_epi8                          = _mm256_cmpgt_epi8(neg_infty7_epi8, tmp_epi8);
+    vp->soft_bits.v[current_var_index] = _mm256_blendv_epi8(tmp_epi8, neg_infty8_epi8, mask_epi8);
+
+    current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
+  }
+
+  return 0;
+}
+
+int extract_ldpc_message_c_avx2_batch(void* p, uint8_t* message, uint16_t liftK, uint32_t cb_idx)
+{
+  if (p == NULL) {
+    return -1;
+  }
+
+  struct ldpc_regs_c_avx2_batch* vp = p;
+
+  int     j       = 0;
+  int8_t* seg_ptr = vp->soft_bits.c + cb_idx * vp->seg_size;
+
+  for (int i = 0; i < liftK / vp->ls; i++) {
+    for (j = 0; j < vp->ls; j++) {
+      message[i * vp->ls + j] = (seg_ptr[i * SRSRAN_AVX2_B_SIZE + j] < 0);
+    }
+  }
+
+  return 0;
+}
+
+static void
+inner_var_to_check_c_avx2_batch(const __m256i* x, const __m256i* y, __m256i* z, const uint8_t clip, const uint32_t len)
+{
+  unsigned i = 0;
+
+  __m256i x_epi8;
+  __m256i y_epi8;
+  __m256i z_epi8;
+  __m256i mask_epi8;
+  __m256i help_sub_epi8;
+  __m256i clip_epi8     = _mm256_set1_epi8(clip);
+  __m256i neg_clip_epi8 = _mm256_set1_epi8((char)(-clip));
+
+  for (i = 0; i < len; i++) {
+    x_epi8 = x[i];
+    y_epi8 = y[i];
+
+    // z = (x-y > clip) ? clip : x-y
+    help_sub_epi8 = _mm256_subs_epi8(x_epi8, y_epi8);
+    mask_epi8     = _mm256_cmpgt_epi8(help_sub_epi8, clip_epi8);
+    z_epi8        = _mm256_blendv_epi8(help_sub_epi8, clip_epi8, mask_epi8);
+
+    // z = (z < -clip) ? -clip : z
+    mask_epi8 = _mm256_cmpgt_epi8(neg_clip_epi8, z_epi8);
+    z_epi8    = _mm256_blendv_epi8(z_epi8, neg_clip_epi8, mask_epi8);
+
+    // ensure that x = +/- infinity => z = +/- infinity
+    // z = (x < infinity) ? z : infinity
+    mask_epi8 = _mm256_cmpgt_epi8(infty8_epi8, x_epi8);
+    z_epi8    = _mm256_blendv_epi8(infty8_epi8, z_epi8, mask_epi8);
+
+    // z = (x > - infinity) ? z : - infinity
+    mask_epi8 = _mm256_cmpgt_epi8(x_epi8, neg_infty8_epi8);
+    z[i]      = _mm256_blendv_epi8(neg_infty8_epi8, z_epi8, mask_epi8);
+  }
+}
+
+static void gen_rotation_masks(__m256i* right, __m256i* left, uint16_t shift, uint16_t ls, uint16_t seg_size)
+{
+  int8_t* right_c = (int8_t*)right;
+  int8_t* left_c  = (int8_t*)left;
+
+  for (int b = 0; b < SRSRAN_AVX2_B_SIZE; b++) {
+    // The shuffle index is relative to the 128-bit lane
+    int lane_idx  = b % 16;
+    int seg_start = (lane_idx / seg_size) * seg_size;
+    int pos       = lane_idx % seg_size;
+
+    if (pos < ls) {
+      right_c[b] = (int8_t)(seg_start + (pos + shift) % ls);
+      left_c[b]  = (int8_t)(seg_start + (pos + ls - shift) % ls);
+    } else {
+      // Setting the most significant bit zeroes the output char
+      right_c[b] = (int8_t)0x80;
+      left_c[b]  = (int8_t)0x80;
+    }
+  }
+}
+
+static __m256i _mm256_scalei_epi8(__m256i a, __m256i sf)
+{
+  __m256i even_epi16 = _mm256_and_si256(a, mask_even_epi8);
+  __m256i odd_epi16  = _mm256_srli_epi16(a, 8);
+
+  __m256i p_even_epi16 = _mm256_mulhi_epu16(even_epi16, sf);
+  __m256i p_odd_epi16  = _mm256_mulhi_epu16(odd_epi16, sf);
+
+  p_odd_epi16 = _mm256_slli_epi16(p_odd_epi16, 8);
+
+  return _mm256_xor_si256(p_even_epi16, p_odd_epi16);
+}
+
+#endif // LV_HAVE_AVX2
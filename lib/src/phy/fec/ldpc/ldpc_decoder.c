@@ -41,6 +41,42 @@
 
 #define LDPC_DECODER_DEFAULT_MAX_NOF_ITER 10 /*!< \brief Default maximum number of iterations of the BP algorithm. */
 
+/*!
+ * Checks whether the hard decisions in q->hard_bits satisfy all the parity checks of the first \b n_layers
+ * layers (i.e., those corresponding to the transmitted part of the codeword).
+ * \param[in,out] q        A pointer to the LDPC decoder.
+ * \param[in]     n_layers The number of layers to check.
+ * \return True if the syndrome is all zeros, false otherwise.
+ */
+static bool ldpc_syndrome_is_zero(srsran_ldpc_decoder_t* q, uint8_t n_layers)
+{
+  uint16_t ls = q->ls;
+
+  for (int i_layer = 0; i_layer < n_layers; i_layer++) {
+    const uint16_t* this_pcm          = q->pcm + i_layer * q->bgN;
+    const int8_t*   these_var_indices = q->var_indices[i_layer];
+
+    srsran_vec_u8_zero(q->syndrome, ls);
+
+    // Lifted check node j is connected to the bit (j + shift) mod ls of each base variable node
+    for (int i = 0; (i < MAX_CNCT) && (these_var_indices[i] != -1); i++) {
+      uint16_t       shift = this_pcm[these_var_indices[i]];
+      const uint8_t* node  = q->hard_bits + these_var_indices[i] * ls;
+
+      srsran_vec_xor_bbb(q->syndrome, node + shift, q->syndrome, ls - shift);
+      srsran_vec_xor_bbb(q->syndrome + ls - shift, node, q->syndrome + ls - shift, shift);
+    }
+
+    for (uint16_t j = 0; j < ls; j++) {
+      if (q->syndrome[j] != 0) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 #define LDPC_DECODER_TEMPLATE(LLR_TYPE, SUFFIX)                                                                        \
   static int decode_##SUFFIX(                                                                                          \
       void* o, const LLR_TYPE* llrs, uint8_t* message, uint32_t cdwd_rm_length, srsran_crc_t* crc)                     \
@@ -84,15 +120,41 @@
         update_ldpc_soft_bits_##SUFFIX(q->ptr, i_layer, these_var_indices);                                            \
       }                                                                                                                \
                                                                                                                        \
-      if (crc != NULL) {                                                                                               \
+      if (q->syndrome_early_stop) {                                                                                    \
+        /* Hard decisions of all the variable nodes involved in the transmitted layers */                              \
+        extract_ldpc_message_##SUFFIX(q->ptr, q->hard_bits, (q->bgK + n_layers) * q->ls);                              \
+                                                                                                                       \
+        if (ldpc_syndrome_is_zero(q, n_layers)) {                                                                      \
+          srsran_vec_u8_copy(message, q->hard_bits, q->liftK);                                                         \
+          q->last_nof_iter = i_iteration + 1;                                                                          \
+                                                                                                                       \
+          /* A codeword has been found, no further iterations: the CRC is checked only once */                        \
+          if (crc != NULL && !srsran_crc_match(crc, message, q->liftK - crc->order)) {                                 \
+            return 0;                                                                                                  \
+          }                                                                                                            \
+          return i_iteration + 1;                                                                                      \
+        }                                                                                                              \
+      } else if (crc != NULL) {                                                                                        \
         extract_ldpc_message_##SUFFIX(q->ptr, message, q->liftK);                                                      \
                                                                                                                        \
         if (srsran_crc_match(crc, message, q->liftK - crc->order)) {                                                   \
+          q->last_nof_iter = i_iteration + 1;                                                                          \
           return i_iteration + 1;                                                                                      \
         }                                                                                                              \
       }                                                                                                                \
     }                                                                                                                  \
                                                                                                                        \
+    q->last_nof_iter = q->max_nof_iter;                                                                                \
+                                                                                                                       \
+    /* With syndrome early stop, the CRC has not been checked with the last hard decisions */                          \
+    if (q->syndrome_early_stop) {                                                                                      \
+      srsran_vec_u8_copy(message, q->hard_bits, q->liftK);                                                             \
+      if (crc != NULL && !srsran_crc_match(crc, message, q->liftK - crc->order)) {                                     \
+        return 0;                                                                                                      \
+      }                                                                                                                \
+      return q->max_nof_iter;                                                                                          \
+    }                                                                                                                  \
+                                                                                                                       \
     /* If reached here, and CRC is being checked, it has failed */                                                     \
     if (crc != NULL) {                                                                                                 \
       return 0;                                                                                                        \
@@ -147,15 +209,41 @@
                                                                                                                        \
       update_ldpc_soft_bits_##SUFFIX(q->ptr, q->var_indices);                                                          \
                                                                                                                        \
-      if (crc != NULL) {                                                                                               \
+      if (q->syndrome_early_stop) {                                                                                    \
+        /* Hard decisions of all the variable nodes involved in the transmitted layers */                              \
+        extract_ldpc_message_##SUFFIX(q->ptr, q->hard_bits, (q->bgK + n_layers) * q->ls);                              \
+                                                                                                                       \
+        if (ldpc_syndrome_is_zero(q, n_layers)) {                                                                      \
+          srsran_vec_u8_copy(message, q->hard_bits, q->liftK);                                                         \
+          q->last_nof_iter = i_iteration + 1;                                                                          \
+                                                                                                                       \
+          /* A codeword has been found, no further iterations: the CRC is checked only once */                        \
+          if (crc != NULL && !srsran_crc_match(crc, message, q->liftK - crc->order)) {                                 \
+            return 0;                                                                                                  \
+          }                                                                                                            \
+          return i_iteration + 1;                                                                                      \
+        }                                                                                                              \
+      } else if (crc != NULL) {                                                                                        \
         extract_ldpc_message_##SUFFIX(q->ptr, message, q->liftK);                                                      \
                                                                                                                        \
         if (srsran_crc_match(crc, message, q->liftK - crc->order)) {                                                   \
+          q->last_nof_iter = i_iteration + 1;                                                                          \
           return i_iteration + 1;                                                                                      \
         }                                                                                                              \
       }                                                                                                                \
     }                                                                                                                  \
                                                                                                                        \
+    q->last_nof_iter = q->max_nof_iter;                                                                                \
+                                                                                                                       \
+    /* With syndrome early stop, the CRC has not been checked with the last hard decisions */                          \
+    if (q->syndrome_early_stop) {                                                                                      \
+      srsran_vec_u8_copy(message, q->hard_bits, q->liftK);                                                             \
+      if (crc != NULL && !srsran_crc_match(crc, message, q->liftK - crc->order)) {                                     \
+        return 0;                                                                                                      \
+      }                                                                                                                \
+      return q->max_nof_iter;                                                                                          \
+    }                                                                                                                  \
+                                                                                                                       \
     /* If reached here, and CRC is being checked, it has failed */                                                     \
     if (crc != NULL) {                                                                                                 \
       return 0;                                                                                                        \
@@ -307,11 +395,158 @@ static void free_dec_c_avx2(void* o)
     free(q->pcm);
   }
   delete_ldpc_dec_c_avx2(q->ptr);
+  delete_ldpc_dec_c_avx2_batch(q->ptr_batch);
 }
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX2 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx2);
 
+/*!
+ * Carries out the decoding of several codewords with 8-bit integer-valued LLRs, packing up to q->batch_size
+ * codewords in the same registers (AVX2 implementation, LS <= 16). Each codeword stops being checked as soon
+ * as its CRC matches (or its syndrome is zero with syndrome early stop), so that the outcome is the same as decoding
+ * the codewords one by one.
+ */
+static int decode_batch_c_avx2(void*                o,
+                               const int8_t* const* llrs,
+                               uint8_t* const*      messages,
+                               uint32_t             cdwd_rm_length,
+                               srsran_crc_t*        crc,
+                               int*                 nof_iterations,
+                               uint32_t             nof_cb)
+{
+  srsran_ldpc_decoder_t* q = o;
+
+  /* it must be smaller than the codeword size */
+  if (cdwd_rm_length > q->liftN - 2 * q->ls) {
+    cdwd_rm_length = q->liftN - 2 * q->ls;
+  }
+  /* We need at least q->bgK + 4 variable nodes to cover the high-rate region. However,*/
+  /* 2 variable nodes are systematically punctured by the encoder. */
+  if (cdwd_rm_length < (q->bgK + 2) * q->ls) {
+    cdwd_rm_length = (q->bgK + 2) * q->ls;
+  }
+  if (cdwd_rm_length % q->ls) {
+    cdwd_rm_length = (cdwd_rm_length / q->ls + 1) * q->ls;
+  }
+
+  /* When computing the number of layers, we need to recall that the standard always removes */
+  /* the first two variable nodes from the final codeword.*/
+  uint8_t n_layers = cdwd_rm_length / q->ls - q->bgK + 2;
+
+  for (uint32_t cb_offset = 0; cb_offset < nof_cb; cb_offset += q->batch_size) {
+    uint32_t batch_len = SRSRAN_MIN(q->batch_size, nof_cb - cb_offset);
+
+    if (init_ldpc_dec_c_avx2_batch(q->ptr_batch, llrs + cb_offset, q->ls, batch_len) != 0) {
+      ERROR("Error initializing batched LDPC decoder");
+      return -1;
+    }
+
+    // Number of used iterations (0 if the CRC did not match) and of carried out iterations of each codeword
+    int nof_iter[SRSRAN_AVX2_B_SIZE]    = {};
+    int nof_carried[SRSRAN_AVX2_B_SIZE] = {};
+
+    // Bitmap of the codewords in the batch that need no further iterations
+    uint32_t done_mask = 0;
+    uint32_t all_done  = (1U << batch_len) - 1;
+
+    uint16_t* this_pcm                   = NULL;
+    int8_t(*these_var_indices)[MAX_CNCT] = NULL;
+
+    for (int i_iteration = 0; i_iteration < q->max_nof_iter && done_mask != all_done; i_iteration++) {
+      for (int i_layer = 0; i_layer < n_layers; i_layer++) {
+        update_ldpc_var_to_check_c_avx2_batch(q->ptr_batch, i_layer);
+
+        this_pcm          = q->pcm + i_layer * q->bgN;
+        these_var_indices = q->var_indices + i_layer;
+
+        update_ldpc_check_to_var_c_avx2_batch(q->ptr_batch, i_layer, this_pcm, these_var_indices);
+
+        update_ldpc_soft_bits_c_avx2_batch(q->ptr_batch, i_layer, these_var_indices);
+      }
+
+      for (uint32_t k = 0; k < batch_len; k++) {
+        uint8_t* message = messages[cb_offset + k];
+        if (done_mask & (1U << k)) {
+          continue;
+        }
+
+        if (q->syndrome_early_stop) {
+          // Hard decisions of all the variable nodes involved in the transmitted layers
+          extract_ldpc_message_c_avx2_batch(q->ptr_batch, q->hard_bits, (q->bgK + n_layers) * q->ls, k);
+
+          if (ldpc_syndrome_is_zero(q, n_layers)) {
+            srsran_vec_u8_copy(message, q->hard_bits, q->liftK);
+
+            // A codeword has been found, no further iterations: the CRC is checked only once
+            bool crc_ok    = (crc == NULL) || srsran_crc_match(crc, message, q->liftK - crc->order);
+            nof_iter[k]    = crc_ok ? i_iteration + 1 : 0;
+            nof_carried[k] = i_iteration + 1;
+            done_mask |= (1U << k);
+          }
+        } else if (crc != NULL) {
+          extract_ldpc_message_c_avx2_batch(q->ptr_batch, message, q->liftK, k);
+
+          if (srsran_crc_match(crc, message, q->liftK - crc->order)) {
+            nof_iter[k]    = i_iteration + 1;
+            nof_carried[k] = i_iteration + 1;
+            done_mask |= (1U << k);
+          }
+        }
+      }
+    }
+
+    // The remaining codewords used all the iterations
+    for (uint32_t k = 0; k < batch_len; k++) {
+      uint8_t* message = messages[cb_offset + k];
+      if (done_mask & (1U << k)) {
+        continue;
+      }
+      nof_carried[k] = q->max_nof_iter;
+
+      if (q->syndrome_early_stop) {
+        // The CRC has not been checked with the last hard decisions
+        extract_ldpc_message_c_avx2_batch(q->ptr_batch, message, q->liftK, k);
+        bool crc_ok = (crc == NULL) || srsran_crc_match(crc, message, q->liftK - crc->order);
+        nof_iter[k] = crc_ok ? q->max_nof_iter : 0;
+      } else if (crc == NULL) {
+        // Without CRC, extract the message and report the maximum number of iterations
+        extract_ldpc_message_c_avx2_batch(q->ptr_batch, message, q->liftK, k);
+        nof_iter[k] = q->max_nof_iter;
+      }
+    }
+
+    // As if the codewords were decoded one after the other
+    q->last_nof_iter = nof_carried[batch_len - 1];
+
+    if (nof_iterations != NULL) {
+      for (uint32_t k = 0; k < batch_len; k++) {
+        nof_iterations[cb_offset + k] = nof_iter[k];
+      }
+    }
+  }
+
+  return 0;
+}
+
+/*! Creates the registers of the batched decoder if the lifting size allows packing several codewords. */
+static int init_batch_c_avx2(srsran_ldpc_decoder_t* q)
+{
+  q->batch_size = get_ldpc_dec_c_avx2_batch_size(q->ls);
+  if (q->batch_size == 0) {
+    return 0;
+  }
+
+  if ((q->ptr_batch = create_ldpc_dec_c_avx2_batch(q->bgN, q->bgM, q->ls, q->scaling_fctr)) == NULL) {
+    ERROR("Create_ldpc_dec_batch failed");
+    return -1;
+  }
+
+  q->decode_batch_c = decode_batch_c_avx2;
+
+  return 0;
+}
+
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX2 implementation). */
 static int init_c_avx2(srsran_ldpc_decoder_t* q)
 {
@@ -325,6 +560,11 @@ static int init_c_avx2(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx2;
 
+  if (init_batch_c_avx2(q) != 0) {
+    free_dec_c_avx2(q);
+    return -1;
+  }
+
   return 0;
 }
 
@@ -446,6 +686,7 @@ static void free_dec_c_avx512(void* o)
     free(q->pcm);
   }
   delete_ldpc_dec_c_avx512(q->ptr);
+  delete_ldpc_dec_c_avx2_batch(q->ptr_batch);
 }
 
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX512 implementation). */
@@ -464,6 +705,11 @@ static int init_c_avx512(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx512;
 
+  if (init_batch_c_avx2(q) != 0) {
+    free_dec_c_avx512(q);
+    return -1;
+  }
+
   return 0;
 }
 
@@ -606,44 +852,77 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
   }
   q->scaling_fctr = scaling_fctr;
 
+  // Only some implementations provide a batched decoder
+  q->ptr_batch      = NULL;
+  q->batch_size     = 0;
+  q->decode_batch_c = NULL;
+
+  q->syndrome_early_stop = args->syndrome_early_stop;
+  q->hard_bits           = NULL;
+  q->syndrome            = NULL;
+  q->last_nof_iter       = 0;
+
+  int ret = -1;
   switch (type) {
     case SRSRAN_LDPC_DECODER_F:
-      return init_f(q);
+      ret = init_f(q);
+      break;
     case SRSRAN_LDPC_DECODER_S:
-      return init_s(q);
+      ret = init_s(q);
+      break;
     case SRSRAN_LDPC_DECODER_C:
-      return init_c(q);
+      ret = init_c(q);
+      break;
     case SRSRAN_LDPC_DECODER_C_FLOOD:
-      return init_c_flood(q);
+      ret = init_c_flood(q);
+      break;
 #ifdef LV_HAVE_AVX2
     case SRSRAN_LDPC_DECODER_C_AVX2:
       if (ls <= SRSRAN_AVX2_B_SIZE) {
-        return init_c_avx2(q);
+        ret = init_c_avx2(q);
       } else {
-        return init_c_avx2long(q);
+        ret = init_c_avx2long(q);
       }
+      break;
     case SRSRAN_LDPC_DECODER_C_AVX2_FLOOD:
       if (ls <= SRSRAN_AVX2_B_SIZE) {
-        return init_c_avx2_flood(q);
+        ret = init_c_avx2_flood(q);
       } else {
-        return init_c_avx2long_flood(q);
+        ret = init_c_avx2long_flood(q);
       }
+      break;
 #endif // LV_HAVE_AVX2
 #ifdef LV_HAVE_AVX512
     case SRSRAN_LDPC_DECODER_C_AVX512:
       if (ls <= SRSRAN_AVX512_B_SIZE) {
-        return init_c_avx512(q);
+        ret = init_c_avx512(q);
       } else {
-        return init_c_avx512long(q);
+        ret = init_c_avx512long(q);
       }
+      break;
     case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
-      return init_c_avx512long_flood(q);
+      ret = init_c_avx512long_flood(q);
+      break;
 #endif // LV_HAVE_AVX2
 
     default:
       ERROR("Unknown decoder.");
       return -1;
   }
+
+  if (ret != 0 || !q->syndrome_early_stop) {
+    return ret;
+  }
+
+  q->hard_bits = srsran_vec_u8_malloc(q->liftN);
+  q->syndrome  = srsran_vec_u8_malloc(q->ls);
+  if (!q->hard_bits || !q->syndrome) {
+    ERROR("Error allocating LDPC syndrome buffers");
+    srsran_ldpc_decoder_free(q);
+    return -1;
+  }
+
+  return 0;
 }
 
 void srsran_ldpc_decoder_free(srsran_ldpc_decoder_t* q)
@@ -651,6 +930,12 @@ void srsran_ldpc_decoder_free(srsran_ldpc_decoder_t* q)
   if (q->free) {
     q->free(q);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
+  if (q->syndrome) {
+    free(q->syndrome);
+  }
   bzero(q, sizeof(srsran_ldpc_decoder_t));
 }
 
@@ -683,3 +968,33 @@ int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
 {
   return q->decode_c(q, llrs, message, cdwd_rm_length, crc);
 }
+
+int srsran_ldpc_decoder_decode_batch(srsran_ldpc_decoder_t* q,
+                                     const int8_t* const*   llrs,
+                                     uint8_t* const*        messages,
+                                     uint32_t               cdwd_rm_length,
+                                     srsran_crc_t*          crc,
+                                     int*                   nof_iterations,
+                                     uint32_t               nof_cb)
+{
+  if (q == NULL || llrs == NULL || messages == NULL) {
+    return -1;
+  }
+
+  if (q->decode_batch_c != NULL) {
+    return q->decode_batch_c(q, llrs, messages, cdwd_rm_length, crc, nof_iterations, nof_cb);
+  }
+
+  // Fall back to decoding the codewords one after the other
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    int n = q->decode_c(q, llrs[i], messages[i], cdwd_rm_length, crc);
+    if (n < 0) {
+      return -1;
+    }
+    if (nof_iterations != NULL) {
+      nof_iterations[i] = n;
+    }
+  }
+
+  return 0;
+}
@@ -47,6 +47,7 @@
  *  - **-B \<number\>** Number of codewords in a batch.(Default 100).
  *  - **-N \<number\>** Max number of simulated batches.(Default 10000).
  *  - **-E \<number\>** Minimum number of errors for a significant simulation.(Default 100).
+ *  - **-S** Enable the early stop based on the syndrome of the hard decisions.
  */
 
 #include <math.h>
@@ -75,12 +76,14 @@ static int max_n_batch = 10000; /*!< \brief Max number of simulated batches. */
 static int req_errors  = 100;   /*!< \brief Minimum number of errors for a significant simulation. */
 #define MS_SF 0.75f             /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
 
+static bool syndrome_early_stop = false; /*!< \brief Enables the syndrome-based early stop of the decoders. */
+
 /*!
  * \brief Prints test help when wrong parameter is passed as input.
  */
 void usage(char* prog)
 {
-  printf("Usage: %s [-bX] [-lX] [-eX] [-sX] [-BX]\n", prog);
+  printf("Usage: %s [-bX] [-lX] [-eX] [-sX] [-BX] [-S]\n", prog);
   printf("\t-b Base Graph [(1 or 2) Default %d]\n", base_graph + 1);
   printf("\t-l Lifting Size [Default %d]\n", lift_size);
   printf("\t-e Word length after rate matching [Default %d (no rate matching, only filler-bits are extracted)]\n",
@@ -88,6 +91,7 @@ void usage(char* prog)
   printf("\t-B Number of codewords in a batch. [Default %d]\n", batch_size);
   printf("\t-N Max number of simulated batches. [Default %d]\n", max_n_batch);
   printf("\t-E Minimum number of errors for a significant simulation. [Default %d]\n", req_errors);
+  printf("\t-S Enable syndrome-based early stop. [Default %s]\n", syndrome_early_stop ? "enabled" : "disabled");
 }
 
 /*!
@@ -96,7 +100,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt = 0;
-  while ((opt = getopt(argc, argv, "b:l:e:s:B:N:E:")) != -1) {
+  while ((opt = getopt(argc, argv, "b:l:e:s:B:N:E:S")) != -1) {
     switch (opt) {
       case 'b':
         base_graph = (int)strtol(optarg, NULL, 10) - 1;
@@ -119,6 +123,9 @@ void parse_args(int argc, char** argv)
       case 'E':
         req_errors = (int)strtol(optarg, NULL, 10);
         break;
+      case 'S':
+        syndrome_early_stop = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -182,6 +189,7 @@ int main(int argc, char** argv)
   decoder_args.bg                         = base_graph;
   decoder_args.ls                         = lift_size;
   decoder_args.scaling_fctr               = MS_SF;
+  decoder_args.syndrome_early_stop        = syndrome_early_stop;
 
   // create an LDPC decoder (float)
   srsran_ldpc_decoder_t decoder_f;
@@ -0,0 +1,338 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_dec_batch_test.c
+ * \brief Unit test and benchmark for the batched LDPC decoder (8-bit integer-valued LLRs).
+ *
+ * For each selected base graph and lifting size, a number of messages with CRC are randomly generated,
+ * encoded, 2-PAM modulated and sent over an AWGN channel. The resulting codewords are decoded one by one
+ * with srsran_ldpc_decoder_decode_crc_c() and all together with srsran_ldpc_decoder_decode_batch(). The
+ * test fails if the two decoders do not return the same messages and number of iterations. The
+ * single-core throughput (information bits) of both methods is reported.
+ *
+ * Synopsis: **ldpc_dec_batch_test [options]**
+ *
+ * Options:
+ *  - **-b \<number\>** Base Graph (1 or 2, 0 for both. Default 0).
+ *  - **-l \<number\>** Lifting Size (according to 5GNR standard, 0 for all. Default 0).
+ *  - **-s \<number\>** SNR in dB (Default 1 dB).
+ *  - **-B \<number\>** Number of codewords (Default 12).
+ *  - **-R \<number\>** Number of times tests are repeated (for computing throughput). (Default 1).
+ *  - **-e** Stop the decoding as soon as all the parity checks are satisfied (syndrome early stop).
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/ldpc/ldpc_common.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include "srsran/phy/fec/ldpc/ldpc_encoder.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+static int   base_graph = 0;     /*!< \brief Base Graph (1 or 2, 0 for both). */
+static int   lift_size  = 0;     /*!< \brief Lifting Size (0 for all). */
+static float snr        = 1;     /*!< \brief Signal-to-Noise Ratio [dB]. */
+static int   nof_cb     = 12;    /*!< \brief Number of codewords decoded together. */
+static int   nof_reps   = 1;     /*!< \brief Number of times tests are repeated (for computing throughput). */
+static bool  early_stop = false; /*!< \brief Syndrome early stop. */
+
+/*!
+ * \brief All the lifting sizes defined by the standard, in increasing order.
+ */
+static const uint16_t all_lifting_sizes[] = {2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,
+                                             15,  16,  18,  20,  22,  24,  26,  28,  30,  32,  36,  40,  44,
+                                             48,  52,  56,  60,  64,  72,  80,  88,  96,  104, 112, 120, 128,
+                                             144, 160, 176, 192, 208, 224, 240, 256, 288, 320, 352, 384};
+
+/*!
+ * \brief Prints test help when a wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-bX] [-lX] [-sX] [-BX] [-RX] [-e]\n", prog);
+  printf("\t-b Base Graph [(1 or 2, 0 for both) Default %d]\n", base_graph);
+  printf("\t-l Lifting Size [(0 for all) Default %d]\n", lift_size);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr);
+  printf("\t-B Number of codewords [Default %d]\n", nof_cb);
+  printf("\t-R Number of times tests are repeated (for computing throughput). [Default %d]\n", nof_reps);
+  printf("\t-e Syndrome early stop [Default %s]\n", early_stop ? "enabled" : "disabled");
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "b:l:s:B:R:e")) != -1) {
+    switch (opt) {
+      case 'b':
+        base_graph = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'l':
+        lift_size = (int)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr = strtof(optarg, NULL);
+        break;
+      case 'B':
+        nof_cb = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'R':
+        nof_reps = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'e':
+        early_stop = true;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Runs the test for the given base graph and lifting size.
+ * \return SRSRAN_SUCCESS if single and batched decoding match, SRSRAN_ERROR otherwise.
+ */
+static int run_test(srsran_random_t random_gen, srsran_basegraph_t bg, uint16_t ls)
+{
+  int ret = SRSRAN_ERROR;
+
+  srsran_ldpc_encoder_t encoder = {};
+  srsran_ldpc_decoder_t decoder = {};
+  srsran_crc_t          crc     = {};
+
+  uint8_t*  messages_true   = NULL;
+  uint8_t*  messages_single = NULL;
+  uint8_t*  messages_batch  = NULL;
+  uint8_t*  codewords       = NULL;
+  float*    symbols         = NULL;
+  int8_t*   llrs            = NULL;
+  int*      iters_single    = NULL;
+  int*      iters_batch     = NULL;
+  int8_t**  llr_ptrs        = NULL;
+  uint8_t** msg_ptrs        = NULL;
+
+  if (srsran_ldpc_encoder_init(&encoder, SRSRAN_LDPC_ENCODER_AVX2, bg, ls) != SRSRAN_SUCCESS) {
+    ERROR("Error initializing LDPC encoder");
+    goto clean_exit;
+  }
+
+  srsran_ldpc_decoder_args_t decoder_args = {};
+  decoder_args.type                       = SRSRAN_LDPC_DECODER_C_AVX2;
+  decoder_args.bg                         = bg;
+  decoder_args.ls                         = ls;
+  decoder_args.scaling_fctr               = 0.8f;
+  decoder_args.syndrome_early_stop        = early_stop;
+  if (srsran_ldpc_decoder_init(&decoder, &decoder_args) != SRSRAN_SUCCESS) {
+    ERROR("Error initializing LDPC decoder");
+    goto clean_exit;
+  }
+
+  uint32_t finalK = decoder.liftK;
+  uint32_t finalN = decoder.liftN - 2 * ls;
+
+  // Short messages do not leave room for a 24-bit CRC
+  if (finalK > 48) {
+    srsran_crc_init(&crc, SRSRAN_LTE_CRC24B, 24);
+  } else {
+    srsran_crc_init(&crc, SRSRAN_LTE_CRC16, 16);
+  }
+
+  messages_true   = srsran_vec_u8_malloc(finalK * nof_cb);
+  messages_single = srsran_vec_u8_malloc(finalK * nof_cb);
+  messages_batch  = srsran_vec_u8_malloc(finalK * nof_cb);
+  codewords       = srsran_vec_u8_malloc(finalN * nof_cb);
+  symbols         = srsran_vec_f_malloc(finalN * nof_cb);
+  llrs            = srsran_vec_i8_malloc(finalN * nof_cb);
+  iters_single    = srsran_vec_i32_malloc(nof_cb);
+  iters_batch     = srsran_vec_i32_malloc(nof_cb);
+  llr_ptrs        = calloc(nof_cb, sizeof(int8_t*));
+  msg_ptrs        = calloc(nof_cb, sizeof(uint8_t*));
+  if (!messages_true || !messages_single || !messages_batch || !codewords || !symbols || !llrs || !iters_single ||
+      !iters_batch || !llr_ptrs || !msg_ptrs) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  // Generate, encode and modulate the messages
+  for (int i = 0; i < nof_cb; i++) {
+    uint8_t* msg = messages_true + i * finalK;
+    for (uint32_t j = 0; j < finalK - crc.order; j++) {
+      msg[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_crc_attach(&crc, msg, finalK - crc.order);
+    srsran_ldpc_encoder_encode(&encoder, msg, codewords + i * finalN, finalK);
+
+    for (uint32_t j = 0; j < finalN; j++) {
+      symbols[i * finalN + j] = 1 - 2 * codewords[i * finalN + j];
+    }
+
+    llr_ptrs[i] = llrs + i * finalN;
+    msg_ptrs[i] = messages_batch + i * finalK;
+  }
+
+  // Apply AWGN and quantize the LLRs with 8 bits
+  float noise_var     = srsran_convert_dB_to_power(-snr);
+  float noise_std_dev = sqrtf(noise_var);
+  srsran_ch_awgn_f(symbols, symbols, noise_var, finalN * nof_cb);
+  srsran_vec_sc_prod_fff(symbols, 2 / noise_var, symbols, finalN * nof_cb);
+
+  int8_t inf7   = (1U << 6U) - 1;
+  float  gain_c = inf7 * noise_std_dev / 8 / (1 / noise_std_dev + 2);
+  srsran_vec_quant_fc(symbols, llrs, gain_c, 0, inf7, finalN * nof_cb);
+
+  // Decode the codewords one by one
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  for (int r = 0; r < nof_reps; r++) {
+    for (int i = 0; i < nof_cb; i++) {
+      iters_single[i] = srsran_ldpc_decoder_decode_crc_c(
+          &decoder, llrs + i * finalN, messages_single + i * finalK, finalN, &crc);
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double elapsed_single = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+  int    last_single    = decoder.last_nof_iter;
+
+  // Decode all the codewords together
+  gettimeofday(&t[1], NULL);
+  for (int r = 0; r < nof_reps; r++) {
+    if (srsran_ldpc_decoder_decode_batch(
+            &decoder, (const int8_t* const*)llr_ptrs, msg_ptrs, finalN, &crc, iters_batch, nof_cb) !=
+        SRSRAN_SUCCESS) {
+      ERROR("Error decoding batch");
+      goto clean_exit;
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double elapsed_batch = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+  // Both methods must provide exactly the same result
+  if (last_single != decoder.last_nof_iter) {
+    ERROR("BG%d LS%d: single decoder carried out %d iterations on the last codeword, batched decoder %d",
+          bg + 1,
+          ls,
+          last_single,
+          decoder.last_nof_iter);
+    goto clean_exit;
+  }
+  uint32_t nof_ok = 0;
+  for (int i = 0; i < nof_cb; i++) {
+    if (iters_single[i] != iters_batch[i]) {
+      ERROR("BG%d LS%d codeword %d: single decoder used %d iterations, batched decoder %d",
+            bg + 1,
+            ls,
+            i,
+            iters_single[i],
+            iters_batch[i]);
+      goto clean_exit;
+    }
+    if (memcmp(messages_single + i * finalK, messages_batch + i * finalK, finalK) != 0) {
+      ERROR("BG%d LS%d codeword %d: single and batched decoded messages differ", bg + 1, ls, i);
+      goto clean_exit;
+    }
+    if (iters_single[i] > 0) {
+      nof_ok++;
+    }
+  }
+
+  double nof_bits = (double)finalK * nof_cb * nof_reps;
+  printf("  BG%d %5d %6d %8d/%-3d %12.1f %12.1f %8.2f\n",
+         bg + 1,
+         ls,
+         finalK,
+         nof_ok,
+         nof_cb,
+         nof_bits / elapsed_single / 1e6,
+         nof_bits / elapsed_batch / 1e6,
+         elapsed_single / elapsed_batch);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  free(msg_ptrs);
+  free(llr_ptrs);
+  free(iters_batch);
+  free(iters_single);
+  free(llrs);
+  free(symbols);
+  free(codewords);
+  free(messages_batch);
+  free(messages_single);
+  free(messages_true);
+  srsran_ldpc_decoder_free(&decoder);
+  srsran_ldpc_encoder_free(&encoder);
+
+  return ret;
+}
+
+/*!
+ * \brief Main test function.
+ */
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  if (nof_cb <= 0 || nof_reps <= 0 || base_graph < 0 || base_graph > 2) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_random_t random_gen = srsran_random_init(0);
+
+  printf("Batched LDPC decoder, %d codewords, SNR %.1f dB%s, throughput in Mbit/s per core:\n",
+         nof_cb,
+         snr,
+         early_stop ? ", syndrome early stop" : "");
+  printf("  BG      LS      K    CRC OK      single      batched  speedup\n");
+
+  int ret = SRSRAN_SUCCESS;
+  for (int bg = BG1; bg <= BG2 && ret == SRSRAN_SUCCESS; bg++) {
+    if (base_graph != 0 && base_graph != bg + 1) {
+      continue;
+    }
+    for (uint32_t i = 0; i < sizeof(all_lifting_sizes) / sizeof(all_lifting_sizes[0]) && ret == SRSRAN_SUCCESS; i++) {
+      if (lift_size != 0 && lift_size != all_lifting_sizes[i]) {
+        continue;
+      }
+      ret = run_test(random_gen, (srsran_basegraph_t)bg, all_lifting_sizes[i]);
+    }
+  }
+
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Test completed successfully!" : "Test failed!");
+  return ret;
+}
@@ -38,6 +38,7 @@
 #include <string.h>
 
 #include "polar_decoder_ssc_c.h"
+#include "polar_decoder_scl_f.h"
 #include "polar_decoder_ssc_c_avx2.h"
 #include "polar_decoder_ssc_f.h"
 #include "polar_decoder_ssc_s.h"
@@ -114,6 +115,74 @@ static int decode_ssc_c_avx2(void*           o,
 }
 #endif // LV_HAVE_AVX2
 
+/*! Fast-SSCL Polar decoder with float LLR inputs. */
+static int decode_list_scl_f(void*           o,
+                             const float*    symbols,
+                             uint8_t**       data,
+                             const uint8_t   n,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (init_polar_decoder_scl_f(q->ptr, symbols, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  return polar_decoder_scl_f(q->ptr, data, q->list_size);
+}
+
+/*! Fast-SSCL Polar decoder with int8_t LLR inputs. */
+static int decode_list_scl_c(void*           o,
+                             const int8_t*   symbols,
+                             uint8_t**       data,
+                             const uint8_t   n,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (init_polar_decoder_scl_c(q->ptr, symbols, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  return polar_decoder_scl_f(q->ptr, data, q->list_size);
+}
+
+/*! Fast-SSCL Polar decoder with float LLR inputs, only the most likely candidate is returned. */
+static int decode_scl_f(void*           o,
+                        const float*    symbols,
+                        uint8_t*        data,
+                        const uint8_t   n,
+                        const uint16_t* frozen_set,
+                        const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (init_polar_decoder_scl_f(q->ptr, symbols, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  return (polar_decoder_scl_f(q->ptr, &data, 1) == 1) ? 0 : -1;
+}
+
+/*! Fast-SSCL Polar decoder with int8_t LLR inputs, only the most likely candidate is returned. */
+static int decode_scl_c(void*           o,
+                        const int8_t*   symbols,
+                        uint8_t*        data,
+                        const uint8_t   n,
+                        const uint16_t* frozen_set,
+                        const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (init_polar_decoder_scl_c(q->ptr, symbols, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  return (polar_decoder_scl_f(q->ptr, &data, 1) == 1) ? 0 : -1;
+}
+
 /*! Destructor of a (float) SSC polar decoder. */
 static void free_ssc_f(void* o)
 {
@@ -144,6 +213,13 @@ static void free_ssc_c_avx2(void* o)
 }
 #endif
 
+/*! Destructor of a (float) Fast-SSCL polar decoder. */
+static void free_scl_f(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_scl_f(q->ptr);
+}
+
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
 static int init_ssc_f(srsran_polar_decoder_t* q)
 {
@@ -203,9 +279,29 @@ static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
 }
 #endif
 
+/*! Initializes a polar decoder structure to use the Fast-SSCL polar decoder algorithm with float LLR inputs. */
+static int init_scl_f(srsran_polar_decoder_t* q)
+{
+  q->decode_f      = decode_scl_f;
+  q->decode_c      = decode_scl_c;
+  q->decode_list_f = decode_list_scl_f;
+  q->decode_list_c = decode_list_scl_c;
+  q->free          = free_scl_f;
+
+  if ((q->ptr = create_polar_decoder_scl_f(q->nMax, q->list_size)) == NULL) {
+    ERROR("create_polar_decoder_scl_f failed");
+    free_scl_f(q);
+    return -1;
+  }
+  return 0;
+}
+
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
 {
-  q->nMax = nMax;
+  q->nMax          = nMax;
+  q->list_size     = 1;
+  q->decode_list_f = NULL;
+  q->decode_list_c = NULL;
   switch (type) {
     case SRSRAN_POLAR_DECODER_SSC_F:
       return init_ssc_f(q);
@@ -217,6 +313,9 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
 #endif
+    case SRSRAN_POLAR_DECODER_SCL_F:
+      q->list_size = SRSRAN_POLAR_DECODER_MAX_LIST_SIZE;
+      return init_scl_f(q);
     default:
       ERROR("Decoder not implemented");
       return -1;
@@ -224,6 +323,20 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
   return 0;
 }
 
+int srsran_polar_decoder_init_list(srsran_polar_decoder_t* q, const uint8_t nMax, const uint8_t list_size)
+{
+  if (list_size == 0 || list_size > SRSRAN_POLAR_DECODER_MAX_LIST_SIZE) {
+    ERROR("Invalid list size %d", list_size);
+    return -1;
+  }
+
+  q->nMax          = nMax;
+  q->list_size     = list_size;
+  q->decode_list_f = NULL;
+  q->decode_list_c = NULL;
+  return init_scl_f(q);
+}
+
 void srsran_polar_decoder_free(srsran_polar_decoder_t* q)
 {
   if (q->free) {
@@ -273,3 +386,39 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_list_f(srsran_polar_decoder_t* q,
+                                       const float*            llr,
+                                       uint8_t**               data_decoded,
+                                       const uint8_t           n,
+                                       const uint16_t*         frozen_set,
+                                       const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n) {
+    return -1;
+  }
+
+  if (q->decode_list_f == NULL) {
+    return (q->decode_f(q, llr, data_decoded[0], n, frozen_set, frozen_set_size) < 0) ? -1 : 1;
+  }
+
+  return q->decode_list_f(q, llr, data_decoded, n, frozen_set, frozen_set_size);
+}
+
+int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                       const int8_t*           llr,
+                                       uint8_t**               data_decoded,
+                                       const uint8_t           n,
+                                       const uint16_t*         frozen_set,
+                                       const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n) {
+    return -1;
+  }
+
+  if (q->decode_list_c == NULL) {
+    return (q->decode_c(q, llr, data_decoded[0], n, frozen_set, frozen_set_size) < 0) ? -1 : 1;
+  }
+
+  return q->decode_list_c(q, llr, data_decoded, n, frozen_set, frozen_set_size);
+}
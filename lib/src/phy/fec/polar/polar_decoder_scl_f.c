@@ -0,0 +1,873 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_f.c
+ * \brief Definition of the Fast-SSCL polar decoder inner functions working with float-valued LLRs.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ * The LLR and partial-sum buffers of every stage are shared by the paths that have not diverged since the stage was
+ * last written, and are only duplicated when a path writes on a shared buffer. Paths that still share their input
+ * buffers also share the output of functions f and g instead of computing it again.
+ *
+ * Inside a Rate-1, repetition or single parity-check node, the paths fork into a list of candidates that only
+ * record their decisions. The paths are cloned or removed once, when the node ends.
+ *
+ * The message bits are not stored: the partial sums of the root node of a path are its codeword, and the message
+ * is recovered by encoding them again.
+ *
+ */
+
+#include "polar_decoder_scl_f.h"
+#include "polar_decoder_vector.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/utils/vector.h"
+#include <math.h>
+#include <string.h>
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2
+
+#define MAX_LIST SRSRAN_POLAR_DECODER_MAX_LIST_SIZE
+
+/*!
+ * \brief Candidate paths inside a terminal node.
+ */
+struct Candidates {
+  float   pm[MAX_LIST] __attribute__((aligned(32)));     /*!< \brief Path metrics. */
+  float   pen[MAX_LIST] __attribute__((aligned(32)));    /*!< \brief Penalty of the next fork. */
+  uint8_t origin[MAX_LIST]; /*!< \brief Path each candidate descends from. */
+  uint8_t choice[MAX_LIST]; /*!< \brief Decisions taken by each candidate, one bit per fork. */
+  uint8_t parity[MAX_LIST]; /*!< \brief Single parity-check node: least reliable bit flipped. */
+  uint8_t count;            /*!< \brief Number of candidates. */
+};
+
+/*!
+ * \brief Describes a Fast-SSCL polar decoder (float version).
+ */
+struct pSCL_f {
+  uint8_t   nMax;          /*!< \brief \f$log_2\f$ of the maximum code size. */
+  uint8_t   list_size;     /*!< \brief Maximum number of paths. */
+  uint8_t   code_size_log; /*!< \brief \f$log_2\f$ of the current code size. */
+  uint8_t*  frozen;        /*!< \brief Frozen bit indicator of the current code. */
+  uint16_t* nof_frozen;    /*!< \brief Number of frozen bits before each position. */
+
+  float*   alpha_mem;                         /*!< \brief Memory of the LLR buffers. */
+  uint8_t* beta_mem;                          /*!< \brief Memory of the partial-sum buffers. */
+  float*   alpha[NMAX_LOG + 1][MAX_LIST];     /*!< \brief LLR buffers of every stage. */
+  uint8_t* beta[NMAX_LOG + 1][MAX_LIST];      /*!< \brief Partial-sum buffers of every stage. */
+  uint8_t  alpha_ref[NMAX_LOG + 1][MAX_LIST]; /*!< \brief Number of paths using each LLR buffer. */
+  uint8_t  beta_ref[NMAX_LOG + 1][MAX_LIST];  /*!< \brief Number of paths using each partial-sum buffer. */
+  uint8_t  alpha_idx[NMAX_LOG + 1][MAX_LIST]; /*!< \brief LLR buffer of each path and stage. */
+  uint8_t  beta_idx[NMAX_LOG + 1][MAX_LIST];  /*!< \brief Partial-sum buffer of each path and stage. */
+  float    pm[MAX_LIST];                      /*!< \brief Path metrics. */
+  bool     active[MAX_LIST];                  /*!< \brief Active path indicator. */
+
+  struct Candidates cand;                      /*!< \brief Candidates of the current node. */
+  uint8_t*          hard[MAX_LIST];            /*!< \brief Hard decisions of the current node, by LLR buffer. */
+  uint8_t           hard_parity[MAX_LIST];     /*!< \brief Parity of the hard decisions, by LLR buffer. */
+  uint16_t          weak[MAX_LIST][MAX_LIST];  /*!< \brief Least reliable positions, by LLR buffer. */
+  float             weak_abs[MAX_LIST][MAX_LIST]; /*!< \brief Magnitude of the least reliable LLRs, by LLR buffer. */
+  uint8_t*          hard_mem;                     /*!< \brief Memory of the hard decisions. */
+
+  srsran_polar_encoder_t enc; /*!< \brief Encoder used to recover the message from the codeword. */
+};
+
+/*! Returns a buffer that no path uses. */
+static uint8_t free_buffer(const uint8_t* ref, uint8_t list_size)
+{
+  uint8_t b = 0;
+  while (b < list_size - 1 && ref[b] != 0) {
+    b++;
+  }
+  return b;
+}
+
+/*! LLR buffer of path l at stage s, for reading. */
+static inline float* alpha_r(struct pSCL_f* pp, uint8_t s, uint8_t l)
+{
+  return pp->alpha[s][pp->alpha_idx[s][l]];
+}
+
+/*! Partial-sum buffer of path l at stage s, for reading. */
+static inline uint8_t* beta_r(struct pSCL_f* pp, uint8_t s, uint8_t l)
+{
+  return pp->beta[s][pp->beta_idx[s][l]];
+}
+
+/*! LLR buffer of path l at stage s, for writing. The buffer is detached from the other paths if it is shared. */
+static float* alpha_w(struct pSCL_f* pp, uint8_t s, uint8_t l)
+{
+  uint8_t b = pp->alpha_idx[s][l];
+  if (pp->alpha_ref[s][b] > 1) {
+    pp->alpha_ref[s][b]--;
+    b                   = free_buffer(pp->alpha_ref[s], pp->list_size);
+    pp->alpha_ref[s][b] = 1;
+    pp->alpha_idx[s][l] = b;
+  }
+  return pp->alpha[s][b];
+}
+
+/*! Partial-sum buffer of path l at stage s, for writing. A detached buffer keeps the content if keep is true. */
+static uint8_t* beta_w(struct pSCL_f* pp, uint8_t s, uint8_t l, bool keep)
+{
+  uint8_t b = pp->beta_idx[s][l];
+  if (pp->beta_ref[s][b] > 1) {
+    uint8_t old = b;
+    pp->beta_ref[s][b]--;
+    b                  = free_buffer(pp->beta_ref[s], pp->list_size);
+    pp->beta_ref[s][b] = 1;
+    pp->beta_idx[s][l] = b;
+    if (keep) {
+      memcpy(pp->beta[s][b], pp->beta[s][old], 1U << s);
+    }
+  }
+  return pp->beta[s][b];
+}
+
+/*! Makes path l use the LLR buffer of path m at stage s. */
+static inline void share_alpha(struct pSCL_f* pp, uint8_t s, uint8_t l, uint8_t m)
+{
+  pp->alpha_ref[s][pp->alpha_idx[s][l]]--;
+  pp->alpha_idx[s][l] = pp->alpha_idx[s][m];
+  pp->alpha_ref[s][pp->alpha_idx[s][l]]++;
+}
+
+/*! Makes path l use the partial-sum buffer of path m at stage s. */
+static inline void share_beta(struct pSCL_f* pp, uint8_t s, uint8_t l, uint8_t m)
+{
+  pp->beta_ref[s][pp->beta_idx[s][l]]--;
+  pp->beta_idx[s][l] = pp->beta_idx[s][m];
+  pp->beta_ref[s][pp->beta_idx[s][l]]++;
+}
+
+/*! Makes path dst a copy of path src that shares all its buffers. */
+static void clone_path(struct pSCL_f* pp, uint8_t src, uint8_t dst)
+{
+  for (uint8_t s = 0; s <= pp->code_size_log; s++) {
+    pp->alpha_idx[s][dst] = pp->alpha_idx[s][src];
+    pp->beta_idx[s][dst]  = pp->beta_idx[s][src];
+    pp->alpha_ref[s][pp->alpha_idx[s][src]]++;
+    pp->beta_ref[s][pp->beta_idx[s][src]]++;
+  }
+  pp->active[dst] = true;
+}
+
+/*! Releases the buffers of path l. */
+static void kill_path(struct pSCL_f* pp, uint8_t l)
+{
+  for (uint8_t s = 0; s <= pp->code_size_log; s++) {
+    pp->alpha_ref[s][pp->alpha_idx[s][l]]--;
+    pp->beta_ref[s][pp->beta_idx[s][l]]--;
+  }
+  pp->active[l] = false;
+}
+
+/*!
+ * Computes the path metric penalties of deciding all the bits with LLRs \a llr as 0 (\a pen0) and as 1 (\a pen1).
+ */
+static void penalties(const float* llr, uint16_t len, float* pen0, float* pen1)
+{
+  float    p0 = 0.0f;
+  float    p1 = 0.0f;
+  uint16_t i  = 0;
+
+#ifdef LV_HAVE_AVX2
+  if (len >= 8) {
+    __m256 zero = _mm256_setzero_ps();
+    __m256 acc0 = zero;
+    __m256 acc1 = zero;
+    for (; i + 8 <= len; i += 8) {
+      __m256 a = _mm256_loadu_ps(&llr[i]);
+      acc0     = _mm256_sub_ps(acc0, _mm256_min_ps(a, zero));
+      acc1     = _mm256_add_ps(acc1, _mm256_max_ps(a, zero));
+    }
+    float tmp0[8], tmp1[8];
+    _mm256_storeu_ps(tmp0, acc0);
+    _mm256_storeu_ps(tmp1, acc1);
+    for (uint32_t k = 0; k < 8; k++) {
+      p0 += tmp0[k];
+      p1 += tmp1[k];
+    }
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i < len; i++) {
+    p0 -= fminf(llr[i], 0.0f);
+    p1 += fmaxf(llr[i], 0.0f);
+  }
+
+  *pen0 = p0;
+  *pen1 = p1;
+}
+
+/*!
+ * Function f of the decoding tree (min-sum approximation), \f$z = sgn(x) sgn(y) min(|x|, |y|)\f$.
+ */
+static void function_f(const float* x, const float* y, float* z, uint16_t len)
+{
+#ifdef LV_HAVE_AVX2
+  if (len >= 8) {
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    for (uint16_t i = 0; i < len; i += 8) {
+      __m256 xv   = _mm256_loadu_ps(&x[i]);
+      __m256 yv   = _mm256_loadu_ps(&y[i]);
+      __m256 sign = _mm256_and_ps(_mm256_xor_ps(xv, yv), sign_mask);
+      __m256 mag  = _mm256_min_ps(_mm256_andnot_ps(sign_mask, xv), _mm256_andnot_ps(sign_mask, yv));
+      _mm256_storeu_ps(&z[i], _mm256_or_ps(mag, sign));
+    }
+    return;
+  }
+#endif // LV_HAVE_AVX2
+  srsran_vec_function_f_fff(x, y, z, len);
+}
+
+/*!
+ * Function g of the decoding tree, \f$z = y + (1 - 2b) x\f$.
+ */
+static void function_g(const uint8_t* b, const float* x, const float* y, float* z, uint16_t len)
+{
+#ifdef LV_HAVE_AVX2
+  if (len >= 8) {
+    for (uint16_t i = 0; i < len; i += 8) {
+      __m256i bv   = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&b[i]));
+      __m256  sign = _mm256_castsi256_ps(_mm256_slli_epi32(bv, 31));
+      __m256  xv   = _mm256_xor_ps(_mm256_loadu_ps(&x[i]), sign);
+      _mm256_storeu_ps(&z[i], _mm256_add_ps(_mm256_loadu_ps(&y[i]), xv));
+    }
+    return;
+  }
+#endif // LV_HAVE_AVX2
+  srsran_vec_function_g_bfff(b, x, y, z, len);
+}
+
+/*! Makes every active path a candidate of a new terminal node. */
+static void begin_node(struct pSCL_f* pp)
+{
+  struct Candidates* c = &pp->cand;
+
+  c->count = 0;
+  for (uint8_t l = 0; l < pp->list_size; l++) {
+    if (pp->active[l]) {
+      c->pm[c->count]     = pp->pm[l];
+      c->origin[c->count] = l;
+      c->choice[c->count] = 0;
+      c->parity[c->count] = 0;
+      c->count++;
+    }
+  }
+}
+
+/*! Sorts the indexes 0 to n - 1 of metric m in order. */
+static inline void sort_metrics(const float* m, uint8_t n, uint8_t* order)
+{
+  for (uint8_t i = 0; i < n; i++) {
+    uint8_t j = i;
+    for (; j > 0 && m[order[j - 1]] > m[i]; j--) {
+      order[j] = order[j - 1];
+    }
+    order[j] = i;
+  }
+}
+
+/*!
+ * Every candidate forks into two: one that keeps its metric and one that adds the penalty in \a pen and sets bit
+ * \a bit of its choice. The best \a list_size candidates survive, sorted by metric.
+ */
+static void fork_candidates(struct pSCL_f* pp, uint8_t bit)
+{
+  struct Candidates* c = &pp->cand;
+  float              m1[MAX_LIST] __attribute__((aligned(32)));
+  uint8_t            order0[MAX_LIST];
+  uint8_t            order1[MAX_LIST];
+  uint8_t            n         = SRSRAN_MIN(c->count, MAX_LIST);
+  uint8_t            max_count = SRSRAN_MIN(pp->list_size, MAX_LIST);
+
+#ifdef LV_HAVE_AVX2
+  _mm256_store_ps(m1, _mm256_add_ps(_mm256_load_ps(c->pm), _mm256_load_ps(c->pen)));
+#else  // LV_HAVE_AVX2
+  for (uint8_t i = 0; i < MAX_LIST; i++) {
+    m1[i] = c->pm[i] + c->pen[i];
+  }
+#endif // LV_HAVE_AVX2
+
+  // Merge the candidates that keep their decisions with the ones that fork, both sorted by metric
+  sort_metrics(c->pm, n, order0);
+  sort_metrics(m1, n, order1);
+
+  struct Candidates next;
+  uint8_t           i0 = 0;
+  uint8_t           i1 = 0;
+  next.count         = 0;
+  while (next.count < max_count && (i0 < n || i1 < n)) {
+    uint8_t k    = 0;
+    bool    fork = (i0 == n) || (i1 < n && m1[order1[i1]] < c->pm[order0[i0]]);
+    if (fork) {
+      k                       = order1[i1++];
+      next.pm[next.count]     = m1[k];
+      next.choice[next.count] = c->choice[k] | (uint8_t)(1U << bit);
+    } else {
+      k                       = order0[i0++];
+      next.pm[next.count]     = c->pm[k];
+      next.choice[next.count] = c->choice[k];
+    }
+    next.origin[next.count] = c->origin[k];
+    next.parity[next.count] = c->parity[k];
+    next.count++;
+  }
+
+  memcpy(c->pm, next.pm, next.count * sizeof(float));
+  memcpy(c->origin, next.origin, next.count);
+  memcpy(c->choice, next.choice, next.count);
+  memcpy(c->parity, next.parity, next.count);
+  c->count = next.count;
+}
+
+/*!
+ * Turns the candidates into paths: paths without candidates are removed, the first candidate of a path takes it
+ * over and the other ones clone it. \a slot gets the path of every candidate.
+ */
+static void end_node(struct pSCL_f* pp, uint8_t* slot)
+{
+  struct Candidates* c = &pp->cand;
+  bool               used[MAX_LIST] = {};
+
+  for (uint8_t i = 0; i < c->count; i++) {
+    slot[i] = MAX_LIST;
+    if (!used[c->origin[i]]) {
+      used[c->origin[i]] = true;
+      slot[i]            = c->origin[i];
+    }
+  }
+
+  for (uint8_t l = 0; l < pp->list_size; l++) {
+    if (pp->active[l] && !used[l]) {
+      kill_path(pp, l);
+    }
+  }
+
+  for (uint8_t i = 0; i < c->count; i++) {
+    if (slot[i] == MAX_LIST) {
+      uint8_t dst = 0;
+      while (pp->active[dst]) {
+        dst++;
+      }
+      clone_path(pp, c->origin[i], dst);
+      slot[i] = dst;
+    }
+    pp->pm[slot[i]] = c->pm[i];
+  }
+}
+
+/*! Inserts the LLR magnitude a of position k in the sorted list of the nof_weak least reliable ones. */
+static inline void insert_weak(uint16_t* weak, float* wabs, uint8_t nof_weak, float a, uint16_t k)
+{
+  if (nof_weak == 0 || !(a < wabs[nof_weak - 1])) {
+    return;
+  }
+  uint8_t j = nof_weak - 1;
+  for (; j > 0 && wabs[j - 1] > a; j--) {
+    wabs[j] = wabs[j - 1];
+    weak[j] = weak[j - 1];
+  }
+  wabs[j] = a;
+  weak[j] = k;
+}
+
+/*!
+ * Finds the hard decisions of the LLRs at stage s, their parity and the positions of the nof_weak least reliable
+ * ones, once for every LLR buffer used by the candidates.
+ */
+static void hard_and_weak(struct pSCL_f* pp, uint8_t s, uint8_t nof_weak)
+{
+  uint16_t size           = 1U << s;
+  bool     done[MAX_LIST] = {};
+
+  for (uint8_t i = 0; i < pp->cand.count; i++) {
+    uint8_t b = pp->alpha_idx[s][pp->cand.origin[i]];
+    if (done[b]) {
+      continue;
+    }
+    done[b] = true;
+
+    const float* llr    = pp->alpha[s][b];
+    uint8_t*     hard   = pp->hard[b];
+    uint16_t*    weak   = pp->weak[b];
+    float*       wabs   = pp->weak_abs[b];
+    uint32_t     parity = 0;
+    uint16_t     k      = 0;
+
+    for (uint8_t t = 0; t < nof_weak; t++) {
+      wabs[t] = INFINITY;
+      weak[t] = 0;
+    }
+
+#ifdef LV_HAVE_AVX2
+    // Most LLRs are more reliable than the ones in the list, skip them 8 at a time
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    for (; k + 8 <= size; k += 8) {
+      __m256   v    = _mm256_loadu_ps(&llr[k]);
+      uint32_t sign = (uint32_t)_mm256_movemask_ps(v);
+      parity += __builtin_popcount(sign);
+
+      // Sign bits to bytes
+      __m256i bits = _mm256_srli_epi32(_mm256_castps_si256(v), 31);
+      __m128i w    = _mm_packs_epi32(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1));
+      _mm_storel_epi64((__m128i*)&hard[k], _mm_packs_epi16(w, w));
+
+      if (nof_weak > 0) {
+        __m256   a    = _mm256_andnot_ps(sign_mask, v);
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a, _mm256_set1_ps(wabs[nof_weak - 1]), _CMP_LT_OQ));
+        while (mask) {
+          uint32_t j = __builtin_ctz(mask);
+          insert_weak(weak, wabs, nof_weak, fabsf(llr[k + j]), k + j);
+          mask &= mask - 1;
+        }
+      }
+    }
+#endif // LV_HAVE_AVX2
+
+    for (; k < size; k++) {
+      hard[k] = signbit(llr[k]) ? 1 : 0;
+      parity += hard[k];
+      insert_weak(weak, wabs, nof_weak, fabsf(llr[k]), k);
+    }
+    pp->hard_parity[b] = parity & 1U;
+  }
+}
+
+/*! All the bits of a Rate-0 node are frozen: they are 0 and every path pays for the LLRs contradicting them. */
+static void rate_0_node(struct pSCL_f* pp, uint8_t s)
+{
+  uint16_t size = 1U << s;
+  for (uint8_t l = 0; l < pp->list_size; l++) {
+    if (pp->active[l]) {
+      float pen0 = 0.0f;
+      float pen1 = 0.0f;
+      penalties(alpha_r(pp, s, l), size, &pen0, &pen1);
+      pp->pm[l] += pen0;
+      memset(beta_w(pp, s, l, false), 0, size);
+    }
+  }
+}
+
+/*!
+ * No bit of a Rate-1 node is frozen: every path forks by flipping, one at a time, its \f$min(L-1, 2^s)\f$ least
+ * reliable hard decisions.
+ */
+static void rate_1_node(struct pSCL_f* pp, uint8_t s)
+{
+  struct Candidates* c        = &pp->cand;
+  uint16_t           size     = 1U << s;
+  uint8_t            nof_weak = (pp->list_size - 1 < size) ? pp->list_size - 1 : size;
+
+  begin_node(pp);
+  hard_and_weak(pp, s, nof_weak);
+
+  for (uint8_t t = 0; t < nof_weak; t++) {
+    for (uint8_t i = 0; i < c->count; i++) {
+      c->pen[i] = pp->weak_abs[pp->alpha_idx[s][c->origin[i]]][t];
+    }
+    fork_candidates(pp, t);
+  }
+
+  // Take the decisions before the paths are cloned, which changes their LLR buffers
+  uint8_t buf[MAX_LIST];
+  for (uint8_t i = 0; i < c->count; i++) {
+    buf[i] = pp->alpha_idx[s][c->origin[i]];
+  }
+
+  uint8_t slot[MAX_LIST];
+  end_node(pp, slot);
+
+  for (uint8_t i = 0; i < c->count; i++) {
+    uint8_t* beta = beta_w(pp, s, slot[i], false);
+    memcpy(beta, pp->hard[buf[i]], size);
+    for (uint8_t t = 0; t < nof_weak; t++) {
+      beta[pp->weak[buf[i]][t]] ^= (c->choice[i] >> t) & 1U;
+    }
+  }
+}
+
+/*! All the bits of a repetition node but the last one are frozen: the node is all zeros or all ones. */
+static void rep_node(struct pSCL_f* pp, uint8_t s)
+{
+  struct Candidates* c    = &pp->cand;
+  uint16_t           size = 1U << s;
+
+  begin_node(pp);
+  for (uint8_t i = 0; i < c->count; i++) {
+    float pen0 = 0.0f;
+    float pen1 = 0.0f;
+    penalties(alpha_r(pp, s, c->origin[i]), size, &pen0, &pen1);
+    c->pm[i] += pen0;
+    c->pen[i] = pen1 - pen0;
+  }
+  fork_candidates(pp, 0);
+
+  uint8_t slot[MAX_LIST];
+  end_node(pp, slot);
+
+  for (uint8_t i = 0; i < c->count; i++) {
+    memset(beta_w(pp, s, slot[i], false), c->choice[i] & 1U, size);
+  }
+}
+
+/*!
+ * Only the first bit of a single parity-check node is frozen: the node bits have even parity. The least reliable
+ * bit is flipped to satisfy the parity, and every path forks by flipping, one at a time, its next \f$min(L, 2^s)-1\f$
+ * least reliable hard decisions together with the least reliable one.
+ */
+static void spc_node(struct pSCL_f* pp, uint8_t s)
+{
+  struct Candidates* c        = &pp->cand;
+  uint16_t           size     = 1U << s;
+  uint8_t            nof_weak = (pp->list_size < size) ? pp->list_size : size;
+
+  begin_node(pp);
+  hard_and_weak(pp, s, nof_weak);
+
+  for (uint8_t i = 0; i < c->count; i++) {
+    uint8_t b    = pp->alpha_idx[s][c->origin[i]];
+    c->parity[i] = pp->hard_parity[b];
+    if (c->parity[i]) {
+      c->pm[i] += pp->weak_abs[b][0];
+    }
+  }
+
+  for (uint8_t t = 1; t < nof_weak; t++) {
+    for (uint8_t i = 0; i < c->count; i++) {
+      const float* wabs = pp->weak_abs[pp->alpha_idx[s][c->origin[i]]];
+      c->pen[i]         = wabs[t] + (c->parity[i] ? -wabs[0] : wabs[0]);
+    }
+    fork_candidates(pp, t);
+    for (uint8_t i = 0; i < c->count; i++) {
+      c->parity[i] ^= (c->choice[i] >> t) & 1U;
+    }
+  }
+
+  uint8_t buf[MAX_LIST];
+  for (uint8_t i = 0; i < c->count; i++) {
+    buf[i] = pp->alpha_idx[s][c->origin[i]];
+  }
+
+  uint8_t slot[MAX_LIST];
+  end_node(pp, slot);
+
+  for (uint8_t i = 0; i < c->count; i++) {
+    uint8_t* beta = beta_w(pp, s, slot[i], false);
+    memcpy(beta, pp->hard[buf[i]], size);
+    for (uint8_t t = 1; t < nof_weak; t++) {
+      beta[pp->weak[buf[i]][t]] ^= (c->choice[i] >> t) & 1U;
+    }
+    beta[pp->weak[buf[i]][0]] ^= c->parity[i];
+  }
+}
+
+/*! Decodes the node at stage s whose first bit is pos. */
+static void scl_node(struct pSCL_f* pp, uint8_t s, uint16_t pos)
+{
+  uint16_t size       = 1U << s;
+  uint16_t nof_frozen = pp->nof_frozen[pos + size] - pp->nof_frozen[pos];
+
+  if (nof_frozen == size) {
+    rate_0_node(pp, s);
+    return;
+  }
+  if (nof_frozen == 0) {
+    rate_1_node(pp, s);
+    return;
+  }
+  if (nof_frozen == size - 1 && !pp->frozen[pos + size - 1]) {
+    rep_node(pp, s);
+    return;
+  }
+  if (nof_frozen == 1 && pp->frozen[pos] && s >= 2) {
+    spc_node(pp, s);
+    return;
+  }
+
+  // Rate-R node: decode the left child with f, the right child with g and combine their partial sums. Paths with
+  // the same inputs share the outputs.
+  uint16_t half = size / 2;
+  uint8_t  L    = pp->list_size;
+
+  for (uint8_t l = 0; l < L; l++) {
+    if (!pp->active[l]) {
+      continue;
+    }
+    uint8_t m = 0;
+    while (m < l && !(pp->active[m] && pp->alpha_idx[s][m] == pp->alpha_idx[s][l])) {
+      m++;
+    }
+    if (m < l) {
+      share_alpha(pp, s - 1, l, m);
+    } else {
+      const float* llr = alpha_r(pp, s, l);
+      function_f(llr, &llr[half], alpha_w(pp, s - 1, l), half);
+    }
+  }
+
+  scl_node(pp, s - 1, pos);
+
+  for (uint8_t l = 0; l < L; l++) {
+    if (!pp->active[l]) {
+      continue;
+    }
+    uint8_t m = 0;
+    while (m < l && !(pp->active[m] && pp->beta_idx[s - 1][m] == pp->beta_idx[s - 1][l])) {
+      m++;
+    }
+    if (m < l) {
+      share_beta(pp, s, l, m);
+    } else {
+      memcpy(beta_w(pp, s, l, false), beta_r(pp, s - 1, l), half);
+    }
+  }
+
+  for (uint8_t l = 0; l < L; l++) {
+    if (!pp->active[l]) {
+      continue;
+    }
+    uint8_t m = 0;
+    while (m < l && !(pp->active[m] && pp->alpha_idx[s][m] == pp->alpha_idx[s][l] &&
+                      pp->beta_idx[s][m] == pp->beta_idx[s][l])) {
+      m++;
+    }
+    if (m < l) {
+      share_alpha(pp, s - 1, l, m);
+    } else {
+      const float* llr = alpha_r(pp, s, l);
+      function_g(beta_r(pp, s, l), llr, &llr[half], alpha_w(pp, s - 1, l), half);
+    }
+  }
+
+  scl_node(pp, s - 1, pos + half);
+
+  uint8_t beta_left[MAX_LIST];
+  memcpy(beta_left, pp->beta_idx[s], L);
+  for (uint8_t l = 0; l < L; l++) {
+    if (!pp->active[l]) {
+      continue;
+    }
+    uint8_t m = 0;
+    while (m < l &&
+           !(pp->active[m] && beta_left[m] == beta_left[l] && pp->beta_idx[s - 1][m] == pp->beta_idx[s - 1][l])) {
+      m++;
+    }
+    if (m < l) {
+      share_beta(pp, s, l, m);
+    } else {
+      uint8_t*       beta       = beta_w(pp, s, l, true);
+      const uint8_t* beta_right = beta_r(pp, s - 1, l);
+      srsran_vec_xor_bbb(beta, beta_right, beta, half);
+      memcpy(&beta[half], beta_right, half);
+    }
+  }
+}
+
+/*! Resets the paths and the frozen set before decoding a new codeword. */
+static int init_paths(struct pSCL_f*  pp,
+                      const uint8_t   code_size_log,
+                      const uint16_t* frozen_set,
+                      const uint16_t  frozen_set_size)
+{
+  if (code_size_log > pp->nMax) {
+    return -1;
+  }
+
+  uint16_t code_size = 1U << code_size_log;
+  pp->code_size_log  = code_size_log;
+
+  memset(pp->frozen, 0, code_size);
+  for (uint16_t i = 0; i < frozen_set_size; i++) {
+    if (frozen_set[i] >= code_size) {
+      return -1;
+    }
+    pp->frozen[frozen_set[i]] = 1;
+  }
+  pp->nof_frozen[0] = 0;
+  for (uint16_t i = 0; i < code_size; i++) {
+    pp->nof_frozen[i + 1] = pp->nof_frozen[i] + pp->frozen[i];
+  }
+
+  memset(pp->alpha_ref, 0, sizeof(pp->alpha_ref));
+  memset(pp->beta_ref, 0, sizeof(pp->beta_ref));
+  for (uint8_t s = 0; s <= code_size_log; s++) {
+    pp->alpha_idx[s][0] = 0;
+    pp->beta_idx[s][0]  = 0;
+    pp->alpha_ref[s][0] = 1;
+    pp->beta_ref[s][0]  = 1;
+  }
+  for (uint8_t l = 0; l < MAX_LIST; l++) {
+    pp->active[l] = false;
+    pp->pm[l]     = 0.0f;
+  }
+  pp->active[0] = true;
+
+  // The penalties of the candidates that do not exist are never selected
+  for (uint8_t i = 0; i < MAX_LIST; i++) {
+    pp->cand.pm[i]  = 0.0f;
+    pp->cand.pen[i] = 0.0f;
+  }
+
+  return 0;
+}
+
+int init_polar_decoder_scl_f(void*           p,
+                             const float*    llr,
+                             const uint8_t   code_size_log,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size)
+{
+  struct pSCL_f* pp = p;
+
+  if (pp == NULL || llr == NULL || init_paths(pp, code_size_log, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  srsran_vec_f_copy(pp->alpha[code_size_log][0], llr, 1U << code_size_log);
+
+  return 0;
+}
+
+int init_polar_decoder_scl_c(void*           p,
+                             const int8_t*   llr,
+                             const uint8_t   code_size_log,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size)
+{
+  struct pSCL_f* pp = p;
+
+  if (pp == NULL || llr == NULL || init_paths(pp, code_size_log, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  float* alpha = pp->alpha[code_size_log][0];
+  for (uint16_t i = 0; i < (1U << code_size_log); i++) {
+    alpha[i] = (float)llr[i];
+  }
+
+  return 0;
+}
+
+int polar_decoder_scl_f(void* p, uint8_t** data_decoded, const uint8_t max_candidates)
+{
+  struct pSCL_f* pp = p;
+
+  if (pp == NULL || data_decoded == NULL) {
+    return -1;
+  }
+
+  uint8_t n = pp->code_size_log;
+
+  scl_node(pp, n, 0);
+
+  // Sort the surviving paths by metric
+  uint8_t order[MAX_LIST];
+  uint8_t nof_paths = 0;
+  for (uint8_t l = 0; l < pp->list_size; l++) {
+    if (pp->active[l]) {
+      uint8_t j = nof_paths++;
+      for (; j > 0 && pp->pm[order[j - 1]] > pp->pm[l]; j--) {
+        order[j] = order[j - 1];
+      }
+      order[j] = l;
+    }
+  }
+
+  // The partial sums of the root node are the codeword of the path, encoding them again gives the message
+  uint8_t nof_candidates = (nof_paths < max_candidates) ? nof_paths : max_candidates;
+  for (uint8_t k = 0; k < nof_candidates; k++) {
+    srsran_polar_encoder_encode(&pp->enc, beta_r(pp, n, order[k]), data_decoded[k], n);
+  }
+
+  return nof_candidates;
+}
+
+void delete_polar_decoder_scl_f(void* p)
+{
+  struct pSCL_f* pp = p;
+
+  if (pp != NULL) {
+    free(pp->frozen);
+    free(pp->nof_frozen);
+    free(pp->alpha_mem);
+    free(pp->beta_mem);
+    free(pp->hard_mem);
+    srsran_polar_encoder_free(&pp->enc);
+    free(pp);
+  }
+}
+
+void* create_polar_decoder_scl_f(const uint8_t nMax, const uint8_t list_size)
+{
+  if (nMax > NMAX_LOG || list_size == 0 || list_size > MAX_LIST) {
+    return NULL;
+  }
+
+  struct pSCL_f* pp = NULL;
+  if (posix_memalign((void**)&pp, 32, sizeof(struct pSCL_f))) {
+    return NULL;
+  }
+  memset(pp, 0, sizeof(struct pSCL_f));
+
+  pp->nMax      = nMax;
+  pp->list_size = list_size;
+
+  uint32_t code_size = 1U << nMax;
+
+  // Every buffer holds the stages 0 to nMax, stage s starts at offset 2^s
+  pp->alpha_mem  = srsran_vec_f_malloc(2 * code_size * list_size);
+  pp->beta_mem   = srsran_vec_u8_malloc(2 * code_size * list_size);
+  pp->frozen     = srsran_vec_u8_malloc(code_size);
+  pp->nof_frozen = srsran_vec_u16_malloc(code_size + 1);
+  pp->hard_mem   = srsran_vec_u8_malloc(code_size * list_size);
+  if (pp->alpha_mem == NULL || pp->beta_mem == NULL || pp->frozen == NULL || pp->nof_frozen == NULL ||
+      pp->hard_mem == NULL) {
+    delete_polar_decoder_scl_f(pp);
+    return NULL;
+  }
+
+#ifdef LV_HAVE_AVX2
+  srsran_polar_encoder_type_t enc_type = SRSRAN_POLAR_ENCODER_AVX2;
+#else  // LV_HAVE_AVX2
+  srsran_polar_encoder_type_t enc_type = SRSRAN_POLAR_ENCODER_PIPELINED;
+#endif // LV_HAVE_AVX2
+  if (srsran_polar_encoder_init(&pp->enc, enc_type, nMax) < 0) {
+    delete_polar_decoder_scl_f(pp);
+    return NULL;
+  }
+
+  for (uint8_t b = 0; b < list_size; b++) {
+    for (uint8_t s = 0; s <= nMax; s++) {
+      pp->alpha[s][b] = &pp->alpha_mem[2 * code_size * b + (1U << s)];
+      pp->beta[s][b]  = &pp->beta_mem[2 * code_size * b + (1U << s)];
+    }
+    pp->hard[b] = &pp->hard_mem[code_size * b];
+  }
+
+  return pp;
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_f.h
+ * \brief Declaration of the Fast-SSC list (Fast-SSCL) polar decoder inner functions working with
+ * float-valued LLRs.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ * The decoder keeps up to \f$L\f$ decoding paths, ordered by path metric, and decodes Rate-0, Rate-1, repetition
+ * and single parity-check nodes without descending to the leaves of the decoding tree (see G. Sarkis et al.,
+ * "Fast list decoders for polar codes", IEEE JSAC, 2016 and S. A. Hashemi et al., "Fast and flexible successive
+ * cancellation list decoders for polar codes", IEEE TSP, 2017).
+ *
+ */
+
+#ifndef POLAR_DECODER_SCL_F_H
+#define POLAR_DECODER_SCL_F_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!
+ * Creates a Fast-SSCL polar decoder structure of type pSCL_f, and allocates memory for the decoding buffers.
+ * \param[in] nMax \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] list_size Maximum number of decoding paths, from 1 to ::SRSRAN_POLAR_DECODER_MAX_LIST_SIZE.
+ * \return A pointer to a pSCL_f structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_scl_f(const uint8_t nMax, const uint8_t list_size);
+
+/*!
+ * The polar decoder SCL "destructor": it frees all the resources allocated to the decoder.
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_scl_f(void* p);
+
+/*!
+ * Initializes a Fast-SSCL polar decoder before processing a new codeword.
+ * \param[in, out] p A void pointer used to declare a pSCL_f structure.
+ * \param[in] llr LLRs for the new codeword.
+ * \param[in] code_size_log \f$\log_2(code_size)\f$.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_polar_decoder_scl_f(void*           p,
+                             const float*    llr,
+                             const uint8_t   code_size_log,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size);
+
+/*!
+ * Same as init_polar_decoder_scl_f() but with 8-bit LLRs, which are converted to float.
+ * \param[in, out] p A void pointer used to declare a pSCL_f structure.
+ * \param[in] llr LLRs for the new codeword.
+ * \param[in] code_size_log \f$\log_2(code_size)\f$.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_polar_decoder_scl_c(void*           p,
+                             const int8_t*   llr,
+                             const uint8_t   code_size_log,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size);
+
+/*!
+ * Decodes the codeword loaded by init_polar_decoder_scl_f() or init_polar_decoder_scl_c() and writes the
+ * surviving candidates in increasing path metric order, that is, the most likely message first.
+ * \param[in] p A pointer to the desired decoder.
+ * \param[out] data_decoded Array of pointers to the candidate messages, \f$2^{code\_size\_log}\f$ bits each.
+ * \param[in] max_candidates Number of pointers in \a data_decoded.
+ * \return The number of candidates written if the function executes correctly, -1 otherwise.
+ */
+int polar_decoder_scl_f(void* p, uint8_t** data_decoded, const uint8_t max_candidates);
+
+#endif // POLAR_DECODER_SCL_F_H
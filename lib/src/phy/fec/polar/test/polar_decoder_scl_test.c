@@ -0,0 +1,281 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_test.c
+ * \brief Compares the CRC-aided Fast-SSC list decoder with the 8-bit SSC decoder used by the NR UCI receiver.
+ *
+ * Random messages with an 11-bit CRC (or a 6-bit CRC if they are shorter than 20 bits) are encoded,
+ * rate-matched, 2-PAM modulated, sent over an AWGN channel, rate-dematched, quantized to 8 bits and decoded by both
+ * decoders. The list decoder picks the most likely candidate that passes the CRC, as the UCI receiver does. The
+ * test reports the WER and the average latency per codeword of each decoder, and fails if the list decoder makes
+ * more word errors than the SSC decoder, or any error without noise.
+ *
+ * Synopsis: **polar_decoder_scl_test [options]**
+ *
+ * Options:
+ *
+ *  - <b>-n \<number\></b> nMax, [Default 10].
+ *  - <b>-k \<number\></b> Message size (K) including the CRC, [Default 40].
+ *  - <b>-e \<number\></b> Rate matching size (E), [Default 128].
+ *  - <b>-i \<number\></b> Enable bit interleaver, [Default 1].
+ *  - <b>-s \<number\></b> SNR [dB, Default 1.00 dB] -- Use 101 for noiseless.
+ *  - <b>-l \<number\></b> List size, [Default 8].
+ *  - <b>-w \<number\></b> Number of codewords, [Default 1000].
+ *
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/polar/polar_chanalloc.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/fec/polar/polar_rm.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+static uint16_t K         = 40;   /*!< \brief Number of message bits (data and CRC). */
+static uint16_t E         = 128;  /*!< \brief Number of bits of the codeword after rate matching. */
+static uint8_t  nMax      = 10;   /*!< \brief Maximum \f$log_2(N)\f$. */
+static uint8_t  bil       = 1;    /*!< \brief If bil = 0 channel interleaver disabled. */
+static double   snr_db    = 1.0;  /*!< \brief SNR in dB (101 for no noise). */
+static uint8_t  list_size = 8;    /*!< \brief Number of paths of the list decoder. */
+static uint32_t nof_words = 1000; /*!< \brief Number of simulated codewords. */
+
+void usage(char* prog)
+{
+  printf("Usage: %s [-nX] [-kX] [-eX] [-iX] [-sX] [-lX] [-wX]\n", prog);
+  printf("\t-n nMax [Default %d]\n", nMax);
+  printf("\t-k Message size, including the CRC [Default %d]\n", K);
+  printf("\t-e Rate matching size [Default %d]\n", E);
+  printf("\t-i Bit interleaver indicator [Default %d]\n", bil);
+  printf("\t-s SNR [dB, Default %.2f dB] -- Use 101 for noiseless\n", snr_db);
+  printf("\t-l List size [Default %d]\n", list_size);
+  printf("\t-w Number of codewords [Default %d]\n", nof_words);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "n:k:e:i:s:l:w:")) != -1) {
+    switch (opt) {
+      case 'n':
+        nMax = (uint8_t)strtol(optarg, NULL, 10);
+        break;
+      case 'k':
+        K = (uint16_t)strtol(optarg, NULL, 10);
+        break;
+      case 'e':
+        E = (uint16_t)strtol(optarg, NULL, 10);
+        break;
+      case 'i':
+        bil = (uint8_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(optarg, NULL);
+        break;
+      case 'l':
+        list_size = (uint8_t)strtol(optarg, NULL, 10);
+        break;
+      case 'w':
+        nof_words = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  uint32_t     L = (K < 20 + 6) ? 6 : 11;
+  srsran_crc_t crc;
+  if (srsran_crc_init(&crc, (L == 6) ? SRSRAN_LTE_CRC6 : SRSRAN_LTE_CRC11, L) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising CRC");
+    return SRSRAN_ERROR;
+  }
+
+  srsran_polar_code_t    code    = {};
+  srsran_polar_encoder_t enc     = {};
+  srsran_polar_decoder_t dec_ssc = {};
+  srsran_polar_decoder_t dec_scl = {};
+  srsran_polar_rm_t      rm_tx   = {};
+  srsran_polar_rm_t      rm_rx   = {};
+
+#ifdef LV_HAVE_AVX2
+  srsran_polar_decoder_type_t ssc_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+#else  // LV_HAVE_AVX2
+  srsran_polar_decoder_type_t ssc_type = SRSRAN_POLAR_DECODER_SSC_C;
+#endif // LV_HAVE_AVX2
+
+  if (srsran_polar_code_init(&code) < SRSRAN_SUCCESS || srsran_polar_code_get(&code, K, E, nMax) < SRSRAN_SUCCESS ||
+      srsran_polar_encoder_init(&enc, SRSRAN_POLAR_ENCODER_PIPELINED, nMax) < SRSRAN_SUCCESS ||
+      srsran_polar_decoder_init(&dec_ssc, ssc_type, nMax) < SRSRAN_SUCCESS ||
+      srsran_polar_decoder_init_list(&dec_scl, nMax, list_size) < SRSRAN_SUCCESS ||
+      srsran_polar_rm_tx_init(&rm_tx) < SRSRAN_SUCCESS || srsran_polar_rm_rx_init_c(&rm_rx) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising polar chain");
+    return SRSRAN_ERROR;
+  }
+
+  uint8_t* data_tx     = srsran_vec_u8_malloc(K);
+  uint8_t* data_rx     = srsran_vec_u8_malloc(K);
+  uint8_t* input_enc   = srsran_vec_u8_malloc(NMAX);
+  uint8_t* output_enc  = srsran_vec_u8_malloc(NMAX);
+  uint8_t* rm_codeword = srsran_vec_u8_malloc(E);
+  float*   rm_llr      = srsran_vec_f_malloc(E);
+  int8_t*  rm_llr_c    = srsran_vec_i8_malloc(E);
+  int8_t*  llr_c       = srsran_vec_i8_malloc(NMAX);
+  uint8_t* output_ssc  = srsran_vec_u8_malloc(NMAX);
+  uint8_t* output_mem  = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_MAX_LIST_SIZE);
+  if (!data_tx || !data_rx || !input_enc || !output_enc || !rm_codeword || !rm_llr || !rm_llr_c || !llr_c ||
+      !output_ssc || !output_mem) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  uint8_t* output_scl[SRSRAN_POLAR_DECODER_MAX_LIST_SIZE];
+  for (uint32_t i = 0; i < SRSRAN_POLAR_DECODER_MAX_LIST_SIZE; i++) {
+    output_scl[i] = &output_mem[NMAX * i];
+  }
+
+  srsran_random_t random_gen = srsran_random_init(0);
+  bool            noiseless  = (snr_db == 101.0);
+  float           var        = srsran_convert_dB_to_power(-snr_db);
+  float           gain_c     = noiseless ? 32.0f : 127.0f * var / 20.0f / (1.0f / var + 2.0f);
+
+  uint32_t       errors_ssc = 0;
+  uint32_t       errors_scl = 0;
+  double         time_ssc   = 0;
+  double         time_scl   = 0;
+  struct timeval t[3];
+
+  for (uint32_t w = 0; w < nof_words; w++) {
+    for (uint32_t j = 0; j < K - L; j++) {
+      data_tx[j] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_crc_attach(&crc, data_tx, K - L);
+
+    srsran_polar_chanalloc_tx(data_tx, input_enc, code.N, code.K, code.nPC, code.K_set, code.PC_set);
+    srsran_polar_encoder_encode(&enc, input_enc, output_enc, code.n);
+    srsran_polar_rm_tx(&rm_tx, output_enc, rm_codeword, code.n, E, K, bil);
+
+    for (uint32_t j = 0; j < E; j++) {
+      rm_llr[j] = rm_codeword[j] ? -1 : 1;
+    }
+    if (!noiseless) {
+      srsran_ch_awgn_f(rm_llr, rm_llr, var, E);
+      srsran_vec_sc_prod_fff(rm_llr, 2 / (var * var), rm_llr, E);
+    }
+    srsran_vec_quant_fc(rm_llr, rm_llr_c, gain_c, 0, 127, E);
+    srsran_polar_rm_rx_c(&rm_rx, rm_llr_c, llr_c, E, code.n, K, bil);
+
+    // SSC decoder
+    gettimeofday(&t[1], NULL);
+    srsran_polar_decoder_decode_c(&dec_ssc, llr_c, output_ssc, code.n, code.F_set, code.F_set_size);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    time_ssc += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+    srsran_polar_chanalloc_rx(output_ssc, data_rx, code.K, code.nPC, code.K_set, code.PC_set);
+    if (srsran_bit_diff(data_tx, data_rx, K) != 0) {
+      errors_ssc++;
+    }
+
+    // CRC-aided list decoder
+    gettimeofday(&t[1], NULL);
+    int nof_candidates =
+        srsran_polar_decoder_decode_list_c(&dec_scl, llr_c, output_scl, code.n, code.F_set, code.F_set_size);
+    int selected = 0;
+    for (int c = 0; c < nof_candidates; c++) {
+      srsran_polar_chanalloc_rx(output_scl[c], data_rx, code.K, code.nPC, code.K_set, code.PC_set);
+      if (srsran_crc_checksum(&crc, data_rx, K) == 0) {
+        selected = c;
+        break;
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    time_scl += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+    if (nof_candidates < 1) {
+      ERROR("Error decoding codeword %d", w);
+      goto clean_exit;
+    }
+    srsran_polar_chanalloc_rx(output_scl[selected], data_rx, code.K, code.nPC, code.K_set, code.PC_set);
+    if (srsran_bit_diff(data_tx, data_rx, K) != 0) {
+      errors_scl++;
+    }
+  }
+
+  printf("K=%d, E=%d, N=%d, SNR=%.1f dB, %d codewords\n", K, E, code.N, noiseless ? INFINITY : snr_db, nof_words);
+  printf("  SSC (8 bit)    : WER=%.4f, %.2f us per codeword\n",
+         (double)errors_ssc / nof_words,
+         1e6 * time_ssc / nof_words);
+  printf("  SCL-%d + CRC%-2d : WER=%.4f, %.2f us per codeword\n",
+         list_size,
+         L,
+         (double)errors_scl / nof_words,
+         1e6 * time_scl / nof_words);
+
+  if (errors_scl > errors_ssc || (noiseless && (errors_scl != 0 || errors_ssc != 0))) {
+    printf("Error: the list decoder made %d word errors and the SSC decoder %d\n", errors_scl, errors_ssc);
+  } else {
+    ret = SRSRAN_SUCCESS;
+  }
+
+  srsran_random_free(random_gen);
+
+clean_exit:
+  free(data_tx);
+  free(data_rx);
+  free(input_enc);
+  free(output_enc);
+  free(rm_codeword);
+  free(rm_llr);
+  free(rm_llr_c);
+  free(llr_c);
+  free(output_ssc);
+  free(output_mem);
+
+  srsran_polar_code_free(&code);
+  srsran_polar_encoder_free(&enc);
+  srsran_polar_decoder_free(&dec_ssc);
+  srsran_polar_decoder_free(&dec_scl);
+  srsran_polar_rm_tx_free(&rm_tx);
+  srsran_polar_rm_rx_free_c(&rm_rx);
+
+  return ret;
+}
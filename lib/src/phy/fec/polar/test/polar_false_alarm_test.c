@@ -0,0 +1,156 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/*!
+ * \file polar_false_alarm_test.c
+ * \brief Measures how often the NR UCI polar receiver accepts pure noise as a valid payload.
+ *
+ * Gaussian noise LLRs are decoded as a PUCCH format 2 payload of 12 bits (CRC6) and of 20 bits (CRC11). Each decoded
+ * word whose CRC passes is a false alarm. The test fails if the false alarm rate exceeds twice the rate of checking
+ * the CRC once per decoded candidate, that is 2^-6 for CRC6 and list size times 2^-11 for CRC11.
+ *
+ * Synopsis: **polar_false_alarm_test [options]**
+ *
+ * Options:
+ *
+ *  - <b>-l \<number\></b> List size, 1 for the SSC decoder, [Default 1].
+ *  - <b>-w \<number\></b> Number of noise words per payload size, [Default 50000].
+ *
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/phch/uci_nr.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static uint32_t list_size = 1;     /*!< \brief Number of paths of the list decoder. */
+static uint32_t nof_words = 50000; /*!< \brief Number of noise words per payload size. */
+
+void usage(char* prog)
+{
+  printf("Usage: %s [-lX] [-wX]\n", prog);
+  printf("\t-l List size [Default %d]\n", list_size);
+  printf("\t-w Number of noise words per payload size [Default %d]\n", nof_words);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "l:w:")) != -1) {
+    switch (opt) {
+      case 'l':
+        list_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'w':
+        nof_words = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int test_false_alarm(srsran_uci_nr_t* uci, uint32_t A)
+{
+  srsran_pucch_nr_resource_t resource = {};
+  resource.format                     = SRSRAN_PUCCH_NR_FORMAT_2;
+  resource.nof_symbols                = 2;
+  resource.nof_prb                    = 4;
+
+  srsran_uci_cfg_nr_t uci_cfg = {};
+  uci_cfg.ack.count           = A;
+
+  int E = srsran_uci_nr_pucch_format_2_3_4_E(&resource);
+  if (E < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  float*  noise = srsran_vec_f_malloc(E);
+  int8_t* llr   = srsran_vec_i8_malloc(E);
+  if (noise == NULL || llr == NULL) {
+    free(noise);
+    free(llr);
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t nof_false_alarms = 0;
+  for (uint32_t w = 0; w < nof_words; w++) {
+    srsran_vec_f_zero(noise, E);
+    srsran_ch_awgn_f(noise, noise, 1.0f, E);
+    srsran_vec_quant_fc(noise, llr, 32.0f, 0, 127, E);
+
+    srsran_uci_value_nr_t value = {};
+    if (srsran_uci_nr_decode_pucch(uci, &resource, &uci_cfg, llr, &value) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding UCI");
+      free(noise);
+      free(llr);
+      return SRSRAN_ERROR;
+    }
+    if (value.valid) {
+      nof_false_alarms++;
+    }
+  }
+  free(noise);
+  free(llr);
+
+  // Every candidate checked against the CRC gives noise one more chance to pass it
+  uint32_t L           = srsran_uci_nr_crc_len(A);
+  uint32_t nof_checked = (L == 6) ? 1 : list_size;
+  double   rate        = (double)nof_false_alarms / nof_words;
+  double   max_rate    = 2.0 * nof_checked / (double)(1U << L);
+
+  printf("A=%d, CRC%d, list size %d: false alarm rate %.5f (maximum %.5f)\n", A, L, list_size, rate, max_rate);
+
+  return (rate > max_rate) ? SRSRAN_ERROR : SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  srsran_uci_nr_args_t args = {};
+  args.polar_list_size      = list_size;
+
+  srsran_uci_nr_t uci = {};
+  if (srsran_uci_nr_init(&uci, &args) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising UCI");
+    return SRSRAN_ERROR;
+  }
+
+  // 12 bits are protected by CRC6 and 20 bits by CRC11
+  if (test_false_alarm(&uci, 12) < SRSRAN_SUCCESS || test_false_alarm(&uci, 20) < SRSRAN_SUCCESS) {
+    printf("Error: too many false alarms\n");
+  } else {
+    ret = SRSRAN_SUCCESS;
+  }
+
+  srsran_uci_nr_free(&uci);
+
+  return ret;
+}
@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -33,6 +34,7 @@
 int      num_bits = 5001, crc_length = 24;
 uint32_t crc_poly = 0x1864CFB;
 uint32_t seed     = 1;
+uint32_t nof_reps = 0;
 
 void usage(char* prog)
 {
@@ -41,13 +43,14 @@ void usage(char* prog)
   printf("\t-l crc_length [Default %d]\n", crc_length);
   printf("\t-p crc_poly (Hex) [Default 0x%x]\n", crc_poly);
   printf("\t-s seed [Default 0=time]\n");
+  printf("\t-R nof_reps, measure the throughput [Default %d]\n", nof_reps);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nlpsv")) != -1) {
+  while ((opt = getopt(argc, argv, "nlpsRv")) != -1) {
     switch (opt) {
       case 'n':
         num_bits = (int)strtol(argv[optind], NULL, 10);
@@ -61,6 +64,9 @@ void parse_args(int argc, char** argv)
       case 's':
         seed = (uint32_t)strtoul(argv[optind], NULL, 0);
         break;
+      case 'R':
+        nof_reps = (uint32_t)strtoul(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -71,6 +77,70 @@ void parse_args(int argc, char** argv)
   }
 }
 
+// Bit by bit long division, used as reference for the table and folding implementations
+static uint32_t crc_reference(const uint8_t* bits, int len, uint32_t poly, int order)
+{
+  uint64_t crc  = 0;
+  uint64_t high = (uint64_t)1 << (uint32_t)order;
+  for (int i = 0; i < len + order; i++) {
+    crc = (crc << 1U) | ((i < len) ? bits[i] : 0);
+    if (crc & high) {
+      crc ^= poly;
+    }
+  }
+  return (uint32_t)crc;
+}
+
+// Checks the bit and byte implementations against the reference for every length up to num_bits
+static int test_lengths(srsran_crc_t* crc_p, const uint8_t* data, uint8_t* data_bytes)
+{
+  srsran_bit_pack_vector((uint8_t*)data, data_bytes, num_bits - num_bits % 8);
+
+  for (int len = 0; len <= num_bits; len++) {
+    uint32_t expected = crc_reference(data, len, crc_poly, crc_length);
+    uint32_t word     = srsran_crc_checksum(crc_p, (uint8_t*)data, len);
+    if (word != expected) {
+      ERROR("Bit checksum mismatch for %d bits: %x != %x", len, word, expected);
+      return SRSRAN_ERROR;
+    }
+    if (len % 8 == 0) {
+      word = srsran_crc_checksum_byte(crc_p, data_bytes, len);
+      if (word != expected) {
+        ERROR("Byte checksum mismatch for %d bits: %x != %x", len, word, expected);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static void measure_throughput(srsran_crc_t* crc_p, uint8_t* data, const uint8_t* data_bytes)
+{
+  struct timeval t[3];
+  uint32_t       acc = 0;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_reps; i++) {
+    acc ^= srsran_crc_checksum(crc_p, data, num_bits);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double usec = (double)(t[0].tv_sec * 1000000 + t[0].tv_usec) / nof_reps;
+  printf("CRC%d unpacked: %.1f Mbps (%.2f usec)\n", crc_length, num_bits / usec, usec);
+
+  int len_bytes = num_bits - num_bits % 8;
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_reps; i++) {
+    acc ^= srsran_crc_checksum_byte(crc_p, data_bytes, len_bytes);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  usec = (double)(t[0].tv_sec * 1000000 + t[0].tv_usec) / nof_reps;
+  printf("CRC%d packed:   %.1f Mbps (%.2f usec)\n", crc_length, len_bytes / usec, usec);
+
+  INFO("acc=%x", acc);
+}
+
 int main(int argc, char** argv)
 {
   int          i;
@@ -111,6 +181,21 @@ int main(int argc, char** argv)
 
   INFO("checksum=%x", crc_word);
 
+  uint8_t* data_bytes = srsran_vec_u8_malloc(num_bits / 8 + 1);
+  if (!data_bytes) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  if (test_lengths(&crc_p, data, data_bytes)) {
+    exit(-1);
+  }
+
+  if (nof_reps > 0) {
+    measure_throughput(&crc_p, data, data_bytes);
+  }
+
+  free(data_bytes);
   free(data);
 
   // check if generated word is as expected
@@ -52,6 +52,13 @@ srsran_tdec_impl_type_t tdec_type;
 #define SNR_MIN 1.0
 #define SNR_MAX 8.0
 
+// Largest BER accepted when checking errors on exit
+#define MAX_BER 1e-3
+
+// Gain and clipping of the LLRs given to the 8-bit decoders
+#define LLR_8BIT_GAIN 8.0f
+#define LLR_8BIT_CLIP 127.0f
+
 void usage(char* prog)
 {
   printf("Usage: %s [kcinNledts]\n", prog);
@@ -62,8 +69,9 @@ void usage(char* prog)
   printf("\t-N nof_repetitions [Default %d]\n", nof_repetitions);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
-  printf("\t-d Decoder implementation type: 0: Generic, 1: SSE, 2: SSE-window\n");
-  printf("\t-t test: check errors on exit [Default disabled]\n");
+  printf("\t-d Decoder implementation type: 0: Auto, 1: Generic, 2: SSE, 3: SSE-window, 5: AVX-window, 6: SSE8-window, "
+         "7: AVX8-window, 8: AVX512-window, 9: AVX512-8-window\n");
+  printf("\t-t test: fail if the BER at a single Eb/No exceeds %.0e [Default disabled]\n", MAX_BER);
   printf("\t-s seed [Default 0=time]\n");
 }
 
@@ -118,11 +126,12 @@ int main(int argc, char** argv)
   uint32_t        frame_cnt;
   float*          llr;
   short*          llr_s;
-  uint8_t*        llr_c;
+  int8_t*         llr_c;
   uint8_t *       data_tx, *data_rx, *data_rx_bytes, *symbols;
   float           var[SNR_POINTS];
   uint32_t        snr_points;
   uint32_t        errors = 0;
+  int             ret    = SRSRAN_SUCCESS;
   uint32_t        coded_length;
   struct timeval  tdata[3];
   float           mean_usec;
@@ -185,7 +194,7 @@ int main(int argc, char** argv)
     perror("malloc");
     exit(-1);
   }
-  llr_c = srsran_vec_u8_malloc(coded_length);
+  llr_c = srsran_vec_i8_malloc(coded_length);
   if (!llr_c) {
     perror("malloc");
     exit(-1);
@@ -208,6 +217,10 @@ int main(int argc, char** argv)
 
   srsran_tdec_force_not_sb(&tdec);
 
+  // The 8-bit decoders take 8-bit LLRs, they would overflow the 16-bit ones
+  bool llr_8bit = tdec_type == SRSRAN_TDEC_SSE8_WINDOW || tdec_type == SRSRAN_TDEC_AVX8_WINDOW ||
+                  tdec_type == SRSRAN_TDEC_AVX512_8_WINDOW;
+
   float ebno_inc, esno_db;
   ebno_inc = (SNR_MAX - SNR_MIN) / SNR_POINTS;
   if (ebno_db == 100.0) {
@@ -250,8 +263,12 @@ int main(int argc, char** argv)
       }
       srsran_ch_awgn_f(llr, llr, var[i], coded_length);
 
-      for (uint32_t j = 0; j < coded_length; j++) {
-        llr_s[j] = (int16_t)(100 * llr[j]);
+      if (llr_8bit) {
+        srsran_vec_quant_fc(llr, llr_c, LLR_8BIT_GAIN, 0.0f, LLR_8BIT_CLIP, coded_length);
+      } else {
+        for (uint32_t j = 0; j < coded_length; j++) {
+          llr_s[j] = (int16_t)(100 * llr[j]);
+        }
       }
 
       /* decoder */
@@ -266,7 +283,11 @@ int main(int argc, char** argv)
 
       gettimeofday(&tdata[1], NULL);
       for (int k = 0; k < nof_repetitions; k++) {
-        srsran_tdec_run_all(&tdec, llr_s, data_rx_bytes, t, frame_length);
+        if (llr_8bit) {
+          srsran_tdec_run_all_8bit(&tdec, llr_c, data_rx_bytes, t, frame_length);
+        } else {
+          srsran_tdec_run_all(&tdec, llr_s, data_rx_bytes, t, frame_length);
+        }
       }
       gettimeofday(&tdata[2], NULL);
       get_time_interval(tdata);
@@ -292,6 +313,11 @@ int main(int argc, char** argv)
     if (errors) {
       printf("%d Errors\n", errors / nof_cb);
     }
+    float ber = (float)errors / (nof_cb * frame_cnt * frame_length);
+    if (test_errors && ber > MAX_BER) {
+      ERROR("BER %.2e exceeds %.2e", ber, MAX_BER);
+      ret = SRSRAN_ERROR;
+    }
   }
 
   free(data_rx_bytes);
@@ -308,5 +334,5 @@ int main(int argc, char** argv)
 
   printf("\n");
   printf("Done\n");
-  exit(0);
+  exit(ret);
 }
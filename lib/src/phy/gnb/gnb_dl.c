@@ -29,7 +29,8 @@ static float gnb_dl_get_norm_factor(uint32_t nof_prb)
 
 static int gnb_dl_alloc_prb(srsran_gnb_dl_t* q, uint32_t new_nof_prb)
 {
-  if (q->max_prb < new_nof_prb) {
+  // Objects writing into a shared grid do not allocate their own
+  if (q->max_prb < new_nof_prb && !q->shared_grid) {
     q->max_prb = new_nof_prb;
 
     for (uint32_t i = 0; i < q->nof_tx_antennas; i++) {
@@ -115,12 +116,57 @@ int srsran_gnb_dl_init(srsran_gnb_dl_t* q, cf_t* output[SRSRAN_MAX_PORTS], const
   return SRSRAN_SUCCESS;
 }
 
+int srsran_gnb_dl_init_shared(srsran_gnb_dl_t* q, const srsran_gnb_dl_args_t* args)
+{
+  if (!q || !args) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (args->nof_tx_antennas == 0) {
+    ERROR("Error invalid number of antennas (%d)", args->nof_tx_antennas);
+    return SRSRAN_ERROR;
+  }
+
+  q->nof_tx_antennas = args->nof_tx_antennas;
+  q->shared_grid     = true;
+
+  if (srsran_pdsch_nr_init_enb(&q->pdsch, &args->pdsch) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_dmrs_sch_init(&q->dmrs, false) < SRSRAN_SUCCESS) {
+    ERROR("Error DMRS");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_gnb_dl_set_grid(srsran_gnb_dl_t* q, const srsran_gnb_dl_t* owner)
+{
+  if (q == NULL || owner == NULL || !q->shared_grid) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < q->nof_tx_antennas; i++) {
+    q->sf_symbols[i] = owner->sf_symbols[i];
+  }
+}
+
 void srsran_gnb_dl_free(srsran_gnb_dl_t* q)
 {
   if (q == NULL) {
     return;
   }
 
+  srsran_pdsch_nr_free(&q->pdsch);
+  srsran_dmrs_sch_free(&q->dmrs);
+
+  if (q->shared_grid) {
+    SRSRAN_MEM_ZERO(q, srsran_gnb_dl_t, 1);
+    return;
+  }
+
   for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
     srsran_ofdm_rx_free(&q->fft[i]);
 
@@ -129,9 +175,6 @@ void srsran_gnb_dl_free(srsran_gnb_dl_t* q)
     }
   }
 
-  srsran_pdsch_nr_free(&q->pdsch);
-  srsran_dmrs_sch_free(&q->dmrs);
-
   srsran_pdcch_nr_free(&q->pdcch);
   srsran_ssb_free(&q->ssb);
 
@@ -154,7 +197,7 @@ int srsran_gnb_dl_set_carrier(srsran_gnb_dl_t* q, const srsran_carrier_nr_t* car
     return SRSRAN_ERROR;
   }
 
-  if (carrier->nof_prb != q->carrier.nof_prb) {
+  if (carrier->nof_prb != q->carrier.nof_prb && !q->shared_grid) {
     srsran_ofdm_cfg_t fft_cfg     = {};
     fft_cfg.nof_prb               = carrier->nof_prb;
     fft_cfg.symbol_sz             = srsran_min_symbol_sz_rb(carrier->nof_prb);
@@ -49,6 +49,11 @@ static int gnb_ul_alloc_prb(srsran_gnb_ul_t* q, uint32_t new_nof_prb)
       return SRSRAN_ERROR;
     }
 
+    // Objects decoding from a shared grid do not allocate their own
+    if (q->shared_grid) {
+      return SRSRAN_SUCCESS;
+    }
+
     if (q->sf_symbols[0] != NULL) {
       free(q->sf_symbols[0]);
     }
@@ -63,12 +68,8 @@ static int gnb_ul_alloc_prb(srsran_gnb_ul_t* q, uint32_t new_nof_prb)
   return SRSRAN_SUCCESS;
 }
 
-int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args_t* args)
+static int gnb_ul_init_channels(srsran_gnb_ul_t* q, const srsran_gnb_ul_args_t* args)
 {
-  if (q == NULL || args == NULL) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
   if (gnb_ul_alloc_prb(q, args->nof_max_prb) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -85,6 +86,25 @@ int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args
     return SRSRAN_ERROR;
   }
 
+  // Set PUSCH minimum SNR, use default value if the given is NAN, INF or zero
+  q->pusch_min_snr_dB = GNB_UL_PUSCH_MIN_SNR_DEFAULT;
+  if (isnormal(args->pusch_min_snr_dB)) {
+    q->pusch_min_snr_dB = args->pusch_min_snr_dB;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args_t* args)
+{
+  if (q == NULL || args == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (gnb_ul_init_channels(q, args) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   srsran_ofdm_cfg_t ofdm_cfg = {};
   ofdm_cfg.nof_prb           = args->nof_max_prb;
   ofdm_cfg.in_buffer         = input;
@@ -97,13 +117,27 @@ int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args
     return SRSRAN_ERROR;
   }
 
-  // Set PUSCH minimum SNR, use default value if the given is NAN, INF or zero
-  q->pusch_min_snr_dB = GNB_UL_PUSCH_MIN_SNR_DEFAULT;
-  if (isnormal(args->pusch_min_snr_dB)) {
-    q->pusch_min_snr_dB = args->pusch_min_snr_dB;
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_gnb_ul_init_shared(srsran_gnb_ul_t* q, const srsran_gnb_ul_args_t* args)
+{
+  if (q == NULL || args == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  return SRSRAN_SUCCESS;
+  q->shared_grid = true;
+
+  return gnb_ul_init_channels(q, args);
+}
+
+void srsran_gnb_ul_set_grid(srsran_gnb_ul_t* q, const srsran_gnb_ul_t* owner)
+{
+  if (q == NULL || owner == NULL || !q->shared_grid) {
+    return;
+  }
+
+  q->sf_symbols[0] = owner->sf_symbols[0];
 }
 
 void srsran_gnb_ul_free(srsran_gnb_ul_t* q)
@@ -112,14 +146,16 @@ void srsran_gnb_ul_free(srsran_gnb_ul_t* q)
     return;
   }
 
-  srsran_ofdm_tx_free(&q->fft);
+  if (!q->shared_grid) {
+    srsran_ofdm_tx_free(&q->fft);
+  }
   srsran_pusch_nr_free(&q->pusch);
   srsran_pucch_nr_free(&q->pucch);
   srsran_dmrs_sch_free(&q->dmrs);
   srsran_chest_dl_res_free(&q->chest_pusch);
   srsran_chest_ul_res_free(&q->chest_pucch);
 
-  if (q->sf_symbols[0] != NULL) {
+  if (q->sf_symbols[0] != NULL && !q->shared_grid) {
     free(q->sf_symbols[0]);
   }
 
@@ -150,6 +186,10 @@ int srsran_gnb_ul_set_carrier(srsran_gnb_ul_t* q, const srsran_carrier_nr_t* car
     return SRSRAN_ERROR;
   }
 
+  if (q->shared_grid) {
+    return SRSRAN_SUCCESS;
+  }
+
   srsran_ofdm_cfg_t ofdm_cfg     = {};
   ofdm_cfg.nof_prb               = carrier->nof_prb;
   ofdm_cfg.rx_window_offset      = GNB_UL_NR_FFT_WINDOW_OFFSET;
@@ -194,6 +234,8 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
     // Set PUSCH data as not decoded
     data->tb[0].crc      = false;
     data->tb[0].avg_iter = NAN;
+    data->tb[0].nof_iter = 0;
+    data->tb[0].max_iter = 0;
     data->uci.valid      = false;
     return SRSRAN_SUCCESS;
   }
@@ -25,7 +25,9 @@
 #include <string.h>
 
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/mimo/layermap.h"
 #include "srsran/phy/mimo/precoding.h"
+#include "srsran/phy/modem/demod_soft.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/mat.h"
 #include "srsran/phy/utils/simd.h"
@@ -845,8 +847,8 @@ static int srsran_predecoding_ccd_2x2_zf_csi(cf_t*  y[SRSRAN_MAX_PORTS],
                                              int    nof_symbols,
                                              float  scaling)
 {
-  uint32_t i    = 0;
-  float    norm = 2.0f / scaling;
+  int   i    = 0;
+  float norm = 2.0f / scaling;
 
 #if SRSRAN_SIMD_CF_SIZE != 0
 #if SRSRAN_SIMD_CF_SIZE == 16
@@ -936,8 +938,8 @@ static int srsran_predecoding_ccd_2x2_zf(cf_t* y[SRSRAN_MAX_PORTS],
                                          int   nof_symbols,
                                          float scaling)
 {
-  uint32_t i    = 0;
-  float    norm = 2.0f / scaling;
+  int   i    = 0;
+  float norm = 2.0f / scaling;
 
 #if SRSRAN_SIMD_CF_SIZE != 0
 #if SRSRAN_SIMD_CF_SIZE == 16
@@ -1925,6 +1927,102 @@ int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
   }
 }
 
+/* Number of resource elements equalized and demodulated at once by srsran_predecoding_demod_type(). It is a multiple of
+ * 4 (SFBC/FSTD groups and CDD precoder parity) and of the SIMD width, so every block keeps the input alignment. */
+#define PREDECODING_DEMOD_BLOCK_RE 256
+
+bool srsran_predecoding_demod_supported(srsran_tx_scheme_t type, int nof_ports, int nof_layers, int nof_cw)
+{
+  if (nof_layers == nof_cw) {
+    // One codeword per layer, no layer demapping needed
+    return type != SRSRAN_TXSCHEME_DIVERSITY && nof_cw > 0 && nof_cw <= SRSRAN_MAX_CODEWORDS;
+  }
+
+  // Transmit diversity maps all the layers onto a single codeword
+  return type == SRSRAN_TXSCHEME_DIVERSITY && nof_cw == 1 && nof_layers == nof_ports;
+}
+
+int srsran_predecoding_demod_type(cf_t*              y[SRSRAN_MAX_PORTS],
+                                  cf_t*              h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                  float*             csi[SRSRAN_MAX_CODEWORDS],
+                                  void*              llr[SRSRAN_MAX_CODEWORDS],
+                                  srsran_mod_t       mod[SRSRAN_MAX_CODEWORDS],
+                                  bool               llr_is_8bit,
+                                  int                nof_rxant,
+                                  int                nof_ports,
+                                  int                nof_layers,
+                                  int                nof_cw,
+                                  int                codebook_idx,
+                                  int                nof_symbols,
+                                  srsran_tx_scheme_t type,
+                                  float              scaling,
+                                  float              noise_estimate)
+{
+  if (nof_rxant > SRSRAN_MAX_PORTS || nof_ports > SRSRAN_MAX_PORTS || nof_layers > SRSRAN_MAX_LAYERS) {
+    ERROR("Invalid dimensions (nof_rxant=%d, nof_ports=%d, nof_layers=%d)", nof_rxant, nof_ports, nof_layers);
+    return SRSRAN_ERROR;
+  }
+  if (!srsran_predecoding_demod_supported(type, nof_ports, nof_layers, nof_cw)) {
+    ERROR("Fused demodulation not supported for Txscheme=%d with %d layers and %d codewords", type, nof_layers, nof_cw);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_simd_aligned cf_t x_blk[SRSRAN_MAX_LAYERS][PREDECODING_DEMOD_BLOCK_RE];
+  srsran_simd_aligned cf_t d_blk[PREDECODING_DEMOD_BLOCK_RE];
+
+  cf_t* x[SRSRAN_MAX_LAYERS];
+  for (int l = 0; l < SRSRAN_MAX_LAYERS; l++) {
+    x[l] = x_blk[l];
+  }
+
+  for (int i = 0; i < nof_symbols; i += PREDECODING_DEMOD_BLOCK_RE) {
+    int n = SRSRAN_MIN(PREDECODING_DEMOD_BLOCK_RE, nof_symbols - i);
+
+    cf_t*  y_blk[SRSRAN_MAX_PORTS];
+    cf_t*  h_blk[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS];
+    float* csi_blk[SRSRAN_MAX_CODEWORDS] = {};
+    for (int p = 0; p < nof_rxant; p++) {
+      y_blk[p] = &y[p][i];
+      for (int t = 0; t < nof_ports; t++) {
+        h_blk[t][p] = &h[t][p][i];
+      }
+    }
+    for (int cw = 0; csi && cw < SRSRAN_MAX_CODEWORDS; cw++) {
+      csi_blk[cw] = csi[cw] ? &csi[cw][i] : NULL;
+    }
+
+    if (srsran_predecoding_type(
+            y_blk, h_blk, x, csi_blk, nof_rxant, nof_ports, nof_layers, codebook_idx, n, type, scaling, noise_estimate) <
+        SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    for (int cw = 0; cw < nof_cw; cw++) {
+      cf_t* d = x[cw];
+      if (nof_layers != nof_cw) {
+        // FSTD leaves a trailing pair of RE undecoded when the allocation is not a multiple of 4
+        int nof_demap = nof_layers * (n / nof_layers);
+        srsran_layerdemap_diversity(x, d_blk, nof_layers, n / nof_layers);
+        srsran_vec_cf_zero(&d_blk[nof_demap], n - nof_demap);
+        d = d_blk;
+      }
+
+      uint32_t qm = srsran_mod_bits_x_symbol(mod[cw]);
+      int      ret;
+      if (llr_is_8bit) {
+        ret = srsran_demod_soft_demodulate_b(mod[cw], d, (int8_t*)llr[cw] + i * qm, n);
+      } else {
+        ret = srsran_demod_soft_demodulate_s(mod[cw], d, (int16_t*)llr[cw] + i * qm, n);
+      }
+      if (ret < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return nof_symbols;
+}
+
 /************************************************
  *
  * TRANSMITTER SIDE FUNCTIONS
@@ -76,6 +76,10 @@
 void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #endif
 
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#include <immintrin.h>
+#endif
+
 #define SCALE_SHORT_CONV_QPSK 100
 #define SCALE_SHORT_CONV_QAM16 400
 #define SCALE_SHORT_CONV_QAM64 700
@@ -731,8 +735,153 @@ void demod_64qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
 
 #endif
 
+#ifdef LV_HAVE_AVX2
+
+// Converts 16 floats into 16 int16 in the same order
+static inline __m256i demod_avx2_convert_s(const float* ptr, __m256 scale)
+{
+  __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(ptr), scale));
+  __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(ptr + 8), scale));
+  return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xd8);
+}
+
+// Converts 32 floats into 32 int8 in the same order
+static inline __m256i demod_avx2_convert_b(const float* ptr, __m256 scale)
+{
+  __m256i a  = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(ptr), scale));
+  __m256i b  = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(ptr + 8), scale));
+  __m256i c  = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(ptr + 16), scale));
+  __m256i d  = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(ptr + 24), scale));
+  __m256i ab = _mm256_packs_epi32(a, b);
+  __m256i cd = _mm256_packs_epi32(c, d);
+  return _mm256_permutevar8x32_epi32(_mm256_packs_epi16(ab, cd), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+// Stores three LLR registers, each 128-bit lane has been interleaved as in the SSE implementation
+static inline void demod_avx2_store_3(__m256i* ptr, __m256i r1, __m256i r2, __m256i r3)
+{
+  _mm256_storeu_si256(ptr, _mm256_permute2x128_si256(r1, r2, 0x20));
+  _mm256_storeu_si256(ptr + 1, _mm256_permute2x128_si256(r3, r1, 0x30));
+  _mm256_storeu_si256(ptr + 2, _mm256_permute2x128_si256(r2, r3, 0x31));
+}
+
+static int demod_64qam_lte_s_avx2(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m256i*     resultPtr  = (__m256i*)llr;
+  __m256i      offset1    = _mm256_set1_epi16(4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42));
+  __m256i      offset2    = _mm256_set1_epi16(2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42));
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM64);
+
+  __m256i shuffle_negated_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(7, 6, 5, 4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0));
+  __m256i shuffle_negated_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_negated_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(11, 10, 9, 8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 7, 6, 5, 4));
+  __m256i shuffle_abs_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs2_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 7, 6, 5, 4, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8));
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m256i symbol_i    = demod_avx2_convert_s(symbolsPtr, scale_v);
+    __m256i symbol_abs  = _mm256_sub_epi16(_mm256_abs_epi16(symbol_i), offset1);
+    __m256i symbol_abs2 = _mm256_sub_epi16(_mm256_abs_epi16(symbol_abs), offset2);
+    symbolsPtr += 16;
+
+    __m256i r1 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_1),
+                                                 _mm256_shuffle_epi8(symbol_abs, shuffle_abs_1)),
+                                 _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_1));
+    __m256i r2 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_2),
+                                                 _mm256_shuffle_epi8(symbol_abs, shuffle_abs_2)),
+                                 _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_2));
+    __m256i r3 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_3),
+                                                 _mm256_shuffle_epi8(symbol_abs, shuffle_abs_3)),
+                                 _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_3));
+
+    demod_avx2_store_3(resultPtr, r1, r2, r3);
+    resultPtr += 3;
+  }
+
+  return i;
+}
+
+static int demod_64qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m256i*     resultPtr  = (__m256i*)llr;
+  __m256i      offset1    = _mm256_set1_epi8(4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42));
+  __m256i      offset2    = _mm256_set1_epi8(2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42));
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM64);
+
+  __m256i shuffle_negated_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 5, 4, 0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0));
+  __m256i shuffle_negated_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(11, 10, 0xff, 0xff, 0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff));
+  __m256i shuffle_negated_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(5, 4, 0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0, 0xff, 0xff));
+  __m256i shuffle_abs_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10));
+
+  __m256i shuffle_abs2_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff, 0xff, 0xff, 5, 4));
+  __m256i shuffle_abs2_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10, 0xff, 0xff));
+
+  int i = 0;
+  for (; i < nsymbols - 15; i += 16) {
+    __m256i symbol_i    = demod_avx2_convert_b(symbolsPtr, scale_v);
+    __m256i symbol_abs  = _mm256_sub_epi8(_mm256_abs_epi8(symbol_i), offset1);
+    __m256i symbol_abs2 = _mm256_sub_epi8(_mm256_abs_epi8(symbol_abs), offset2);
+    symbolsPtr += 32;
+
+    __m256i r1 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_1),
+                                                 _mm256_shuffle_epi8(symbol_abs, shuffle_abs_1)),
+                                 _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_1));
+    __m256i r2 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_2),
+                                                 _mm256_shuffle_epi8(symbol_abs, shuffle_abs_2)),
+                                 _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_2));
+    __m256i r3 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_3),
+                                                 _mm256_shuffle_epi8(symbol_abs, shuffle_abs_3)),
+                                 _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_3));
+
+    demod_avx2_store_3(resultPtr, r1, r2, r3);
+    resultPtr += 3;
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
 void demod_64qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  int n = demod_64qam_lte_s_avx2(symbols, llr, nsymbols);
+  symbols += n;
+  llr += 6 * n;
+  nsymbols -= n;
+#endif /* LV_HAVE_AVX2 */
+
 #ifdef LV_HAVE_SSE
   demod_64qam_lte_s_sse(symbols, llr, nsymbols);
 #else
@@ -756,6 +905,13 @@ void demod_64qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 
 void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  int n = demod_64qam_lte_b_avx2(symbols, llr, nsymbols);
+  symbols += n;
+  llr += 6 * n;
+  nsymbols -= n;
+#endif /* LV_HAVE_AVX2 */
+
 #ifdef LV_HAVE_SSE
   demod_64qam_lte_b_sse(symbols, llr, nsymbols);
 #else
@@ -799,7 +955,7 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+static void demod_256qam_lte_b_generic(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -821,7 +977,7 @@ void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+static void demod_256qam_lte_s_generic(const cf_t* symbols, short* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -843,6 +999,206 @@ void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
   }
 }
 
+/* The 256QAM LLRs of every real and imaginary component only depend on that component, so the four LLR layers are
+ * computed for whole registers. Then, 32-bit (int16) or 16-bit (int8) re/im pairs of the layers are transposed within
+ * each 128-bit lane, and the lanes are reordered.
+ */
+#define DEMOD_256QAM_T1(S) roundf((S)*8.0f / sqrtf(170.0f))
+#define DEMOD_256QAM_T2(S) roundf((S)*4.0f / sqrtf(170.0f))
+#define DEMOD_256QAM_T3(S) roundf((S)*2.0f / sqrtf(170.0f))
+
+#ifdef LV_HAVE_AVX2
+
+static int demod_256qam_lte_s_avx2(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m256i*     resultPtr  = (__m256i*)llr;
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  __m256i      t1         = _mm256_set1_epi16(DEMOD_256QAM_T1(SCALE_SHORT_CONV_QAM256));
+  __m256i      t2         = _mm256_set1_epi16(DEMOD_256QAM_T2(SCALE_SHORT_CONV_QAM256));
+  __m256i      t3         = _mm256_set1_epi16(DEMOD_256QAM_T3(SCALE_SHORT_CONV_QAM256));
+
+  int i = 0;
+  for (; i < nsymbols - 7; i += 8) {
+    __m256i l0 = demod_avx2_convert_s(symbolsPtr, scale_v);
+    __m256i l1 = _mm256_sub_epi16(_mm256_abs_epi16(l0), t1);
+    __m256i l2 = _mm256_sub_epi16(_mm256_abs_epi16(l1), t2);
+    __m256i l3 = _mm256_sub_epi16(_mm256_abs_epi16(l2), t3);
+    symbolsPtr += 16;
+
+    __m256i u0 = _mm256_unpacklo_epi32(l0, l1);
+    __m256i u1 = _mm256_unpacklo_epi32(l2, l3);
+    __m256i u2 = _mm256_unpackhi_epi32(l0, l1);
+    __m256i u3 = _mm256_unpackhi_epi32(l2, l3);
+    __m256i v0 = _mm256_unpacklo_epi64(u0, u1);
+    __m256i v1 = _mm256_unpackhi_epi64(u0, u1);
+    __m256i v2 = _mm256_unpacklo_epi64(u2, u3);
+    __m256i v3 = _mm256_unpackhi_epi64(u2, u3);
+
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(v0, v1, 0x20));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(v2, v3, 0x20));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(v0, v1, 0x31));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(v2, v3, 0x31));
+  }
+
+  return i;
+}
+
+static int demod_256qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m256i*     resultPtr  = (__m256i*)llr;
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  __m256i      t1         = _mm256_set1_epi8(DEMOD_256QAM_T1(SCALE_BYTE_CONV_QAM256));
+  __m256i      t2         = _mm256_set1_epi8(DEMOD_256QAM_T2(SCALE_BYTE_CONV_QAM256));
+  __m256i      t3         = _mm256_set1_epi8(DEMOD_256QAM_T3(SCALE_BYTE_CONV_QAM256));
+
+  int i = 0;
+  for (; i < nsymbols - 15; i += 16) {
+    __m256i l0 = demod_avx2_convert_b(symbolsPtr, scale_v);
+    __m256i l1 = _mm256_subs_epi8(_mm256_abs_epi8(l0), t1);
+    __m256i l2 = _mm256_subs_epi8(_mm256_abs_epi8(l1), t2);
+    __m256i l3 = _mm256_subs_epi8(_mm256_abs_epi8(l2), t3);
+    symbolsPtr += 32;
+
+    __m256i u0 = _mm256_unpacklo_epi16(l0, l1);
+    __m256i u1 = _mm256_unpacklo_epi16(l2, l3);
+    __m256i u2 = _mm256_unpackhi_epi16(l0, l1);
+    __m256i u3 = _mm256_unpackhi_epi16(l2, l3);
+    __m256i v0 = _mm256_unpacklo_epi32(u0, u1);
+    __m256i v1 = _mm256_unpackhi_epi32(u0, u1);
+    __m256i v2 = _mm256_unpacklo_epi32(u2, u3);
+    __m256i v3 = _mm256_unpackhi_epi32(u2, u3);
+
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(v0, v1, 0x20));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(v2, v3, 0x20));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(v0, v1, 0x31));
+    _mm256_storeu_si256(resultPtr++, _mm256_permute2x128_si256(v2, v3, 0x31));
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX512
+
+// Transposes the 128-bit lanes of four registers and stores them
+static inline void demod_avx512_store_4(__m512i* ptr, __m512i v0, __m512i v1, __m512i v2, __m512i v3)
+{
+  __m512i t0 = _mm512_shuffle_i64x2(v0, v1, 0x44);
+  __m512i t1 = _mm512_shuffle_i64x2(v2, v3, 0x44);
+  __m512i t2 = _mm512_shuffle_i64x2(v0, v1, 0xee);
+  __m512i t3 = _mm512_shuffle_i64x2(v2, v3, 0xee);
+
+  _mm512_storeu_si512(ptr, _mm512_shuffle_i64x2(t0, t1, 0x88));
+  _mm512_storeu_si512(ptr + 1, _mm512_shuffle_i64x2(t0, t1, 0xdd));
+  _mm512_storeu_si512(ptr + 2, _mm512_shuffle_i64x2(t2, t3, 0x88));
+  _mm512_storeu_si512(ptr + 3, _mm512_shuffle_i64x2(t2, t3, 0xdd));
+}
+
+static int demod_256qam_lte_s_avx512(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m512i*     resultPtr  = (__m512i*)llr;
+  __m512       scale_v    = _mm512_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  __m512i      t1         = _mm512_set1_epi16(DEMOD_256QAM_T1(SCALE_SHORT_CONV_QAM256));
+  __m512i      t2         = _mm512_set1_epi16(DEMOD_256QAM_T2(SCALE_SHORT_CONV_QAM256));
+  __m512i      t3         = _mm512_set1_epi16(DEMOD_256QAM_T3(SCALE_SHORT_CONV_QAM256));
+  __m512i      order      = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+
+  int i = 0;
+  for (; i < nsymbols - 15; i += 16) {
+    __m512i a  = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(symbolsPtr), scale_v));
+    __m512i b  = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(symbolsPtr + 16), scale_v));
+    __m512i l0 = _mm512_permutexvar_epi64(order, _mm512_packs_epi32(a, b));
+    __m512i l1 = _mm512_sub_epi16(_mm512_abs_epi16(l0), t1);
+    __m512i l2 = _mm512_sub_epi16(_mm512_abs_epi16(l1), t2);
+    __m512i l3 = _mm512_sub_epi16(_mm512_abs_epi16(l2), t3);
+    symbolsPtr += 32;
+
+    __m512i u0 = _mm512_unpacklo_epi32(l0, l1);
+    __m512i u1 = _mm512_unpacklo_epi32(l2, l3);
+    __m512i u2 = _mm512_unpackhi_epi32(l0, l1);
+    __m512i u3 = _mm512_unpackhi_epi32(l2, l3);
+
+    demod_avx512_store_4(resultPtr,
+                         _mm512_unpacklo_epi64(u0, u1),
+                         _mm512_unpackhi_epi64(u0, u1),
+                         _mm512_unpacklo_epi64(u2, u3),
+                         _mm512_unpackhi_epi64(u2, u3));
+    resultPtr += 4;
+  }
+
+  return i;
+}
+
+static int demod_256qam_lte_b_avx512(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbolsPtr = (const float*)symbols;
+  __m512i*     resultPtr  = (__m512i*)llr;
+  __m512       scale_v    = _mm512_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  __m512i      t1         = _mm512_set1_epi8(DEMOD_256QAM_T1(SCALE_BYTE_CONV_QAM256));
+  __m512i      t2         = _mm512_set1_epi8(DEMOD_256QAM_T2(SCALE_BYTE_CONV_QAM256));
+  __m512i      t3         = _mm512_set1_epi8(DEMOD_256QAM_T3(SCALE_BYTE_CONV_QAM256));
+  __m512i      order      = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+
+  int i = 0;
+  for (; i < nsymbols - 31; i += 32) {
+    __m512i a  = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(symbolsPtr), scale_v));
+    __m512i b  = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(symbolsPtr + 16), scale_v));
+    __m512i c  = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(symbolsPtr + 32), scale_v));
+    __m512i d  = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_loadu_ps(symbolsPtr + 48), scale_v));
+    __m512i ab = _mm512_packs_epi32(a, b);
+    __m512i cd = _mm512_packs_epi32(c, d);
+    __m512i l0 = _mm512_permutexvar_epi32(order, _mm512_packs_epi16(ab, cd));
+    __m512i l1 = _mm512_subs_epi8(_mm512_abs_epi8(l0), t1);
+    __m512i l2 = _mm512_subs_epi8(_mm512_abs_epi8(l1), t2);
+    __m512i l3 = _mm512_subs_epi8(_mm512_abs_epi8(l2), t3);
+    symbolsPtr += 64;
+
+    __m512i u0 = _mm512_unpacklo_epi16(l0, l1);
+    __m512i u1 = _mm512_unpacklo_epi16(l2, l3);
+    __m512i u2 = _mm512_unpackhi_epi16(l0, l1);
+    __m512i u3 = _mm512_unpackhi_epi16(l2, l3);
+
+    demod_avx512_store_4(resultPtr,
+                         _mm512_unpacklo_epi32(u0, u1),
+                         _mm512_unpackhi_epi32(u0, u1),
+                         _mm512_unpacklo_epi32(u2, u3),
+                         _mm512_unpackhi_epi32(u2, u3));
+    resultPtr += 4;
+  }
+
+  return i;
+}
+
+#endif /* LV_HAVE_AVX512 */
+
+void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+{
+  int n = 0;
+#ifdef LV_HAVE_AVX512
+  n = demod_256qam_lte_s_avx512(symbols, llr, nsymbols);
+#endif /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  n += demod_256qam_lte_s_avx2(&symbols[n], &llr[8 * n], nsymbols - n);
+#endif /* LV_HAVE_AVX2 */
+  demod_256qam_lte_s_generic(&symbols[n], &llr[8 * n], nsymbols - n);
+}
+
+void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  int n = 0;
+#ifdef LV_HAVE_AVX512
+  n = demod_256qam_lte_b_avx512(symbols, llr, nsymbols);
+#endif /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  n += demod_256qam_lte_b_avx2(&symbols[n], &llr[8 * n], nsymbols - n);
+#endif /* LV_HAVE_AVX2 */
+  demod_256qam_lte_b_generic(&symbols[n], &llr[8 * n], nsymbols - n);
+}
+
 int srsran_demod_soft_demodulate(srsran_mod_t modulation, const cf_t* symbols, float* llr, int nsymbols)
 {
   switch (modulation) {
@@ -32,20 +32,22 @@
 
 static uint32_t     nof_frames = 10;
 static uint32_t     num_bits   = 1000;
+static uint32_t     nof_reps   = 1;
 static srsran_mod_t modulation = SRSRAN_MOD_NITEMS;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)\n", prog);
+  printf("Usage: %s [nfrv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-f nof_frames [Default %d]\n", nof_frames);
+  printf("\t-r nof_reps, demodulations per frame for measuring the throughput [Default %d]\n", nof_reps);
   printf("\t-v srsran_verbose [Default None]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nmvf")) != -1) {
+  while ((opt = getopt(argc, argv, "nmvfr")) != -1) {
     switch (opt) {
       case 'n':
         num_bits = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -53,6 +55,9 @@ void parse_args(int argc, char** argv)
       case 'f':
         nof_frames = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'r':
+        nof_reps = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -75,7 +80,7 @@ void parse_args(int argc, char** argv)
             break;
           default:
             ERROR("Invalid modulation %d. Possible values: "
-                  "(1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)",
+                  "(1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)",
                   (int)strtol(argv[optind], NULL, 10));
             break;
         }
@@ -109,6 +114,18 @@ float mse_threshold()
   }
 }
 
+// Average execution time of a single demodulation
+static float elapsed_us(const struct timeval* t)
+{
+  return (float)(t[0].tv_sec * 1000000 + t[0].tv_usec) / (float)nof_reps;
+}
+
+// Checks the fixed point LLR has the same sign as the floating point one, unless the latter is close to zero
+static bool llr_sign_mismatch(float llr, int32_t llr_fixed)
+{
+  return (llr > 0.05f && llr_fixed <= 0) || (llr < -0.05f && llr_fixed >= 0);
+}
+
 int main(int argc, char** argv)
 {
   int                  i;
@@ -182,31 +199,37 @@ int main(int argc, char** argv)
     srsran_mod_modulate(&mod, input, symbols, num_bits);
 
     gettimeofday(&t[1], NULL);
-    srsran_demod_soft_demodulate(modulation, symbols, llr, num_bits / mod.nbits_x_symbol);
+    for (uint32_t r = 0; r < nof_reps; r++) {
+      srsran_demod_soft_demodulate(modulation, symbols, llr, num_bits / mod.nbits_x_symbol);
+    }
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
 
     /* compute exponentially averaged execution time */
     if (n > 0) {
-      mean_texec = SRSRAN_VEC_CMA((float)t[0].tv_usec, mean_texec, n - 1);
+      mean_texec = SRSRAN_VEC_CMA(elapsed_us(t), mean_texec, n - 1);
     }
 
     gettimeofday(&t[1], NULL);
-    srsran_demod_soft_demodulate_s(modulation, symbols, llr_s, num_bits / mod.nbits_x_symbol);
+    for (uint32_t r = 0; r < nof_reps; r++) {
+      srsran_demod_soft_demodulate_s(modulation, symbols, llr_s, num_bits / mod.nbits_x_symbol);
+    }
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
 
     if (n > 0) {
-      mean_texec_s = SRSRAN_VEC_CMA((float)t[0].tv_usec, mean_texec_s, n - 1);
+      mean_texec_s = SRSRAN_VEC_CMA(elapsed_us(t), mean_texec_s, n - 1);
     }
 
     gettimeofday(&t[1], NULL);
-    srsran_demod_soft_demodulate_b(modulation, symbols, llr_b, num_bits / mod.nbits_x_symbol);
+    for (uint32_t r = 0; r < nof_reps; r++) {
+      srsran_demod_soft_demodulate_b(modulation, symbols, llr_b, num_bits / mod.nbits_x_symbol);
+    }
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
 
     if (n > 0) {
-      mean_texec_b = SRSRAN_VEC_CMA((float)t[0].tv_usec, mean_texec_b, n - 1);
+      mean_texec_b = SRSRAN_VEC_CMA(elapsed_us(t), mean_texec_b, n - 1);
     }
 
     if (SRSRAN_VERBOSE_ISDEBUG()) {
@@ -232,6 +255,14 @@ int main(int argc, char** argv)
         printf("Error in bit %d\n", i);
         goto clean_exit;
       }
+      if (llr_sign_mismatch(llr[i], llr_s[i])) {
+        printf("Error in int16 LLR %d: %f/%d\n", i, llr[i], llr_s[i]);
+        goto clean_exit;
+      }
+      if (llr_sign_mismatch(llr[i], llr_b[i])) {
+        printf("Error in int8 LLR %d: %f/%d\n", i, llr[i], llr_b[i]);
+        goto clean_exit;
+      }
     }
   }
   ret = 0;
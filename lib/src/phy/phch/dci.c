@@ -1439,7 +1439,7 @@ int srsran_dci_location_set(srsran_dci_location_t* c, uint32_t L, uint32_t nCCE)
   return SRSRAN_SUCCESS;
 }
 
-bool srsran_dci_location_isvalid(srsran_dci_location_t* c)
+bool srsran_dci_location_isvalid(const srsran_dci_location_t* c)
 {
   if (c->L <= 3 && c->ncce <= 87) {
     return true;
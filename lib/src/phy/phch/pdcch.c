@@ -89,6 +89,13 @@ static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
 
     srsran_vec_f_zero(q->llr, q->max_bits);
 
+    if (q->is_ue) {
+      q->rm_batch = srsran_vec_f_malloc(SRSRAN_VITERBI_BATCH_LANES * 3 * (SRSRAN_DCI_MAX_BITS + 16));
+      if (!q->rm_batch) {
+        goto clean;
+      }
+    }
+
     q->d = srsran_vec_cf_malloc(q->max_bits / 2);
     if (!q->d) {
       goto clean;
@@ -140,6 +147,9 @@ void srsran_pdcch_free(srsran_pdcch_t* q)
   if (q->llr) {
     free(q->llr);
   }
+  if (q->rm_batch) {
+    free(q->rm_batch);
+  }
   if (q->d) {
     free(q->d);
   }
@@ -187,6 +197,7 @@ int srsran_pdcch_set_cell(srsran_pdcch_t* q, srsran_regs_t* regs, srsran_cell_t
 
   if (q != NULL && regs != NULL && srsran_cell_isvalid(&cell)) {
     srsran_pdcch_set_regs(q, regs);
+    q->nof_decoded = 0;
 
     INFO("PDCCH: Cell config PCI=%d, %d ports.", q->cell.id, q->cell.nof_ports);
 
@@ -328,6 +339,15 @@ uint32_t srsran_pdcch_common_locations_ncce(uint32_t nof_cce, srsran_dci_locatio
   return k;
 }
 
+// XOR between the received parity bits and the CRC of the decoded payload
+static uint16_t pdcch_dci_crc_rem(srsran_pdcch_t* q, uint8_t* data, uint32_t nof_bits)
+{
+  uint8_t* x       = &data[nof_bits];
+  uint16_t p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
+  uint16_t crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, data, nof_bits) & 0xffff);
+  return p_bits ^ crc_res;
+}
+
 /** 36.212 5.3.3.2 to 5.3.3.4
  *
  * Returns XOR between parity and remainder bits
@@ -336,9 +356,6 @@ uint32_t srsran_pdcch_common_locations_ncce(uint32_t nof_cce, srsran_dci_locatio
  */
 int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t E, uint32_t nof_bits, uint16_t* crc)
 {
-  uint16_t p_bits, crc_res;
-  uint8_t* x;
-
   if (q != NULL) {
     if (data != NULL && E <= q->max_bits && nof_bits <= SRSRAN_DCI_MAX_BITS) {
       srsran_vec_f_zero(q->rm_f, 3 * (SRSRAN_DCI_MAX_BITS + 16));
@@ -351,12 +368,8 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
       /* viterbi decoder */
       srsran_viterbi_decode_f(&q->decoder, q->rm_f, data, nof_bits + 16);
 
-      x       = &data[nof_bits];
-      p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
-      crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, data, nof_bits) & 0xffff);
-
       if (crc) {
-        *crc = p_bits ^ crc_res;
+        *crc = pdcch_dci_crc_rem(q, data, nof_bits);
       }
 
       return SRSRAN_SUCCESS;
@@ -369,8 +382,121 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+// Looks for a candidate already decoded since the last LLR extraction
+static srsran_pdcch_decoded_t*
+pdcch_find_decoded(srsran_pdcch_t* q, const srsran_dci_location_t* location, uint32_t nof_bits)
+{
+  for (uint32_t i = 0; i < q->nof_decoded; i++) {
+    srsran_pdcch_decoded_t* d = &q->decoded[i];
+    if (d->ncce == location->ncce && d->L == location->L && d->nof_bits == nof_bits) {
+      return d;
+    }
+  }
+  return NULL;
+}
+
+// Absolute mean of the LLRs of a candidate, candidates below 0.3 are not decoded
+static double pdcch_candidate_mean(srsran_pdcch_t* q, const srsran_dci_location_t* location)
+{
+  double mean = 0;
+  for (uint32_t i = 0; i < PDCCH_FORMAT_NOF_CCE(location->L); i++) {
+    mean += q->cce_llr_abs[location->ncce + i];
+  }
+  return mean / PDCCH_FORMAT_NOF_BITS(location->L);
+}
+
+// Decodes the candidates appended to the decoded list from index first, all of them of nof_bits
+static int pdcch_decode_batch(srsran_pdcch_t* q, uint32_t first, uint32_t nof_bits)
+{
+  uint32_t nof_cw = q->nof_decoded - first;
+  float*   symbols[SRSRAN_VITERBI_BATCH_LANES];
+  uint8_t  data[SRSRAN_VITERBI_BATCH_LANES][SRSRAN_DCI_MAX_BITS + 16];
+  uint8_t* data_ptr[SRSRAN_VITERBI_BATCH_LANES];
+
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    srsran_pdcch_decoded_t* decoded = &q->decoded[first + i];
+
+    symbols[i]  = &q->rm_batch[i * 3 * (SRSRAN_DCI_MAX_BITS + 16)];
+    data_ptr[i] = data[i];
+
+    /* unrate matching */
+    srsran_rm_conv_rx(
+        &q->llr[decoded->ncce * 72], PDCCH_FORMAT_NOF_BITS(decoded->L), symbols[i], 3 * (nof_bits + 16));
+  }
+
+  if (srsran_viterbi_decode_batch(&q->decoder, symbols, data_ptr, nof_cw, nof_bits + 16) < SRSRAN_SUCCESS) {
+    q->nof_decoded = first;
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    srsran_pdcch_decoded_t* decoded = &q->decoded[first + i];
+    decoded->crc_rem                = pdcch_dci_crc_rem(q, data[i], nof_bits);
+    memcpy(decoded->payload, data[i], nof_bits);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_decode_candidates(srsran_pdcch_t*              q,
+                                   srsran_dl_sf_cfg_t*          sf,
+                                   srsran_dci_cfg_t*            dci_cfg,
+                                   const srsran_dci_location_t* locations,
+                                   uint32_t                     nof_locations,
+                                   const srsran_dci_format_t*   formats,
+                                   uint32_t                     nof_formats)
+{
+  if (q == NULL || q->rm_batch == NULL || sf == NULL || dci_cfg == NULL || locations == NULL || formats == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t nof_bits[SRSRAN_DCI_NOF_FORMATS];
+  for (uint32_t f = 0; f < nof_formats && f < SRSRAN_DCI_NOF_FORMATS; f++) {
+    nof_bits[f] = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, formats[f]);
+
+    // Formats of the same size share the candidates
+    bool repeated = false;
+    for (uint32_t i = 0; i < f; i++) {
+      repeated |= (nof_bits[i] == nof_bits[f]);
+    }
+    if (repeated || nof_bits[f] == 0 || nof_bits[f] > SRSRAN_DCI_MAX_BITS) {
+      continue;
+    }
+
+    uint32_t first = q->nof_decoded;
+    for (uint32_t l = 0; l < nof_locations && q->nof_decoded < SRSRAN_PDCCH_MAX_DECODED; l++) {
+      const srsran_dci_location_t* location = &locations[l];
+      if (!srsran_dci_location_isvalid(location) ||
+          location->ncce * 72 + PDCCH_FORMAT_NOF_BITS(location->L) > NOF_CCE(sf->cfi) * 72 ||
+          pdcch_candidate_mean(q, location) <= 0.3f || pdcch_find_decoded(q, location, nof_bits[f]) != NULL) {
+        continue;
+      }
+
+      srsran_pdcch_decoded_t* decoded = &q->decoded[q->nof_decoded++];
+      decoded->ncce                   = location->ncce;
+      decoded->L                      = location->L;
+      decoded->nof_bits               = nof_bits[f];
+
+      if (q->nof_decoded - first == SRSRAN_VITERBI_BATCH_LANES) {
+        if (pdcch_decode_batch(q, first, nof_bits[f])) {
+          return SRSRAN_ERROR;
+        }
+        first = q->nof_decoded;
+      }
+    }
+    if (q->nof_decoded > first) {
+      if (pdcch_decode_batch(q, first, nof_bits[f])) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
+ * A candidate (location and payload size) is only decoded once per extraction, later calls reuse the result.
  * The location to search for is obtained from msg.
  * The decoded message is stored in msg and the CRC remainder in msg->rnti
  *
@@ -388,14 +514,25 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
       uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
 
       // Compute absolute mean of the LLRs
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
-      }
-      mean /= e_bits;
+      double mean = pdcch_candidate_mean(q, &msg->location);
 
       if (mean > 0.3f) {
-        ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+        srsran_pdcch_decoded_t* decoded = pdcch_find_decoded(q, &msg->location, nof_bits);
+        if (decoded != NULL) {
+          memcpy(msg->payload, decoded->payload, nof_bits);
+          msg->rnti = decoded->crc_rem;
+        } else {
+          ret =
+              srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+          if (ret == SRSRAN_SUCCESS && q->nof_decoded < SRSRAN_PDCCH_MAX_DECODED) {
+            decoded           = &q->decoded[q->nof_decoded++];
+            decoded->ncce     = msg->location.ncce;
+            decoded->L        = msg->location.L;
+            decoded->nof_bits = nof_bits;
+            decoded->crc_rem  = msg->rnti;
+            memcpy(decoded->payload, msg->payload, nof_bits);
+          }
+        }
         if (ret == SRSRAN_SUCCESS) {
           msg->nof_bits = nof_bits;
           // Check format differentiation
@@ -506,6 +643,16 @@ int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
     /* descramble */
     srsran_scrambling_f_offset(&q->seq[sf->tti % 10], q->llr, 0, e_bits);
 
+    /* candidate energies are computed once per CCE, decoded candidates from the previous subframe are invalid */
+    for (i = 0; i < NOF_CCE(sf->cfi) && i < SRSRAN_MAX_PRB; i++) {
+      float sum = 0.0f;
+      for (uint32_t j = 0; j < 72; j++) {
+        sum += fabsf(q->llr[i * 72 + j]);
+      }
+      q->cce_llr_abs[i] = sum;
+    }
+    q->nof_decoded = 0;
+
     ret = SRSRAN_SUCCESS;
   }
   return ret;
@@ -65,6 +65,7 @@ typedef struct {
 
   /* Encoder/Decoder data pointers: they must be set before posting start semaphore  */
   srsran_pdsch_res_t* data;
+  bool                llr_ready;
 
   /* Execution status */
   int ret_status;
@@ -665,6 +666,7 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
                                         srsran_sch_t*       dl_sch,
                                         srsran_pdsch_res_t* data,
                                         uint32_t            tb_idx,
+                                        bool                llr_ready,
                                         bool*               ack)
 {
   srsran_ra_tb_t*         mcs          = &cfg->grant.tb[tb_idx];
@@ -686,11 +688,13 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
          cfg->grant.tb[tb_idx].nof_bits,
          rv);
 
-    /* demodulate symbols
+    /* demodulate symbols, unless the pre-decoder already did it
      * The MAX-log-MAP algorithm used in turbo decoding is unsensitive to SNR estimation,
      * thus we don't need tot set it in the LLRs normalization
      */
-    if (q->llr_is_8bit) {
+    if (llr_ready) {
+      /* Do nothing */
+    } else if (q->llr_is_8bit) {
       srsran_demod_soft_demodulate_b(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
     } else {
       srsran_demod_soft_demodulate_s(mcs->mod, q->d[codeword_idx], q->e[codeword_idx], cfg->grant.nof_re);
@@ -769,7 +773,8 @@ static void* srsran_pdsch_decode_thread(void* arg)
 
   sem_wait(&q->start);
   while (!q->quit) {
-    q->ret_status = srsran_pdsch_codeword_decode(q->pdsch_ptr, q->sf, q->cfg, &q->dl_sch, q->data, q->tb_idx, q->ack);
+    q->ret_status = srsran_pdsch_codeword_decode(
+        q->pdsch_ptr, q->sf, q->cfg, &q->dl_sch, q->data, q->tb_idx, q->llr_ready, q->ack);
 
     /* Post finish semaphore */
     sem_post(&q->finish);
@@ -865,24 +870,58 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
 
     // Pre-decoder
     uint32_t codebook_idx = nof_tb == 1 ? cfg->grant.pmi : (cfg->grant.pmi + 1);
-    if (srsran_predecoding_type(q->symbols,
-                                q->ce,
-                                x,
-                                q->csi,
-                                q->nof_rx_antennas,
-                                q->cell.nof_ports,
-                                cfg->grant.nof_layers,
-                                codebook_idx,
-                                cfg->grant.nof_re,
-                                cfg->grant.tx_scheme,
-                                pdsch_scaling,
-                                noise_estimate) < 0) {
+
+    // Fused pre-decoding and demodulation does not keep the equalized symbols, which EVM and debug traces need. It
+    // also demodulates every codeword, so it is skipped if any of them has already been decoded.
+    bool llr_ready = cfg->fused_demod && !cfg->meas_evm_en && !SRSRAN_VERBOSE_ISDEBUG() &&
+                     srsran_predecoding_demod_supported(
+                         cfg->grant.tx_scheme, q->cell.nof_ports, cfg->grant.nof_layers, (int)nof_tb);
+
+    srsran_mod_t mod[SRSRAN_MAX_CODEWORDS] = {};
+    for (uint32_t tb_idx = 0; tb_idx < SRSRAN_MAX_TB; tb_idx++) {
+      if (cfg->grant.tb[tb_idx].enabled) {
+        mod[cfg->grant.tb[tb_idx].cw_idx] = cfg->grant.tb[tb_idx].mod;
+        llr_ready &= !data[tb_idx].crc;
+      }
+    }
+
+    if (llr_ready) {
+      if (srsran_predecoding_demod_type(q->symbols,
+                                        q->ce,
+                                        q->csi,
+                                        q->e,
+                                        mod,
+                                        q->llr_is_8bit,
+                                        q->nof_rx_antennas,
+                                        q->cell.nof_ports,
+                                        cfg->grant.nof_layers,
+                                        nof_tb,
+                                        codebook_idx,
+                                        cfg->grant.nof_re,
+                                        cfg->grant.tx_scheme,
+                                        pdsch_scaling,
+                                        noise_estimate) < 0) {
+        ERROR("Error predecoding");
+        return SRSRAN_ERROR;
+      }
+    } else if (srsran_predecoding_type(q->symbols,
+                                       q->ce,
+                                       x,
+                                       q->csi,
+                                       q->nof_rx_antennas,
+                                       q->cell.nof_ports,
+                                       cfg->grant.nof_layers,
+                                       codebook_idx,
+                                       cfg->grant.nof_re,
+                                       cfg->grant.tx_scheme,
+                                       pdsch_scaling,
+                                       noise_estimate) < 0) {
       ERROR("Error predecoding");
       return SRSRAN_ERROR;
     }
 
     // Layer demapping only if necessary
-    if (cfg->grant.nof_layers != nof_tb) {
+    if (!llr_ready && cfg->grant.nof_layers != nof_tb) {
       srsran_layerdemap_type(x, q->d, cfg->grant.nof_layers, nof_tb, nof_symbols[0], nof_symbols, cfg->grant.tx_scheme);
     }
 
@@ -900,13 +939,14 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
             h->sf                    = sf;
             h->data                  = &data[tb_idx];
             h->tb_idx                = tb_idx;
+            h->llr_ready             = llr_ready;
             h->ack                   = &data[tb_idx].crc;
             h->dl_sch.max_iterations = q->dl_sch.max_iterations;
             h->started               = true;
             sem_post(&h->start);
 
           } else {
-            ret = srsran_pdsch_codeword_decode(q, sf, cfg, &q->dl_sch, data, tb_idx, &data[tb_idx].crc);
+            ret = srsran_pdsch_codeword_decode(q, sf, cfg, &q->dl_sch, data, tb_idx, llr_ready, &data[tb_idx].crc);
 
             data[tb_idx].avg_iterations_block = srsran_sch_last_noi(&q->dl_sch);
           }
@@ -116,6 +116,7 @@ int srsran_pdsch_nr_init_ue(srsran_pdsch_nr_t* q, const srsran_pdsch_nr_args_t*
   }
 
   q->meas_time_en = args->measure_time;
+  q->fused_demod  = args->fused_demod && !args->measure_evm;
 
   return SRSRAN_SUCCESS;
 }
@@ -427,7 +428,8 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
                                            const srsran_sch_cfg_nr_t* cfg,
                                            const srsran_sch_tb_t*     tb,
                                            srsran_pdsch_res_nr_t*     res,
-                                           uint16_t                   rnti)
+                                           uint16_t                   rnti,
+                                           bool                       llr_ready)
 {
   // Early return if TB is not enabled
   if (!tb->enabled) {
@@ -446,19 +448,20 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
     return SRSRAN_ERROR_OUT_OF_BOUNDS;
   }
 
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered() &&
+      !llr_ready) {
     DEBUG("d=");
     srsran_vec_fprint_c(stdout, q->d[tb->cw_idx], tb->nof_re);
   }
 
-  // Demodulation
+  // Demodulation, unless it was done while equalizing
   int8_t* llr = (int8_t*)q->b[tb->cw_idx];
-  if (srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
+  if (!llr_ready && srsran_demod_soft_demodulate_b(tb->mod, q->d[tb->cw_idx], llr, tb->nof_re)) {
     return SRSRAN_ERROR;
   }
 
   // EVM
-  if (q->evm_buffer != NULL) {
+  if (q->evm_buffer != NULL && !llr_ready) {
     res->evm[tb->cw_idx] =
         srsran_evm_run_b(q->evm_buffer, &q->modem_tables[tb->mod], q->d[tb->cw_idx], llr, tb->nof_bits);
   }
@@ -537,7 +540,34 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
 
   // Antenna port demapping
   // ... Not implemented
-  srsran_predecoding_single(q->x[0], channel->ce[0][0], q->d[0], NULL, nof_re, 1.0f, channel->noise_estimate);
+  bool llr_ready = q->fused_demod && grant->nof_layers == 1 && nof_cw == 1 && grant->tb[0].enabled;
+  if (llr_ready) {
+    // Equalize and demodulate block by block, q->d is not written
+    cf_t*        y[SRSRAN_MAX_PORTS]                   = {q->x[0]};
+    cf_t*        h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS] = {{channel->ce[0][0]}};
+    void*        llr[SRSRAN_MAX_CODEWORDS]             = {q->b[grant->tb[0].cw_idx]};
+    srsran_mod_t mod[SRSRAN_MAX_CODEWORDS]             = {grant->tb[0].mod};
+    if (srsran_predecoding_demod_type(y,
+                                      h,
+                                      NULL,
+                                      llr,
+                                      mod,
+                                      true,
+                                      1,
+                                      1,
+                                      1,
+                                      1,
+                                      0,
+                                      nof_re,
+                                      SRSRAN_TXSCHEME_PORT0,
+                                      1.0f,
+                                      channel->noise_estimate) < SRSRAN_SUCCESS) {
+      ERROR("Error equalizing and demodulating");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    srsran_predecoding_single(q->x[0], channel->ce[0][0], q->d[0], NULL, nof_re, 1.0f, channel->noise_estimate);
+  }
 
   // Layer demapping
   if (grant->nof_layers > 1) {
@@ -546,7 +576,7 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
 
   // SCH decode
   for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
-    if (pdsch_nr_decode_codeword(q, cfg, &grant->tb[tb], data, grant->rnti) < SRSRAN_SUCCESS) {
+    if (pdsch_nr_decode_codeword(q, cfg, &grant->tb[tb], data, grant->rnti, llr_ready) < SRSRAN_SUCCESS) {
       ERROR("Error encoding TB %d", tb);
       return SRSRAN_ERROR;
     }
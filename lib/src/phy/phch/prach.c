@@ -27,6 +27,7 @@
 #include "srsran/phy/common/phy_common_nr.h"
 #include "srsran/phy/phch/prach.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 #include "prach_tables.h"
@@ -34,7 +35,7 @@
 // PRACH detection threshold is PRACH_DETECT_FACTOR*average
 #define PRACH_DETECT_FACTOR 18
 #define SUCCESSIVE_CANCELLATION_ITS 4
-#define N_SEQS 64         // Number of prach sequences available
+#define N_SEQS SRSRAN_PRACH_NOF_PREAMBLES
 #define N_RB_SC 12        // Number of subcarriers per resource block
 #define DELTA_F 15000     // Normal subcarrier spacing
 #define DELTA_F_RA 1250   // PRACH subcarrier spacing
@@ -447,6 +448,32 @@ static cf_t* get_precoded_dft(srsran_prach_t* p, uint32_t idx)
   return p->dft_seqs[idx];
 }
 
+/// Multiplies the received PRACH bins by the conjugate of the precoded DFT of each searched root sequence and writes
+/// the N_zc products of every root contiguously in roots_corr_spec. The received bins are loaded once for all roots.
+static void prach_correlate_roots(srsran_prach_t* p, uint32_t nof_roots)
+{
+  const cf_t* roots[N_SEQS];
+  for (uint32_t i = 0; i < nof_roots; i++) {
+    roots[i] = get_precoded_dft(p, p->root_seqs_idx[i]);
+  }
+
+  uint32_t k = 0;
+#if SRSRAN_SIMD_CF_SIZE
+  for (; k + SRSRAN_SIMD_CF_SIZE <= p->N_zc; k += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t bins = srsran_simd_cfi_loadu(&p->prach_bins[k]);
+    for (uint32_t i = 0; i < nof_roots; i++) {
+      simd_cf_t root = srsran_simd_cfi_loadu(&roots[i][k]);
+      srsran_simd_cfi_storeu(&p->roots_corr_spec[i * p->N_zc + k], srsran_simd_cf_conjprod(bins, root));
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+  for (; k < p->N_zc; k++) {
+    for (uint32_t i = 0; i < nof_roots; i++) {
+      p->roots_corr_spec[i * p->N_zc + k] = p->prach_bins[k] * conjf(roots[i][k]);
+    }
+  }
+}
+
 int srsran_prach_gen_seqs(srsran_prach_t* p)
 {
   uint32_t u           = 0;
@@ -570,6 +597,14 @@ int srsran_prach_init(srsran_prach_t* p, uint32_t max_N_ifft_ul)
     p->cross      = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->corr_freq  = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
 
+    // Correlation with all the root sequences
+    p->roots_corr_spec = srsran_vec_cf_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    p->roots_corr      = srsran_vec_f_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    if (!p->roots_corr_spec || !p->roots_corr) {
+      ERROR("Error allocating memory");
+      return SRSRAN_ERROR;
+    }
+
     // Set up ZC FFTS
     if (srsran_dft_plan(&p->zc_fft, SRSRAN_PRACH_N_ZC_LONG, SRSRAN_DFT_FORWARD, SRSRAN_DFT_COMPLEX)) {
       return SRSRAN_ERROR;
@@ -696,6 +731,25 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
       p->num_ra_preambles = p->N_roots;
     }
 
+    // Plan a single IFFT for the correlation with all the searched roots
+    if (p->roots_ifft.size) {
+      srsran_dft_plan_free(&p->roots_ifft);
+    }
+    p->nof_roots_ifft = p->num_ra_preambles;
+    if (srsran_dft_plan_guru_c(&p->roots_ifft,
+                               p->N_zc,
+                               SRSRAN_DFT_BACKWARD,
+                               p->roots_corr_spec,
+                               p->roots_corr_spec,
+                               1,
+                               1,
+                               p->nof_roots_ifft,
+                               p->N_zc,
+                               p->N_zc)) {
+      ERROR("Error creating DFT plan");
+      return SRSRAN_ERROR;
+    }
+
     // Create our FFT objects and buffers
     p->N_ifft_ul = N_ifft_ul;
     if (4 == preamble_format) {
@@ -882,20 +936,20 @@ int srsran_prach_process(srsran_prach_t* p,
   int max_idx         = 0;
   srsran_vec_cf_zero(p->cross, p->N_zc);
   srsran_vec_cf_zero(p->corr_freq, p->N_zc);
-  for (int i = 0; i < p->num_ra_preambles; i++) {
-    cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
 
-    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
+  // Correlate with all the roots in one pass: conjugate products, a batched IFFT and the power of all of them
+  uint32_t nof_roots = p->nof_roots_ifft;
+  prach_correlate_roots(p, nof_roots);
+  srsran_dft_run_guru_c(&p->roots_ifft);
+  srsran_vec_abs_square_cf(p->roots_corr_spec, p->roots_corr, nof_roots * p->N_zc);
 
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
-    if (p->successive_cancellation) {
-      srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
-    }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+  // Measurements are only saved in the first pass, before any preamble is cancelled
+  bool save_meas = (p->nof_meas == 0);
 
-    srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+  for (int i = 0; i < nof_roots; i++) {
+    float* corr = &p->roots_corr[i * p->N_zc];
 
-    float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
+    float corr_ave = srsran_vec_acc_ff(corr, p->N_zc) / p->N_zc;
 
     uint32_t winsize = 0;
     if (p->N_cs != 0) {
@@ -915,8 +969,8 @@ int srsran_prach_process(srsran_prach_t* p,
       start += p->deadzone;
       p->peak_values[j] = 0;
       for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
+        if (corr[k] > p->peak_values[j]) {
+          p->peak_values[j]  = corr[k];
           p->peak_offsets[j] = k - start;
           if (p->peak_values[j] > max_peak) {
             max_peak = p->peak_values[j];
@@ -924,8 +978,23 @@ int srsran_prach_process(srsran_prach_t* p,
           }
         }
       }
+      if (save_meas && i * n_wins + j < N_SEQS) {
+        srsran_prach_meas_t* meas = &p->meas[i * n_wins + j];
+        meas->energy              = p->peak_values[j] / (p->N_zc * p->N_zc);
+        meas->peak_to_avg         = p->peak_values[j] / corr_ave;
+        meas->t_offset            = (p->peak_values[j] > 0) ? srsran_prach_get_offset_secs(p, j) : 0;
+        p->nof_meas               = SRSRAN_MAX(p->nof_meas, i * n_wins + j + 1);
+      }
     }
     if (max_peak > (p->detect_factor * corr_ave)) {
+      // The frequency domain correlation of the root is only needed if a preamble is detected
+      if (p->successive_cancellation || p->freq_domain_offset_calc) {
+        srsran_vec_prod_conj_ccc(p->prach_bins, get_precoded_dft(p, p->root_seqs_idx[i]), p->corr_spec, p->N_zc);
+        srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
+        if (p->successive_cancellation) {
+          srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
+        }
+      }
       for (int j = 0; j < n_wins; j++) {
         if (p->peak_values[j] > p->detect_factor * corr_ave) {
           if (indices) {
@@ -983,6 +1052,7 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
     }
     int cancellation_idx = -2;
     bzero(&p->prach_cancel, sizeof(srsran_prach_cancellation_t));
+    p->nof_meas = 0;
 
     // FFT incoming signal
     srsran_dft_run(&p->fft, signal, p->signal_fft);
@@ -1024,6 +1094,9 @@ int srsran_prach_free(srsran_prach_t* p)
   srsran_dft_plan_free(&p->fft);
   srsran_dft_plan_free(&p->zc_fft);
   srsran_dft_plan_free(&p->zc_ifft);
+  srsran_dft_plan_free(&p->roots_ifft);
+  free(p->roots_corr_spec);
+  free(p->roots_corr);
 
   if (p->signal_fft) {
     free(p->signal_fft);
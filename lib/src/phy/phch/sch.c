@@ -24,7 +24,10 @@
 #include "srsran/phy/utils/vector.h"
 #include "srsran/srsran.h"
 #include <assert.h>
+#include <errno.h>
 #include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -137,6 +140,82 @@ uint32_t srsran_sch_find_Ioffset_cqi(float beta)
 
 #define SCH_MAX_G_BITS (SRSRAN_MAX_PRB * 12 * 12 * 12)
 
+/* Set of code block jobs of the transport block being decoded through an external executor */
+typedef struct {
+  srsran_sch_cb_job_t* jobs;
+  sem_t                done;
+  pthread_mutex_t      mutex;
+  bool                 abort; ///< Set when a code block fails, the remaining ones skip the turbo iterations
+} sch_cb_batch_t;
+
+struct srsran_sch_cb_job_s {
+  sch_cb_batch_t* batch;
+
+  /* Inputs */
+  uint32_t cb_idx;
+  bool     llr_is_8bit;
+  void*    e_bits;
+  void*    cb_buffer;
+  uint32_t n_e;
+  uint32_t cb_len;
+  uint32_t cb_len_idx;
+  uint32_t rlen;
+  uint32_t len_crc;
+  uint32_t rv;
+  uint32_t max_iterations;
+  bool     use_tb_crc;
+
+  /* Outputs */
+  uint8_t* data;
+  uint32_t noi;
+  bool     crc_ok;
+  int      ret;
+};
+
+/* Cached UL-SCH deinterleaver tables. The RI positions only depend on the grant and the number of RI bits, so these
+ * parameters fully determine the permutation. */
+#define SCH_UL_DEINTERLEAVER_CACHE_SIZE 8
+
+typedef struct {
+  uint32_t  H_prime_total;
+  uint32_t  N_pusch_symbs;
+  uint32_t  Qm;
+  uint32_t  nof_ri_bits;
+  uint32_t  nof_pairs; ///< Number of LLR pairs gathered by the table
+  uint32_t  max_pairs; ///< Allocated table size
+  uint32_t* table;     ///< Index of the q_bits LLR pair for each g_bits LLR pair
+  uint64_t  last_use;
+} sch_ul_deinterleaver_entry_t;
+
+typedef struct {
+  sch_ul_deinterleaver_entry_t entries[SCH_UL_DEINTERLEAVER_CACHE_SIZE];
+  uint64_t                     count;
+} sch_ul_deinterleaver_t;
+
+static void sch_ul_deinterleaver_free(sch_ul_deinterleaver_t* q)
+{
+  if (q) {
+    for (uint32_t i = 0; i < SCH_UL_DEINTERLEAVER_CACHE_SIZE; i++) {
+      if (q->entries[i].table) {
+        free(q->entries[i].table);
+      }
+    }
+    free(q);
+  }
+}
+
+static void sch_cb_batch_free(sch_cb_batch_t* batch)
+{
+  if (batch) {
+    if (batch->jobs) {
+      free(batch->jobs);
+    }
+    sem_destroy(&batch->done);
+    pthread_mutex_destroy(&batch->mutex);
+    free(batch);
+  }
+}
+
 int srsran_sch_init(srsran_sch_t* q)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -181,8 +260,8 @@ int srsran_sch_init(srsran_sch_t* q)
       goto clean;
     }
     bzero(q->temp_g_bits, SRSRAN_MAX_PRB * 12 * 12 * 12);
-    q->ul_interleaver = srsran_vec_u32_malloc(SCH_MAX_G_BITS);
-    if (!q->ul_interleaver) {
+    q->ul_deinterleaver = calloc(1, sizeof(sch_ul_deinterleaver_t));
+    if (!q->ul_deinterleaver) {
       goto clean;
     }
     if (srsran_uci_cqi_init(&q->uci_cqi)) {
@@ -211,15 +290,110 @@ void srsran_sch_free(srsran_sch_t* q)
   if (q->temp_g_bits) {
     free(q->temp_g_bits);
   }
-  if (q->ul_interleaver) {
-    free(q->ul_interleaver);
-  }
+  sch_ul_deinterleaver_free(q->ul_deinterleaver);
   srsran_tdec_free(&q->decoder);
   srsran_tcod_free(&q->encoder);
   srsran_uci_cqi_free(&q->uci_cqi);
+  sch_cb_batch_free(q->cb_batch);
   bzero(q, sizeof(srsran_sch_t));
 }
 
+int srsran_sch_set_cb_executor(srsran_sch_t* q, const srsran_sch_cb_executor_t* executor)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Disable parallel decoding
+  if (executor == NULL || executor->push == NULL) {
+    q->cb_executor.arg  = NULL;
+    q->cb_executor.push = NULL;
+    return SRSRAN_SUCCESS;
+  }
+
+  // Allocate batch the first time an executor is set
+  if (q->cb_batch == NULL) {
+    sch_cb_batch_t* batch = calloc(1, sizeof(sch_cb_batch_t));
+    if (batch == NULL) {
+      ERROR("Error allocating code block batch");
+      return SRSRAN_ERROR;
+    }
+
+    batch->jobs = calloc(SRSRAN_MAX_CODEBLOCKS, sizeof(srsran_sch_cb_job_t));
+    if (batch->jobs == NULL) {
+      ERROR("Error allocating code block jobs");
+      free(batch);
+      return SRSRAN_ERROR;
+    }
+
+    if (sem_init(&batch->done, 0, 0)) {
+      ERROR("Error creating semaphore");
+      free(batch->jobs);
+      free(batch);
+      return SRSRAN_ERROR;
+    }
+
+    if (pthread_mutex_init(&batch->mutex, NULL)) {
+      ERROR("Error creating mutex");
+      sem_destroy(&batch->done);
+      free(batch->jobs);
+      free(batch);
+      return SRSRAN_ERROR;
+    }
+
+    q->cb_batch = batch;
+  }
+
+  q->cb_executor = *executor;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_sch_cb_decoder_init(srsran_sch_cb_decoder_t* q)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sch_cb_decoder_t, 1);
+
+  if (srsran_tdec_init(&q->decoder, SRSRAN_TCOD_MAX_LEN_CB)) {
+    ERROR("Error initiating Turbo Decoder");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_crc_init(&q->crc_tb, SRSRAN_LTE_CRC24A, 24)) {
+    ERROR("Error initiating CRC");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_crc_init(&q->crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+    ERROR("Error initiating CRC");
+    return SRSRAN_ERROR;
+  }
+
+  q->data = srsran_vec_u8_malloc(SRSRAN_TCOD_MAX_LEN_CB / 8);
+  if (q->data == NULL) {
+    ERROR("Error allocating memory");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_sch_cb_decoder_free(srsran_sch_cb_decoder_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  srsran_tdec_free(&q->decoder);
+  if (q->data) {
+    free(q->data);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_sch_cb_decoder_t, 1);
+}
+
 void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 {
   if (max_iterations == 0) {
@@ -368,6 +542,171 @@ static int encode_tb(srsran_sch_t*           q,
   return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
 }
 
+static bool sch_cb_batch_aborted(sch_cb_batch_t* batch)
+{
+  pthread_mutex_lock(&batch->mutex);
+  bool abort = batch->abort;
+  pthread_mutex_unlock(&batch->mutex);
+  return abort;
+}
+
+void srsran_sch_cb_job_run(srsran_sch_cb_job_t* job, srsran_sch_cb_decoder_t* decoder)
+{
+  if (job == NULL) {
+    return;
+  }
+
+  sch_cb_batch_t* batch = job->batch;
+
+  job->noi    = 0;
+  job->crc_ok = false;
+  job->ret    = SRSRAN_SUCCESS;
+
+  // Rate dematching is always performed, so the soft-combining is preserved even if the turbo decoding is skipped
+  int err;
+  if (job->llr_is_8bit) {
+    err = srsran_rm_turbo_rx_lut_8bit(job->e_bits, job->cb_buffer, job->n_e, job->cb_len_idx, job->rv);
+  } else {
+    err = srsran_rm_turbo_rx_lut(job->e_bits, job->cb_buffer, job->n_e, job->cb_len_idx, job->rv);
+  }
+
+  if (err) {
+    ERROR("Error in rate matching");
+    job->ret = SRSRAN_ERROR;
+  } else if (decoder == NULL) {
+    ERROR("Invalid code block decoder");
+    job->ret = SRSRAN_ERROR_INVALID_INPUTS;
+  } else {
+    srsran_crc_t* crc_ptr = job->use_tb_crc ? &decoder->crc_tb : &decoder->crc_cb;
+
+    srsran_tdec_new_cb(&decoder->decoder, job->cb_len);
+
+    // Run iterations and use CRC for early stopping, the decoded code block CRC shall not overwrite the next one
+    while (job->noi < job->max_iterations && !job->crc_ok && !sch_cb_batch_aborted(batch)) {
+      if (job->llr_is_8bit) {
+        srsran_tdec_iteration_8bit(&decoder->decoder, job->cb_buffer, decoder->data);
+      } else {
+        srsran_tdec_iteration(&decoder->decoder, job->cb_buffer, decoder->data);
+      }
+      job->noi++;
+
+      // CRC is OK and ran the minimum number of iterations
+      if (!srsran_crc_checksum_byte(crc_ptr, decoder->data, job->len_crc) &&
+          (job->noi >= SRSRAN_PDSCH_MIN_TDEC_ITERS)) {
+        job->crc_ok = true;
+      }
+    }
+
+    if (job->noi > 0) {
+      memcpy(job->data, decoder->data, job->rlen / 8);
+    }
+
+    // CRC is error and exceeded maximum iterations for this CB, the transport block is lost. Early stop the rest.
+    if (!job->crc_ok) {
+      pthread_mutex_lock(&batch->mutex);
+      batch->abort = true;
+      pthread_mutex_unlock(&batch->mutex);
+    }
+  }
+
+  sem_post(&batch->done);
+}
+
+static int decode_tb_cb_parallel(srsran_sch_t*           q,
+                                 srsran_softbuffer_rx_t* softbuffer,
+                                 srsran_cbsegm_t*        cb_segm,
+                                 uint32_t                Qm,
+                                 uint32_t                rv,
+                                 uint32_t                nof_e_bits,
+                                 void*                   e_bits,
+                                 uint8_t*                data)
+{
+  int8_t*         e_bits_b = e_bits;
+  int16_t*        e_bits_s = e_bits;
+  sch_cb_batch_t* batch    = q->cb_batch;
+  uint32_t        nof_jobs = 0;
+
+  pthread_mutex_lock(&batch->mutex);
+  batch->abort = false;
+  pthread_mutex_unlock(&batch->mutex);
+
+  for (uint32_t cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
+    uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+    uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+
+    /* Do not process blocks with CRC Ok */
+    if (softbuffer->cb_crc[cb_idx]) {
+      // Copy decoded data from previous transmissions
+      memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+      continue;
+    }
+
+    uint32_t Gp    = nof_e_bits / Qm;
+    uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+    uint32_t n_e   = Qm * (Gp / cb_segm->C);
+
+    uint32_t rp   = cb_idx * n_e;
+    uint32_t n_e2 = n_e;
+
+    if (cb_idx > cb_segm->C - gamma) {
+      n_e2 = n_e + Qm;
+      rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+    }
+
+    srsran_sch_cb_job_t* job = &batch->jobs[nof_jobs++];
+    job->batch               = batch;
+    job->cb_idx              = cb_idx;
+    job->llr_is_8bit         = q->llr_is_8bit;
+    job->e_bits              = q->llr_is_8bit ? (void*)&e_bits_b[rp] : (void*)&e_bits_s[rp];
+    job->cb_buffer           = softbuffer->buffer_f[cb_idx];
+    job->n_e                 = n_e2;
+    job->cb_len              = cb_len;
+    job->cb_len_idx          = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+    job->rlen                = rlen;
+    job->use_tb_crc          = cb_segm->C == 1;
+    job->len_crc             = cb_segm->C == 1 ? cb_segm->tbs + 24 : cb_len;
+    job->rv                  = rv;
+    job->max_iterations      = q->max_iterations;
+    job->data                = &data[cb_idx * rlen / 8];
+  }
+
+  // Dispatch all jobs before waiting, so they run concurrently
+  for (uint32_t i = 0; i < nof_jobs; i++) {
+    q->cb_executor.push(q->cb_executor.arg, &batch->jobs[i]);
+  }
+
+  // Join
+  for (uint32_t i = 0; i < nof_jobs; i++) {
+    while (sem_wait(&batch->done) && errno == EINTR) {
+      // Retry if interrupted
+    }
+  }
+
+  // Collect results
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_jobs; i++) {
+    srsran_sch_cb_job_t* job = &batch->jobs[i];
+
+    if (job->ret < SRSRAN_SUCCESS) {
+      ret = job->ret;
+    }
+
+    softbuffer->cb_crc[job->cb_idx] = job->crc_ok;
+    q->avg_iterations += job->noi;
+
+    INFO("CB %d: n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
+         job->cb_idx,
+         job->n_e,
+         job->cb_len,
+         job->crc_ok ? "OK" : "KO",
+         job->rlen,
+         job->noi,
+         job->max_iterations);
+  }
+
+  return ret;
+}
+
 bool decode_tb_cb(srsran_sch_t*           q,
                   srsran_softbuffer_rx_t* softbuffer,
                   srsran_cbsegm_t*        cb_segm,
@@ -387,7 +726,13 @@ bool decode_tb_cb(srsran_sch_t*           q,
 
   q->avg_iterations = 0;
 
-  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
+  // Dispatch code blocks to the executor if available, a single code block is decoded in place
+  bool parallel = q->cb_executor.push != NULL && q->cb_batch != NULL && cb_segm->C > 1;
+  if (parallel && decode_tb_cb_parallel(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data) < SRSRAN_SUCCESS) {
+    return false;
+  }
+
+  for (int cb_idx = 0; cb_idx < cb_segm->C && !parallel; cb_idx++) {
     /* Do not process blocks with CRC Ok */
     if (softbuffer->cb_crc[cb_idx] == false) {
       uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
@@ -655,30 +1000,50 @@ int srsran_dlsch_encode2(srsran_sch_t*       q,
                    e_bits);
 }
 
-/* Compute the interleaving function on-the-fly, because it depends on number of RI bits
- * Profiling show that the computation of this matrix is neglegible.
+/* Computes the deinterleaving gather table. Every RE carries an even number of LLRs, so the table indexes LLR pairs: the
+ * g_bits pair i is read from the q_bits pair table[i]. REs carrying RI are skipped. Returns the number of pairs.
  */
-static void ulsch_interleave_gen(uint32_t  H_prime_total,
-                                 uint32_t  N_pusch_symbs,
-                                 uint32_t  Qm,
-                                 uint8_t*  ri_present,
-                                 uint32_t* interleaver_lut)
+static uint32_t ulsch_deinterleave_gen(uint32_t       H_prime_total,
+                                       uint32_t       N_pusch_symbs,
+                                       uint32_t       Qm,
+                                       const uint8_t* ri_present,
+                                       uint32_t*      table)
 {
-  uint32_t rows = H_prime_total / N_pusch_symbs;
-  uint32_t cols = N_pusch_symbs;
-  uint32_t idx  = 0;
+  uint32_t rows     = H_prime_total / N_pusch_symbs;
+  uint32_t cols     = N_pusch_symbs;
+  uint32_t re_pairs = Qm / 2;
+  uint32_t idx      = 0;
   for (uint32_t j = 0; j < rows; j++) {
     for (uint32_t i = 0; i < cols; i++) {
-      for (uint32_t k = 0; k < Qm; k++) {
-        if (ri_present && ri_present[j * Qm + i * rows * Qm + k]) {
-          interleaver_lut[j * Qm + i * rows * Qm + k] = 0;
-        } else {
-          interleaver_lut[j * Qm + i * rows * Qm + k] = idx;
-          idx++;
-        }
+      uint32_t re = i * rows + j;
+      if (ri_present && ri_present[re * Qm]) {
+        continue;
+      }
+      for (uint32_t k = 0; k < re_pairs; k++) {
+        table[idx++] = re * re_pairs + k;
       }
     }
   }
+  return idx;
+}
+
+static void ulsch_deinterleave_gather(const int16_t* q_bits, const uint32_t* table, int16_t* g_bits, uint32_t nof_pairs)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX2
+  // Each 32-bit lane moves one LLR pair
+  for (; i + 8 <= nof_pairs; i += 8) {
+    __m256i idx = _mm256_loadu_si256((__m256i*)&table[i]);
+    __m256i v   = _mm256_i32gather_epi32((const int*)q_bits, idx, 4);
+    _mm256_storeu_si256((__m256i*)&g_bits[2 * i], v);
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < nof_pairs; i++) {
+    g_bits[2 * i]     = q_bits[2 * table[i]];
+    g_bits[2 * i + 1] = q_bits[2 * table[i] + 1];
+  }
 }
 
 static void ulsch_interleave_qm2(const uint8_t* g_bits,
@@ -990,34 +1355,90 @@ static void ulsch_interleave(uint8_t*          g_bits,
   }
 }
 
-/* UL-SCH channel deinterleaver according to 5.2.2.8 of 36.212 */
-void ulsch_deinterleave(int16_t*          q_bits,
-                        uint32_t          Qm,
-                        uint32_t          H_prime_total,
-                        uint32_t          N_pusch_symbs,
-                        int16_t*          g_bits,
-                        srsran_uci_bit_t* ri_bits,
-                        uint32_t          nof_ri_bits,
-                        uint8_t*          ri_present,
-                        uint32_t*         inteleaver_lut)
+/* Looks up the deinterleaver table for the given grant and RI bits. On a miss, the least recently used entry is
+ * regenerated. Returns NULL if the table cannot be allocated.
+ */
+static sch_ul_deinterleaver_entry_t* ulsch_deinterleaver_get(sch_ul_deinterleaver_t* q,
+                                                             uint32_t                Qm,
+                                                             uint32_t                H_prime_total,
+                                                             uint32_t                N_pusch_symbs,
+                                                             srsran_uci_bit_t*       ri_bits,
+                                                             uint32_t                nof_ri_bits,
+                                                             uint8_t*                ri_present)
 {
-  // Prepare ri_bits for fast search using temp_buffer
-  if (nof_ri_bits > 0) {
-    for (uint32_t i = 0; i < nof_ri_bits; i++) {
-      ri_present[ri_bits[i].position] = 1;
+  sch_ul_deinterleaver_entry_t* entry = &q->entries[0];
+  q->count++;
+
+  for (uint32_t i = 0; i < SCH_UL_DEINTERLEAVER_CACHE_SIZE; i++) {
+    sch_ul_deinterleaver_entry_t* e = &q->entries[i];
+    if (e->table && e->H_prime_total == H_prime_total && e->N_pusch_symbs == N_pusch_symbs && e->Qm == Qm &&
+        e->nof_ri_bits == nof_ri_bits) {
+      e->last_use = q->count;
+      return e;
+    }
+    if (e->last_use < entry->last_use) {
+      entry = e;
+    }
+  }
+
+  uint32_t max_pairs = H_prime_total * Qm / 2;
+  if (entry->max_pairs < max_pairs) {
+    if (entry->table) {
+      free(entry->table);
     }
+    entry->max_pairs = 0;
+    entry->table     = srsran_vec_u32_malloc(max_pairs);
+    if (!entry->table) {
+      return NULL;
+    }
+    entry->max_pairs = max_pairs;
   }
 
-  // Generate interleaver table and interleave samples
-  ulsch_interleave_gen(H_prime_total, N_pusch_symbs, Qm, ri_present, inteleaver_lut);
-  srsran_vec_lut_sis(q_bits, inteleaver_lut, g_bits, H_prime_total * Qm);
+  // Prepare ri_bits for fast search using temp_buffer
+  for (uint32_t i = 0; i < nof_ri_bits; i++) {
+    ri_present[ri_bits[i].position] = 1;
+  }
+
+  entry->nof_pairs     = ulsch_deinterleave_gen(H_prime_total, N_pusch_symbs, Qm, ri_present, entry->table);
+  entry->H_prime_total = H_prime_total;
+  entry->N_pusch_symbs = N_pusch_symbs;
+  entry->Qm            = Qm;
+  entry->nof_ri_bits   = nof_ri_bits;
+  entry->last_use      = q->count;
 
   // Reset temp_buffer because will be reused next time
-  if (nof_ri_bits > 0) {
-    for (uint32_t i = 0; i < nof_ri_bits; i++) {
-      ri_present[ri_bits[i].position] = 0;
-    }
+  for (uint32_t i = 0; i < nof_ri_bits; i++) {
+    ri_present[ri_bits[i].position] = 0;
+  }
+
+  return entry;
+}
+
+/* UL-SCH channel deinterleaver according to 5.2.2.8 of 36.212 */
+static int ulsch_deinterleave(srsran_sch_t*     q,
+                              int16_t*          q_bits,
+                              uint32_t          Qm,
+                              uint32_t          H_prime_total,
+                              uint32_t          N_pusch_symbs,
+                              int16_t*          g_bits,
+                              srsran_uci_bit_t* ri_bits,
+                              uint32_t          nof_ri_bits)
+{
+  if (N_pusch_symbs == 0 || Qm % 2 != 0 || H_prime_total < N_pusch_symbs) {
+    ERROR("Invalid input: N_pusch_symbs=%d, Qm=%d, H_prime_total=%d", N_pusch_symbs, Qm, H_prime_total);
+    return SRSRAN_ERROR;
   }
+
+  sch_ul_deinterleaver_entry_t* entry = ulsch_deinterleaver_get(
+      q->ul_deinterleaver, Qm, H_prime_total, N_pusch_symbs, ri_bits, nof_ri_bits, q->temp_g_bits);
+  if (!entry) {
+    ERROR("Error allocating deinterleaver table");
+    return SRSRAN_ERROR;
+  }
+
+  ulsch_deinterleave_gather(q_bits, entry->table, g_bits, entry->nof_pairs);
+
+  return SRSRAN_SUCCESS;
 }
 
 static int uci_decode_ri_ack(srsran_sch_t*       q,
@@ -1150,15 +1571,9 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
   uint32_t Q_prime_ri = (uint32_t)ret;
 
   // Deinterleave data and CQI in ULSCH
-  ulsch_deinterleave(q_bits,
-                     Qm,
-                     nb_q / Qm,
-                     cfg->grant.nof_symb,
-                     g_bits,
-                     q->ack_ri_bits,
-                     Q_prime_ri * Qm,
-                     q->temp_g_bits,
-                     q->ul_interleaver);
+  if (ulsch_deinterleave(q, q_bits, Qm, nb_q / Qm, cfg->grant.nof_symb, g_bits, q->ack_ri_bits, Q_prime_ri * Qm)) {
+    return SRSRAN_ERROR;
+  }
 
   // Decode CQI (multiplexed at the front of ULSCH)
   uint32_t Q_prime_cqi = 0;
@@ -1353,5 +1768,11 @@ void srsran_sl_ulsch_deinterleave(int16_t*  q_bits,
                                   int16_t*  g_bits,
                                   uint32_t* inteleaver_lut)
 {
-  ulsch_deinterleave(q_bits, Qm, H_prime_total, N_pusch_symbs, g_bits, NULL, 0, NULL, inteleaver_lut);
+  if (N_pusch_symbs == 0 || Qm % 2 != 0 || H_prime_total < N_pusch_symbs) {
+    ERROR("Invalid input: N_pusch_symbs=%d, Qm=%d, H_prime_total=%d", N_pusch_symbs, Qm, H_prime_total);
+    return;
+  }
+
+  uint32_t nof_pairs = ulsch_deinterleave_gen(H_prime_total, N_pusch_symbs, Qm, NULL, inteleaver_lut);
+  ulsch_deinterleave_gather(q_bits, inteleaver_lut, g_bits, nof_pairs);
 }
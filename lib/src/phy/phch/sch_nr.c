@@ -323,6 +323,7 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     decoder_args.ls                         = ls;
     decoder_args.scaling_fctr               = scaling_factor;
     decoder_args.max_nof_iter               = args->max_nof_iter;
+    decoder_args.syndrome_early_stop        = args->decoder_syndrome_early_stop;
 
     q->decoder_bg1[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
     if (!q->decoder_bg1[ls]) {
@@ -576,6 +577,7 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
 
   int8_t*  input_ptr    = e_bits;
   uint32_t nof_iter_sum = 0;
+  uint32_t nof_iter_max = 0;
 
   srsran_sch_nr_tb_info_t cfg = {};
   if (srsran_sch_nr_fill_tb_info(&q->carrier, sch_cfg, tb, &cfg) < SRSRAN_SUCCESS) {
@@ -667,9 +669,10 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
       return SRSRAN_ERROR;
     }
 
-    // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
+    // Compute number of iterations, the decoder may stop before the maximum even if the CRC does not match
+    uint32_t n_iter_cb = decoder->last_nof_iter;
     nof_iter_sum += n_iter_cb;
+    nof_iter_max = SRSRAN_MAX(nof_iter_max, n_iter_cb);
 
     // Check if CB is all zeros
     uint32_t cb_len = cfg.Kp - cfg.L_cb;
@@ -691,8 +694,9 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
 
     input_ptr += E;
   }
-  // Set average number of iterations
-  res->avg_iter = (float)nof_iter_sum / (float)cfg.C;
+  // Set number of iterations
+  res->nof_iter = nof_iter_sum;
+  res->max_iter = nof_iter_max;
 
   // Set average number of iterations
   if (cfg.C > 0) {
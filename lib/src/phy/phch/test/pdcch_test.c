@@ -261,6 +261,16 @@ static int test_case1()
         get_time_interval(t);
         t_llr_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
 
+        // Every other subframe, decode all the candidates at once first so the loop below uses the batch results
+        if (sf_idx % 2) {
+          gettimeofday(&t[1], NULL);
+          TESTASSERT(srsran_pdcch_decode_candidates(
+                         &pdcch_rx, &dl_sf_cfg, &dci_cfg, locations, locations_count, &format, 1) == SRSRAN_SUCCESS);
+          gettimeofday(&t[2], NULL);
+          get_time_interval(t);
+          t_decode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+        }
+
         // Try decoding the PDCCH in all possible locations
         for (uint32_t loc_rx = 0; loc_rx < locations_count; loc_rx++) {
           // Skip location if:
@@ -325,6 +335,15 @@ static int test_case1()
 
           // Assert received message
           TESTASSERT(payload_match);
+
+          // Decoding the same candidate again reuses the previous result, it must not change
+          srsran_dci_msg_t dci_rx_again = {};
+          dci_rx_again.location         = locations[loc_rx];
+          dci_rx_again.format           = format;
+          TESTASSERT(srsran_pdcch_decode_msg(&pdcch_rx, &dl_sf_cfg, &dci_cfg, &dci_rx_again) == SRSRAN_SUCCESS);
+          TESTASSERT(dci_rx_again.rnti == dci_rx.rnti);
+          TESTASSERT(dci_rx_again.format == dci_rx.format);
+          TESTASSERT(memcmp(dci_rx_again.payload, dci_rx.payload, dci_rx.nof_bits) == 0);
         }
       }
     }
@@ -35,22 +35,24 @@ static uint32_t            n_prb     = 0;  // Set to 0 for steering
 static uint32_t            mcs       = 30; // Set to 30 for steering
 static srsran_sch_cfg_nr_t pdsch_cfg = {};
 static uint16_t            rnti      = 0x1234;
+static bool                fused     = false; // Fused equalization and demodulation, EVM and d are not available
 
 void usage(char* prog)
 {
-  printf("Usage: %s [pTL] \n", prog);
+  printf("Usage: %s [pTLF] \n", prog);
   printf("\t-p Number of grant PRB, set to 0 for steering [Default %d]\n", n_prb);
   printf("\t-m MCS PRB, set to >28 for steering [Default %d]\n", mcs);
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-F Enable fused equalization and demodulation [Default %s]\n", fused ? "enabled" : "disabled");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pmTLv")) != -1) {
+  while ((opt = getopt(argc, argv, "pmTLFv")) != -1) {
     switch (opt) {
       case 'p':
         n_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -64,6 +66,9 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'F':
+        fused = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -98,7 +103,8 @@ int main(int argc, char** argv)
 
   srsran_pdsch_nr_args_t pdsch_args = {};
   pdsch_args.sch.disable_simd       = false;
-  pdsch_args.measure_evm            = true;
+  pdsch_args.measure_evm            = !fused;
+  pdsch_args.fused_demod            = fused;
 
   if (srsran_pdsch_nr_init_enb(&pdsch_tx, &pdsch_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating PDSCH for Tx");
@@ -229,7 +235,7 @@ int main(int argc, char** argv)
         goto clean_exit;
       }
 
-      if (pdsch_res.evm[0] > 0.001f) {
+      if (!fused && pdsch_res.evm[0] > 0.001f) {
         ERROR("Error PDSCH EVM is too high %f", pdsch_res.evm[0]);
         goto clean_exit;
       }
@@ -244,7 +250,7 @@ int main(int argc, char** argv)
       if (nof_re * pdsch_cfg.grant.nof_layers > 0) {
         mse = mse / (nof_re * pdsch_cfg.grant.nof_layers);
       }
-      if (mse > 0.001) {
+      if (!fused && mse > 0.001) {
         ERROR("MSE error (%f) is too high", mse);
         for (uint32_t i = 0; i < pdsch_cfg.grant.nof_layers; i++) {
           printf("d_tx[%d]=", i);
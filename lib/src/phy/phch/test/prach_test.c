@@ -128,6 +128,12 @@ int main(int argc, char** argv)
     printf("texec=%ld us\n", t[0].tv_usec);
     if (n_indices != 1 || indices[0] != seq_index)
       return -1;
+
+    // The preamble measurements must agree with the detection
+    srsran_prach_meas_t* meas = &prach.meas[seq_index];
+    printf("energy=%.3f, peak2avg=%.1f, offset=%.2f us\n", meas->energy, meas->peak_to_avg, meas->t_offset * 1e6);
+    if (seq_index >= prach.nof_meas || meas->peak_to_avg < prach.detect_factor || meas->t_offset != 0.0f)
+      return -1;
   }
 
   srsran_prach_free(&prach);
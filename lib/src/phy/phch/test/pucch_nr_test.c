@@ -38,6 +38,7 @@ static uint32_t              starting_symbol_stride = 4;
 static srsran_random_t       random_gen             = NULL;
 static int                   format                 = -1;
 static float                 snr_db                 = 20.0f;
+static uint32_t              polar_list_size        = 1;
 static srsran_channel_awgn_t awgn                   = {};
 
 static int test_pucch_format0(srsran_pucch_nr_t* pucch, const srsran_pucch_nr_common_cfg_t* cfg, cf_t* slot_symbols)
@@ -263,6 +264,7 @@ static void usage(char* prog)
   printf("\t-n nof_prb [Default %d]\n", carrier.nof_prb);
   printf("\t-f format [Default %d]\n", format);
   printf("\t-s SNR in dB [Default %.2f]\n", snr_db);
+  printf("\t-l UCI polar list decoder size [Default %d]\n", polar_list_size);
   printf("\t-v [set verbose to debug, default none]\n");
 }
 
@@ -272,7 +274,7 @@ static void parse_args(int argc, char** argv)
   carrier.nof_prb = 6;
 
   int opt;
-  while ((opt = getopt(argc, argv, "cnfsv")) != -1) {
+  while ((opt = getopt(argc, argv, "cnfslv")) != -1) {
     switch (opt) {
       case 'c':
         carrier.pci = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -286,6 +288,9 @@ static void parse_args(int argc, char** argv)
       case 's':
         snr_db = strtof(argv[optind], NULL);
         break;
+      case 'l':
+        polar_list_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -318,6 +323,7 @@ int main(int argc, char** argv)
   }
 
   srsran_pucch_nr_args_t pucch_args = {};
+  pucch_args.uci.polar_list_size    = polar_list_size;
   if (srsran_pucch_nr_init(&pucch, &pucch_args) < SRSRAN_SUCCESS) {
     ERROR("PUCCH init");
     goto clean_exit;
@@ -21,6 +21,7 @@
 
 #include "srsran/srsran.h"
 #include <srsran/phy/phch/pusch_cfg.h>
+#include <pthread.h>
 #include <srsran/phy/utils/random.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -56,6 +57,7 @@ int          freq_hop      = -1;
 int          riv           = -1;
 uint32_t     mcs_idx       = 0;
 bool         enable_64_qam = false;
+bool         cb_executor   = false;
 
 void usage(char* prog)
 {
@@ -83,6 +85,8 @@ void usage(char* prog)
 
   printf("\n\tOther parameters:\n");
   printf("\t\t-p enable_64qam [Default %s]\n", enable_64_qam ? "enabled" : "disabled");
+  printf("\t\t-p cb_executor, decodes code blocks in parallel threads [Default %s]\n",
+         cb_executor ? "enabled" : "disabled");
   printf("\t\t-s number of subframes [Default %d]\n", subframe);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
@@ -126,6 +130,8 @@ void parse_extensive_param(char* param, char* arg)
     uci_data_tx.cfg.ack[0].nof_acks = SRSRAN_MIN((uint32_t)strtol(arg, NULL, 10), SRSRAN_UCI_MAX_ACK_BITS);
   } else if (!strcmp(param, "enable_64qam")) {
     enable_64_qam ^= true;
+  } else if (!strcmp(param, "cb_executor")) {
+    cb_executor ^= true;
   } else {
     ext_code = SRSRAN_ERROR;
   }
@@ -136,6 +142,30 @@ void parse_extensive_param(char* param, char* arg)
   }
 }
 
+static void* cb_executor_thread(void* arg)
+{
+  srsran_sch_cb_decoder_t decoder = {};
+  if (srsran_sch_cb_decoder_init(&decoder) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising code block decoder");
+  }
+
+  srsran_sch_cb_job_run((srsran_sch_cb_job_t*)arg, &decoder);
+
+  srsran_sch_cb_decoder_free(&decoder);
+  return NULL;
+}
+
+// Runs every code block in its own thread, the decoder waits for all of them
+static void cb_executor_push(void* arg, srsran_sch_cb_job_t* job)
+{
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, cb_executor_thread, job)) {
+    ERROR("Error creating code block thread");
+    exit(-1);
+  }
+  pthread_detach(thread);
+}
+
 void parse_args(int argc, char** argv)
 {
   int opt;
@@ -243,6 +273,13 @@ int main(int argc, char** argv)
     ERROR("Error creating PUSCH object");
     goto quit;
   }
+  if (cb_executor) {
+    srsran_sch_cb_executor_t executor = {.arg = NULL, .push = cb_executor_push};
+    if (srsran_sch_set_cb_executor(&pusch_rx.ul_sch, &executor)) {
+      ERROR("Error setting code block executor");
+      goto quit;
+    }
+  }
 
   uint16_t rnti = 62;
   dci.rnti      = rnti;
@@ -101,7 +101,13 @@ int srsran_uci_nr_init(srsran_uci_nr_t* q, const srsran_uci_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
-  if (srsran_polar_decoder_init(&q->decoder, polar_decoder_type, NMAX_LOG) < SRSRAN_SUCCESS) {
+  if (args->polar_list_size > 1) {
+    if (args->polar_list_size > SRSRAN_POLAR_DECODER_MAX_LIST_SIZE ||
+        srsran_polar_decoder_init_list(&q->decoder, NMAX_LOG, args->polar_list_size) < SRSRAN_SUCCESS) {
+      ERROR("Initialising polar list decoder");
+      return SRSRAN_ERROR;
+    }
+  } else if (srsran_polar_decoder_init(&q->decoder, polar_decoder_type, NMAX_LOG) < SRSRAN_SUCCESS) {
     ERROR("Initialising polar encoder");
     return SRSRAN_ERROR;
   }
@@ -140,7 +146,8 @@ int srsran_uci_nr_init(srsran_uci_nr_t* q, const srsran_uci_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
-  q->allocated = srsran_vec_u8_malloc(UCI_NR_POLAR_MAX);
+  // Allocate one polar code intermediate per list decoder candidate
+  q->allocated = srsran_vec_u8_malloc(UCI_NR_POLAR_MAX * q->decoder.list_size);
   if (q->allocated == NULL) {
     ERROR("Error malloc");
     return SRSRAN_ERROR;
@@ -808,31 +815,46 @@ static int uci_nr_decode_11_1706_bit(srsran_uci_nr_t*           q,
     int8_t* d = (int8_t*)q->d;
     srsran_polar_rm_rx_c(&q->rm_rx, &llr[E_r * r], d, E_r, q->code.n, K_r, UCI_NR_POLAR_RM_IBIL);
 
-    // Decode bits
-    if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-        SRSRAN_SUCCESS) {
+    // Decode bits, one candidate per list path
+    uint8_t* candidates[SRSRAN_POLAR_DECODER_MAX_LIST_SIZE];
+    for (uint32_t i = 0; i < q->decoder.list_size; i++) {
+      candidates[i] = &q->allocated[UCI_NR_POLAR_MAX * i];
+    }
+    int nof_candidates = srsran_polar_decoder_decode_list_c(
+        &q->decoder, d, candidates, q->code.n, q->code.F_set, q->code.F_set_size);
+    if (nof_candidates < 1) {
       return SRSRAN_ERROR;
     }
 
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-      UCI_NR_INFO_RX("Polar alloc %d/%d ", r, C);
-      srsran_vec_fprint_byte(stdout, q->allocated, q->code.N);
-    }
+    // Select the most likely candidate that passes the CRC, or the most likely one if none does. Every candidate
+    // checked is a chance for noise to pass the CRC, CRC6 is too short for that so only the most likely one is checked
+    int  nof_checked = (L == 6) ? 1 : nof_candidates;
+    bool crc_ok      = false;
+    for (int i = 0; i < nof_checked && !crc_ok; i++) {
+      if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+        UCI_NR_INFO_RX("Polar alloc %d/%d candidate %d ", r, C, i);
+        srsran_vec_fprint_byte(stdout, candidates[i], q->code.N);
+      }
 
-    // Undo channel allocation
-    srsran_polar_chanalloc_rx(q->allocated, q->c, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+      // Undo channel allocation
+      srsran_polar_chanalloc_rx(candidates[i], q->c, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
 
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-      UCI_NR_INFO_RX("Polar cb %d/%d c=", r, C);
-      srsran_vec_fprint_byte(stdout, q->c, K_r);
-    }
+      if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+        UCI_NR_INFO_RX("Polar cb %d/%d c=", r, C);
+        srsran_vec_fprint_byte(stdout, q->c, K_r);
+      }
 
-    // Calculate checksum
-    uint8_t* ptr       = &q->c[A_prime / C];
-    uint32_t checksum1 = srsran_crc_checksum(crc, q->c, A_prime / C);
-    uint32_t checksum2 = srsran_bit_pack(&ptr, L);
-    (*decoded_ok)      = ((*decoded_ok) && (checksum1 == checksum2));
-    UCI_NR_INFO_RX("Checking %d/%d CRC%d={%02x,%02x}", r, C, L, checksum1, checksum2);
+      // Calculate checksum
+      uint8_t* ptr       = &q->c[A_prime / C];
+      uint32_t checksum1 = srsran_crc_checksum(crc, q->c, A_prime / C);
+      uint32_t checksum2 = srsran_bit_pack(&ptr, L);
+      crc_ok             = (checksum1 == checksum2);
+      UCI_NR_INFO_RX("Checking %d/%d CRC%d={%02x,%02x}", r, C, L, checksum1, checksum2);
+    }
+    if (!crc_ok && nof_candidates > 1) {
+      srsran_polar_chanalloc_rx(candidates[0], q->c, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+    }
+    (*decoded_ok) = ((*decoded_ok) && crc_ok);
 
     // Prefix (A_prime - A) zeros for the first CB only
     if (r == 0) {
@@ -0,0 +1,317 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Kaiser window beta and number of taps of each branch for every quality. When decimating, the branches are M / L times
+ * longer so the filter spans the same time at the output rate
+ */
+static const struct {
+  uint32_t nof_taps;
+  double   beta;
+} resampler_poly_quality_params[] = {{16, 5.0}, {32, 7.0}, {64, 9.0}};
+
+/**
+ * The number of taps of each branch is a multiple of this, so every branch starts aligned for the widest SIMD and the
+ * dot product has no tail
+ */
+#define RESAMPLER_POLY_TAPS_ALIGN 8
+
+static uint64_t resampler_poly_gcd(uint64_t a, uint64_t b)
+{
+  while (b != 0) {
+    uint64_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  return a;
+}
+
+/// Zero order modified Bessel function of the first kind, computed with its power series
+static double resampler_poly_bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+  for (uint32_t k = 1; k < 64 && term > 1e-12 * sum; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+/// Designs the prototype low pass filter at L times the input rate and splits it in L time reversed branches
+static void resampler_poly_design(srsran_resampler_poly_t* q, double beta)
+{
+  uint32_t L = q->interp;
+  uint32_t T = q->nof_taps;
+  uint32_t N = T * L;
+
+  // The prototype is symmetric around N / 2, so the delay is an integer number of samples at the high rate. Its first
+  // coefficient is left to zero
+  double center = (double)N / 2.0;
+  double fc     = 0.5 / (double)SRSRAN_MAX(L, q->decim);
+  double i0beta = resampler_poly_bessel_i0(beta);
+
+  double* h   = calloc(N, sizeof(double));
+  double  sum = 0.0;
+  if (h == NULL) {
+    return;
+  }
+  for (uint32_t n = 1; n < N; n++) {
+    double t = (double)n - center;
+    double r = t / center;
+    double w = resampler_poly_bessel_i0(beta * sqrt(SRSRAN_MAX(0.0, 1.0 - r * r))) / i0beta;
+    double s = (t == 0.0) ? 1.0 : sin(2.0 * M_PI * fc * t) / (2.0 * M_PI * fc * t);
+    h[n]     = 2.0 * fc * s * w;
+    sum += h[n];
+  }
+
+  // Normalise the gain to 1 at the output rate, each branch adds up to one
+  double norm = (double)L / sum;
+
+  // Branch p, tap m multiplies the input sample m of the window, the newest sample is the last one
+  for (uint32_t p = 0; p < L; p++) {
+    for (uint32_t m = 0; m < T; m++) {
+      float coeff                   = (float)(h[p + (T - 1 - m) * L] * norm);
+      q->filter[2 * (p * T + m)]     = coeff;
+      q->filter[2 * (p * T + m) + 1] = coeff;
+    }
+  }
+
+  free(h);
+}
+
+int srsran_resampler_poly_init(srsran_resampler_poly_t*        q,
+                               double                          srate_in_hz,
+                               double                          srate_out_hz,
+                               srsran_resampler_poly_quality_t quality)
+{
+  if (q == NULL || !isnormal(srate_in_hz) || !isnormal(srate_out_hz) || srate_in_hz < 0.0 || srate_out_hz < 0.0 ||
+      quality > SRSRAN_RESAMPLER_POLY_QUALITY_HIGH) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Reduce the rate ratio
+  uint64_t in  = (uint64_t)round(srate_in_hz);
+  uint64_t out = (uint64_t)round(srate_out_hz);
+  uint64_t gcd = resampler_poly_gcd(in, out);
+  if (gcd == 0 || out / gcd > SRSRAN_RESAMPLER_POLY_MAX_PHASES || in / gcd > UINT32_MAX) {
+    ERROR("Unsupported resampling ratio %.3f MHz / %.3f MHz", srate_out_hz / 1e6, srate_in_hz / 1e6);
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+  uint32_t L = (uint32_t)(out / gcd);
+  uint32_t M = (uint32_t)(in / gcd);
+
+  if (q->filter != NULL && q->interp == L && q->decim == M && q->quality == quality) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure the resampler is freed
+  srsran_resampler_poly_free(q);
+
+  q->quality  = quality;
+  q->interp   = L;
+  q->decim    = M;
+  q->nof_taps = resampler_poly_quality_params[quality].nof_taps;
+  if (M > L) {
+    q->nof_taps = SRSRAN_CEIL(q->nof_taps * M, RESAMPLER_POLY_TAPS_ALIGN * L) * RESAMPLER_POLY_TAPS_ALIGN;
+  }
+
+  q->filter = srsran_vec_f_malloc(2 * L * q->nof_taps);
+  if (q->filter == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->state = srsran_vec_cf_malloc(2 * q->nof_taps);
+  if (q->state == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  resampler_poly_design(q, resampler_poly_quality_params[quality].beta);
+
+  srsran_resampler_poly_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->state == NULL) {
+    return;
+  }
+
+  srsran_vec_cf_zero(q->state, 2 * q->nof_taps);
+
+  // The first output sample is at N / 2 - delay * M samples after the newest state sample at the high rate, where N/2
+  // is the prototype delay. The largest delay that keeps it within the state makes the delay an integer number of
+  // output samples
+  uint32_t start = q->nof_taps * q->interp / 2 + q->interp;
+  q->delay       = start / q->decim;
+  start -= q->delay * q->decim;
+  q->next_idx   = start / q->interp;
+  q->next_phase = start % q->interp;
+}
+
+uint32_t srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return UINT32_MAX;
+  }
+
+  return q->delay;
+}
+
+uint32_t srsran_resampler_poly_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output)
+{
+  if (q == NULL || q->interp == 0 || nof_output == 0) {
+    return 0;
+  }
+
+  // Window start of the last output sample
+  uint64_t pos = (uint64_t)q->next_idx * q->interp + q->next_phase;
+  return (uint32_t)((pos + (uint64_t)(nof_output - 1) * q->decim) / q->interp);
+}
+
+uint32_t srsran_resampler_poly_nof_output(const srsran_resampler_poly_t* q, uint32_t nof_input)
+{
+  if (q == NULL || q->interp == 0) {
+    return 0;
+  }
+
+  // Count the output samples whose window starts within the input
+  uint64_t pos = (uint64_t)q->next_idx * q->interp + q->next_phase;
+  uint64_t end = ((uint64_t)nof_input + 1) * q->interp;
+  if (pos >= end) {
+    return 0;
+  }
+  return (uint32_t)((end - pos + q->decim - 1) / q->decim);
+}
+
+/// Filters a window of nof_taps complex samples with a real polyphase branch. The branch holds every coefficient twice,
+/// so the window is multiplied as interleaved real and imaginary parts without shuffling them
+static inline cf_t resampler_poly_dot(const cf_t* x, const float* h, uint32_t nof_taps)
+{
+  const float* x_f    = (const float*)x;
+  uint32_t     i      = 0;
+  cf_t         result = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  simd_f_t acc = srsran_simd_f_zero();
+  for (; i + SRSRAN_SIMD_F_SIZE <= 2 * nof_taps; i += SRSRAN_SIMD_F_SIZE) {
+    acc = srsran_simd_f_add(srsran_simd_f_mul(srsran_simd_f_loadu(&x_f[i]), srsran_simd_f_load(&h[i])), acc);
+  }
+
+  __attribute__((aligned(64))) float acc_vector[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_f_store(acc_vector, acc);
+  for (uint32_t j = 0; j < SRSRAN_SIMD_F_SIZE; j += 2) {
+    __real__ result += acc_vector[j];
+    __imag__ result += acc_vector[j + 1];
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  for (; i < 2 * nof_taps; i += 2) {
+    __real__ result += x_f[i] * h[i];
+    __imag__ result += x_f[i + 1] * h[i + 1];
+  }
+
+  return result;
+}
+
+int srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                              const cf_t*              input,
+                              cf_t*                    output,
+                              uint32_t                 nof_input,
+                              uint32_t                 nof_output)
+{
+  if (q == NULL || q->filter == NULL || (nof_input > 0 && input == NULL) || (nof_output > 0 && output == NULL)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t L = q->interp;
+  uint32_t M = q->decim;
+  uint32_t T = q->nof_taps;
+
+  // The input must contain the window of the last output sample, and no sample after the window of the next one
+  uint64_t pos = (uint64_t)q->next_idx * L + q->next_phase;
+  if ((nof_output > 0 && (pos + (uint64_t)(nof_output - 1) * M) / L > nof_input) ||
+      (pos + (uint64_t)nof_output * M) / L < nof_input) {
+    ERROR("Invalid number of samples (%d input, %d output)", nof_input, nof_output);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Windows starting in the state read the state followed by the first input samples
+  srsran_vec_cf_copy(&q->state[T], input, SRSRAN_MIN(T - 1, nof_input));
+
+  uint32_t idx   = q->next_idx;
+  uint32_t phase = q->next_phase;
+  uint32_t k     = 0;
+  for (; k < nof_output && idx < T; k++) {
+    output[k] = resampler_poly_dot(&q->state[idx], &q->filter[2 * phase * T], T);
+    phase += M;
+    idx += phase / L;
+    phase %= L;
+  }
+
+  // The rest of the windows are read straight from the input
+  for (; k < nof_output; k++) {
+    output[k] = resampler_poly_dot(&input[idx - T], &q->filter[2 * phase * T], T);
+    phase += M;
+    idx += phase / L;
+    phase %= L;
+  }
+
+  // Keep the last samples for the next call
+  if (nof_input >= T) {
+    srsran_vec_cf_copy(q->state, &input[nof_input - T], T);
+  } else {
+    memmove(q->state, &q->state[nof_input], T * sizeof(cf_t));
+  }
+
+  q->next_idx   = idx - nof_input;
+  q->next_phase = phase;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_poly_free(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->filter) {
+    free(q->filter);
+  }
+  if (q->state) {
+    free(q->state);
+  }
+
+  memset(q, 0, sizeof(srsran_resampler_poly_t));
+}
@@ -0,0 +1,198 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static double                          srate_in_hz  = 23.04e6;
+static double                          srate_out_hz = 30.72e6;
+static srsran_resampler_poly_quality_t quality      = SRSRAN_RESAMPLER_POLY_QUALITY_MEDIUM;
+static uint32_t                        repetitions  = 100;
+static float                           max_error_db = -40.0f;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ioqre]\n", prog);
+  printf("\t-i Input sampling rate in Hz [Default %.0f]\n", srate_in_hz);
+  printf("\t-o Output sampling rate in Hz [Default %.0f]\n", srate_out_hz);
+  printf("\t-q Quality: 0 (low), 1 (medium), 2 (high) [Default %d]\n", quality);
+  printf("\t-r Benchmark repetitions of 1 ms [Default %d]\n", repetitions);
+  printf("\t-e Maximum error in dB [Default %.1f]\n", max_error_db);
+  printf("\t-v increase verbosity\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ioqrev")) != -1) {
+    switch (opt) {
+      case 'i':
+        srate_in_hz = strtod(argv[optind], NULL);
+        break;
+      case 'o':
+        srate_out_hz = strtod(argv[optind], NULL);
+        break;
+      case 'q':
+        quality = (srsran_resampler_poly_quality_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        max_error_db = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval          t[3]      = {};
+  srsran_resampler_poly_t resampler = {};
+  int                     ret       = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  // 10 ms of signal
+  uint32_t nof_input = (uint32_t)round(srate_in_hz / 100);
+
+  cf_t* input     = NULL;
+  cf_t* output    = NULL;
+  cf_t* reference = NULL;
+
+  if (srsran_resampler_poly_init(&resampler, srate_in_hz, srate_out_hz, quality) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising resampler");
+    goto clean_exit;
+  }
+
+  // Resampling the whole signal at once produces the most output samples
+  uint32_t max_output = srsran_resampler_poly_nof_output(&resampler, nof_input);
+  input               = srsran_vec_cf_malloc(nof_input);
+  output              = srsran_vec_cf_malloc(max_output);
+  reference           = srsran_vec_cf_malloc(max_output);
+  if (input == NULL || output == NULL || reference == NULL) {
+    goto clean_exit;
+  }
+
+  // Tone at a quarter of the lowest rate, within the band of an LTE signal
+  double freq_hz = SRSRAN_MIN(srate_in_hz, srate_out_hz) / 4.0;
+  for (uint32_t i = 0; i < nof_input; i++) {
+    input[i] = cexpf(I * (float)(2.0 * M_PI * fmod(freq_hz * i / srate_in_hz, 1.0)));
+  }
+
+  // Resample the whole signal at once
+  uint32_t n_out = max_output;
+  if (srsran_resampler_poly_run(&resampler, input, reference, nof_input, n_out) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  // Compare with the ideal tone after the filter transient
+  uint32_t delay = srsran_resampler_poly_get_delay(&resampler);
+  uint32_t start = 2 * delay;
+  if (start >= n_out) {
+    ERROR("Signal too short for the resampler delay %d", delay);
+    goto clean_exit;
+  }
+  double err_pwr = 0.0;
+  for (uint32_t k = start; k < n_out; k++) {
+    double phase = fmod(freq_hz * ((double)k - delay) / srate_out_hz, 1.0);
+    err_pwr += pow(cabs(reference[k] - cexp(I * 2.0 * M_PI * phase)), 2.0);
+  }
+  float error_db = srsran_convert_power_to_dB((float)(err_pwr / (n_out - start)));
+
+  // Resample the same signal in blocks of different lengths, given either by the input or the output
+  srsran_resampler_poly_reset_state(&resampler);
+  uint32_t count_in  = 0;
+  uint32_t count_out = 0;
+  for (uint32_t i = 0; count_in < nof_input; i++) {
+    uint32_t n_in = 0;
+    if (i % 2 == 0) {
+      n_in  = SRSRAN_MIN((i * 37) % 1001 + 1, nof_input - count_in);
+      n_out = srsran_resampler_poly_nof_output(&resampler, n_in);
+    } else {
+      n_out = SRSRAN_MIN((i * 53) % 1409, max_output - count_out);
+      n_in  = srsran_resampler_poly_nof_input(&resampler, n_out);
+      if (count_in + n_in > nof_input) {
+        continue;
+      }
+    }
+    if (srsran_resampler_poly_run(&resampler, &input[count_in], &output[count_out], n_in, n_out) < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+    count_in += n_in;
+    count_out += n_out;
+  }
+  srsran_vec_sub_ccc(reference, output, output, count_out);
+  float stream_error = srsran_vec_avg_power_cf(output, count_out);
+
+  // Measure throughput, 1 ms per iteration
+  uint32_t n_in_ms = nof_input / 10;
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    n_out = srsran_resampler_poly_nof_output(&resampler, n_in_ms);
+    srsran_resampler_poly_run(&resampler, input, output, n_in_ms, n_out);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t duration_us = (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+
+  printf("%.2f -> %.2f MHz (L=%d, M=%d, %d taps): %.1f Msps in, %.1f Msps out; error %+.1f dB; stream error %.1e\n",
+         srate_in_hz / 1e6,
+         srate_out_hz / 1e6,
+         resampler.interp,
+         resampler.decim,
+         resampler.nof_taps,
+         (double)n_in_ms * repetitions / (double)SRSRAN_MAX(duration_us, 1),
+         srate_out_hz / 1e6 * (double)n_in_ms * repetitions / (srate_in_hz / 1e6 * (double)SRSRAN_MAX(duration_us, 1)),
+         error_db,
+         stream_error);
+
+  if (count_out > 0 && error_db < max_error_db && stream_error < 1e-9f) {
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  srsran_resampler_poly_free(&resampler);
+  if (input) {
+    free(input);
+  }
+  if (output) {
+    free(output);
+  }
+  if (reference) {
+    free(reference);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
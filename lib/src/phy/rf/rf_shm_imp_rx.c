@@ -0,0 +1,346 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <fcntl.h>
+#include <inttypes.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+  uint64_t end_ts;
+} rf_shm_rx_data_t;
+
+static bool rf_shm_rx_has_data(rf_shm_ring_t* ring, void* arg)
+{
+  rf_shm_rx_data_t* data = (rf_shm_rx_data_t*)arg;
+  return __atomic_load_n(&ring->write_ts, __ATOMIC_SEQ_CST) >= data->end_ts ||
+         __atomic_load_n(&ring->closed, __ATOMIC_SEQ_CST);
+}
+
+static void rf_shm_rx_detach(rf_shm_map_t* map)
+{
+  if (map->ring) {
+    __atomic_store_n(&map->ring->reader[map->slot].state, SHM_READER_FREE, __ATOMIC_SEQ_CST);
+    rf_shm_ring_notify(map->ring);
+    munmap(map->ring, map->size);
+    map->ring = NULL;
+  }
+  if (map->fd >= 0) {
+    close(map->fd);
+    map->fd = -1;
+  }
+}
+
+// Maps the ring of a transmitter, if it exists, and registers as a receiver. The first receiver reads the ring from
+// the start, the next ones join at the current write pointer
+static int rf_shm_rx_attach(rf_shm_rx_t* q, rf_shm_map_t* map)
+{
+  map->fd = shm_open(map->name, O_RDWR, 0600);
+  if (map->fd < 0) {
+    return SRSRAN_ERROR;
+  }
+
+  // The transmitter might still be initialising the ring
+  struct stat st = {};
+  if (fstat(map->fd, &st) < 0 || (size_t)st.st_size <= sizeof(rf_shm_ring_t)) {
+    rf_shm_rx_detach(map);
+    return SRSRAN_ERROR;
+  }
+
+  map->size = (size_t)st.st_size;
+  void* ptr = mmap(NULL, map->size, PROT_READ | PROT_WRITE, MAP_SHARED, map->fd, 0);
+  if (ptr == MAP_FAILED) {
+    rf_shm_rx_detach(map);
+    return SRSRAN_ERROR;
+  }
+
+  rf_shm_ring_t* ring = (rf_shm_ring_t*)ptr;
+  if (__atomic_load_n(&ring->magic, __ATOMIC_SEQ_CST) != SHM_MAGIC ||
+      map->size < sizeof(rf_shm_ring_t) + (size_t)ring->ring_len * sizeof(cf_t) ||
+      __atomic_load_n(&ring->closed, __ATOMIC_SEQ_CST)) {
+    munmap(ptr, map->size);
+    rf_shm_rx_detach(map);
+    return SRSRAN_ERROR;
+  }
+
+  // Claim a free slot, the read timestamp is set before the transmitter can see it
+  for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+    uint32_t expected = SHM_READER_FREE;
+    if (__atomic_compare_exchange_n(
+            &ring->reader[i].state, &expected, SHM_READER_CLAIMED, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+      map->ring    = ring;
+      map->slot    = i;
+      map->read_ts =
+          __atomic_load_n(&ring->hold, __ATOMIC_SEQ_CST) ? 0 : __atomic_load_n(&ring->write_ts, __ATOMIC_SEQ_CST);
+      map->seen    = true;
+      __atomic_store_n(&ring->reader[i].read_ts, map->read_ts, __ATOMIC_SEQ_CST);
+      __atomic_store_n(&ring->reader[i].state, SHM_READER_ACTIVE, __ATOMIC_SEQ_CST);
+      __atomic_store_n(&ring->hold, 0, __ATOMIC_SEQ_CST);
+
+      rf_shm_info(q->id, "Attached to %s as receiver %d from sample %" PRIu64 "\n", map->name, i, map->read_ts);
+      return SRSRAN_SUCCESS;
+    }
+  }
+
+  fprintf(stderr, "[shm] Error: too many receivers attached to %s\n", map->name);
+  munmap(ptr, map->size);
+  rf_shm_rx_detach(map);
+  return SRSRAN_ERROR;
+}
+
+int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, char* names)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_rx_t));
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    q->frequency_mhz      = opts.frequency_mhz;
+    q->fail_on_disconnect = opts.fail_on_disconnect;
+    q->trx_timeout_ms     = opts.trx_timeout_ms;
+    q->log_trx_timeout    = opts.log_trx_timeout;
+
+    // The samples of every transmitter in the list, separated by '+', are added together
+    char  tmp[RF_PARAM_LEN] = {};
+    char* saveptr           = NULL;
+    strncpy(tmp, names, RF_PARAM_LEN - 1);
+    for (char* name = strtok_r(tmp, "+", &saveptr); name != NULL; name = strtok_r(NULL, "+", &saveptr)) {
+      if (q->nof_sources == SHM_MAX_SOURCES) {
+        fprintf(stderr, "[shm] Error: more than %d transmitters for one receiver\n", SHM_MAX_SOURCES);
+        goto clean_exit;
+      }
+      rf_shm_map_t* map = &q->sources[q->nof_sources++];
+      snprintf(map->name, RF_PARAM_LEN, "%s%s", name[0] == '/' ? "" : "/", name);
+      map->fd = -1;
+
+      rf_shm_info(q->id, "Receiving from %s\n", map->name);
+    }
+
+    if (q->nof_sources == 0) {
+      fprintf(stderr, "[shm] Error: no transmitter given for the receiver\n");
+      goto clean_exit;
+    }
+
+    // The transmitters are attached on the first reception, they might not have been started yet
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
+
+// Waits until a source has the requested samples, attaching to it first if needed. The number of samples is limited
+// to half of the ring once attached. Returns SRSRAN_SUCCESS once the samples are available, or SRSRAN_ERROR_TIMEOUT if
+// the receiver keeps going without this source. A transmitter is waited for until it first shows up; once it has gone,
+// the receiver only checks whether it is back
+static int rf_shm_rx_wait_source(rf_shm_rx_t* q, rf_shm_map_t* map, uint32_t* nsamples)
+{
+  uint32_t wait_ms = 0;
+
+  while (q->running) {
+    // Leave a ring that has dropped this receiver, the samples might have been overwritten already
+    if (map->ring && __atomic_load_n(&map->ring->reader[map->slot].state, __ATOMIC_SEQ_CST) != SHM_READER_ACTIVE) {
+      fprintf(stderr, "[shm] %s: dropped by transmitter %s\n", q->id, map->name);
+      rf_shm_rx_detach(map);
+    }
+
+    if (map->ring == NULL) {
+      if (rf_shm_rx_attach(q, map) == SRSRAN_SUCCESS) {
+        continue;
+      }
+      if (map->seen) {
+        return SRSRAN_ERROR_TIMEOUT;
+      }
+      usleep(SHM_ATTACH_POLL_US);
+      wait_ms += SHM_ATTACH_POLL_US / 1000;
+    } else {
+      // The samples written before the transmitter closed the ring are still read
+      *nsamples             = SRSRAN_MIN(*nsamples, map->ring->ring_len / 2);
+      rf_shm_rx_data_t data = {map->read_ts + *nsamples};
+      if (__atomic_load_n(&map->ring->write_ts, __ATOMIC_SEQ_CST) >= data.end_ts) {
+        return SRSRAN_SUCCESS;
+      }
+
+      // Leave a closed ring, the transmitter may come back with a new one
+      if (__atomic_load_n(&map->ring->closed, __ATOMIC_SEQ_CST)) {
+        rf_shm_info(q->id, "Transmitter %s is gone\n", map->name);
+        rf_shm_rx_detach(map);
+        continue;
+      }
+
+      if (rf_shm_ring_wait(map->ring, rf_shm_rx_has_data, &data, q->trx_timeout_ms) == SRSRAN_ERROR_TIMEOUT) {
+        wait_ms += q->trx_timeout_ms;
+      }
+    }
+
+    if (wait_ms >= q->trx_timeout_ms) {
+      if (q->log_trx_timeout) {
+        fprintf(stderr, "Error: timeout receiving samples from %s after %dms\n", map->name, q->trx_timeout_ms);
+      }
+      // Other end disconnected, either keep going, or fail
+      if (q->fail_on_disconnect) {
+        return SRSRAN_ERROR;
+      }
+      if (map->ring) {
+        rf_shm_rx_detach(map);
+        return SRSRAN_ERROR_TIMEOUT;
+      }
+      wait_ms = 0;
+    }
+  }
+
+  return SRSRAN_ERROR;
+}
+
+int rf_shm_rx_connect(rf_shm_rx_t* q, uint64_t* ts)
+{
+  if (q == NULL || !q->running) {
+    return SRSRAN_ERROR;
+  }
+
+  // Attach to every transmitter that has not shown up yet, waiting for it if needed
+  for (uint32_t i = 0; i < q->nof_sources; i++) {
+    uint32_t nsamples = 0;
+    if (!q->sources[i].seen && rf_shm_rx_wait_source(q, &q->sources[i], &nsamples) == SRSRAN_ERROR) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  if (ts != NULL && q->sources[0].ring != NULL) {
+    *ts = q->sources[0].read_ts;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Copies or adds the samples of a source into the buffer, in two parts if the ring wraps around
+static void rf_shm_rx_read(rf_shm_map_t* map, cf_t* buffer, uint32_t nsamples, bool add)
+{
+  rf_shm_ring_t* ring = map->ring;
+  uint64_t       ts   = map->read_ts;
+
+  if (buffer != NULL) {
+    uint32_t mask  = ring->ring_len - 1;
+    uint32_t idx   = (uint32_t)(ts & mask);
+    uint32_t first = SRSRAN_MIN(nsamples, ring->ring_len - idx);
+
+    if (add) {
+      srsran_vec_sum_ccc(buffer, &ring->samples[idx], buffer, first);
+      srsran_vec_sum_ccc(&buffer[first], &ring->samples[0], &buffer[first], nsamples - first);
+    } else {
+      srsran_vec_cf_copy(buffer, &ring->samples[idx], first);
+      srsran_vec_cf_copy(&buffer[first], &ring->samples[0], nsamples - first);
+    }
+
+    // The samples older than a whole ring before the write pointer may have been overwritten while copying. That only
+    // happens while attaching, they are lost
+    uint64_t write_ts = __atomic_load_n(&ring->write_ts, __ATOMIC_SEQ_CST);
+    if (write_ts > ts + ring->ring_len) {
+      uint32_t nof_lost = (uint32_t)SRSRAN_MIN(write_ts - ring->ring_len - ts, nsamples);
+      srsran_vec_cf_zero(buffer, nof_lost);
+      fprintf(stderr, "[shm] Warning: lost %d samples from %s\n", nof_lost, map->name);
+    }
+  }
+
+  // Release the samples for the transmitter
+  map->read_ts += nsamples;
+  __atomic_store_n(&ring->reader[map->slot].read_ts, map->read_ts, __ATOMIC_SEQ_CST);
+  rf_shm_ring_notify(ring);
+}
+
+int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  if (q == NULL || !q->running) {
+    return SRSRAN_ERROR;
+  }
+
+  bool filled = false;
+  for (uint32_t i = 0; i < q->nof_sources; i++) {
+    rf_shm_map_t* map   = &q->sources[i];
+    uint32_t      count = 0;
+    while (count < nsamples) {
+      uint32_t len = nsamples - count;
+      int      ret = rf_shm_rx_wait_source(q, map, &len);
+      if (ret == SRSRAN_ERROR) {
+        return SRSRAN_ERROR;
+      }
+      if (ret == SRSRAN_ERROR_TIMEOUT) {
+        // The source has gone half way, the rest of the first contribution is zero
+        if (buffer != NULL && !filled && count > 0) {
+          srsran_vec_cf_zero(&buffer[count], nsamples - count);
+        }
+        break;
+      }
+
+      // The samples of a channel without buffer are consumed anyway
+      rf_shm_rx_read(map, buffer ? &buffer[count] : NULL, len, filled);
+      count += len;
+    }
+    filled = filled || (buffer != NULL && count > 0);
+  }
+
+  if (buffer != NULL && !filled) {
+    srsran_vec_cf_zero(buffer, nsamples);
+  }
+
+  return (int)nsamples;
+}
+
+bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+bool rf_shm_rx_is_running(rf_shm_rx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  return q->running;
+}
+
+void rf_shm_rx_close(rf_shm_rx_t* q)
+{
+  rf_shm_info(q->id, "Closing ...\n");
+  q->running = false;
+
+  for (uint32_t i = 0; i < q->nof_sources; i++) {
+    rf_shm_rx_detach(&q->sources[i]);
+  }
+  q->nof_sources = 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_TRX_H
+#define SRSRAN_RF_SHM_IMP_TRX_H
+
+#include "srsran/config.h"
+#include "srsran/phy/rf/rf.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Definitions */
+#define SHM_VERBOSE (0)
+#define SHM_MAGIC (0x73727368) // "srsh"
+#define SHM_MAX_READERS (32)
+#define SHM_MAX_SOURCES (16)
+#define SHM_RING_LEN_DEFAULT (1U << 20) // 45 ms at 23.04 MHz
+#define SHM_MAX_BUFFER_SIZE (3072000)   // Samples, 10 subframes at 20 MHz
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_ATTACH_POLL_US (1000)
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_ID_STRLEN 16
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+
+typedef enum { SHM_READER_FREE = 0, SHM_READER_CLAIMED, SHM_READER_ACTIVE } rf_shm_reader_state_t;
+
+/**
+ * Receiver attached to a ring. The transmitter never overwrites the samples from read_ts onwards
+ */
+typedef struct {
+  uint64_t read_ts; ///< Next sample timestamp the receiver consumes
+  uint32_t state;   ///< One of rf_shm_reader_state_t
+} __attribute__((aligned(64))) rf_shm_reader_t;
+
+/**
+ * Shared memory ring header, followed by ring_len samples. Timestamps count the samples written by the transmitter
+ * since it opened the ring, the sample with timestamp ts is stored at ts modulo ring_len. The samples are exchanged
+ * without locking, the mutex and condition variable are only used to sleep while waiting for samples or room in the
+ * ring
+ */
+typedef struct {
+  uint32_t        magic;       ///< Set to SHM_MAGIC once the ring is initialised
+  uint32_t        ring_len;    ///< Number of samples, power of two
+  uint32_t        closed;      ///< The transmitter has closed the ring
+  uint32_t        hold;        ///< No receiver has attached yet, the samples from timestamp 0 are kept
+  uint32_t        nof_waiting; ///< Number of threads sleeping on the condition variable
+  pthread_mutex_t mutex;
+  pthread_cond_t  cvar;
+  uint64_t        write_ts __attribute__((aligned(64))); ///< Timestamp of the next sample to write
+  rf_shm_reader_t reader[SHM_MAX_READERS];
+  cf_t            samples[] __attribute__((aligned(64)));
+} rf_shm_ring_t;
+
+/**
+ * Mapping of a ring into the process memory
+ */
+typedef struct {
+  char           name[RF_PARAM_LEN];
+  int            fd;
+  size_t         size;
+  rf_shm_ring_t* ring;
+  uint32_t       slot;    ///< Reader slot, receivers only
+  uint64_t       read_ts; ///< Next sample to read in the transmitter time, receivers only
+  bool           seen;    ///< The transmitter has been attached before, receivers only
+} rf_shm_map_t;
+
+typedef struct {
+  char         id[SHM_ID_STRLEN];
+  rf_shm_map_t map;
+  uint64_t     nsamples;
+  bool         running;
+  uint32_t     frequency_mhz;
+  uint32_t     trx_timeout_ms;
+} rf_shm_tx_t;
+
+typedef struct {
+  char         id[SHM_ID_STRLEN];
+  rf_shm_map_t sources[SHM_MAX_SOURCES]; ///< Rings added together, one for each transmitter
+  uint32_t     nof_sources;
+  bool         running;
+  uint32_t     frequency_mhz;
+  bool         fail_on_disconnect;
+  uint32_t     trx_timeout_ms;
+  bool         log_trx_timeout;
+} rf_shm_rx_t;
+
+typedef struct {
+  const char* id;
+  uint32_t    frequency_mhz;
+  uint32_t    ring_len;
+  bool        fail_on_disconnect;
+  uint32_t    trx_timeout_ms;
+  bool        log_trx_timeout;
+} rf_shm_opts_t;
+
+/*
+ * Common functions
+ */
+SRSRAN_API void rf_shm_info(char* id, const char* format, ...);
+
+SRSRAN_API void rf_shm_error(char* id, const char* format, ...);
+
+SRSRAN_API void rf_shm_ring_notify(rf_shm_ring_t* ring);
+
+SRSRAN_API int
+rf_shm_ring_wait(rf_shm_ring_t* ring, bool (*ready)(rf_shm_ring_t*, void*), void* arg, uint32_t timeout_ms);
+
+/*
+ * Transmitter functions
+ */
+SRSRAN_API int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, char* name);
+
+SRSRAN_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples);
+
+SRSRAN_API uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q);
+
+SRSRAN_API int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_is_running(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSRAN_API int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, char* names);
+
+/**
+ * Attaches the receiver to its transmitters, waiting for the ones that have not been started yet. If ts is not NULL it
+ * is set to the timestamp the first transmitter is read from
+ */
+SRSRAN_API int rf_shm_rx_connect(rf_shm_rx_t* q, uint64_t* ts);
+
+SRSRAN_API int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_is_running(rf_shm_rx_t* q);
+
+#endif // SRSRAN_RF_SHM_IMP_TRX_H
@@ -0,0 +1,303 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+  uint64_t end_ts;
+} rf_shm_tx_space_t;
+
+// Oldest sample still needed by a receiver, the ring can be written up to ring_len samples after it
+static uint64_t rf_shm_tx_min_read_ts(rf_shm_ring_t* ring, uint64_t write_ts)
+{
+  if (__atomic_load_n(&ring->hold, __ATOMIC_SEQ_CST)) {
+    return 0;
+  }
+
+  uint64_t min_ts = write_ts;
+  for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+    if (__atomic_load_n(&ring->reader[i].state, __ATOMIC_SEQ_CST) == SHM_READER_ACTIVE) {
+      min_ts = SRSRAN_MIN(min_ts, __atomic_load_n(&ring->reader[i].read_ts, __ATOMIC_SEQ_CST));
+    }
+  }
+  return min_ts;
+}
+
+static bool rf_shm_tx_has_space(rf_shm_ring_t* ring, void* arg)
+{
+  rf_shm_tx_space_t* space    = (rf_shm_tx_space_t*)arg;
+  uint64_t           write_ts = __atomic_load_n(&ring->write_ts, __ATOMIC_SEQ_CST);
+  return space->end_ts <= rf_shm_tx_min_read_ts(ring, write_ts) + ring->ring_len;
+}
+
+// Drops the receivers that have not read anything for a whole timeout, for instance after a crash
+static void rf_shm_tx_evict_readers(rf_shm_tx_t* q)
+{
+  rf_shm_ring_t* ring     = q->map.ring;
+  uint64_t       write_ts = __atomic_load_n(&ring->write_ts, __ATOMIC_SEQ_CST);
+  uint64_t       min_ts   = rf_shm_tx_min_read_ts(ring, write_ts);
+
+  __atomic_store_n(&ring->hold, 0, __ATOMIC_SEQ_CST);
+  for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+    if (__atomic_load_n(&ring->reader[i].state, __ATOMIC_SEQ_CST) == SHM_READER_ACTIVE &&
+        __atomic_load_n(&ring->reader[i].read_ts, __ATOMIC_SEQ_CST) == min_ts) {
+      __atomic_store_n(&ring->reader[i].state, SHM_READER_FREE, __ATOMIC_SEQ_CST);
+      fprintf(stderr, "[shm] %s: receiver %d of %s stalled, dropping it\n", q->id, i, q->map.name);
+    }
+  }
+}
+
+static void rf_shm_tx_close_stale(const char* name)
+{
+  int fd = shm_open(name, O_RDWR, 0600);
+  if (fd < 0) {
+    return;
+  }
+
+  struct stat st = {};
+  if (fstat(fd, &st) == 0 && (size_t)st.st_size > sizeof(rf_shm_ring_t)) {
+    void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr != MAP_FAILED) {
+      rf_shm_ring_t* ring = (rf_shm_ring_t*)ptr;
+      if (__atomic_load_n(&ring->magic, __ATOMIC_SEQ_CST) == SHM_MAGIC) {
+        __atomic_store_n(&ring->closed, 1, __ATOMIC_SEQ_CST);
+        rf_shm_ring_notify(ring);
+      }
+      munmap(ptr, (size_t)st.st_size);
+    }
+  }
+  close(fd);
+}
+
+int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, char* name)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_tx_t));
+    q->map.fd = -1;
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    // Shared memory object names start with a slash
+    snprintf(q->map.name, RF_PARAM_LEN, "%s%s", name[0] == '/' ? "" : "/", name);
+    q->frequency_mhz  = opts.frequency_mhz;
+    q->trx_timeout_ms = opts.trx_timeout_ms;
+
+    // The ring length is rounded up to a power of two
+    uint32_t ring_len = 1;
+    while (ring_len < opts.ring_len) {
+      ring_len <<= 1;
+    }
+
+    rf_shm_info(q->id, "Creating transmitter ring %s (%d samples)\n", q->map.name, ring_len);
+
+    // Close and remove any ring left behind by a previous run, so its receivers move to the new one
+    rf_shm_tx_close_stale(q->map.name);
+    shm_unlink(q->map.name);
+    q->map.fd = shm_open(q->map.name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (q->map.fd < 0) {
+      fprintf(stderr, "[shm] Error: creating shared memory %s: %s\n", q->map.name, strerror(errno));
+      goto clean_exit;
+    }
+
+    q->map.size = sizeof(rf_shm_ring_t) + (size_t)ring_len * sizeof(cf_t);
+    if (ftruncate(q->map.fd, (off_t)q->map.size) < 0) {
+      fprintf(stderr, "[shm] Error: resizing shared memory %s: %s\n", q->map.name, strerror(errno));
+      goto clean_exit;
+    }
+
+    void* ptr = mmap(NULL, q->map.size, PROT_READ | PROT_WRITE, MAP_SHARED, q->map.fd, 0);
+    if (ptr == MAP_FAILED) {
+      fprintf(stderr, "[shm] Error: mapping shared memory %s: %s\n", q->map.name, strerror(errno));
+      goto clean_exit;
+    }
+    q->map.ring = (rf_shm_ring_t*)ptr;
+
+    rf_shm_ring_t* ring = q->map.ring;
+    ring->ring_len      = ring_len;
+    ring->hold          = 1;
+
+    pthread_mutexattr_t mutex_attr;
+    pthread_mutexattr_init(&mutex_attr);
+    pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+    if (pthread_mutex_init(&ring->mutex, &mutex_attr)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&ring->cvar, &cond_attr)) {
+      fprintf(stderr, "Error: creating condition variable\n");
+      goto clean_exit;
+    }
+    pthread_condattr_destroy(&cond_attr);
+
+    // Receivers attach once the magic number is set
+    __atomic_store_n(&ring->magic, SHM_MAGIC, __ATOMIC_SEQ_CST);
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
+
+static int _rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples)
+{
+  rf_shm_ring_t*    ring  = q->map.ring;
+  uint32_t          mask  = ring->ring_len - 1;
+  rf_shm_tx_space_t space = {q->nsamples + nsamples};
+
+  // Wait for the receivers to leave room for the samples
+  while (!rf_shm_tx_has_space(ring, &space)) {
+    if (!q->running) {
+      return SRSRAN_ERROR;
+    }
+    if (rf_shm_ring_wait(ring, rf_shm_tx_has_space, &space, q->trx_timeout_ms) == SRSRAN_ERROR_TIMEOUT) {
+      rf_shm_tx_evict_readers(q);
+    }
+  }
+
+  // Write straight into the ring, in two parts if it wraps around
+  uint32_t idx   = (uint32_t)(q->nsamples & mask);
+  uint32_t first = SRSRAN_MIN(nsamples, ring->ring_len - idx);
+  if (buffer == NULL) {
+    srsran_vec_cf_zero(&ring->samples[idx], first);
+    srsran_vec_cf_zero(&ring->samples[0], nsamples - first);
+  } else if (scale == 1.0f) {
+    srsran_vec_cf_copy(&ring->samples[idx], buffer, first);
+    srsran_vec_cf_copy(&ring->samples[0], &buffer[first], nsamples - first);
+  } else {
+    srsran_vec_sc_prod_cfc(buffer, scale, &ring->samples[idx], first);
+    srsran_vec_sc_prod_cfc(&buffer[first], scale, &ring->samples[0], nsamples - first);
+  }
+
+  // Publish the samples
+  q->nsamples += nsamples;
+  __atomic_store_n(&ring->write_ts, q->nsamples, __ATOMIC_SEQ_CST);
+  rf_shm_ring_notify(ring);
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  int64_t nsamples = (int64_t)ts - (int64_t)q->nsamples;
+
+  if (nsamples > 0) {
+    rf_shm_info(q->id, " - Detected Tx gap of %" PRId64 " samples.\n", nsamples);
+    if (rf_shm_tx_zeros(q, (uint32_t)nsamples) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, const cf_t* buffer, float scale, uint32_t nsamples)
+{
+  int n = SRSRAN_ERROR;
+
+  if (q && q->running) {
+    // Never write more than half of the ring at once, so a receiver can always make progress
+    uint32_t max_len = q->map.ring->ring_len / 2;
+    uint32_t count   = 0;
+    while (count < nsamples) {
+      uint32_t len = SRSRAN_MIN(nsamples - count, max_len);
+      if (_rf_shm_tx_baseband(q, buffer ? &buffer[count] : NULL, scale, len) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      count += len;
+    }
+    n = (int)nsamples;
+  }
+
+  return n;
+}
+
+int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  rf_shm_info(q->id, " - Tx %d Zeros.\n", nsamples);
+  return rf_shm_tx_baseband(q, NULL, 1.0f, nsamples);
+}
+
+uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q)
+{
+  return q->nsamples;
+}
+
+bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+bool rf_shm_tx_is_running(rf_shm_tx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  return q->running;
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  rf_shm_info(q->id, "Closing ...\n");
+  q->running = false;
+
+  if (q->map.ring) {
+    // Receivers still attached detach when they see the ring closed
+    __atomic_store_n(&q->map.ring->closed, 1, __ATOMIC_SEQ_CST);
+    rf_shm_ring_notify(q->map.ring);
+    munmap(q->map.ring, q->map.size);
+    q->map.ring = NULL;
+  }
+
+  // Only the transmitters that were opened own a shared memory object
+  if (q->map.name[0] != '\0' && q->map.fd >= 0) {
+    close(q->map.fd);
+    shm_unlink(q->map.name);
+    q->map.fd = -1;
+  }
+}
@@ -0,0 +1,387 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp.h"
+#include "srsran/common/tsan_options.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/utils/debug.h"
+#include <complex.h>
+#include <pthread.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define COMPARE_EPSILON (1e-6f)
+#define NOF_RX_ANT 4
+#define NOF_UE 2
+#define NUM_SF (500)
+#define SF_LEN (1920)
+#define RF_BUFFER_SIZE (SF_LEN * NUM_SF)
+#define TX_OFFSET_MS (4)
+
+static cf_t ue_rx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
+static cf_t enb_tx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
+static cf_t enb_rx_buffer[NOF_RX_ANT][RF_BUFFER_SIZE];
+
+// Fan-in test, one channel per radio
+static cf_t fan_ue_tx_buffer[NOF_UE][RF_BUFFER_SIZE];
+static cf_t fan_ue_rx_buffer[NOF_UE][RF_BUFFER_SIZE];
+
+static srsran_rf_t ue_radio, enb_radio;
+pthread_t          rx_thread;
+
+static void generate_random(cf_t* buffer, uint32_t nsamples)
+{
+  for (uint32_t i = 0; i < nsamples; i++) {
+    buffer[i] = ((float)rand() / (float)RAND_MAX) + _Complex_I * ((float)rand() / (float)RAND_MAX);
+  }
+}
+
+static bool compare(const cf_t* x, const cf_t* y, uint32_t nsamples)
+{
+  for (uint32_t i = 0; i < nsamples; i++) {
+    if (cabsf(x[i] - y[i]) > COMPARE_EPSILON) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static double elapsed_s(struct timeval* t)
+{
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  return (double)t[0].tv_sec + 1e-6 * (double)t[0].tv_usec;
+}
+
+void* ue_rx_thread_function(void* args)
+{
+  char rf_args[RF_PARAM_LEN];
+  strncpy(rf_args, (char*)args, RF_PARAM_LEN - 1);
+  rf_args[RF_PARAM_LEN - 1] = 0;
+
+  printf("opening rx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&ue_radio, "shm", rf_args, NOF_RX_ANT)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+
+  // receive 5 subframes at once (i.e. mimic initial rx that receives one slot)
+  uint32_t num_slots          = NUM_SF / 5;
+  uint32_t num_samps_per_slot = SF_LEN * 5;
+  uint32_t num_rxed_samps     = 0;
+  for (uint32_t i = 0; i < num_slots; ++i) {
+    void* data_ptr[SRSRAN_MAX_PORTS] = {NULL};
+    for (uint32_t c = 0; c < NOF_RX_ANT; c++) {
+      data_ptr[c] = &ue_rx_buffer[c][i * num_samps_per_slot];
+    }
+    num_rxed_samps += srsran_rf_recv_with_time_multi(&ue_radio, data_ptr, num_samps_per_slot, true, NULL, NULL);
+  }
+
+  printf("received %d samples.\n", num_rxed_samps);
+
+  printf("closing ue shm device\n");
+  srsran_rf_close(&ue_radio);
+
+  return NULL;
+}
+
+void enb_tx_function(const char* tx_args, bool timed_tx)
+{
+  char rf_args[RF_PARAM_LEN];
+  strncpy(rf_args, tx_args, RF_PARAM_LEN - 1);
+  rf_args[RF_PARAM_LEN - 1] = 0;
+
+  printf("opening tx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&enb_radio, "shm", rf_args, NOF_RX_ANT)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+
+  // generate random tx data
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    generate_random(enb_tx_buffer[c], RF_BUFFER_SIZE);
+  }
+
+  // send data subframe per subframe
+  uint32_t num_txed_samples = 0;
+
+  // initial transmission without ts
+  void* data_ptr[SRSRAN_MAX_PORTS] = {NULL};
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    data_ptr[c] = &enb_tx_buffer[c][num_txed_samples];
+  }
+  int ret = srsran_rf_send_multi(&enb_radio, (void**)data_ptr, SF_LEN, true, true, false);
+  num_txed_samples += SF_LEN;
+
+  // from here on, all transmissions are timed relative to the last rx time
+  srsran_timestamp_t rx_time, tx_time;
+
+  for (uint32_t i = 0; i < NUM_SF - ((timed_tx) ? TX_OFFSET_MS : 1); ++i) {
+    // first recv samples
+    for (int c = 0; c < NOF_RX_ANT; c++) {
+      data_ptr[c] = enb_rx_buffer[c];
+    }
+    srsran_rf_recv_with_time_multi(&enb_radio, data_ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs);
+
+    // prepare data buffer
+    for (int c = 0; c < NOF_RX_ANT; c++) {
+      data_ptr[c] = &enb_tx_buffer[c][num_txed_samples];
+    }
+
+    if (timed_tx) {
+      // timed tx relative to receive time (this will cause a gap in the rx'ed samples at the UE resulting in 3 zero
+      // subframes)
+      srsran_timestamp_copy(&tx_time, &rx_time);
+      srsran_timestamp_add(&tx_time, 0, TX_OFFSET_MS * 1e-3);
+      ret = srsran_rf_send_timed_multi(
+          &enb_radio, (void**)data_ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, true, false);
+    } else {
+      // normal tx
+      ret = srsran_rf_send_multi(&enb_radio, (void**)data_ptr, SF_LEN, true, true, false);
+    }
+    if (ret != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error sending data\n");
+      exit(-1);
+    }
+
+    num_txed_samples += SF_LEN;
+  }
+
+  printf("transmitted %d samples in %d subframes\n", num_txed_samples, NUM_SF);
+
+  printf("closing tx device\n");
+  srsran_rf_close(&enb_radio);
+}
+
+int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+{
+  int            ret  = SRSRAN_ERROR;
+  struct timeval t[3] = {};
+
+  gettimeofday(&t[1], NULL);
+
+  // start Rx thread
+  if (pthread_create(&rx_thread, NULL, ue_rx_thread_function, (void*)rx_args)) {
+    perror("pthread_create");
+    exit(-1);
+  }
+
+  enb_tx_function(tx_args, timed_tx);
+
+  // wait for rx thread
+  pthread_join(rx_thread, NULL);
+
+  printf("Exchanged %d samples in %d channels at %.1f Msps\n",
+         RF_BUFFER_SIZE,
+         NOF_RX_ANT,
+         (double)NOF_RX_ANT * RF_BUFFER_SIZE / elapsed_s(t) / 1e6);
+
+  // channel-wise comparison
+  for (int c = 0; c < NOF_RX_ANT; c++) {
+    // subframe-wise compare tx'ed and rx'ed data (stop 3 subframes earlier for timed tx)
+    for (uint32_t i = 0; i < NUM_SF - (timed_tx ? 3 : 0); ++i) {
+      uint32_t sf_offet = 0;
+      if (timed_tx && i >= 1) {
+        // for timed transmission, the enb inserts 3 zero subframes after the first untimed tx
+        sf_offet = (TX_OFFSET_MS - 1) * SF_LEN;
+      }
+
+      if (!compare(&ue_rx_buffer[c][sf_offet + i * SF_LEN], &enb_tx_buffer[c][i * SF_LEN], SF_LEN)) {
+        fprintf(stderr, "data mismatch in channel %d subframe %d\n", c, i);
+        printf("enb_tx_buffer sf%d:\n", i);
+        srsran_vec_fprint_c(stdout, &enb_tx_buffer[c][i * SF_LEN], 10);
+        printf("ue_rx_buffer sf%d:\n", i);
+        srsran_vec_fprint_c(stdout, &ue_rx_buffer[c][sf_offet + i * SF_LEN], 10);
+        goto exit;
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+exit:
+  return ret;
+}
+
+typedef struct {
+  uint32_t ue_idx;
+  char     rf_args[RF_PARAM_LEN];
+} fan_ue_args_t;
+
+// Receives the DL and answers every subframe with its own UL
+void* fan_ue_thread_function(void* args)
+{
+  fan_ue_args_t* ue    = (fan_ue_args_t*)args;
+  srsran_rf_t    radio = {};
+
+  printf("opening ue %d device with args=%s\n", ue->ue_idx, ue->rf_args);
+  if (srsran_rf_open_devname(&radio, "shm", ue->rf_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+
+  for (uint32_t i = 0; i < NUM_SF; i++) {
+    srsran_rf_recv_with_time(&radio, &fan_ue_rx_buffer[ue->ue_idx][i * SF_LEN], SF_LEN, true, NULL, NULL);
+    if (srsran_rf_send2(&radio, &fan_ue_tx_buffer[ue->ue_idx][i * SF_LEN], SF_LEN, true, true, false) !=
+        SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error sending data\n");
+      exit(-1);
+    }
+  }
+
+  srsran_rf_close(&radio);
+
+  return NULL;
+}
+
+// Two UEs receive the same DL ring, the eNB receives the sum of their UL rings
+int run_fan_test()
+{
+  int            ret                    = SRSRAN_ERROR;
+  pthread_t      ue_thread[NOF_UE]      = {};
+  fan_ue_args_t  ue_args[NOF_UE]        = {};
+  struct timeval t[3]                   = {};
+  char           enb_args[RF_PARAM_LEN] =
+      "tx_port=shm_test_dl,rx_port=shm_test_ul0+shm_test_ul1,id=enb,base_srate=1.92e6";
+
+  for (uint32_t u = 0; u < NOF_UE; u++) {
+    generate_random(fan_ue_tx_buffer[u], RF_BUFFER_SIZE);
+  }
+  generate_random(enb_tx_buffer[0], RF_BUFFER_SIZE);
+
+  gettimeofday(&t[1], NULL);
+
+  for (uint32_t u = 0; u < NOF_UE; u++) {
+    ue_args[u].ue_idx = u;
+    snprintf(ue_args[u].rf_args,
+             RF_PARAM_LEN,
+             "tx_port=shm_test_ul%d,rx_port=shm_test_dl,id=ue%d,base_srate=1.92e6",
+             u,
+             u);
+    if (pthread_create(&ue_thread[u], NULL, fan_ue_thread_function, &ue_args[u])) {
+      perror("pthread_create");
+      exit(-1);
+    }
+  }
+
+  printf("opening enb device with args=%s\n", enb_args);
+  if (srsran_rf_open_devname(&enb_radio, "shm", enb_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+
+  srsran_rf_send2(&enb_radio, &enb_tx_buffer[0][0], SF_LEN, true, true, false);
+  for (uint32_t i = 0; i < NUM_SF; i++) {
+    srsran_rf_recv_with_time(&enb_radio, &enb_rx_buffer[0][i * SF_LEN], SF_LEN, true, NULL, NULL);
+    if (i + 1 < NUM_SF) {
+      srsran_rf_send2(&enb_radio, &enb_tx_buffer[0][(i + 1) * SF_LEN], SF_LEN, true, true, false);
+    }
+  }
+
+  // A UE that joined late waits for the subframes the eNB has not sent until it closes
+  srsran_rf_close(&enb_radio);
+  for (uint32_t u = 0; u < NOF_UE; u++) {
+    pthread_join(ue_thread[u], NULL);
+  }
+
+  printf("Exchanged %d samples with %d UEs at %.1f Msps\n",
+         RF_BUFFER_SIZE,
+         NOF_UE,
+         (double)2 * NOF_UE * RF_BUFFER_SIZE / elapsed_s(t) / 1e6);
+
+  // Every UE receives the DL from the subframe it joined at
+  srsran_vec_cf_zero(ue_rx_buffer[0], RF_BUFFER_SIZE);
+  for (uint32_t u = 0; u < NOF_UE; u++) {
+    uint32_t join_sf = 0;
+    while (join_sf < NUM_SF && !compare(fan_ue_rx_buffer[u], &enb_tx_buffer[0][join_sf * SF_LEN], SF_LEN)) {
+      join_sf++;
+    }
+    uint32_t len = (NUM_SF - join_sf) * SF_LEN;
+    if (join_sf > 2 || !compare(fan_ue_rx_buffer[u], &enb_tx_buffer[0][join_sf * SF_LEN], len)) {
+      fprintf(stderr, "DL data mismatch in UE %d\n", u);
+      goto exit;
+    }
+    printf("UE %d joined at subframe %d\n", u, join_sf);
+
+    // The UE takes the eNB time and answers the subframe it has just received, one subframe later
+    uint32_t offset = (join_sf + 1) * SF_LEN;
+    srsran_vec_sum_ccc(
+        &ue_rx_buffer[0][offset], fan_ue_tx_buffer[u], &ue_rx_buffer[0][offset], RF_BUFFER_SIZE - offset);
+  }
+
+  // The eNB receives the sum of the UEs
+  if (!compare(enb_rx_buffer[0], ue_rx_buffer[0], RF_BUFFER_SIZE)) {
+    fprintf(stderr, "UL data mismatch\n");
+    goto exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+exit:
+  return ret;
+}
+
+int main()
+{
+  // up to 4 trx radios with continous tx (no decimation, no timed tx)
+  if (run_test("tx_port=shm_test_ul0,tx_port=shm_test_ul1,tx_port=shm_test_ul2,tx_port=shm_test_ul3,rx_port="
+               "shm_test_dl0,rx_port=shm_test_dl1,rx_port=shm_test_dl2,rx_port=shm_test_dl3,id=ue,base_srate=1.92e6,"
+               "log_trx_timeout=true,trx_timeout_ms=1000",
+               "rx_port=shm_test_ul0,rx_port=shm_test_ul1,rx_port=shm_test_ul2,rx_port=shm_test_ul3,tx_port="
+               "shm_test_dl0,tx_port=shm_test_dl1,tx_port=shm_test_dl2,tx_port=shm_test_dl3,id=enb,base_srate=1.92e6",
+               false) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios with continous tx (timed tx)
+  if (run_test("tx_port=shm_test_ul0,tx_port=shm_test_ul1,tx_port=shm_test_ul2,tx_port=shm_test_ul3,rx_port="
+               "shm_test_dl0,rx_port=shm_test_dl1,rx_port=shm_test_dl2,rx_port=shm_test_dl3,id=ue,base_srate=1.92e6",
+               "rx_port=shm_test_ul0,rx_port=shm_test_ul1,rx_port=shm_test_ul2,rx_port=shm_test_ul3,tx_port="
+               "shm_test_dl0,tx_port=shm_test_dl1,tx_port=shm_test_dl2,tx_port=shm_test_dl3,id=enb,base_srate=1.92e6",
+               true) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test with timed tx failed!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios with continous tx (timed tx) with decimation 23.04e6 <-> 1.92e6 and a ring shorter than a
+  // transmission at the base rate
+  if (run_test("tx_port=shm_test_ul0,tx_port=shm_test_ul1,tx_port=shm_test_ul2,tx_port=shm_test_ul3,rx_port="
+               "shm_test_dl0,rx_port=shm_test_dl1,rx_port=shm_test_dl2,rx_port=shm_test_dl3,id=ue,base_srate=23.04e6,"
+               "ring_len=262144",
+               "rx_port=shm_test_ul0,rx_port=shm_test_ul1,rx_port=shm_test_ul2,rx_port=shm_test_ul3,tx_port="
+               "shm_test_dl0,tx_port=shm_test_dl1,tx_port=shm_test_dl2,tx_port=shm_test_dl3,id=enb,base_srate=23.04e6,"
+               "ring_len=262144",
+               true) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test with timed tx and decimation failed!\n");
+    return -1;
+  }
+
+  // two UEs sharing the DL and added together in the UL
+  if (run_fan_test() != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Fan-in radio test failed!\n");
+    return -1;
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -405,18 +405,18 @@ void srsran_pss_set_ema_alpha(srsran_pss_t* q, float alpha)
   q->ema_alpha = alpha;
 }
 
-float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t conv_output_len)
+static float peak_sidelobe(const float* corr, uint32_t corr_peak_pos, uint32_t conv_output_len)
 {
   // Find end of peak lobe to the right
   int pl_ub = corr_peak_pos + 1;
-  while (q->conv_output_avg[pl_ub + 1] <= q->conv_output_avg[pl_ub] && pl_ub < conv_output_len) {
+  while (corr[pl_ub + 1] <= corr[pl_ub] && pl_ub < conv_output_len) {
     pl_ub++;
   }
   // Find end of peak lobe to the left
   int pl_lb;
   if (corr_peak_pos > 2) {
     pl_lb = corr_peak_pos - 1;
-    while (q->conv_output_avg[pl_lb - 1] <= q->conv_output_avg[pl_lb] && pl_lb > 1) {
+    while (corr[pl_lb - 1] <= corr[pl_lb] && pl_lb > 1) {
       pl_lb--;
     }
   } else {
@@ -429,11 +429,16 @@ float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t co
   }
   int sl_distance_left = pl_lb;
 
-  int   sl_right        = pl_ub + srsran_vec_max_fi(&q->conv_output_avg[pl_ub], sl_distance_right);
-  int   sl_left         = srsran_vec_max_fi(q->conv_output_avg, sl_distance_left);
-  float side_lobe_value = SRSRAN_MAX(q->conv_output_avg[sl_right], q->conv_output_avg[sl_left]);
+  int   sl_right        = pl_ub + srsran_vec_max_fi(&corr[pl_ub], sl_distance_right);
+  int   sl_left         = srsran_vec_max_fi(corr, sl_distance_left);
+  float side_lobe_value = SRSRAN_MAX(corr[sl_right], corr[sl_left]);
+
+  return corr[corr_peak_pos] / side_lobe_value;
+}
 
-  return q->conv_output_avg[corr_peak_pos] / side_lobe_value;
+float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t conv_output_len)
+{
+  return peak_sidelobe(q->conv_output_avg, corr_peak_pos, conv_output_len);
 }
 
 /** Performs time-domain PSS correlation.
@@ -621,3 +626,177 @@ float srsran_pss_cfo_compute(srsran_pss_t* q, const cf_t* pss_recv)
       &q->pss_signal_time[q->N_id_2][q->fft_size / 2], &pss_ptr[q->fft_size / 2], q->fft_size / 2);
   return cargf(conjf(y0) * y1) / M_PI;
 }
+
+/* Initializes the coarse search of the three PSS sequences.
+ *
+ * The input frame of frame_size samples is correlated at 1/decimate of its sample rate. The decimated band must hold
+ * the PSS, that is, fft_size / decimate must be at least SRSRAN_PSS_LEN + 2 subcarriers.
+ */
+int srsran_pss_search_init(srsran_pss_search_t* q, uint32_t frame_size, uint32_t fft_size, uint32_t decimate)
+{
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
+
+  if (q != NULL && frame_size >= fft_size && decimate > 0 && fft_size / decimate >= SRSRAN_PSS_LEN + 2) {
+    ret = SRSRAN_ERROR;
+    bzero(q, sizeof(srsran_pss_search_t));
+
+    q->frame_size = frame_size;
+    q->fft_size   = fft_size;
+    q->decimate   = decimate;
+
+    // Room for the linear correlation, rounded so that the decimated band has an even number of bins
+    q->dft_size     = SRSRAN_CEIL(frame_size + fft_size, 2 * decimate) * 2 * decimate;
+    q->dft_size_dec = q->dft_size / decimate;
+
+    if (srsran_dft_plan_c(&q->dftp_input, q->dft_size, SRSRAN_DFT_FORWARD)) {
+      ERROR("Error creating DFT plan");
+      goto clean_exit;
+    }
+    if (srsran_dft_plan_c(&q->idftp_corr, q->dft_size_dec, SRSRAN_DFT_BACKWARD)) {
+      ERROR("Error creating DFT plan");
+      goto clean_exit;
+    }
+
+    q->input_pad     = srsran_vec_cf_malloc(q->dft_size);
+    q->input_fft     = srsran_vec_cf_malloc(q->dft_size);
+    q->input_fft_dec = srsran_vec_cf_malloc(q->dft_size_dec);
+    q->corr_fft      = srsran_vec_cf_malloc(q->dft_size_dec);
+    q->corr          = srsran_vec_cf_malloc(q->dft_size_dec);
+    q->corr_abs      = srsran_vec_f_malloc(q->dft_size_dec + 1);
+    if (!q->input_pad || !q->input_fft || !q->input_fft_dec || !q->corr_fft || !q->corr || !q->corr_abs) {
+      ERROR("Error allocating memory");
+      goto clean_exit;
+    }
+    srsran_vec_cf_zero(q->input_pad, q->dft_size);
+    srsran_vec_f_zero(q->corr_abs, q->dft_size_dec + 1);
+
+    // Transform the matched filter of each N_id_2 at the full rate and keep its decimated band
+    cf_t pss_signal_freq[SRSRAN_PSS_LEN];
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      q->pss_fft_dec[N_id_2] = srsran_vec_cf_malloc(q->dft_size_dec);
+      if (!q->pss_fft_dec[N_id_2]) {
+        ERROR("Error allocating memory");
+        goto clean_exit;
+      }
+      if (srsran_pss_init_N_id_2(pss_signal_freq, q->input_pad, N_id_2, fft_size, 0)) {
+        ERROR("Error initiating PSS detector for N_id_2=%d fft_size=%d", N_id_2, fft_size);
+        goto clean_exit;
+      }
+      srsran_dft_run_c(&q->dftp_input, q->input_pad, q->input_fft);
+      memcpy(q->pss_fft_dec[N_id_2], q->input_fft, sizeof(cf_t) * q->dft_size_dec / 2);
+      memcpy(&q->pss_fft_dec[N_id_2][q->dft_size_dec / 2],
+             &q->input_fft[q->dft_size - q->dft_size_dec / 2],
+             sizeof(cf_t) * q->dft_size_dec / 2);
+    }
+    srsran_vec_cf_zero(q->input_pad, q->dft_size);
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  if (ret == SRSRAN_ERROR) {
+    srsran_pss_search_free(q);
+  }
+  return ret;
+}
+
+void srsran_pss_search_free(srsran_pss_search_t* q)
+{
+  if (q) {
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      if (q->pss_fft_dec[N_id_2]) {
+        free(q->pss_fft_dec[N_id_2]);
+      }
+    }
+    if (q->input_pad) {
+      free(q->input_pad);
+    }
+    if (q->input_fft) {
+      free(q->input_fft);
+    }
+    if (q->input_fft_dec) {
+      free(q->input_fft_dec);
+    }
+    if (q->corr_fft) {
+      free(q->corr_fft);
+    }
+    if (q->corr) {
+      free(q->corr);
+    }
+    if (q->corr_abs) {
+      free(q->corr_abs);
+    }
+    srsran_dft_plan_free(&q->dftp_input);
+    srsran_dft_plan_free(&q->idftp_corr);
+
+    bzero(q, sizeof(srsran_pss_search_t));
+  }
+}
+
+/* Clears the correlation lobe that holds pos, climbing first to its maximum */
+static void pss_search_clear_lobe(float* corr, uint32_t pos, uint32_t corr_len)
+{
+  while (pos + 1 < corr_len && corr[pos + 1] > corr[pos]) {
+    pos++;
+  }
+  while (pos > 0 && corr[pos - 1] > corr[pos]) {
+    pos--;
+  }
+  uint32_t lb = pos;
+  while (lb > 0 && corr[lb - 1] <= corr[lb]) {
+    lb--;
+  }
+  uint32_t ub = pos;
+  while (ub + 1 < corr_len && corr[ub + 1] <= corr[ub]) {
+    ub++;
+  }
+  srsran_vec_f_zero(&corr[lb], ub - lb + 1);
+}
+
+/* Correlates frame_size samples of input with the three PSS sequences.
+ *
+ * Since the matched filters are band-limited to the PSS, keeping only the central dft_size/decimate bins of the
+ * product gives the full rate correlation at every decimate-th sample. The whole linear correlation is searched,
+ * frame_size + fft_size - 1 samples including the partial overlaps at both edges, as srsran_pss_find_pss() does. For
+ * each N_id_2, res holds the peak position in full rate samples, with an error up to decimate/2 samples, the squared
+ * peak and the peak to side-lobe ratio. The PSS is repeated every half frame, so when frame_size exceeds it the peak
+ * may be either repetition and the repetitions are not taken as side lobes.
+ */
+int srsran_pss_search_run(srsran_pss_search_t* q, const cf_t* input, srsran_pss_search_res_t res[SRSRAN_NOF_NID_2])
+{
+  if (q == NULL || input == NULL || res == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The tail of input_pad is always zero
+  srsran_vec_cf_copy(q->input_pad, input, q->frame_size);
+  srsran_dft_run_c(&q->dftp_input, q->input_pad, q->input_fft);
+
+  uint32_t half = q->dft_size_dec / 2;
+  srsran_vec_cf_copy(q->input_fft_dec, q->input_fft, half);
+  srsran_vec_cf_copy(&q->input_fft_dec[half], &q->input_fft[q->dft_size - half], half);
+
+  // Length of the linear correlation and PSS period at the decimated rate
+  uint32_t corr_len = (q->frame_size + q->fft_size - 1) / q->decimate;
+  uint32_t period   = SRSRAN_SF_LEN(q->fft_size) * (SRSRAN_NOF_SF_X_FRAME / 2) / q->decimate;
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_vec_prod_ccc(q->input_fft_dec, q->pss_fft_dec[N_id_2], q->corr_fft, q->dft_size_dec);
+    srsran_dft_run_c(&q->idftp_corr, q->corr_fft, q->corr);
+    srsran_vec_abs_square_cf(q->corr, q->corr_abs, corr_len);
+
+    uint32_t peak_pos = srsran_vec_max_fi(q->corr_abs, corr_len);
+
+    res[N_id_2].peak_pos   = peak_pos * q->decimate;
+    res[N_id_2].peak_value = q->corr_abs[peak_pos];
+
+    for (uint32_t pos = peak_pos % period; pos < corr_len; pos += period) {
+      if (pos != peak_pos) {
+        pss_search_clear_lobe(q->corr_abs, pos, corr_len);
+      }
+    }
+    res[N_id_2].psr = peak_sidelobe(q->corr_abs, peak_pos, corr_len);
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -76,16 +76,18 @@ void parse_args(int argc, char** argv)
 
 int main(int argc, char** argv)
 {
-  int           N_id_2, sf_idx, find_sf;
-  cf_t *        buffer, *fft_buffer;
-  cf_t          pss_signal[SRSRAN_PSS_LEN];
-  float         sss_signal0[SRSRAN_SSS_LEN]; // for subframe 0
-  float         sss_signal5[SRSRAN_SSS_LEN]; // for subframe 5
-  int           cid, max_cid;
-  uint32_t      find_idx;
-  srsran_sync_t syncobj;
-  srsran_ofdm_t ifft;
-  int           fft_size;
+  int                     N_id_2, sf_idx, find_sf;
+  cf_t *                  buffer, *fft_buffer;
+  cf_t                    pss_signal[SRSRAN_PSS_LEN];
+  float                   sss_signal0[SRSRAN_SSS_LEN]; // for subframe 0
+  float                   sss_signal5[SRSRAN_SSS_LEN]; // for subframe 5
+  int                     cid, max_cid;
+  uint32_t                find_idx;
+  srsran_sync_t           syncobj;
+  srsran_ofdm_t           ifft;
+  srsran_pss_search_t     pss_search;
+  srsran_pss_search_res_t pss_search_res[SRSRAN_NOF_NID_2];
+  int                     fft_size;
 
   parse_args(argc, argv);
 
@@ -117,6 +119,11 @@ int main(int argc, char** argv)
     return -1;
   }
 
+  if (srsran_pss_search_init(&pss_search, FLEN, fft_size, 2)) {
+    ERROR("Error initiating PSS search");
+    return -1;
+  }
+
   srsran_sync_set_cp(&syncobj, cp);
 
   /* Set a very high threshold to make sure the correlation is ok */
@@ -173,6 +180,30 @@ int main(int argc, char** argv)
         printf("Detected CP should be %s\n", SRSRAN_CP_ISNORM(cp) ? "Normal" : "Extended");
         exit(-1);
       }
+
+      /* The decimated search of all N_id_2 must find the same peak, up to the decimation factor */
+      if (srsran_pss_search_run(&pss_search, fft_buffer, pss_search_res)) {
+        ERROR("Error running srsran_pss_search_run");
+        exit(-1);
+      }
+      uint32_t max_N_id_2 = 0;
+      for (uint32_t i = 1; i < SRSRAN_NOF_NID_2; i++) {
+        if (pss_search_res[i].psr > pss_search_res[max_N_id_2].psr) {
+          max_N_id_2 = i;
+        }
+      }
+      printf("search: N_id_2=%d peak=%d psr=%.1f\n",
+             max_N_id_2,
+             pss_search_res[max_N_id_2].peak_pos,
+             pss_search_res[max_N_id_2].psr);
+      if (max_N_id_2 != N_id_2 || abs((int)pss_search_res[N_id_2].peak_pos - (int)find_idx) > 1) {
+        printf("search N_id_2/peak != find: %d/%d != %d/%d\n",
+               max_N_id_2,
+               pss_search_res[max_N_id_2].peak_pos,
+               N_id_2,
+               find_idx);
+        exit(-1);
+      }
     }
     cid++;
   }
@@ -181,6 +212,7 @@ int main(int argc, char** argv)
   free(buffer);
 
   srsran_sync_free(&syncobj);
+  srsran_pss_search_free(&pss_search);
   srsran_ofdm_tx_free(&ifft);
 
   printf("Ok\n");
@@ -0,0 +1,242 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * \file ue_cell_search_test.c
+ * \brief Cell search over a synthetic LTE signal.
+ *
+ * A frame with the PSS and SSS of one cell and random data in the rest of the resource grid is generated at the cell
+ * search sampling rate, impaired with AWGN and fed in a loop through the receive callback. The fast scan must detect
+ * the same cell ID and CP as the sequential scan and as the generated ones.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+static uint32_t    cell_id  = 150;
+static srsran_cp_t cp       = SRSRAN_CP_NORM;
+static uint32_t    offset   = 1234;
+static float       snr_db   = 10.0f;
+static uint32_t    nof_prbs = SRSRAN_CS_NOF_PRB;
+
+typedef struct {
+  cf_t*    frame;
+  uint32_t frame_len;
+  uint32_t pos;
+} test_stream_t;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ceosv]\n", prog);
+  printf("\t-c cell_id [Default %d]\n", cell_id);
+  printf("\t-e extended CP [Default normal]\n");
+  printf("\t-o offset of the first received sample [Default %d]\n", offset);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_db);
+  printf("\t-v srsran_verbose\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ceosv")) != -1) {
+    switch (opt) {
+      case 'c':
+        cell_id = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        cp = SRSRAN_CP_EXT;
+        break;
+      case 'o':
+        offset = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Plays the generated frame in a loop */
+static int recv_callback(void* h, void* data, uint32_t nsamples, srsran_timestamp_t* t)
+{
+  test_stream_t* stream = (test_stream_t*)h;
+  cf_t*          out    = (cf_t*)data;
+
+  for (uint32_t i = 0; i < nsamples; i++) {
+    out[i]      = stream->frame[stream->pos];
+    stream->pos = (stream->pos + 1) % stream->frame_len;
+  }
+  return (int)nsamples;
+}
+
+/* Generates a frame with the PSS and SSS of cell_id in subframes 0 and 5 and random QPSK-like data elsewhere */
+static int generate_frame(srsran_random_t random_gen, cf_t* frame)
+{
+  srsran_ofdm_t ifft;
+  cf_t          pss_signal[SRSRAN_PSS_LEN];
+  float         sss_signal0[SRSRAN_SSS_LEN];
+  float         sss_signal5[SRSRAN_SSS_LEN];
+  uint32_t      sf_len = SRSRAN_SF_LEN_PRB(nof_prbs);
+  uint32_t      nof_re = SRSRAN_SF_LEN_RE(nof_prbs, cp);
+  cf_t*         grid   = srsran_vec_cf_malloc(nof_re);
+  cf_t*         sf     = srsran_vec_cf_malloc(sf_len);
+  int           ret    = SRSRAN_ERROR;
+
+  if (grid == NULL || sf == NULL) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  if (srsran_ofdm_tx_init(&ifft, cp, grid, sf, nof_prbs)) {
+    ERROR("Error creating iFFT object");
+    goto clean_exit;
+  }
+
+  srsran_pss_generate(pss_signal, cell_id % SRSRAN_NOF_NID_2);
+  srsran_sss_generate(sss_signal0, sss_signal5, cell_id);
+
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    srsran_random_uniform_complex_dist_vector(random_gen, grid, nof_re, -M_SQRT1_2, M_SQRT1_2);
+    if (sf_idx == 0 || sf_idx == 5) {
+      srsran_pss_put_slot(pss_signal, grid, nof_prbs, cp);
+      srsran_sss_put_slot(sf_idx == 0 ? sss_signal0 : sss_signal5, grid, nof_prbs, cp);
+    }
+
+    srsran_ofdm_tx_sf(&ifft);
+    srsran_vec_cf_copy(&frame[sf_idx * sf_len], sf, sf_len);
+  }
+  srsran_ofdm_tx_free(&ifft);
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (grid) {
+    free(grid);
+  }
+  if (sf) {
+    free(sf);
+  }
+  return ret;
+}
+
+/* Checks that the cell with the strongest PSS is the generated one */
+static int check_result(const char*                         name,
+                        int                                 nof_cells,
+                        const srsran_ue_cellsearch_result_t found_cells[SRSRAN_NOF_NID_2],
+                        uint32_t                            max_N_id_2)
+{
+  const srsran_ue_cellsearch_result_t* found = &found_cells[max_N_id_2];
+
+  printf("%s: found %d cells, strongest N_id_2=%d cell_id=%d CP=%s PSR=%.1f CFO=%.1f Hz\n",
+         name,
+         nof_cells,
+         max_N_id_2,
+         found->cell_id,
+         srsran_cp_string(found->cp),
+         found->psr,
+         found->cfo);
+
+  if (nof_cells < 1) {
+    ERROR("%s: no cell found", name);
+    return SRSRAN_ERROR;
+  }
+  if (max_N_id_2 != cell_id % SRSRAN_NOF_NID_2 || found->cell_id != cell_id) {
+    ERROR("%s: found cell_id %d, expected %d", name, found->cell_id, cell_id);
+    return SRSRAN_ERROR;
+  }
+  if (found->cp != cp) {
+    ERROR("%s: found %s CP, expected %s", name, srsran_cp_string(found->cp), srsran_cp_string(cp));
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_ue_cellsearch_t        cs;
+  srsran_ue_cellsearch_result_t found_cells[SRSRAN_NOF_NID_2];
+  srsran_random_t               random_gen = srsran_random_init(0x1234);
+  test_stream_t                 stream     = {};
+  uint32_t                      max_N_id_2 = 0;
+  int                           ret        = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  if (cell_id >= SRSRAN_NOF_NID_1 * SRSRAN_NOF_NID_2) {
+    ERROR("Invalid cell_id %d", cell_id);
+    exit(-1);
+  }
+
+  stream.frame_len = SRSRAN_NOF_SF_X_FRAME * SRSRAN_SF_LEN_PRB(nof_prbs);
+  stream.frame     = srsran_vec_cf_malloc(stream.frame_len);
+  if (stream.frame == NULL) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  if (generate_frame(random_gen, stream.frame)) {
+    goto clean_exit;
+  }
+
+  float signal_power = srsran_vec_avg_power_cf(stream.frame, stream.frame_len);
+  srsran_ch_awgn_c(stream.frame, stream.frame, signal_power * srsran_convert_dB_to_power(-snr_db), stream.frame_len);
+  stream.pos = offset % stream.frame_len;
+
+  if (srsran_ue_cellsearch_init(&cs, 8, recv_callback, &stream)) {
+    ERROR("Error initiating cell search");
+    goto clean_exit;
+  }
+  srsran_ue_cellsearch_set_nof_valid_frames(&cs, 4);
+  srsran_set_detect_cp(&cs, true);
+
+  bzero(found_cells, sizeof(found_cells));
+  int nof_cells = srsran_ue_cellsearch_scan_fast(&cs, found_cells, &max_N_id_2);
+  if (check_result("Fast scan", nof_cells, found_cells, max_N_id_2)) {
+    goto clean_cs;
+  }
+
+  bzero(found_cells, sizeof(found_cells));
+  nof_cells = srsran_ue_cellsearch_scan(&cs, found_cells, &max_N_id_2);
+  if (check_result("Sequential scan", nof_cells, found_cells, max_N_id_2)) {
+    goto clean_cs;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_cs:
+  srsran_ue_cellsearch_free(&cs);
+
+clean_exit:
+  free(stream.frame);
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -33,6 +33,39 @@
 
 #define CELL_SEARCH_BUFFER_MAX_SAMPLES (3 * SRSRAN_SF_LEN_MAX)
 
+/* srsran_ue_cellsearch_scan_fast() parameters */
+#define CELL_SEARCH_FAST_DECIMATE 2
+#define CELL_SEARCH_FAST_THRESHOLD 1.5f // Coarse PSR threshold, the full rate one is checked on refinement
+#define CELL_SEARCH_FAST_OVERLAP(fft_size) (8 * (fft_size)) // Room for the SSS before a PSS at the frame start
+#define CELL_SEARCH_FAST_WINDOW(fft_size) (2 * (fft_size))  // Full rate refinement window
+
+static int cellsearch_fast_init(srsran_ue_cellsearch_t* q)
+{
+  uint32_t fft_size   = q->ue_sync.fft_size;
+  uint32_t search_len = CELL_SEARCH_FAST_OVERLAP(fft_size) + q->ue_sync.frame_len;
+
+  if (search_len > CELL_SEARCH_BUFFER_MAX_SAMPLES) {
+    ERROR("Cell search frame exceeds the buffer size");
+    return SRSRAN_ERROR;
+  }
+  q->search_overlap = CELL_SEARCH_FAST_OVERLAP(fft_size);
+
+  if (srsran_pss_search_init(&q->pss_search, search_len, fft_size, CELL_SEARCH_FAST_DECIMATE)) {
+    ERROR("Error initiating PSS search");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    if (srsran_sync_init(&q->sync_refine[N_id_2], search_len, CELL_SEARCH_FAST_WINDOW(fft_size), fft_size)) {
+      ERROR("Error initiating sync refine");
+      return SRSRAN_ERROR;
+    }
+    srsran_sync_set_N_id_2(&q->sync_refine[N_id_2], N_id_2);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
                               uint32_t                max_frames,
                               int(recv_callback)(void*, void*, uint32_t, srsran_timestamp_t*),
@@ -66,7 +99,8 @@ int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
     q->sf_buffer[0]    = srsran_vec_cf_malloc(CELL_SEARCH_BUFFER_MAX_SAMPLES);
     q->nof_rx_antennas = 1;
 
-    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    // srsran_ue_cellsearch_scan_fast() keeps the candidates of every N_id_2
+    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), SRSRAN_NOF_NID_2 * max_frames);
     if (!q->candidates) {
       perror("malloc");
       goto clean_exit;
@@ -85,6 +119,10 @@ int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
     q->max_frames       = max_frames;
     q->nof_valid_frames = max_frames;
 
+    if (cellsearch_fast_init(q)) {
+      goto clean_exit;
+    }
+
     ret = SRSRAN_SUCCESS;
   }
 
@@ -128,7 +166,8 @@ int srsran_ue_cellsearch_init_multi(
     }
     q->nof_rx_antennas = nof_rx_antennas;
 
-    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    // srsran_ue_cellsearch_scan_fast() keeps the candidates of every N_id_2
+    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), SRSRAN_NOF_NID_2 * max_frames);
     if (!q->candidates) {
       perror("malloc");
       goto clean_exit;
@@ -147,6 +186,10 @@ int srsran_ue_cellsearch_init_multi(
     q->max_frames       = max_frames;
     q->nof_valid_frames = max_frames;
 
+    if (cellsearch_fast_init(q)) {
+      goto clean_exit;
+    }
+
     ret = SRSRAN_SUCCESS;
   }
 
@@ -175,6 +218,11 @@ void srsran_ue_cellsearch_free(srsran_ue_cellsearch_t* q)
   }
   srsran_ue_sync_free(&q->ue_sync);
 
+  srsran_pss_search_free(&q->pss_search);
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_sync_free(&q->sync_refine[N_id_2]);
+  }
+
   bzero(q, sizeof(srsran_ue_cellsearch_t));
 }
 
@@ -194,7 +242,10 @@ void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable)
 }
 
 /* Decide the most likely cell based on the mode */
-static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, srsran_ue_cellsearch_result_t* found_cell)
+static void get_cell(srsran_ue_cellsearch_t*              q,
+                     const srsran_ue_cellsearch_result_t* candidates,
+                     uint32_t                             nof_detected_frames,
+                     srsran_ue_cellsearch_result_t*       found_cell)
 {
   uint32_t i, j;
 
@@ -205,7 +256,7 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   for (i = 0; i < nof_detected_frames; i++) {
     uint32_t cnt = 1;
     for (j = i + 1; j < nof_detected_frames; j++) {
-      if (q->candidates[j].cell_id == q->candidates[i].cell_id && !q->mode_counted[j]) {
+      if (candidates[j].cell_id == candidates[i].cell_id && !q->mode_counted[j]) {
         q->mode_counted[j] = 1;
         cnt++;
       }
@@ -219,22 +270,22 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
       mode_pos  = i;
     }
   }
-  found_cell->cell_id = q->candidates[mode_pos].cell_id;
+  found_cell->cell_id = candidates[mode_pos].cell_id;
   /* Now in all these cell IDs, find most frequent CP and duplex mode */
   uint32_t nof_normal = 0;
   uint32_t nof_fdd    = 0;
   found_cell->peak    = 0;
   for (i = 0; i < nof_detected_frames; i++) {
-    if (q->candidates[i].cell_id == found_cell->cell_id) {
-      if (SRSRAN_CP_ISNORM(q->candidates[i].cp)) {
+    if (candidates[i].cell_id == found_cell->cell_id) {
+      if (SRSRAN_CP_ISNORM(candidates[i].cp)) {
         nof_normal++;
       }
-      if (q->candidates[i].frame_type == SRSRAN_FDD) {
+      if (candidates[i].frame_type == SRSRAN_FDD) {
         nof_fdd++;
       }
     }
     // average absolute peak value
-    found_cell->peak += q->candidates[i].peak;
+    found_cell->peak += candidates[i].peak;
   }
   found_cell->peak /= nof_detected_frames;
 
@@ -251,10 +302,10 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   found_cell->mode = (float)q->mode_ntimes[mode_pos] / nof_detected_frames;
 
   // PSR is already averaged so take the last value
-  found_cell->psr = q->candidates[nof_detected_frames - 1].psr;
+  found_cell->psr = candidates[nof_detected_frames - 1].psr;
 
   // CFO is also already averaged
-  found_cell->cfo = q->candidates[nof_detected_frames - 1].cfo;
+  found_cell->cfo = candidates[nof_detected_frames - 1].cfo;
 }
 
 /** Finds up to 3 cells, one per each N_id_2=0,1,2 and stores ID and CP in the structure pointed by found_cell.
@@ -288,6 +339,164 @@ int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
   return nof_detected_cells;
 }
 
+/* The fast scan is over once every N_id_2 has enough detections or, if any N_id_2 has them, once the rest have none */
+static bool cellsearch_fast_done(srsran_ue_cellsearch_t* q, const uint32_t nof_detected_frames[SRSRAN_NOF_NID_2])
+{
+  bool any_valid = false;
+  bool all_done  = true;
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    if (nof_detected_frames[N_id_2] >= q->nof_valid_frames) {
+      any_valid = true;
+    } else if (nof_detected_frames[N_id_2] > 0) {
+      all_done = false;
+    }
+  }
+  return any_valid && all_done;
+}
+
+/** Same as srsran_ue_cellsearch_scan() but all the N_id_2 are searched on the same frames.
+ * Every frame is correlated with the three PSS sequences at a decimated rate, then the N_id_2 with a coarse peak are
+ * refined at the full rate in a small window around it, where the CFO, SSS and CP are estimated.
+ * It scans up to max_frames frames instead of max_frames for each N_id_2.
+ * Returns the number of found cells or a negative number if error
+ */
+int srsran_ue_cellsearch_scan_fast(srsran_ue_cellsearch_t*       q,
+                                   srsran_ue_cellsearch_result_t found_cells[3],
+                                   uint32_t*                     max_N_id_2)
+{
+  if (q == NULL || found_cells == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_ue_sync_t* ue_sync    = &q->ue_sync;
+  uint32_t          frame_len  = ue_sync->frame_len;
+  uint32_t          search_len = q->search_overlap + frame_len;
+  // Samples around a coarse peak read by its refinement
+  uint32_t refine_len                            = CELL_SEARCH_FAST_WINDOW(ue_sync->fft_size) + ue_sync->fft_size;
+  uint32_t nof_scanned_frames                    = 0;
+  uint32_t nof_detected_frames[SRSRAN_NOF_NID_2] = {};
+
+  srsran_ue_cellsearch_result_t* candidates[SRSRAN_NOF_NID_2];
+  srsran_pss_search_res_t        coarse[SRSRAN_NOF_NID_2];
+
+  bzero(q->candidates, sizeof(srsran_ue_cellsearch_result_t) * SRSRAN_NOF_NID_2 * q->max_frames);
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    candidates[N_id_2] = &q->candidates[N_id_2 * q->max_frames];
+
+    // Refine with the same options as the find object of the sequential scan
+    srsran_sync_t* sfind  = &ue_sync->sfind;
+    srsran_sync_t* refine = &q->sync_refine[N_id_2];
+    srsran_sync_set_cp(refine, sfind->cp);
+    srsran_sync_cp_en(refine, sfind->detect_cp);
+    srsran_sync_sss_en(refine, sfind->sss_en);
+    srsran_sync_set_sss_algorithm(refine, sfind->sss_alg);
+    srsran_sync_set_cfo_i_enable(refine, sfind->cfo_i_enable);
+    srsran_sync_set_cfo_cp_enable(refine, sfind->cfo_cp_enable, sfind->cfo_cp_nsymbols);
+    srsran_sync_set_cfo_pss_enable(refine, sfind->cfo_pss_enable);
+    srsran_sync_set_pss_filt_enable(refine, sfind->pss_filtering_enabled);
+    srsran_sync_set_sss_eq_enable(refine, sfind->sss_channel_equalize);
+    srsran_sync_set_cfo_ema_alpha(refine, sfind->cfo_ema_alpha);
+    srsran_sync_set_em_alpha(refine, 1);
+    srsran_sync_set_threshold(refine, sfind->threshold);
+    srsran_sync_reset(refine);
+    srsran_sync_cfo_reset(refine, 0.0f);
+  }
+
+  for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+    srsran_vec_cf_zero(q->sf_buffer[i], search_len);
+  }
+
+  do {
+    // Keep the end of the previous frame, so that a PSS at the frame boundary is found in full
+    cf_t* ptr[SRSRAN_MAX_CHANNELS] = {NULL};
+    for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+      memmove(q->sf_buffer[i], &q->sf_buffer[i][frame_len], sizeof(cf_t) * q->search_overlap);
+      ptr[i] = &q->sf_buffer[i][q->search_overlap];
+    }
+    if (ue_sync->recv_callback(ue_sync->stream, ptr, frame_len, &ue_sync->last_timestamp) < 0) {
+      ERROR("Error receiving samples");
+      return SRSRAN_ERROR;
+    }
+    if (ue_sync->do_agc) {
+      srsran_agc_process(&ue_sync->agc, ptr[0], frame_len);
+    }
+
+    if (srsran_pss_search_run(&q->pss_search, q->sf_buffer[0], coarse)) {
+      ERROR("Error running PSS search");
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      if (nof_detected_frames[N_id_2] >= q->nof_valid_frames || coarse[N_id_2].psr < CELL_SEARCH_FAST_THRESHOLD) {
+        continue;
+      }
+
+      // Center the refinement window on the coarse peak. The PSS repeats every frame_len samples, so a peak without
+      // room for the window or for the SSS before it is refined on its repetition
+      uint32_t peak_pos = coarse[N_id_2].peak_pos;
+      if (peak_pos + refine_len / 2 > search_len) {
+        peak_pos -= frame_len;
+      } else if (peak_pos + refine_len / 2 < q->search_overlap) {
+        peak_pos += frame_len;
+      }
+      uint32_t       find_offset = peak_pos - refine_len / 2;
+      srsran_sync_t* refine      = &q->sync_refine[N_id_2];
+
+      srsran_sync_find_ret_t ret = srsran_sync_find(refine, q->sf_buffer[0], find_offset, NULL);
+      if (ret == SRSRAN_SYNC_ERROR) {
+        ERROR("Error refining PSS for N_id_2=%d", N_id_2);
+        return SRSRAN_ERROR;
+      }
+      if (ret != SRSRAN_SYNC_FOUND || !srsran_sync_sss_detected(refine)) {
+        continue;
+      }
+
+      int cell_id = srsran_sync_get_cell_id(refine);
+      if (cell_id >= 0) {
+        srsran_ue_cellsearch_result_t* candidate = &candidates[N_id_2][nof_detected_frames[N_id_2]];
+        candidate->cell_id                       = (uint32_t)cell_id;
+        candidate->cp                            = srsran_sync_get_cp(refine);
+        candidate->peak                          = refine->pss.peak_value;
+        candidate->psr                           = srsran_sync_get_peak_value(refine);
+        candidate->cfo                           = 15000 * srsran_sync_get_cfo(refine);
+        candidate->frame_type                    = refine->frame_type;
+        INFO("CELL SEARCH: [%d/%d/%d]: Found peak PSR=%.3f, Cell_id: %d CP: %s, CFO=%.1f KHz",
+             nof_detected_frames[N_id_2],
+             nof_scanned_frames,
+             q->nof_valid_frames,
+             candidate->psr,
+             candidate->cell_id,
+             srsran_cp_string(candidate->cp),
+             candidate->cfo / 1000);
+
+        nof_detected_frames[N_id_2]++;
+      }
+    }
+
+    nof_scanned_frames++;
+
+  } while (nof_scanned_frames < q->max_frames && !cellsearch_fast_done(q, nof_detected_frames));
+
+  int   nof_detected_cells = 0;
+  float max_peak_value     = -1.0;
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    if (nof_detected_frames[N_id_2] == 0) {
+      continue;
+    }
+    get_cell(q, candidates[N_id_2], nof_detected_frames[N_id_2], &found_cells[N_id_2]);
+    nof_detected_cells++;
+    if (max_N_id_2) {
+      if (found_cells[N_id_2].peak > max_peak_value) {
+        max_peak_value = found_cells[N_id_2].peak;
+        *max_N_id_2    = N_id_2;
+      }
+    }
+  }
+
+  return nof_detected_cells;
+}
+
 /** Finds a cell for a given N_id_2 and stores ID and CP in the structure pointed by found_cell.
  * Returns 1 if the cell is found, 0 if not or -1 on error
  */
@@ -352,7 +561,7 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
     if (nof_detected_frames > 0) {
       ret = 1; // A cell has been found.
       if (found_cell) {
-        get_cell(q, nof_detected_frames, found_cell);
+        get_cell(q, q->candidates, nof_detected_frames, found_cell);
       }
     } else {
       ret = 0; // A cell was not found.
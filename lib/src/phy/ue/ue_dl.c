@@ -423,6 +423,20 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
 {
   uint32_t nof_dci = 0;
   if (rnti) {
+    // Decode all the candidates not yet allocated at once, the loop below picks up the results
+    srsran_dci_location_t candidates[SRSRAN_MAX_CANDIDATES];
+    uint32_t              nof_candidates = 0;
+    for (uint32_t l = 0; l < search_space->nof_locations && l < SRSRAN_MAX_CANDIDATES; l++) {
+      if (!dci_location_is_allocated(q, search_space->loc[l])) {
+        candidates[nof_candidates++] = search_space->loc[l];
+      }
+    }
+    if (srsran_pdcch_decode_candidates(
+            &q->pdcch, sf, dci_cfg, candidates, nof_candidates, search_space->formats, search_space->nof_formats)) {
+      ERROR("Error decoding PDCCH candidates");
+      return SRSRAN_ERROR;
+    }
+
     for (int l = 0; l < search_space->nof_locations; l++) {
       if (nof_dci >= SRSRAN_MAX_DCI_MSG) {
         ERROR("Can't store more DCIs in buffer");
@@ -47,6 +47,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_poly_t& q : tx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
+
+  for (srsran_resampler_poly_t& q : rx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -295,18 +303,25 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
 
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
-  uint32_t ratio = 1; // No decimation by default
+  uint32_t ratio    = 1; // No decimation by default
+  bool     resample = false;
   if (decimator_busy) {
     lock.unlock();
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
+  } else if (rx_resamplers[0].filter != nullptr) {
+    resample = true;
   }
 
-  // Calculate number of samples, considering the decimation ratio
-  uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  // Calculate number of samples, considering the decimation ratio or the resampler state
+  uint32_t nof_samples     = buffer.get_nof_samples() * ratio;
+  uint32_t nof_samples_out = buffer.get_nof_samples();
+  if (resample) {
+    nof_samples = srsran_resampler_poly_nof_input(&rx_resamplers[0], nof_samples_out);
+  }
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if ((ratio > 1 || resample) && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
@@ -319,6 +334,9 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
 
     // Limit number of samples to receive
     nof_samples = rx_buffer[0].size();
+    if (resample) {
+      nof_samples_out = srsran_resampler_poly_nof_output(&rx_resamplers[0], nof_samples);
+    }
   }
 
   // Set new buffer size
@@ -327,7 +345,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, (ratio > 1 || resample) ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -357,6 +375,17 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
     }
   }
 
+  // Perform non-integer ratio resampling. All channels are resampled to keep their resampler states aligned
+  if (resample) {
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      srsran_resampler_poly_run(&rx_resamplers[ch],
+                                buffer_rx.get(ch),
+                                buffer.get(ch) ? buffer.get(ch) : dummy_buffers[ch].data(),
+                                buffer_rx.get_nof_samples(),
+                                nof_samples_out);
+    }
+  }
+
   return ret;
 }
 
@@ -454,6 +483,27 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
 
     // Set buffer size after applying the interpolation
     buffer.set_nof_samples(nof_samples * ratio);
+  } else if (tx_resamplers[0].filter != nullptr) {
+    // Perform non-integer ratio resampling, the number of samples depends on the resampler state
+    uint32_t nof_samples_out = srsran_resampler_poly_nof_output(&tx_resamplers[0], nof_samples);
+    if (nof_samples_out > tx_buffer[0].size()) {
+      logger.info("Tx number of samples (%d/%d) exceeds buffer size (%d)",
+                  nof_samples,
+                  nof_samples_out,
+                  (uint32_t)tx_buffer[0].size());
+      nof_samples_out = tx_buffer[0].size();
+      nof_samples     = srsran_resampler_poly_nof_input(&tx_resamplers[0], nof_samples_out);
+    }
+
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      srsran_resampler_poly_run(&tx_resamplers[ch],
+                                buffer.get(ch) ? buffer.get(ch) : zeros.data(),
+                                tx_buffer[ch].data(),
+                                nof_samples,
+                                nof_samples_out);
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+    buffer.set_nof_samples(nof_samples_out);
   }
 
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
@@ -746,17 +796,24 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+    // Integer ratios use the FFT decimator, otherwise a polyphase resampler
+    if (((uint32_t)cur_rx_srate % (uint32_t)srate) == 0) {
+      uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+        srsran_resampler_poly_free(&rx_resamplers[ch]);
+      }
+    } else {
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, 1);
+        int err =
+            srsran_resampler_poly_init(&rx_resamplers[ch], cur_rx_srate, srate, SRSRAN_RESAMPLER_POLY_QUALITY_MEDIUM);
+        srsran_assert(err == SRSRAN_SUCCESS,
+                      "Unsupported sampling rate ratio (%.2f MHz / %.2f MHz = %.3f)",
+                      cur_rx_srate / 1e6,
+                      srate / 1e6,
+                      cur_rx_srate / srate);
+      }
     }
 
     decimator_busy = false;
@@ -1002,17 +1059,24 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+    // Integer ratios use the FFT interpolator, otherwise a polyphase resampler
+    if (((uint32_t)cur_tx_srate % (uint32_t)srate) == 0) {
+      uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+        srsran_resampler_poly_free(&tx_resamplers[ch]);
+      }
+    } else {
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, 1);
+        int err =
+            srsran_resampler_poly_init(&tx_resamplers[ch], srate, cur_tx_srate, SRSRAN_RESAMPLER_POLY_QUALITY_MEDIUM);
+        srsran_assert(err == SRSRAN_SUCCESS,
+                      "Unsupported sampling rate ratio (%.2f MHz / %.2f MHz = %.3f)",
+                      cur_tx_srate / 1e6,
+                      srate / 1e6,
+                      cur_tx_srate / srate);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/spsc_queue.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+
+namespace srsran {
+
+int test_spsc_queue_api()
+{
+  static_spsc_queue<int, 4> q;
+  TESTASSERT(q.max_size() == 4);
+  TESTASSERT(q.empty() and not q.full() and q.size() == 0);
+
+  int v = 0;
+  TESTASSERT(not q.try_pop(v));
+
+  // push until full
+  for (int i = 0; i < 4; ++i) {
+    TESTASSERT(q.try_push(i));
+    TESTASSERT(q.size() == (size_t)i + 1);
+  }
+  TESTASSERT(q.full());
+  TESTASSERT(not q.try_push(4));
+
+  // pop in order and wrap around the storage
+  for (int i = 0; i < 10; ++i) {
+    TESTASSERT(q.try_pop(v) and v == i);
+    TESTASSERT(q.try_push(i + 4));
+  }
+  TESTASSERT(q.size() == 4);
+  for (int i = 10; i < 14; ++i) {
+    TESTASSERT(q.try_pop(v) and v == i);
+  }
+  TESTASSERT(q.empty());
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_spsc_queue_threads()
+{
+  const int                  nof_items = 1000000;
+  static_spsc_queue<int, 16> q;
+  std::thread                producer([&q]() {
+    for (int i = 0; i < nof_items; ++i) {
+      while (not q.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  // the consumer must see every element once and in order
+  int expected = 0;
+  while (expected < nof_items) {
+    int v = 0;
+    if (q.try_pop(v)) {
+      TESTASSERT(v == expected);
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  TESTASSERT(q.empty());
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsran::test_spsc_queue_api() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::test_spsc_queue_threads() == SRSRAN_SUCCESS);
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
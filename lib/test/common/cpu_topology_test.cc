@@ -0,0 +1,119 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/cpu_topology.h"
+#include "srsran/support/srsran_test.h"
+#include <fstream>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+
+using srsran::cpu_topology;
+
+static void write_file(const std::string& path, const std::string& content)
+{
+  std::ofstream file(path);
+  file << content << "\n";
+}
+
+/// Creates every directory in the path below the given root
+static void make_dirs(const std::string& root, const std::string& path)
+{
+  std::string dir = root;
+  size_t      pos = 0;
+  while (pos != std::string::npos) {
+    size_t end = path.find('/', pos + 1);
+    dir        = root + path.substr(0, end);
+    mkdir(dir.c_str(), 0755);
+    pos = end;
+  }
+}
+
+void test_parse_cpu_list()
+{
+  std::vector<uint32_t> list;
+  TESTASSERT(cpu_topology::parse_cpu_list("0-3,8,10-11\n", list));
+  TESTASSERT(list == std::vector<uint32_t>({0, 1, 2, 3, 8, 10, 11}));
+  TESTASSERT(cpu_topology::parse_cpu_list("\n", list));
+  TESTASSERT(list.empty());
+  TESTASSERT(cpu_topology::parse_cpu_list("5", list));
+  TESTASSERT(list == std::vector<uint32_t>({5}));
+  TESTASSERT(not cpu_topology::parse_cpu_list("3-1", list));
+  TESTASSERT(not cpu_topology::parse_cpu_list("a", list));
+  TESTASSERT(not cpu_topology::parse_cpu_list("1-", list));
+}
+
+/// Two packages with one NUMA node each, two cores per package and two threads per core
+void test_read_topology()
+{
+  char root_template[] = "/tmp/cpu_topology_testXXXXXX";
+  TESTASSERT(mkdtemp(root_template) != nullptr);
+  std::string root = root_template;
+
+  cpu_topology topology;
+  TESTASSERT(not topology.read(root));
+
+  make_dirs(root, "/cpu");
+  write_file(root + "/cpu/online", "0-7");
+  write_file(root + "/cpu/isolated", "3-7");
+  for (uint32_t cpu = 0; cpu < 8; cpu++) {
+    std::string dir = "/cpu/cpu" + std::to_string(cpu) + "/topology";
+    make_dirs(root, dir);
+    write_file(root + dir + "/core_id", std::to_string(cpu % 2));
+    write_file(root + dir + "/physical_package_id", std::to_string(cpu / 4));
+  }
+  make_dirs(root, "/node/node0");
+  make_dirs(root, "/node/node1");
+  write_file(root + "/node/online", "0-1");
+  write_file(root + "/node/node0/cpulist", "0-3");
+  write_file(root + "/node/node1/cpulist", "4-7");
+
+  TESTASSERT(topology.read(root));
+  TESTASSERT(topology.get_cpus().size() == 8);
+  TESTASSERT(topology.get_cpus()[6].core_id == 0);
+  TESTASSERT(topology.get_cpus()[6].package_id == 1);
+  TESTASSERT(topology.get_cpus()[6].numa_node == 1);
+  TESTASSERT(not topology.get_cpus()[2].isolated);
+  TESTASSERT(topology.get_cpus()[3].isolated);
+  TESTASSERT(topology.to_string() == "cpus=8 cores=4 numa_nodes=2 isolated_cpus=5");
+
+  // Node 1 has two isolated cores and node 0 only one, SMT siblings are skipped
+  TESTASSERT(topology.select_cores(true) == std::vector<uint32_t>({4, 5}));
+  TESTASSERT(topology.select_cores(false) == std::vector<uint32_t>({0, 1}));
+
+  // Without isolated CPUs nor NUMA information everything is in node 0
+  write_file(root + "/cpu/isolated", "");
+  write_file(root + "/node/online", "");
+  TESTASSERT(topology.read(root));
+  TESTASSERT(topology.select_cores(true).empty());
+  TESTASSERT(topology.select_cores(false) == std::vector<uint32_t>({0, 1, 4, 5}));
+
+  std::string cmd = "rm -rf " + root;
+  TESTASSERT(system(cmd.c_str()) == 0);
+}
+
+int main()
+{
+  test_parse_cpu_list();
+  test_read_topology();
+  return 0;
+}
@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "../phy_common.h"
+#include "fec_worker_pool.h"
 #include "srsran/srslog/srslog.h"
 
 #define LOG_EXECTIME
@@ -37,7 +38,7 @@ class cc_worker
 public:
   cc_worker(srslog::basic_logger& logger);
   ~cc_worker();
-  void init(phy_common* phy, uint32_t cc_idx);
+  void init(phy_common* phy, uint32_t cc_idx, fec_worker_pool* fec_pool = nullptr);
   void reset();
 
   cf_t* get_buffer_rx(uint32_t antenna_idx);
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_LTE_FEC_WORKER_POOL_H
+#define SRSENB_LTE_FEC_WORKER_POOL_H
+
+#include "srsran/common/thread_pool.h"
+#include "srsran/srsran.h"
+
+namespace srsenb {
+namespace lte {
+
+/**
+ * Pool of threads shared by all the LTE subframe workers for turbo decoding PUSCH code blocks in parallel. Every thread
+ * owns a code block decoder, so the code blocks of a transport block, and the ones of other UEs and TTIs being decoded
+ * at the same time, are spread across all the pool threads.
+ */
+class fec_worker_pool
+{
+public:
+  fec_worker_pool(uint32_t nof_workers, int32_t prio);
+  ~fec_worker_pool();
+
+  /// Gets the code block executor to be set in the UL-SCH decoders
+  const srsran_sch_cb_executor_t* get_cb_executor() const { return &executor; }
+
+  void stop();
+
+private:
+  static void push_cb_job(void* arg, srsran_sch_cb_job_t* job);
+
+  srsran::task_thread_pool pool;
+  srsran_sch_cb_executor_t executor = {};
+};
+
+} // namespace lte
+} // namespace srsenb
+
+#endif // SRSENB_LTE_FEC_WORKER_POOL_H
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSENB_LTE_IN_FLIGHT_ADAPTER_H
+#define SRSENB_LTE_IN_FLIGHT_ADAPTER_H
+
+#include "srsran/phy/utils/vector.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace srsenb {
+namespace lte {
+
+/**
+ * @brief Number of subframes handed to the PHY workers at the same time, adapted to the measured worker busy time.
+ *
+ * A subframe is received every millisecond, so a worker busy for N ms holds N subframes at once. One spare worker on
+ * top absorbs a slower subframe until the measurement catches up. The number grows as soon as a subframe needs it and
+ * only shrinks after a whole window of shorter subframes, never below the minimum given at construction.
+ */
+class in_flight_adapter
+{
+public:
+  static const uint32_t window_tti = 1000;
+
+  in_flight_adapter(uint32_t nof_workers_, uint32_t min_in_flight_) :
+    nof_workers(nof_workers_), min_in_flight(std::min(min_in_flight_, nof_workers_)), nof_in_flight(nof_workers_)
+  {}
+
+  /// Feeds the busy time of a worker for one subframe, returns true if the number of subframes in flight changed
+  bool new_busy_time(uint32_t busy_us)
+  {
+    uint32_t needed = required(busy_us);
+    window_peak_us  = std::max(window_peak_us, busy_us);
+
+    uint32_t target = nof_in_flight;
+    if (needed > nof_in_flight) {
+      target = needed;
+    } else if (++window_count >= window_tti) {
+      target         = required(window_peak_us);
+      window_count   = 0;
+      window_peak_us = 0;
+    }
+
+    bool changed  = (target != nof_in_flight);
+    nof_in_flight = target;
+    return changed;
+  }
+
+  uint32_t get_nof_in_flight() const { return nof_in_flight; }
+
+private:
+  uint32_t required(uint32_t busy_us) const
+  {
+    return std::max(std::min(SRSRAN_CEIL(busy_us, 1000U) + 1, nof_workers), min_in_flight);
+  }
+
+  uint32_t nof_workers    = 0;
+  uint32_t min_in_flight  = 0;
+  uint32_t nof_in_flight  = 0;
+  uint32_t window_count   = 0;
+  uint32_t window_peak_us = 0;
+};
+
+} // namespace lte
+} // namespace srsenb
+
+#endif // SRSENB_LTE_IN_FLIGHT_ADAPTER_H
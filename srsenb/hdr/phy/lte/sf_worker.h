@@ -22,11 +22,14 @@
 #ifndef SRSENB_PHCH_WORKER_H
 #define SRSENB_PHCH_WORKER_H
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <string.h>
 
 #include "../phy_common.h"
 #include "cc_worker.h"
+#include "fec_worker_pool.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
@@ -38,7 +41,7 @@ class sf_worker : public srsran::thread_pool::worker
 public:
   sf_worker(srslog::basic_logger& logger) : logger(logger) {}
   ~sf_worker();
-  void init(phy_common* phy);
+  void init(phy_common* phy, fec_worker_pool* fec_pool = nullptr);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
@@ -58,6 +61,13 @@ public:
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
+  /// Sets when the worker was taken for receiving a subframe, the busy time is measured from there
+  void set_taken_time(std::chrono::steady_clock::time_point t) { taken_time = t; }
+
+  /// Time the worker was busy with the last subframe, from being taken for receiving it until it was released after
+  /// the previous subframes were transmitted
+  uint32_t get_busy_time_us() const { return busy_time_us; }
+
 private:
   void work_imp() final;
 
@@ -68,6 +78,9 @@ private:
   bool                  running   = false;
   std::mutex            work_mutex;
 
+  std::chrono::steady_clock::time_point taken_time   = {};
+  std::atomic<uint32_t>                 busy_time_us = {0};
+
   uint32_t                                       tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
   std::vector<std::unique_ptr<cc_worker> >       cc_workers;
   srsran::phy_common_interface::worker_context_t context = {};
@@ -22,6 +22,8 @@
 #ifndef SRSENB_LTE_WORKER_POOL_H
 #define SRSENB_LTE_WORKER_POOL_H
 
+#include "fec_worker_pool.h"
+#include "in_flight_adapter.h"
 #include "sf_worker.h"
 #include "srsran/common/thread_pool.h"
 
@@ -32,14 +34,28 @@ class worker_pool
 {
   srsran::thread_pool                      pool;
   std::vector<std::unique_ptr<sf_worker> > workers;
+  std::unique_ptr<fec_worker_pool>         fec_pool;
+  srslog::basic_logger*                    logger = nullptr;
+
+  // Number of subframes handed to the workers at the same time, adapted to the measured busy time
+  std::unique_ptr<in_flight_adapter> in_flight;
+
+  void take_worker(sf_worker* w);
 
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
   uint32_t   get_nof_workers() { return (uint32_t)workers.size(); }
 
   worker_pool(uint32_t max_workers);
-  bool       init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio);
+  bool       init(const phy_args_t&            args,
+                  phy_common*                  common,
+                  srslog::sink&                log_sink,
+                  int                          prio,
+                  const std::vector<uint32_t>& cpus          = {},
+                  uint32_t                     min_in_flight = 0);
+  uint32_t   get_nof_in_flight() const { return in_flight ? in_flight->get_nof_in_flight() : (uint32_t)workers.size(); }
   sf_worker* wait_worker(uint32_t tti);
+  sf_worker* wait_worker_nb(uint32_t tti);
   sf_worker* wait_worker_id(uint32_t id);
   void       start_worker(sf_worker* w);
   void       stop();
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSENB_NR_SLOT_TASK_POOL_H
+#define SRSENB_NR_SLOT_TASK_POOL_H
+
+#include "srsran/common/thread_pool.h"
+#include "srsran/srsran.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace srsenb {
+namespace nr {
+
+/**
+ * @brief Channel processors a slot job runs with. Pool threads have their own ones, which borrow the resource grid of
+ * the slot the job belongs to, while the slot worker uses its gNb DL and UL objects
+ */
+struct slot_lane_t {
+  srsran_gnb_dl_t* gnb_dl = nullptr;
+  srsran_gnb_ul_t* gnb_ul = nullptr;
+};
+
+/**
+ * @brief Pool of threads shared by all the NR slot workers for running the independent jobs of a slot (per-UE PDSCH
+ * encoding, per-UE PUSCH decoding and PUCCH groups) in parallel.
+ *
+ * A slot worker publishes a group of jobs and runs them itself together with the pool threads, each job is claimed by
+ * the first free thread. Idle pool threads take the unclaimed jobs of any slot in flight, so a slot with many UEs gets
+ * help from the threads that finished the jobs of lighter slots.
+ */
+class slot_task_pool
+{
+public:
+  /// Jobs of one slot stage, they can run in any order and in any thread
+  class job_group
+  {
+  public:
+    virtual ~job_group() = default;
+
+    virtual void run_job(const slot_lane_t& lane, uint32_t job_idx) = 0;
+
+  private:
+    friend class slot_task_pool;
+
+    static const uint32_t max_nof_jobs = UINT16_MAX;
+
+    /// Claim state: generation in the 32 most significant bits, number of jobs and next job in 16 bits each. Threads
+    /// holding an old generation cannot claim jobs of the following stages that reuse the group
+    std::atomic<uint64_t>   state    = {0};
+    std::atomic<uint32_t>   nof_done = {0};
+    uint32_t                nof_jobs = 0;
+    std::mutex              mutex;
+    std::condition_variable cvar;
+  };
+
+  slot_task_pool(uint32_t nof_threads, int32_t prio);
+  ~slot_task_pool();
+
+  /// Sets the arguments the pool threads initialise their channel processors with
+  void set_args(const srsran_gnb_dl_args_t& dl_args, const srsran_gnb_ul_args_t& ul_args);
+
+  /// Sets the carrier of the pool threads channel processors, they apply it before running their next job
+  void set_carrier(const srsran_carrier_nr_t& carrier);
+
+  /// Runs the jobs of the group, own_lane is used for the ones taken by the calling thread. Returns once all finished
+  void run(job_group& group, uint32_t nof_jobs, const slot_lane_t& own_lane);
+
+  void stop();
+
+private:
+  class thread_lane;
+
+  static bool claim_job(job_group& group, uint32_t generation, uint32_t& job_idx);
+  static void finish_job(job_group& group);
+  void        help(job_group& group, uint32_t generation);
+
+  srsran::task_thread_pool pool;
+  std::mutex               cfg_mutex;
+  srsran_gnb_dl_args_t     dl_args     = {};
+  srsran_gnb_ul_args_t     ul_args     = {};
+  srsran_carrier_nr_t      carrier     = {};
+  std::atomic<uint32_t>    carrier_gen = {0};
+};
+
+} // namespace nr
+} // namespace srsenb
+
+#endif // SRSENB_NR_SLOT_TASK_POOL_H
@@ -22,6 +22,7 @@
 #ifndef SRSENB_NR_SLOT_WORKER_H
 #define SRSENB_NR_SLOT_WORKER_H
 
+#include "slot_task_pool.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
@@ -59,21 +60,24 @@ public:
   };
 
   struct args_t {
-    uint32_t                    cell_index       = 0;
-    uint32_t                    nof_max_prb      = SRSRAN_MAX_PRB_NR;
-    uint32_t                    nof_tx_ports     = 1;
-    uint32_t                    nof_rx_ports     = 1;
-    uint32_t                    rf_port          = 0;
-    srsran_subcarrier_spacing_t scs              = srsran_subcarrier_spacing_15kHz;
-    uint32_t                    pusch_max_its    = 10;
-    float                       pusch_min_snr_dB = -10.0f;
-    double                      srate_hz         = 0.0;
+    uint32_t                    cell_index          = 0;
+    uint32_t                    nof_max_prb         = SRSRAN_MAX_PRB_NR;
+    uint32_t                    nof_tx_ports        = 1;
+    uint32_t                    nof_rx_ports        = 1;
+    uint32_t                    rf_port             = 0;
+    srsran_subcarrier_spacing_t scs                 = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    pusch_max_its       = 10;
+    bool                        pusch_early_stop    = false;
+    uint32_t                    uci_polar_list_size = 1;
+    float                       pusch_min_snr_dB    = -10.0f;
+    double                      srate_hz            = 0.0;
   };
 
   slot_worker(srsran::phy_common_interface& common_,
               stack_interface_phy_nr&       stack_,
               sync_interface&               sync_,
-              srslog::basic_logger&         logger);
+              srslog::basic_logger&         logger,
+              slot_task_pool*               task_pool_ = nullptr);
   ~slot_worker();
 
   bool init(const args_t& args);
@@ -87,6 +91,7 @@ public:
   cf_t*    get_buffer_tx(uint32_t antenna_idx);
   uint32_t get_buffer_len();
   void     set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
+  uint32_t get_tti() const { return context.sf_idx; }
 
 private:
   /**
@@ -106,6 +111,37 @@ private:
    */
   bool work_dl();
 
+  /// Independent jobs of the UL and DL stages of the slot: PUSCH, groups of PUCCH and PDSCH
+  class slot_jobs_t final : public slot_task_pool::job_group
+  {
+  public:
+    explicit slot_jobs_t(slot_worker& parent_) : parent(parent_) {}
+    void run_job(const slot_lane_t& lane, uint32_t job_idx) override;
+
+    bool ul_stage = true;
+
+  private:
+    slot_worker& parent;
+  };
+
+  /// PUCCH and PUSCH decoded by the jobs, reported to the stack in scheduling order once all have finished
+  struct pucch_result_t {
+    bool                                 ok   = false;
+    stack_interface_phy_nr::pucch_info_t info = {};
+  };
+  struct pusch_result_t {
+    bool                                 ok   = false;
+    stack_interface_phy_nr::pusch_info_t info = {};
+  };
+
+  /// PUCCH decoding is short, a few of them are grouped in a job to keep the job overhead small
+  static const uint32_t pucch_group_size = 4;
+
+  void run_jobs(uint32_t nof_jobs, bool ul_stage);
+  void decode_pucch(const slot_lane_t& lane, uint32_t pucch_idx);
+  void decode_pusch(const slot_lane_t& lane, uint32_t pusch_idx);
+  void encode_pdsch(const slot_lane_t& lane, uint32_t pdsch_idx);
+
   srsran::phy_common_interface& common;
   stack_interface_phy_nr&       stack;
   srslog::basic_logger&         logger;
@@ -123,6 +159,14 @@ private:
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
+
+  slot_task_pool*                           task_pool = nullptr; ///< Runs the slot jobs, in this thread if null
+  slot_jobs_t                               jobs;
+  stack_interface_phy_nr::ul_sched_t*       ul_sched = nullptr; ///< UL scheduling of the slot being processed
+  const stack_interface_phy_nr::dl_sched_t* dl_sched = nullptr; ///< DL scheduling of the slot being processed
+  std::vector<pucch_result_t>               pucch_results;
+  std::vector<pusch_result_t>               pusch_results;
+  std::atomic<bool>                         pdsch_failed = {false};
 };
 
 } // namespace nr
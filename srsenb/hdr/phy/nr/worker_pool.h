@@ -22,6 +22,7 @@
 #ifndef SRSENB_NR_WORKER_POOL_H
 #define SRSENB_NR_WORKER_POOL_H
 
+#include "slot_task_pool.h"
 #include "slot_worker.h"
 #include "srsenb/hdr/phy/phy_interfaces.h"
 #include "srsenb/hdr/phy/prach_worker.h"
@@ -92,8 +93,8 @@ private:
   srslog::sink&                              log_sink;
   srsran::thread_pool                        pool;
   std::vector<std::unique_ptr<slot_worker> > workers;
+  std::unique_ptr<slot_task_pool>            task_pool; ///< Optional, shared by the workers for the slot jobs
   prach_worker_pool                          prach;
-  uint32_t                                   current_tti = 0; ///< Current TTI, read and write from same thread
   srslog::basic_logger&                      logger;
   prach_stack_adaptor_t                      prach_stack_adaptor;
   uint32_t                                   nof_prach_workers = 0;
@@ -101,13 +102,16 @@ private:
 
 public:
   struct args_t {
-    double                 srate_hz          = 0.0;
-    uint32_t               nof_phy_threads   = 3;
-    uint32_t               nof_prach_workers = 0;
-    uint32_t               prio              = 52;
-    uint32_t               pusch_max_its     = 10;
-    float                  pusch_min_snr_dB  = -10;
-    srsran::phy_log_args_t log               = {};
+    double                 srate_hz            = 0.0;
+    uint32_t               nof_phy_threads     = 3;
+    uint32_t               nof_prach_workers   = 0;
+    uint32_t               prio                = 52;
+    uint32_t               nof_task_threads    = 0; ///< Threads helping the workers with the slot jobs, 0 disables
+    uint32_t               pusch_max_its       = 10;
+    bool                   pusch_early_stop    = false;
+    uint32_t               uci_polar_list_size = 1;
+    float                  pusch_min_snr_dB    = -10;
+    srsran::phy_log_args_t log                 = {};
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
 
@@ -117,6 +121,7 @@ public:
               uint32_t                      max_workers);
   bool         init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_list);
   slot_worker* wait_worker(uint32_t tti);
+  slot_worker* wait_worker_nb(uint32_t tti);
   slot_worker* wait_worker_id(uint32_t id);
   void         start_worker(slot_worker* w);
   void         stop();
@@ -111,7 +111,15 @@ private:
   srsran_prach_cfg_t prach_cfg  = {};
   common_cfg_t       common_cfg = {};
 
-  void parse_common_config(const phy_cfg_t& cfg);
+  /// CPUs the RF, PRACH and PHY worker threads are pinned to with auto_phy_threads, empty lists leave them unpinned
+  struct cpu_layout_t {
+    std::vector<uint32_t> rf;
+    std::vector<uint32_t> prach;
+    std::vector<uint32_t> workers;
+  } cpu_layout;
+
+  void     parse_common_config(const phy_cfg_t& cfg);
+  uint32_t plan_cpu_layout(uint32_t nof_phy_threads);
   int  init_lte(const phy_args_t&            args,
                 const phy_cfg_t&             cfg,
                 srsran::radio_interface_phy* radio_,
@@ -59,22 +59,28 @@ struct phy_args_t {
   std::string            type;
   srsran::phy_log_args_t log;
 
-  float                   rx_gain_offset      = 62;
-  float                   max_prach_offset_us = 10;
-  uint32_t                pusch_max_its       = 10;
-  uint32_t                nr_pusch_max_its    = 10;
-  bool                    pusch_8bit_decoder  = false;
-  float                   tx_amplitude        = 1.0f;
-  uint32_t                nof_phy_threads     = 1;
-  std::string             equalizer_mode      = "mmse";
-  float                   estimator_fil_w     = 1.0f;
-  bool                    pusch_meas_epre     = true;
-  bool                    pusch_meas_evm      = false;
-  bool                    pusch_meas_ta       = true;
-  bool                    pucch_meas_ta       = true;
-  bool                    use_cedron_alg      = false;
-  uint32_t                nof_prach_threads   = 1;
-  bool                    extended_cp         = false;
+  float                   rx_gain_offset         = 62;
+  float                   max_prach_offset_us    = 10;
+  uint32_t                pusch_max_its          = 10;
+  uint32_t                nr_pusch_max_its       = 10;
+  bool                    nr_pusch_early_stop    = false;
+  uint32_t                nr_uci_polar_list_size = 1;
+  bool                    pusch_8bit_decoder     = false;
+  float                   tx_amplitude           = 1.0f;
+  uint32_t                nof_phy_threads        = 1;
+  uint32_t                nof_fec_threads        = 0;
+  bool                    pipelined_txrx         = false;
+  bool                    auto_phy_threads       = false;
+  uint32_t                nof_nr_task_threads    = 0;
+  std::string             equalizer_mode         = "mmse";
+  float                   estimator_fil_w        = 1.0f;
+  bool                    pusch_meas_epre        = true;
+  bool                    pusch_meas_evm         = false;
+  bool                    pusch_meas_ta          = true;
+  bool                    pucch_meas_ta          = true;
+  bool                    use_cedron_alg         = false;
+  uint32_t                nof_prach_threads      = 1;
+  bool                    extended_cp            = false;
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
   cfr_args_t              cfr_args;
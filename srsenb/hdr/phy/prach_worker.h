@@ -58,6 +58,8 @@ public:
   void set_max_prach_offset_us(float delay_us);
   void stop();
 
+  using srsran::thread::set_affinity;
+
 private:
   uint32_t cc_idx = 0;
 
@@ -140,6 +142,13 @@ public:
     }
   }
 
+  void set_affinity(const std::vector<uint32_t>& cpus)
+  {
+    for (auto& prach : prach_vec) {
+      prach->set_affinity(cpus);
+    }
+  }
+
   void stop()
   {
     for (auto& prach : prach_vec) {
@@ -26,11 +26,14 @@
 #include "prach_worker.h"
 #include "srsenb/hdr/phy/lte/worker_pool.h"
 #include "srsenb/hdr/phy/nr/worker_pool.h"
+#include "srsran/adt/spsc_queue.h"
 #include "srsran/config.h"
 #include "srsran/interfaces/enb_time_interface.h"
 #include "srsran/phy/channel/channel.h"
 #include "srsran/radio/radio.h"
 #include <atomic>
+#include <chrono>
+#include <semaphore.h>
 
 namespace srsenb {
 
@@ -47,8 +50,60 @@ public:
   bool set_nr_workers(nr::worker_pool* nr_workers_);
   void stop();
 
+  /// Pins the RF thread and, in pipelined mode, the dispatcher thread
+  bool set_affinity(const std::vector<uint32_t>& cpus);
+
 private:
+  /// Subframe received by the RF thread, waiting to be dispatched. Without workers the subframe was dropped
+  struct rx_sf_t {
+    uint32_t                              tti        = 0;
+    lte::sf_worker*                       lte_worker = nullptr;
+    nr::slot_worker*                      nr_worker  = nullptr;
+    srsran::rf_timestamp_t                timestamp  = {};
+    std::chrono::steady_clock::time_point rx_time    = {};
+
+    rx_sf_t()                     = default;
+    rx_sf_t(const rx_sf_t& other) = default;
+    rx_sf_t& operator=(const rx_sf_t& other)
+    {
+      tti        = other.tti;
+      lte_worker = other.lte_worker;
+      nr_worker  = other.nr_worker;
+      rx_time    = other.rx_time;
+      timestamp.copy(other.timestamp);
+      return *this;
+    }
+  };
+
+  /// Latency histogram with power of two buckets in microseconds, updated by a single thread
+  class latency_histogram_t
+  {
+  public:
+    static const uint32_t nof_buckets = 16;
+
+    void        add(std::chrono::steady_clock::duration d);
+    std::string to_string() const;
+
+  private:
+    std::array<uint32_t, nof_buckets> count  = {}; ///< Bucket i counts latencies below 2^i us, the last one the rest
+    uint32_t                          max_us = 0;
+  };
+
+  class dispatcher_t final : public srsran::thread
+  {
+  public:
+    explicit dispatcher_t(txrx* parent_) : thread("TXRX_DISPATCH"), parent(parent_) {}
+
+  private:
+    void  run_thread() override { parent->run_dispatcher(); }
+    txrx* parent;
+  };
+
   void run_thread() override;
+  void run_pipelined();
+  void run_dispatcher();
+  void set_buffers(srsran::rf_buffer_t& buffer, lte::sf_worker* lte_worker, nr::slot_worker* nr_worker);
+  void dispatch(rx_sf_t& sf, srsran::rf_buffer_t& buffer);
 
   enb_time_interface*          enb     = nullptr;
   srsran::radio_interface_phy* radio_h = nullptr;
@@ -60,7 +115,19 @@ private:
   srsran::channel_ptr          ul_channel  = nullptr;
 
   // Main system TTI counter
-  uint32_t tti = 0;
+  uint32_t tti    = 0;
+  uint32_t sf_len = 0;
+
+  // Pipelined mode, the RF thread hands the received subframes over to the dispatcher
+  static const uint32_t                           rx_queue_sz = 32;
+  srsran::static_spsc_queue<rx_sf_t, rx_queue_sz> rx_queue;
+  sem_t                                           rx_queue_sem = {};
+  std::unique_ptr<dispatcher_t>                   dispatcher;
+  std::unique_ptr<srsran::rf_buffer_t>            drop_buffer;
+  latency_histogram_t                             rx_latency;
+  latency_histogram_t                             queue_latency;
+  latency_histogram_t                             dispatch_latency;
+  uint32_t                                        nof_dropped = 0;
 
   std::atomic<bool> running;
 };
@@ -192,6 +192,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),               "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(0),          "Number of worker threads pipelining the channel stages, 0 runs them in the radio thread")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),          "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),         "Target SNR in dB")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),        "Enable/Disable Fading model")
@@ -211,6 +212,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(0),             "Number of worker threads pipelining the channel stages, 0 runs them in the radio thread")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
@@ -255,6 +257,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
+    ("expert.nof_fec_threads", bpo::value<uint32_t>(&args->phy.nof_fec_threads)->default_value(0), "Number of threads for decoding PUSCH code blocks in parallel (0 decodes them in the PHY threads).")
+    ("expert.pipelined_txrx", bpo::value<bool>(&args->phy.pipelined_txrx)->default_value(false), "Receive subframes in the RF thread and start the PHY workers from a separate dispatcher thread.")
+    ("expert.nof_nr_task_threads", bpo::value<uint32_t>(&args->phy.nof_nr_task_threads)->default_value(0), "Number of threads shared by the NR PHY threads for encoding PDSCH and decoding PUSCH and PUCCH of a slot in parallel (0 processes them in the PHY threads).")
+    ("expert.auto_phy_threads", bpo::value<bool>(&args->phy.auto_phy_threads)->default_value(false), "Size the PHY worker pool from the CPU topology, pin the PHY threads to isolated cores and adapt the subframes in flight to the worker busy time, keeping at least nof_phy_threads.")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
@@ -304,6 +310,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
+    ("expert.nr_pusch_early_stop", bpo::value<bool>(&args->phy.nr_pusch_early_stop)->default_value(false), "Stop LDPC iterations for NR as soon as all parity checks are satisfied.")
+    ("expert.nr_uci_polar_list_size", bpo::value<uint32_t>(&args->phy.nr_uci_polar_list_size)->default_value(1), "Polar list decoder size for NR UCI (1 for SSC decoding, up to 8).")
   ;
 
   // Positional options - config file location
@@ -602,6 +610,7 @@ static size_t fixup_log_file_maxsize(int x)
 }
 
 extern "C" void srsran_dft_exit();
+extern "C" int  srsran_dft_wisdom_save();
 static void     emergency_cleanup_handler(void* data)
 {
   srslog::flush();
@@ -683,6 +692,9 @@ int main(int argc, char* argv[])
     return SRSRAN_ERROR;
   }
 
+  // All cells are planned, keep the FFTW wisdom even if the eNB does not exit cleanly
+  srsran_dft_wisdom_save();
+
   // Set metrics
   metricshub.init(enb.get(), args.general.metrics_period_secs);
   metricshub.add_listener(&metrics_screen);
@@ -86,7 +86,7 @@ cc_worker::~cc_worker()
 FILE* f;
 #endif
 
-void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
+void cc_worker::init(phy_common* phy_, uint32_t cc_idx_, fec_worker_pool* fec_pool)
 {
   phy                         = phy_;
   cc_idx                      = cc_idx_;
@@ -156,6 +156,13 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
   }
+
+  if (fec_pool != nullptr) {
+    if (srsran_sch_set_cb_executor(&enb_ul.pusch.ul_sch, fec_pool->get_cb_executor()) < SRSRAN_SUCCESS) {
+      ERROR("Error setting PUSCH code block executor");
+      return;
+    }
+  }
   initiated = true;
 
 #ifdef DEBUG_WRITE_FILE
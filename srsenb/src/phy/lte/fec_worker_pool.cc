@@ -0,0 +1,71 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/lte/fec_worker_pool.h"
+
+namespace srsenb {
+namespace lte {
+
+namespace {
+
+/// Code block decoding resources of a pool thread, created the first time the thread runs a job
+class thread_cb_decoder
+{
+public:
+  thread_cb_decoder() { initiated = srsran_sch_cb_decoder_init(&decoder) == SRSRAN_SUCCESS; }
+  ~thread_cb_decoder() { srsran_sch_cb_decoder_free(&decoder); }
+
+  srsran_sch_cb_decoder_t* get() { return initiated ? &decoder : nullptr; }
+
+private:
+  srsran_sch_cb_decoder_t decoder   = {};
+  bool                    initiated = false;
+};
+
+} // namespace
+
+fec_worker_pool::fec_worker_pool(uint32_t nof_workers, int32_t prio) : pool(nof_workers, false, prio)
+{
+  executor.arg  = this;
+  executor.push = push_cb_job;
+}
+
+fec_worker_pool::~fec_worker_pool()
+{
+  stop();
+}
+
+void fec_worker_pool::stop()
+{
+  pool.stop();
+}
+
+void fec_worker_pool::push_cb_job(void* arg, srsran_sch_cb_job_t* job)
+{
+  auto* self = static_cast<fec_worker_pool*>(arg);
+  self->pool.push_task([job]() {
+    static thread_local thread_cb_decoder decoder;
+    srsran_sch_cb_job_run(job, decoder.get());
+  });
+}
+
+} // namespace lte
+} // namespace srsenb
@@ -19,6 +19,9 @@
  *
  */
 
+#include <chrono>
+
+#include "srsran/adt/scope_exit.h"
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
@@ -72,7 +75,7 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+void sf_worker::init(phy_common* phy_, fec_worker_pool* fec_pool)
 {
   phy = phy_;
 
@@ -82,7 +85,7 @@ void sf_worker::init(phy_common* phy_)
     auto q = new cc_worker(logger);
 
     // Initialise
-    q->init(phy, i);
+    q->init(phy, i, fec_pool);
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -151,6 +154,12 @@ void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
 
+  // The worker is released once this returns, on every path
+  auto measure_busy_time = srsran::make_scope_exit([this]() {
+    std::chrono::steady_clock::duration busy = std::chrono::steady_clock::now() - taken_time;
+    busy_time_us = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(busy).count();
+  });
+
   srsran_ul_sf_cfg_t ul_sf = {};
   srsran_dl_sf_cfg_t dl_sf = {};
 
@@ -25,8 +25,20 @@ namespace lte {
 
 worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
-bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
+bool worker_pool::init(const phy_args_t&            args,
+                       phy_common*                  common,
+                       srslog::sink&                log_sink,
+                       int                          prio,
+                       const std::vector<uint32_t>& cpus,
+                       uint32_t                     min_in_flight)
 {
+  logger = &srslog::fetch_basic_logger("PHY", log_sink);
+
+  // Create the code block decoding pool shared by all workers, if enabled
+  if (args.nof_fec_threads > 0) {
+    fec_pool = std::unique_ptr<fec_worker_pool>(new fec_worker_pool(args.nof_fec_threads, prio));
+  }
+
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
@@ -35,14 +47,36 @@ bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink&
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
+    w->init(common, fec_pool.get());
     pool.init_worker(i, w.get(), prio);
+    if (not cpus.empty() and not w->set_affinity(cpus)) {
+      logger->warning("Couldn't pin PHY worker %d to its CPUs", i);
+    }
     workers.push_back(std::move(w));
   }
 
+  // All workers take subframes until the busy time has been measured, min_in_flight of them are always kept
+  if (args.auto_phy_threads) {
+    uint32_t min_workers = (min_in_flight == 0) ? get_nof_workers() : min_in_flight;
+    in_flight            = std::unique_ptr<in_flight_adapter>(new in_flight_adapter(get_nof_workers(), min_workers));
+  }
+
   return true;
 }
 
+void worker_pool::take_worker(sf_worker* w)
+{
+  uint32_t busy_us = w->get_busy_time_us();
+  w->set_taken_time(std::chrono::steady_clock::now());
+
+  if (in_flight != nullptr and in_flight->new_busy_time(busy_us)) {
+    logger->info("Setting %d subframes in flight, a PHY worker was busy for %d us",
+                 in_flight->get_nof_in_flight(),
+                 busy_us);
+    pool.set_nof_active_workers(in_flight->get_nof_in_flight());
+  }
+}
+
 void worker_pool::start_worker(sf_worker* w)
 {
   pool.start_worker(w);
@@ -50,7 +84,20 @@ void worker_pool::start_worker(sf_worker* w)
 
 sf_worker* worker_pool::wait_worker(uint32_t tti)
 {
-  return (sf_worker*)pool.wait_worker(tti);
+  sf_worker* w = (sf_worker*)pool.wait_worker(tti);
+  if (w != nullptr) {
+    take_worker(w);
+  }
+  return w;
+}
+
+sf_worker* worker_pool::wait_worker_nb(uint32_t tti)
+{
+  sf_worker* w = (sf_worker*)pool.wait_worker_nb(tti);
+  if (w != nullptr) {
+    take_worker(w);
+  }
+  return w;
 }
 
 sf_worker* worker_pool::wait_worker_id(uint32_t id)
@@ -61,6 +108,11 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+
+  // Stop the code block decoders once no worker can push jobs
+  if (fec_pool != nullptr) {
+    fec_pool->stop();
+  }
 }
 
 }; // namespace lte
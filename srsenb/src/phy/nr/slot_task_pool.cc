@@ -0,0 +1,175 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/phy/nr/slot_task_pool.h"
+
+namespace srsenb {
+namespace nr {
+
+/// Channel processors of a pool thread, created the first time the thread runs a job
+class slot_task_pool::thread_lane
+{
+public:
+  ~thread_lane()
+  {
+    if (initiated) {
+      srsran_gnb_dl_free(&gnb_dl);
+      srsran_gnb_ul_free(&gnb_ul);
+    }
+  }
+
+  /// Gets the processors configured with the current carrier of the pool, or an empty lane if they are not available
+  slot_lane_t get(slot_task_pool& parent)
+  {
+    if (not initiated) {
+      std::lock_guard<std::mutex> lock(parent.cfg_mutex);
+      initiated = true;
+      valid     = (srsran_gnb_dl_init_shared(&gnb_dl, &parent.dl_args) == SRSRAN_SUCCESS);
+      valid     = valid and (srsran_gnb_ul_init_shared(&gnb_ul, &parent.ul_args) == SRSRAN_SUCCESS);
+    }
+
+    if (valid and carrier_gen != parent.carrier_gen.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(parent.cfg_mutex);
+      carrier_gen = parent.carrier_gen;
+      valid       = (srsran_gnb_dl_set_carrier(&gnb_dl, &parent.carrier) == SRSRAN_SUCCESS);
+      valid       = valid and (srsran_gnb_ul_set_carrier(&gnb_ul, &parent.carrier) == SRSRAN_SUCCESS);
+    }
+
+    if (not valid) {
+      return {};
+    }
+    return {&gnb_dl, &gnb_ul};
+  }
+
+private:
+  srsran_gnb_dl_t gnb_dl      = {};
+  srsran_gnb_ul_t gnb_ul      = {};
+  bool            initiated   = false;
+  bool            valid       = false;
+  uint32_t        carrier_gen = 0;
+};
+
+slot_task_pool::slot_task_pool(uint32_t nof_threads, int32_t prio) : pool(nof_threads, false, prio) {}
+
+slot_task_pool::~slot_task_pool()
+{
+  stop();
+}
+
+void slot_task_pool::stop()
+{
+  pool.stop();
+}
+
+void slot_task_pool::set_args(const srsran_gnb_dl_args_t& dl_args_, const srsran_gnb_ul_args_t& ul_args_)
+{
+  std::lock_guard<std::mutex> lock(cfg_mutex);
+  dl_args = dl_args_;
+  ul_args = ul_args_;
+}
+
+void slot_task_pool::set_carrier(const srsran_carrier_nr_t& carrier_)
+{
+  std::lock_guard<std::mutex> lock(cfg_mutex);
+  carrier = carrier_;
+  carrier_gen++;
+}
+
+bool slot_task_pool::claim_job(job_group& group, uint32_t generation, uint32_t& job_idx)
+{
+  uint64_t state = group.state.load(std::memory_order_acquire);
+  do {
+    uint32_t nof_jobs = (uint32_t)(state >> 16U) & 0xffffU;
+    uint32_t next     = (uint32_t)state & 0xffffU;
+    if ((uint32_t)(state >> 32U) != generation or next >= nof_jobs) {
+      return false;
+    }
+    job_idx = next;
+  } while (not group.state.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel));
+  return true;
+}
+
+void slot_task_pool::finish_job(job_group& group)
+{
+  if (group.nof_done.fetch_add(1, std::memory_order_acq_rel) + 1 == group.nof_jobs) {
+    std::lock_guard<std::mutex> lock(group.mutex);
+    group.cvar.notify_all();
+  }
+}
+
+void slot_task_pool::help(job_group& group, uint32_t generation)
+{
+  static thread_local thread_lane thread_processors;
+
+  // Without processors the jobs are left to the other threads, the slot worker takes any remaining one
+  slot_lane_t lane = thread_processors.get(*this);
+  if (lane.gnb_dl == nullptr) {
+    return;
+  }
+
+  uint32_t job_idx = 0;
+  while (claim_job(group, generation, job_idx)) {
+    group.run_job(lane, job_idx);
+    finish_job(group);
+  }
+}
+
+void slot_task_pool::run(job_group& group, uint32_t nof_jobs, const slot_lane_t& own_lane)
+{
+  // The claim state cannot hold that many jobs, run them in the calling thread
+  if (nof_jobs > job_group::max_nof_jobs) {
+    for (uint32_t i = 0; i < nof_jobs; i++) {
+      group.run_job(own_lane, i);
+    }
+    return;
+  }
+  if (nof_jobs == 0) {
+    return;
+  }
+
+  // Publish the jobs under a new generation, threads still helping with the previous stage cannot claim them
+  uint32_t generation = (uint32_t)(group.state.load(std::memory_order_relaxed) >> 32U) + 1;
+  group.nof_jobs      = nof_jobs;
+  group.nof_done      = 0;
+  group.state.store(((uint64_t)generation << 32U) | ((uint64_t)nof_jobs << 16U), std::memory_order_release);
+
+  // The calling thread runs jobs too, so the pool is only asked for help with the rest
+  uint32_t nof_helpers = std::min(nof_jobs - 1, (uint32_t)pool.nof_workers());
+  for (uint32_t i = 0; i < nof_helpers; i++) {
+    pool.push_task([this, &group, generation]() { help(group, generation); });
+  }
+
+  uint32_t job_idx = 0;
+  while (claim_job(group, generation, job_idx)) {
+    group.run_job(own_lane, job_idx);
+    finish_job(group);
+  }
+
+  // Wait for the jobs taken by the pool threads
+  std::unique_lock<std::mutex> lock(group.mutex);
+  while (group.nof_done.load(std::memory_order_acquire) < nof_jobs) {
+    group.cvar.wait(lock);
+  }
+}
+
+} // namespace nr
+} // namespace srsenb
@@ -36,8 +36,9 @@ namespace nr {
 slot_worker::slot_worker(srsran::phy_common_interface& common_,
                          stack_interface_phy_nr&       stack_,
                          sync_interface&               sync_,
-                         srslog::basic_logger&         logger_) :
-  common(common_), stack(stack_), sync(sync_), logger(logger_)
+                         srslog::basic_logger&         logger_,
+                         slot_task_pool*               task_pool_) :
+  common(common_), stack(stack_), sync(sync_), logger(logger_), task_pool(task_pool_), jobs(*this)
 {
   // Do nothing
 }
@@ -89,14 +90,17 @@ bool slot_worker::init(const args_t& args)
   }
 
   // Prepare UL arguments
-  srsran_gnb_ul_args_t ul_args   = {};
-  ul_args.pusch.measure_time     = true;
-  ul_args.pusch.measure_evm      = true;
-  ul_args.pusch.max_layers       = args.nof_rx_ports;
-  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
-  ul_args.pusch.max_prb          = args.nof_max_prb;
-  ul_args.nof_max_prb            = args.nof_max_prb;
-  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+  srsran_gnb_ul_args_t ul_args                  = {};
+  ul_args.pusch.measure_time                    = true;
+  ul_args.pusch.measure_evm                     = true;
+  ul_args.pusch.max_layers                      = args.nof_rx_ports;
+  ul_args.pusch.sch.max_nof_iter                = args.pusch_max_its;
+  ul_args.pusch.sch.decoder_syndrome_early_stop = args.pusch_early_stop;
+  ul_args.pusch.max_prb                         = args.nof_max_prb;
+  ul_args.nof_max_prb                           = args.nof_max_prb;
+  ul_args.pusch_min_snr_dB                      = args.pusch_min_snr_dB;
+  ul_args.pusch.uci.polar_list_size             = args.uci_polar_list_size;
+  ul_args.pucch.uci.polar_list_size             = args.uci_polar_list_size;
 
   // Initialise UL
   if (srsran_gnb_ul_init(&gnb_ul, rx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
@@ -104,6 +108,11 @@ bool slot_worker::init(const args_t& args)
     return false;
   }
 
+  // The task pool threads create the same channel processors
+  if (task_pool != nullptr) {
+    task_pool->set_args(dl_args, ul_args);
+  }
+
 #ifdef DEBUG_WRITE_FILE
   const char* filename = "nr_baseband.dat";
   printf("Opening %s to dump baseband\n", filename);
@@ -164,9 +173,139 @@ void slot_worker::set_context(const srsran::phy_common_interface::worker_context
   context.copy(w_ctx);
 }
 
+void slot_worker::slot_jobs_t::run_job(const slot_lane_t& lane, uint32_t job_idx)
+{
+  if (not ul_stage) {
+    srsran_gnb_dl_set_grid(lane.gnb_dl, &parent.gnb_dl);
+    parent.encode_pdsch(lane, job_idx);
+    return;
+  }
+
+  // PUSCH go first, they are the longest jobs
+  srsran_gnb_ul_set_grid(lane.gnb_ul, &parent.gnb_ul);
+  uint32_t nof_pusch = (uint32_t)parent.ul_sched->pusch.size();
+  if (job_idx < nof_pusch) {
+    parent.decode_pusch(lane, job_idx);
+    return;
+  }
+
+  uint32_t first = (job_idx - nof_pusch) * pucch_group_size;
+  uint32_t last  = std::min(first + pucch_group_size, (uint32_t)parent.ul_sched->pucch.size());
+  for (uint32_t i = first; i < last; i++) {
+    parent.decode_pucch(lane, i);
+  }
+}
+
+void slot_worker::run_jobs(uint32_t nof_jobs, bool ul_stage)
+{
+  jobs.ul_stage        = ul_stage;
+  slot_lane_t own_lane = {&gnb_dl, &gnb_ul};
+
+  if (task_pool != nullptr) {
+    task_pool->run(jobs, nof_jobs, own_lane);
+    return;
+  }
+
+  for (uint32_t i = 0; i < nof_jobs; i++) {
+    jobs.run_job(own_lane, i);
+  }
+}
+
+void slot_worker::decode_pucch(const slot_lane_t& lane, uint32_t pucch_idx)
+{
+  stack_interface_phy_nr::pucch_t& pucch = ul_sched->pucch[pucch_idx];
+  srsran::bounded_vector<stack_interface_phy_nr::pucch_info_t, stack_interface_phy_nr::MAX_PUCCH_CANDIDATES>
+      pucch_info(pucch.candidates.size());
+
+  // For each candidate decode PUCCH
+  for (uint32_t i = 0; i < (uint32_t)pucch.candidates.size(); i++) {
+    pucch_info[i].uci_data.cfg = pucch.candidates[i].uci_cfg;
+
+    // Decode PUCCH
+    if (srsran_gnb_ul_get_pucch(lane.gnb_ul,
+                                &ul_slot_cfg,
+                                &pucch.pucch_cfg,
+                                &pucch.candidates[i].resource,
+                                &pucch_info[i].uci_data.cfg,
+                                &pucch_info[i].uci_data.value,
+                                &pucch_info[i].csi) < SRSRAN_SUCCESS) {
+      logger.error("Error getting PUCCH");
+      return;
+    }
+  }
+
+  // Find most suitable PUCCH candidate
+  uint32_t best_candidate = 0;
+  for (uint32_t i = 1; i < (uint32_t)pucch_info.size(); i++) {
+    // Select candidate if exceeds the previous best candidate SNR
+    if (pucch_info[i].csi.snr_dB > pucch_info[best_candidate].csi.snr_dB) {
+      best_candidate = i;
+    }
+  }
+
+  pucch_results[pucch_idx].info = pucch_info[best_candidate];
+  pucch_results[pucch_idx].ok   = true;
+
+  // Log PUCCH decoding
+  if (logger.info.enabled()) {
+    std::array<char, 512> str;
+    srsran_gnb_ul_pucch_info(lane.gnb_ul,
+                             &pucch.candidates[0].resource,
+                             &pucch_info[best_candidate].uci_data,
+                             &pucch_info[best_candidate].csi,
+                             str.data(),
+                             (uint32_t)str.size());
+
+    logger.info("PUCCH: %s", str.data());
+  }
+}
+
+void slot_worker::decode_pusch(const slot_lane_t& lane, uint32_t pusch_idx)
+{
+  stack_interface_phy_nr::pusch_t& pusch = ul_sched->pusch[pusch_idx];
+
+  // Prepare PUSCH
+  stack_interface_phy_nr::pusch_info_t& pusch_info = pusch_results[pusch_idx].info;
+  pusch_info.uci_cfg                               = pusch.sch.uci;
+  pusch_info.pid                                   = pusch.pid;
+  pusch_info.rnti                                  = pusch.sch.grant.rnti;
+  pusch_info.pdu                                   = srsran::make_byte_buffer();
+  if (pusch_info.pdu == nullptr) {
+    logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    return;
+  }
+  pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
+  pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
+
+  // Decode PUSCH
+  if (srsran_gnb_ul_get_pusch(lane.gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
+      SRSRAN_SUCCESS) {
+    logger.error("Error getting PUSCH");
+    return;
+  }
+
+  // Extract DMRS information
+  pusch_info.csi                = lane.gnb_ul->dmrs.csi;
+  pusch_results[pusch_idx].ok = true;
+
+  // Log PUSCH decoding
+  if (logger.info.enabled()) {
+    std::array<char, 512> str;
+    srsran_gnb_ul_pusch_info(lane.gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
+
+    if (logger.debug.enabled()) {
+      std::array<char, 1024> str_extra = {};
+      srsran_sch_cfg_nr_info(&pusch.sch, str_extra.data(), (uint32_t)str_extra.size());
+      logger.info("PUSCH: %s\n%s", str.data(), str_extra.data());
+    } else {
+      logger.info("PUSCH: %s", str.data());
+    }
+  }
+}
+
 bool slot_worker::work_ul()
 {
-  stack_interface_phy_nr::ul_sched_t* ul_sched = stack.get_ul_sched(ul_slot_cfg);
+  ul_sched = stack.get_ul_sched(ul_slot_cfg);
   if (ul_sched == nullptr) {
     logger.error("Error retrieving UL scheduling");
     return false;
@@ -183,104 +322,70 @@ bool slot_worker::work_ul()
     return false;
   }
 
-  // For each PUCCH...
-  for (stack_interface_phy_nr::pucch_t& pucch : ul_sched->pucch) {
-    srsran::bounded_vector<stack_interface_phy_nr::pucch_info_t, stack_interface_phy_nr::MAX_PUCCH_CANDIDATES>
-        pucch_info(pucch.candidates.size());
-
-    // For each candidate decode PUCCH
-    for (uint32_t i = 0; i < (uint32_t)pucch.candidates.size(); i++) {
-      pucch_info[i].uci_data.cfg = pucch.candidates[i].uci_cfg;
-
-      // Decode PUCCH
-      if (srsran_gnb_ul_get_pucch(&gnb_ul,
-                                  &ul_slot_cfg,
-                                  &pucch.pucch_cfg,
-                                  &pucch.candidates[i].resource,
-                                  &pucch_info[i].uci_data.cfg,
-                                  &pucch_info[i].uci_data.value,
-                                  &pucch_info[i].csi) < SRSRAN_SUCCESS) {
-        logger.error("Error getting PUCCH");
-        return false;
-      }
-    }
-
-    // Find most suitable PUCCH candidate
-    uint32_t best_candidate = 0;
-    for (uint32_t i = 1; i < (uint32_t)pucch_info.size(); i++) {
-      // Select candidate if exceeds the previous best candidate SNR
-      if (pucch_info[i].csi.snr_dB > pucch_info[best_candidate].csi.snr_dB) {
-        best_candidate = i;
-      }
+  // Decode every PUSCH and group of PUCCH as an independent job
+  pucch_results.clear();
+  pucch_results.resize(ul_sched->pucch.size());
+  pusch_results.clear();
+  pusch_results.resize(ul_sched->pusch.size());
+  uint32_t nof_pucch_groups = ((uint32_t)ul_sched->pucch.size() + pucch_group_size - 1) / pucch_group_size;
+  run_jobs((uint32_t)ul_sched->pusch.size() + nof_pucch_groups, true);
+
+  // Inform stack, the jobs have logged their errors
+  for (pucch_result_t& pucch : pucch_results) {
+    if (not pucch.ok) {
+      return false;
     }
-
-    // Inform stack
-    if (stack.pucch_info(ul_slot_cfg, pucch_info[best_candidate]) < SRSRAN_SUCCESS) {
+    if (stack.pucch_info(ul_slot_cfg, pucch.info) < SRSRAN_SUCCESS) {
       logger.error("Error pushing PUCCH information to stack");
       return false;
     }
-
-    // Log PUCCH decoding
-    if (logger.info.enabled()) {
-      std::array<char, 512> str;
-      srsran_gnb_ul_pucch_info(&gnb_ul,
-                               &pucch.candidates[0].resource,
-                               &pucch_info[best_candidate].uci_data,
-                               &pucch_info[best_candidate].csi,
-                               str.data(),
-                               (uint32_t)str.size());
-
-      logger.info("PUCCH: %s", str.data());
-    }
   }
 
-  // For each PUSCH...
-  for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
-    // Prepare PUSCH
-    stack_interface_phy_nr::pusch_info_t pusch_info = {};
-    pusch_info.uci_cfg                              = pusch.sch.uci;
-    pusch_info.pid                                  = pusch.pid;
-    pusch_info.rnti                                 = pusch.sch.grant.rnti;
-    pusch_info.pdu                                  = srsran::make_byte_buffer();
-    if (pusch_info.pdu == nullptr) {
-      logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+  for (pusch_result_t& pusch : pusch_results) {
+    if (not pusch.ok) {
       return false;
     }
-    pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
-    pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
-
-    // Decode PUSCH
-    if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
-        SRSRAN_SUCCESS) {
-      logger.error("Error getting PUSCH");
+    if (stack.pusch_info(ul_slot_cfg, pusch.info) < SRSRAN_SUCCESS) {
+      logger.error("Error pushing PUSCH information to stack");
       return false;
     }
+  }
 
-    // Extract DMRS information
-    pusch_info.csi = gnb_ul.dmrs.csi;
+  return true;
+}
 
-    // Inform stack
-    if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
-      logger.error("Error pushing PUSCH information to stack");
-      return false;
-    }
+void slot_worker::encode_pdsch(const slot_lane_t& lane, uint32_t pdsch_idx)
+{
+  const stack_interface_phy_nr::pdsch_t& pdsch = dl_sched->pdsch[pdsch_idx];
 
-    // Log PUSCH decoding
-    if (logger.info.enabled()) {
-      std::array<char, 512> str;
-      srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
-
-      if (logger.debug.enabled()) {
-        std::array<char, 1024> str_extra = {};
-        srsran_sch_cfg_nr_info(&pusch.sch, str_extra.data(), (uint32_t)str_extra.size());
-        logger.info("PUSCH: %s\n%s", str.data(), str_extra.data());
-      } else {
-        logger.info("PUSCH: %s", str.data());
-      }
+  // convert MAC to PHY buffer data structures
+  uint8_t* data[SRSRAN_MAX_TB] = {};
+  for (uint32_t i = 0; i < SRSRAN_MAX_TB; ++i) {
+    if (pdsch.data[i] != nullptr) {
+      data[i] = pdsch.data[i]->msg;
     }
   }
 
-  return true;
+  // Put PDSCH message
+  if (srsran_gnb_dl_pdsch_put(lane.gnb_dl, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
+    logger.error("PDSCH: Error putting DL message");
+    pdsch_failed = true;
+    return;
+  }
+
+  // Log PDSCH information
+  if (logger.info.enabled()) {
+    std::array<char, 512> str = {};
+    srsran_gnb_dl_pdsch_info(lane.gnb_dl, &pdsch.sch, str.data(), (uint32_t)str.size());
+
+    if (logger.debug.enabled()) {
+      std::array<char, 1024> str_extra = {};
+      srsran_sch_cfg_nr_info(&pdsch.sch, str_extra.data(), (uint32_t)str_extra.size());
+      logger.info("PDSCH: cc=%d %s tti_tx=%d\n%s", cell_index, str.data(), dl_slot_cfg.idx, str_extra.data());
+    } else {
+      logger.info("PDSCH: cc=%d %s tti_tx=%d", cell_index, str.data(), dl_slot_cfg.idx);
+    }
+  }
 }
 
 bool slot_worker::work_dl()
@@ -348,35 +453,12 @@ bool slot_worker::work_dl()
     }
   }
 
-  // Encode PDSCH
-  for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
-    // convert MAC to PHY buffer data structures
-    uint8_t* data[SRSRAN_MAX_TB] = {};
-    for (uint32_t i = 0; i < SRSRAN_MAX_TB; ++i) {
-      if (pdsch.data[i] != nullptr) {
-        data[i] = pdsch.data[i]->msg;
-      }
-    }
-
-    // Put PDSCH message
-    if (srsran_gnb_dl_pdsch_put(&gnb_dl, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
-      logger.error("PDSCH: Error putting DL message");
-      return false;
-    }
-
-    // Log PDSCH information
-    if (logger.info.enabled()) {
-      std::array<char, 512> str = {};
-      srsran_gnb_dl_pdsch_info(&gnb_dl, &pdsch.sch, str.data(), (uint32_t)str.size());
-
-      if (logger.debug.enabled()) {
-        std::array<char, 1024> str_extra = {};
-        srsran_sch_cfg_nr_info(&pdsch.sch, str_extra.data(), (uint32_t)str_extra.size());
-        logger.info("PDSCH: cc=%d %s tti_tx=%d\n%s", cell_index, str.data(), dl_slot_cfg.idx, str_extra.data());
-      } else {
-        logger.info("PDSCH: cc=%d %s tti_tx=%d", cell_index, str.data(), dl_slot_cfg.idx);
-      }
-    }
+  // Encode every PDSCH as an independent job, they are mapped to different PRB of the grid
+  dl_sched     = dl_sched_ptr;
+  pdsch_failed = false;
+  run_jobs((uint32_t)dl_sched->pdsch.size(), false);
+  if (pdsch_failed) {
+    return false;
   }
 
   // Put NZP-CSI-RS
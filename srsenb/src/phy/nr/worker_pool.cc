@@ -53,13 +53,18 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   logger.set_level(log_level);
 
+  // Create the threads the workers share for running the slot jobs in parallel
+  if (args.nof_task_threads > 0) {
+    task_pool.reset(new slot_task_pool(args.nof_task_threads, args.prio));
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
-    auto w = new slot_worker(common, stack, *this, log);
+    auto w = new slot_worker(common, stack, *this, log, task_pool.get());
     pool.init_worker(i, w, args.prio);
     workers.push_back(std::unique_ptr<slot_worker>(w));
 
@@ -72,6 +77,8 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.rf_port                 = cell_list[cell_index].rf_port;
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
+    w_args.pusch_early_stop        = args.pusch_early_stop;
+    w_args.uci_polar_list_size     = args.uci_polar_list_size;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
 
     if (not w->init(w_args)) {
@@ -87,8 +94,8 @@ void worker_pool::start_worker(slot_worker* w)
   // Push worker into synchronization queue
   slot_sync.push(w);
 
-  // Feed PRACH detection before start processing
-  prach.new_tti(0, current_tti, w->get_buffer_rx(0));
+  // Feed PRACH detection before start processing, the worker context holds the TTI it was taken for
+  prach.new_tti(0, w->get_tti(), w->get_buffer_rx(0));
 
   // Start actual worker
   pool.start_worker(w);
@@ -96,13 +103,12 @@ void worker_pool::start_worker(slot_worker* w)
 
 slot_worker* worker_pool::wait_worker(uint32_t tti)
 {
-  slot_worker* w = (slot_worker*)pool.wait_worker(tti);
-
-  // Save current TTI
-  current_tti = tti;
+  return (slot_worker*)pool.wait_worker(tti);
+}
 
-  // Return worker
-  return w;
+slot_worker* worker_pool::wait_worker_nb(uint32_t tti)
+{
+  return (slot_worker*)pool.wait_worker_nb(tti);
 }
 
 slot_worker* worker_pool::wait_worker_id(uint32_t id)
@@ -113,6 +119,9 @@ slot_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  if (task_pool != nullptr) {
+    task_pool->stop();
+  }
   prach.stop();
 }
 
@@ -154,6 +163,11 @@ int worker_pool::set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common
     logger.info("Setting SSB configuration %s", ssb_cfg_str.data());
   }
 
+  // The task pool threads apply the carrier before their next job
+  if (task_pool != nullptr) {
+    task_pool->set_carrier(common_cfg.carrier);
+  }
+
   // For each worker set configuration
   for (uint32_t i = 0; i < pool.get_nof_workers(); i++) {
     // Reserve worker from pool
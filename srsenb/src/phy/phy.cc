@@ -21,6 +21,7 @@
 
 #include "srsenb/hdr/phy/phy.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/cpu_topology.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/threads.h"
 #include <pthread.h>
@@ -102,6 +103,57 @@ void phy::parse_common_config(const phy_cfg_t& cfg)
   workers_common.dmrs_pusch_cfg.sequence_hopping_en = cfg.pusch_cnfg.ul_ref_sigs_pusch.seq_hop_enabled;
 }
 
+uint32_t phy::plan_cpu_layout(uint32_t nof_phy_threads)
+{
+  srsran::cpu_topology topology;
+  if (not topology.read()) {
+    phy_log.warning("Couldn't read the CPU topology, using %d PHY threads", nof_phy_threads);
+    return nof_phy_threads;
+  }
+
+  // Threads are only pinned to isolated cores, the other cores are shared with the rest of the system
+  std::vector<uint32_t> cores = topology.select_cores(true);
+  bool                  pin   = not cores.empty();
+  if (not pin) {
+    cores = topology.select_cores(false);
+  }
+
+  // The RF and PRACH threads take a core each when there are enough, the workers run on the remaining ones
+  std::vector<uint32_t> worker_cores = cores;
+  if (cores.size() >= 3) {
+    cpu_layout.rf    = {cores[0]};
+    cpu_layout.prach = {cores[1]};
+    worker_cores.erase(worker_cores.begin(), worker_cores.begin() + 2);
+  } else if (cores.size() == 2) {
+    cpu_layout.rf    = {cores[0]};
+    cpu_layout.prach = {cores[0]};
+    worker_cores.erase(worker_cores.begin());
+  } else {
+    cpu_layout.rf    = cores;
+    cpu_layout.prach = cores;
+  }
+  cpu_layout.workers = worker_cores;
+
+  // One worker per core processing a subframe, plus the one receiving the next subframe
+  uint32_t nof_workers_ = std::max(std::min((uint32_t)worker_cores.size() + 1, (uint32_t)MAX_WORKERS), 2U);
+
+  if (pin) {
+    phy_log.info("CPU topology %s. Pinning RF to CPU %d, PRACH to CPU %d and %d PHY workers to CPUs %s",
+                 topology.to_string().c_str(),
+                 cpu_layout.rf[0],
+                 cpu_layout.prach[0],
+                 nof_workers_,
+                 fmt::format("{}", fmt::join(worker_cores.begin(), worker_cores.end(), ",")).c_str());
+  } else {
+    phy_log.warning("CPU topology %s. No isolated cores, running %d PHY workers without pinning",
+                    topology.to_string().c_str(),
+                    nof_workers_);
+    cpu_layout = {};
+  }
+
+  return nof_workers_;
+}
+
 int phy::init(const phy_args_t&            args,
               const phy_cfg_t&             cfg,
               srsran::radio_interface_phy* radio_,
@@ -120,6 +172,9 @@ int phy::init(const phy_args_t&            args,
   }
 
   tx_rx.init(enb_, radio, &lte_workers, &workers_common, &prach, SF_RECV_THREAD_PRIO);
+  if (not cpu_layout.rf.empty()) {
+    tx_rx.set_affinity(cpu_layout.rf);
+  }
   initialized = true;
 
   return SRSRAN_SUCCESS;
@@ -137,6 +192,9 @@ int phy::init(const phy_args_t&            args,
   }
 
   tx_rx.init(enb_, radio, &lte_workers, &workers_common, &prach, SF_RECV_THREAD_PRIO);
+  if (not cpu_layout.rf.empty()) {
+    tx_rx.set_affinity(cpu_layout.rf);
+  }
   initialized = true;
 
   return SRSRAN_SUCCESS;
@@ -168,10 +226,16 @@ int phy::init_lte(const phy_args_t&            args,
   phy_log.set_level(log_lvl);
   phy_log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
+  // Size the worker pool from the CPU layout instead of the configured number of threads
+  phy_args_t lte_args = args;
+  if (args.auto_phy_threads) {
+    lte_args.nof_phy_threads = plan_cpu_layout(args.nof_phy_threads);
+  }
+
   radio       = radio_;
-  nof_workers = cfg.phy_cell_cfg.empty() ? 0 : args.nof_phy_threads;
+  nof_workers = cfg.phy_cell_cfg.empty() ? 0 : lte_args.nof_phy_threads;
 
-  workers_common.params = args;
+  workers_common.params = lte_args;
 
   workers_common.init(cfg.phy_cell_cfg, cfg.phy_cell_cfg_nr, radio, stack_lte_);
   if (cfg.cfr_config.cfr_enable) {
@@ -180,9 +244,10 @@ int phy::init_lte(const phy_args_t&            args,
 
   parse_common_config(cfg);
 
-  // Add workers to workers pool and start threads
+  // Add workers to workers pool and start threads, the configured number of threads is the least kept in flight
   if (not cfg.phy_cell_cfg.empty()) {
-    lte_workers.init(args, &workers_common, log_sink, WORKERS_THREAD_PRIO);
+    lte_workers.init(
+        lte_args, &workers_common, log_sink, WORKERS_THREAD_PRIO, cpu_layout.workers, args.nof_phy_threads);
   }
 
   // For each carrier, initialise PRACH worker
@@ -197,6 +262,9 @@ int phy::init_lte(const phy_args_t&            args,
                args.nof_prach_threads);
   }
   prach.set_max_prach_offset_us(args.max_prach_offset_us);
+  if (not cpu_layout.prach.empty()) {
+    prach.set_affinity(cpu_layout.prach);
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -376,6 +444,9 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.pusch_early_stop        = args.nr_pusch_early_stop;
+  worker_args.uci_polar_list_size     = args.nr_uci_polar_list_size;
+  worker_args.nof_task_threads        = args.nof_nr_task_threads;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
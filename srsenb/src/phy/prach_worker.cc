@@ -157,13 +157,17 @@ int prach_worker::run_tti(sf_buffer* b)
 
     if (prach_nof_det) {
       for (uint32_t i = 0; i < prach_nof_det; i++) {
-        logger.info("PRACH: cc=%d, %d/%d, preamble=%d, offset=%.1f us, peak2avg=%.1f, max_offset=%.1f us",
+        float energy_dB = (prach_indices[i] < prach.nof_meas)
+                              ? srsran_convert_power_to_dB(prach.meas[prach_indices[i]].energy)
+                              : NAN;
+        logger.info("PRACH: cc=%d, %d/%d, preamble=%d, offset=%.1f us, peak2avg=%.1f, pwr=%.1f dB, max_offset=%.1f us",
                     cc_idx,
                     i,
                     prach_nof_det,
                     prach_indices[i],
                     prach_offsets[i] * 1e6,
                     prach_p2avg[i],
+                    energy_dB,
                     max_prach_offset_us);
 
         if (prach_offsets[i] * 1e6 < max_prach_offset_us) {
@@ -19,6 +19,7 @@
  *
  */
 
+#include <thread>
 #include <unistd.h>
 
 #include "srsenb/hdr/phy/txrx.h"
@@ -68,6 +69,17 @@ bool txrx::init(enb_time_interface*          enb_,
         new srsran::channel(worker_com->params.ul_channel_args, worker_com->get_nof_rf_channels(), logger));
   }
 
+  // Start the dispatcher first, it waits for the first received subframe
+  if (worker_com->params.pipelined_txrx) {
+    if (sem_init(&rx_queue_sem, 0, 0) != 0) {
+      logger.error("Error initialising the TXRX pipeline semaphore");
+      return false;
+    }
+    drop_buffer = std::unique_ptr<srsran::rf_buffer_t>(new srsran::rf_buffer_t(1));
+    dispatcher  = std::unique_ptr<dispatcher_t>(new dispatcher_t(this));
+    dispatcher->start(prio_);
+  }
+
   start(prio_);
   return true;
 }
@@ -83,14 +95,151 @@ void txrx::stop()
   if (running) {
     running = false;
     wait_thread_finish();
+
+    if (dispatcher) {
+      sem_post(&rx_queue_sem);
+      dispatcher->wait_thread_finish();
+      dispatcher.reset();
+      sem_destroy(&rx_queue_sem);
+
+      logger.info("TXRX pipeline: %d subframes dropped", nof_dropped);
+      logger.info("TXRX pipeline rx latency: %s", rx_latency.to_string());
+      logger.info("TXRX pipeline queue latency: %s", queue_latency.to_string());
+      logger.info("TXRX pipeline dispatch latency: %s", dispatch_latency.to_string());
+      if (nof_dropped > 0) {
+        srsran::console("TXRX: %d subframes were dropped because no PHY worker was idle\n", nof_dropped);
+      }
+    }
+  }
+}
+
+bool txrx::set_affinity(const std::vector<uint32_t>& cpus)
+{
+  bool ret = thread::set_affinity(cpus);
+  if (dispatcher) {
+    ret = dispatcher->set_affinity(cpus) and ret;
+  }
+  return ret;
+}
+
+void txrx::latency_histogram_t::add(std::chrono::steady_clock::duration d)
+{
+  int64_t  us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+  uint32_t i  = 0;
+  while (i < nof_buckets - 1 and us >= (1LL << i)) {
+    i++;
+  }
+  count[i]++;
+  max_us = std::max(max_us, (uint32_t)std::max(us, (int64_t)0));
+}
+
+std::string txrx::latency_histogram_t::to_string() const
+{
+  fmt::memory_buffer buffer;
+  for (uint32_t i = 0; i < nof_buckets; i++) {
+    if (count[i] == 0) {
+      continue;
+    }
+    if (i < nof_buckets - 1) {
+      fmt::format_to(buffer, "<{}us:{} ", 1U << i, count[i]);
+    } else {
+      fmt::format_to(buffer, ">={}us:{} ", 1U << (i - 1), count[i]);
+    }
+  }
+  fmt::format_to(buffer, "max={}us", max_us);
+  return fmt::to_string(buffer);
+}
+
+void txrx::set_buffers(srsran::rf_buffer_t& buffer, lte::sf_worker* lte_worker, nr::slot_worker* nr_worker)
+{
+  uint32_t cc = 0;
+  for (uint32_t cc_lte = 0; cc_lte < worker_com->get_nof_carriers_lte(); cc_lte++, cc++) {
+    uint32_t rf_port = worker_com->get_rf_port(cc);
+
+    for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
+      // WARNING: The number of ports for all cells must be the same
+      buffer.set(rf_port, p, worker_com->get_nof_ports(0), lte_worker->get_buffer_rx(cc_lte, p));
+    }
+  }
+  for (uint32_t cc_nr = 0; cc_nr < worker_com->get_nof_carriers_nr(); cc_nr++, cc++) {
+    uint32_t rf_port = worker_com->get_rf_port(cc);
+
+    for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
+      // WARNING:
+      // - The number of ports for all cells must be the same
+      // - Only one NR cell is currently supported
+      if (nr_worker != nullptr) {
+        buffer.set(rf_port, p, worker_com->get_nof_ports(0), nr_worker->get_buffer_rx(p));
+      }
+    }
+  }
+  buffer.set_nof_samples(sf_len);
+}
+
+void txrx::dispatch(rx_sf_t& sf, srsran::rf_buffer_t& buffer)
+{
+  logger.set_context(sf.tti);
+
+  // Without workers there is no carrier to process, only the stack clock advances
+  if (sf.lte_worker != nullptr or sf.nr_worker != nullptr) {
+    if (ul_channel) {
+      ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, sf.timestamp.get(0));
+    }
+
+    // Compute TX time: Any transmission happens in TTI+4 thus advance 4 ms the reception time
+    sf.timestamp.add(FDD_HARQ_DELAY_UL_MS * 1e-3);
+
+    Debug("Setting TTI=%d, tx_time=%ld:%f to worker %d",
+          sf.tti,
+          sf.timestamp.get(0).full_secs,
+          sf.timestamp.get(0).frac_secs,
+          sf.lte_worker ? sf.lte_worker->get_id() : 0);
+
+    // Trigger prach worker execution
+    for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
+      prach->new_tti(cc, sf.tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
+    }
+
+    // Set NR worker context and start
+    if (sf.nr_worker != nullptr) {
+      srsran::phy_common_interface::worker_context_t context;
+      context.sf_idx     = sf.tti;
+      context.worker_ptr = sf.nr_worker;
+      context.last       = (sf.lte_worker == nullptr); // Set last if standalone
+      context.tx_time.copy(sf.timestamp);
+
+      sf.nr_worker->set_context(context);
+
+      // Start NR worker processing
+      worker_com->semaphore.push(sf.nr_worker);
+      nr_workers->start_worker(sf.nr_worker);
+    }
+
+    // Set LTE worker context and start
+    if (sf.lte_worker != nullptr) {
+      srsran::phy_common_interface::worker_context_t context;
+      context.sf_idx     = sf.tti;
+      context.worker_ptr = sf.lte_worker;
+      context.last       = true;
+      context.tx_time.copy(sf.timestamp);
+
+      sf.lte_worker->set_context(context);
+
+      // Start LTE worker processing
+      worker_com->semaphore.push(sf.lte_worker);
+      lte_workers->start_worker(sf.lte_worker);
+    }
   }
+
+  // Advance in time
+  enb->tti_clock();
 }
 
 void txrx::run_thread()
 {
   srsran::rf_buffer_t    buffer    = {};
   srsran::rf_timestamp_t timestamp = {};
-  uint32_t               sf_len    = SRSRAN_SF_LEN_PRB(worker_com->get_nof_prb(0));
+  sf_len                           = SRSRAN_SF_LEN_PRB(worker_com->get_nof_prb(0));
 
   float samp_rate = srsran_sampling_freq_hz(worker_com->get_nof_prb(0));
 
@@ -136,6 +285,12 @@ void txrx::run_thread()
   // Set TTI so that first TX is at tti=0
   tti = TTI_SUB(0, FDD_HARQ_DELAY_UL_MS + 1);
 
+  // The RF thread only receives in pipelined mode
+  if (dispatcher) {
+    run_pipelined();
+    return;
+  }
+
   // Main loop
   while (running) {
     tti = TTI_ADD(tti, 1);
@@ -160,84 +315,97 @@ void txrx::run_thread()
       }
     }
 
-    // Multiple cell buffer mapping
-    {
-      uint32_t cc = 0;
-      for (uint32_t cc_lte = 0; cc_lte < worker_com->get_nof_carriers_lte(); cc_lte++, cc++) {
-        uint32_t rf_port = worker_com->get_rf_port(cc);
+    set_buffers(buffer, lte_worker, nr_worker);
+    radio_h->rx_now(buffer, timestamp);
 
-        for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
-          // WARNING: The number of ports for all cells must be the same
-          buffer.set(rf_port, p, worker_com->get_nof_ports(0), lte_worker->get_buffer_rx(cc_lte, p));
-        }
-      }
-      for (uint32_t cc_nr = 0; cc_nr < worker_com->get_nof_carriers_nr(); cc_nr++, cc++) {
-        uint32_t rf_port = worker_com->get_rf_port(cc);
-
-        for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
-          // WARNING:
-          // - The number of ports for all cells must be the same
-          // - Only one NR cell is currently supported
-          if (nr_worker != nullptr) {
-            buffer.set(rf_port, p, worker_com->get_nof_ports(0), nr_worker->get_buffer_rx(p));
-          }
-        }
-      }
-    }
+    rx_sf_t sf    = {};
+    sf.tti        = tti;
+    sf.lte_worker = lte_worker;
+    sf.nr_worker  = nr_worker;
+    sf.timestamp.copy(timestamp);
+    dispatch(sf, buffer);
+  }
+}
 
-    buffer.set_nof_samples(sf_len);
-    radio_h->rx_now(buffer, timestamp);
+void txrx::run_pipelined()
+{
+  srsran::rf_buffer_t    buffer    = {};
+  srsran::rf_timestamp_t timestamp = {};
 
-    if (ul_channel) {
-      ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
-    }
+  while (running) {
+    tti = TTI_ADD(tti, 1);
 
-    // Compute TX time: Any transmission happens in TTI+4 thus advance 4 ms the reception time
-    timestamp.add(FDD_HARQ_DELAY_UL_MS * 1e-3);
+    // Take idle workers without waiting for them, a busy pool must not stall the radio
+    rx_sf_t sf = {};
+    sf.tti     = tti;
+    bool drop  = false;
+    if (worker_com->get_nof_carriers_lte() > 0) {
+      sf.lte_worker = lte_workers->wait_worker_nb(tti);
+      drop          = (sf.lte_worker == nullptr);
+    }
+    if (not drop and nr_workers != nullptr and worker_com->get_nof_carriers_nr() > 0) {
+      sf.nr_worker = nr_workers->wait_worker_nb(tti);
+      drop         = (sf.nr_worker == nullptr);
+    }
 
-    Debug("Setting TTI=%d, tx_time=%ld:%f to worker %d",
-          tti,
-          timestamp.get(0).full_secs,
-          timestamp.get(0).frac_secs,
-          lte_worker ? lte_worker->get_id() : 0);
+    if (drop) {
+      // Give back a worker taken for this TTI and receive the subframe into a scratch buffer
+      if (sf.lte_worker != nullptr) {
+        sf.lte_worker->release();
+        sf.lte_worker = nullptr;
+      }
+      for (uint32_t ch = 0; ch < worker_com->get_nof_rf_channels(); ch++) {
+        buffer.set(ch, drop_buffer->get(ch));
+      }
+      buffer.set_nof_samples(sf_len);
+      nof_dropped++;
+      Warning("Dropping TTI=%d, no PHY worker is idle", tti);
+    } else {
+      // Receive straight into the worker buffers
+      set_buffers(buffer, sf.lte_worker, sf.nr_worker);
+    }
 
-    // Trigger prach worker execution
-    for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
-      prach->new_tti(cc, tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    radio_h->rx_now(buffer, timestamp);
+    sf.rx_time = std::chrono::steady_clock::now();
+    rx_latency.add(sf.rx_time - t0);
+    sf.timestamp.copy(timestamp);
+
+    // Only the entries holding workers are bounded by the pool size, dropped ones keep coming while the workers are
+    // busy. The queue fills up if the dispatcher falls rx_queue_sz subframes behind, then the RF thread waits for it
+    while (not rx_queue.try_push(sf) and running) {
+      std::this_thread::yield();
     }
+    sem_post(&rx_queue_sem);
+  }
+}
 
-    // Set NR worker context and start
-    if (nr_worker != nullptr) {
-      srsran::phy_common_interface::worker_context_t context;
-      context.sf_idx     = tti;
-      context.worker_ptr = nr_worker;
-      context.last       = (lte_worker == nullptr); // Set last if standalone
-      context.tx_time.copy(timestamp);
+void txrx::run_dispatcher()
+{
+  srsran::rf_buffer_t buffer = {};
 
-      nr_worker->set_context(context);
+  while (running) {
+    sem_wait(&rx_queue_sem);
 
-      // Start NR worker processing
-      worker_com->semaphore.push(nr_worker);
-      nr_workers->start_worker(nr_worker);
+    rx_sf_t sf = {};
+    if (not rx_queue.try_pop(sf)) {
+      // Woken up for stopping
+      continue;
     }
 
-    // Set LTE worker context and start
-    if (lte_worker != nullptr) {
-      srsran::phy_common_interface::worker_context_t context;
-      context.sf_idx     = tti;
-      context.worker_ptr = lte_worker;
-      context.last       = true;
-      context.tx_time.copy(timestamp);
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    queue_latency.add(t0 - sf.rx_time);
 
-      lte_worker->set_context(context);
-
-      // Start LTE worker processing
-      worker_com->semaphore.push(lte_worker);
-      lte_workers->start_worker(lte_worker);
+    // A dropped subframe has no worker buffers, only the stack clock advances
+    if (sf.lte_worker == nullptr and sf.nr_worker == nullptr) {
+      logger.set_context(sf.tti);
+      enb->tti_clock();
+    } else {
+      set_buffers(buffer, sf.lte_worker, sf.nr_worker);
+      dispatch(sf, buffer);
     }
 
-    // Advance in time
-    enb->tti_clock();
+    dispatch_latency.add(std::chrono::steady_clock::now() - t0);
   }
 }
 
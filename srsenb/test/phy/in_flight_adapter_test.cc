@@ -0,0 +1,100 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/phy/lte/in_flight_adapter.h"
+#include "srsran/support/srsran_test.h"
+
+using srsenb::lte::in_flight_adapter;
+
+/// Feeds the same busy time for n subframes, returns the number of changes
+static uint32_t feed(in_flight_adapter& adapter, uint32_t busy_us, uint32_t n)
+{
+  uint32_t nof_changes = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    nof_changes += adapter.new_busy_time(busy_us) ? 1 : 0;
+  }
+  return nof_changes;
+}
+
+/// Light load shrinks to the minimum after a whole window, never before and never below it
+int test_shrink()
+{
+  in_flight_adapter adapter(8, 3);
+  TESTASSERT_EQ(8, adapter.get_nof_in_flight());
+
+  TESTASSERT_EQ(0, feed(adapter, 1200, in_flight_adapter::window_tti - 1));
+  TESTASSERT_EQ(8, adapter.get_nof_in_flight());
+
+  // 1.2 ms busy holds 2 subframes, plus the spare, which is the minimum
+  TESTASSERT_EQ(1, feed(adapter, 1200, 1));
+  TESTASSERT_EQ(3, adapter.get_nof_in_flight());
+
+  // Below the minimum it stays at the minimum
+  feed(adapter, 100, 2 * in_flight_adapter::window_tti);
+  TESTASSERT_EQ(3, adapter.get_nof_in_flight());
+
+  return SRSRAN_SUCCESS;
+}
+
+/// A slow subframe grows the number right away, and it shrinks back one window after the load goes down
+int test_grow()
+{
+  in_flight_adapter adapter(8, 3);
+  feed(adapter, 500, in_flight_adapter::window_tti);
+  TESTASSERT_EQ(3, adapter.get_nof_in_flight());
+
+  // 4.5 ms busy holds 5 subframes, plus the spare
+  TESTASSERT_EQ(1, feed(adapter, 4500, 1));
+  TESTASSERT_EQ(6, adapter.get_nof_in_flight());
+
+  // Never more than the workers
+  TESTASSERT_EQ(1, feed(adapter, 20000, 1));
+  TESTASSERT_EQ(8, adapter.get_nof_in_flight());
+
+  // The window holding the slow subframes keeps the number up, the next one brings it down
+  feed(adapter, 500, in_flight_adapter::window_tti);
+  TESTASSERT_EQ(8, adapter.get_nof_in_flight());
+  feed(adapter, 500, in_flight_adapter::window_tti);
+  TESTASSERT_EQ(3, adapter.get_nof_in_flight());
+
+  return SRSRAN_SUCCESS;
+}
+
+/// A minimum above the number of workers keeps all of them
+int test_min_above_workers()
+{
+  in_flight_adapter adapter(2, 3);
+  feed(adapter, 100, 2 * in_flight_adapter::window_tti);
+  TESTASSERT_EQ(2, adapter.get_nof_in_flight());
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_shrink() == SRSRAN_SUCCESS);
+  TESTASSERT(test_grow() == SRSRAN_SUCCESS);
+  TESTASSERT(test_min_above_workers() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/txrx.h"
+#include "srsran/common/test_common.h"
+#include "srsran/radio/radio_null.h"
+#include <thread>
+
+namespace {
+
+class dummy_enb_time final : public srsenb::enb_time_interface
+{
+public:
+  void tti_clock() override { nof_ticks++; }
+
+  std::atomic<uint32_t> nof_ticks = {0};
+};
+
+} // namespace
+
+/// Runs the pipelined TXRX without idle LTE workers, so every subframe is dropped. The stack clock shall keep ticking
+int test_pipelined_drop()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TXRX", false);
+
+  srsenb::phy_cell_cfg_list_t cell_list(1);
+  cell_list[0]                = {};
+  cell_list[0].cell.nof_prb   = 6;
+  cell_list[0].cell.nof_ports = 1;
+  cell_list[0].dl_freq_hz     = 2680e6;
+  cell_list[0].ul_freq_hz     = 2560e6;
+
+  srsran::radio_null radio;
+  radio.init({}, nullptr);
+
+  srsenb::phy_common common;
+  common.params.pipelined_txrx = true;
+  TESTASSERT(common.init(cell_list, {}, &radio, nullptr));
+
+  // The pool has no worker initialised, it never returns an idle one
+  srsenb::lte::worker_pool  lte_workers(1);
+  srsenb::prach_worker_pool prach;
+  dummy_enb_time            enb;
+
+  srsenb::txrx tx_rx(logger);
+  TESTASSERT(tx_rx.init(&enb, &radio, &lte_workers, &common, &prach, 10));
+
+  const uint32_t nof_ticks = 100;
+  for (uint32_t i = 0; i < 5000 and enb.nof_ticks < nof_ticks; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  tx_rx.stop();
+  lte_workers.stop();
+  common.stop();
+
+  TESTASSERT(enb.nof_ticks >= nof_ticks);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_pipelined_drop() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -180,6 +180,7 @@ void ue_nr::metrics_read(mac_ue_metrics_t* metrics_)
   dl_cqi_valid_counter = 0;
   pucch_sinr_counter   = 0;
   pusch_sinr_counter   = 0;
+  fec_iters_counter    = 0;
   ue_metrics           = {};
 }
 
@@ -263,6 +264,16 @@ void ue_nr::metrics_pusch_sinr(float sinr)
   }
 }
 
+void ue_nr::metrics_fec_iters(float iters)
+{
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  // average LDPC iterations per code block, NAN if no code block was decoded
+  if (!std::isnan(iters)) {
+    ue_metrics.fec_iters = SRSRAN_VEC_SAFE_CMA(iters, ue_metrics.fec_iters, fec_iters_counter);
+    fec_iters_counter++;
+  }
+}
+
 // Called from Stack thread when demuxing UL PDUs
 void ue_nr::store_msg3(srsran::unique_byte_buffer_t pdu)
 {
@@ -51,6 +51,7 @@ public:
   void     set_agc_enable(bool enable);
   ret_code run(srsran_cell_t* cell, std::array<uint8_t, SRSRAN_BCH_PAYLOAD_LEN>& bch_payload);
   void     set_cp_en(bool enable);
+  void     set_fast_search(bool enable);
 
 private:
   search_callback*       p = nullptr;
@@ -60,6 +61,7 @@ private:
   srsran_ue_mib_sync_t   ue_mib_sync  = {};
   int                    force_N_id_2 = 0;
   int                    force_N_id_1 = 0;
+  bool                   fast_search  = false;
 };
 
 }; // namespace srsue
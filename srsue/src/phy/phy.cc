@@ -148,6 +148,9 @@ void phy::run_thread()
   sfsync.init(
       radio, stack, &prach_buffer, &lte_workers, &nr_workers, &common, SF_RECV_THREAD_PRIO, args.sync_cpu_affinity);
 
+  // Keep the FFTW wisdom of the plans created so far even if the UE does not exit cleanly
+  srsran_dft_wisdom_save();
+
   is_configured = true;
   config_cond.notify_all();
 }
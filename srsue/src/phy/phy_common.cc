@@ -106,11 +106,13 @@ void phy_common::set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg)
       args->interpolate_subframe_enabled ? SRSRAN_ESTIMATOR_ALG_INTERPOLATE : SRSRAN_ESTIMATOR_ALG_AVERAGE;
   chest_cfg->cfo_estimate_enable  = args->cfo_ref_mask != 0;
   chest_cfg->cfo_estimate_sf_mask = args->cfo_ref_mask;
+  chest_cfg->precomputed_interp   = args->estimator_precomputed;
 }
 
 void phy_common::set_pdsch_cfg(srsran_pdsch_cfg_t* pdsch_cfg)
 {
   pdsch_cfg->csi_enable         = args->pdsch_csi_enabled;
+  pdsch_cfg->fused_demod        = args->pdsch_fused_demod;
   pdsch_cfg->max_nof_iterations = args->pdsch_max_its;
   pdsch_cfg->meas_evm_en        = args->meas_evm;
   pdsch_cfg->decoder_type       = (args->equalizer_mode == "zf") ? SRSRAN_MIMO_DECODER_ZF : SRSRAN_MIMO_DECODER_MMSE;
@@ -82,6 +82,11 @@ void search::set_cp_en(bool enable)
   srsran_set_detect_cp(&cs, enable);
 }
 
+void search::set_fast_search(bool enable)
+{
+  fast_search = enable;
+}
+
 void search::reset()
 {
   srsran_ue_sync_reset(&ue_mib_sync.ue_sync);
@@ -124,6 +129,8 @@ search::ret_code search::run(srsran_cell_t* cell_, std::array<uint8_t, SRSRAN_BC
   if (force_N_id_2 >= 0 && force_N_id_2 < SRSRAN_NOF_NID_2) {
     ret           = srsran_ue_cellsearch_scan_N_id_2(&cs, force_N_id_2, &found_cells[force_N_id_2]);
     max_peak_cell = force_N_id_2;
+  } else if (fast_search) {
+    ret = srsran_ue_cellsearch_scan_fast(&cs, found_cells, &max_peak_cell);
   } else {
     ret = srsran_ue_cellsearch_scan(&cs, found_cells, &max_peak_cell);
   }
@@ -90,6 +90,7 @@ test_bench::args_t::args_t(int argc, char** argv)
 
   options_gnb_phy.add_options()
         ("gnb.phy.nof_threads",     bpo::value<uint32_t>(&gnb_phy.nof_phy_threads)->default_value(1),          "Number of threads")
+        ("gnb.phy.nof_task_threads", bpo::value<uint32_t>(&gnb_phy.nof_task_threads)->default_value(0),   "Number of threads for processing the slot channels in parallel")
         ("gnb.phy.log.level",       bpo::value<std::string>(&gnb_phy.log.phy_level)->default_value("warning"), "gNb PHY log level")
         ("gnb.phy.log.hex_limit",   bpo::value<int>(&gnb_phy.log.phy_hex_limit)->default_value(0),             "gNb PHY log hex limit")
         ("gnb.phy.log.id_preamble", bpo::value<std::string>(&gnb_phy.log.id_preamble)->default_value("GNB/"),  "gNb PHY log ID preamble")